@@ -45,10 +45,18 @@ typedef enum {
     CCAP_PIXEL_FORMAT_YUYV_F = CCAP_PIXEL_FORMAT_YUYV | (1 << 17),
     CCAP_PIXEL_FORMAT_UYVY = (1 << 4) | (1 << 16),
     CCAP_PIXEL_FORMAT_UYVY_F = CCAP_PIXEL_FORMAT_UYVY | (1 << 17),
+    CCAP_PIXEL_FORMAT_NV21 = (1 << 5) | (1 << 16),
+    CCAP_PIXEL_FORMAT_NV21F = CCAP_PIXEL_FORMAT_NV21 | (1 << 17),
+    CCAP_PIXEL_FORMAT_YV12 = (1 << 6) | (1 << 16),
+    CCAP_PIXEL_FORMAT_YV12F = CCAP_PIXEL_FORMAT_YV12 | (1 << 17),
+    CCAP_PIXEL_FORMAT_P010 = (1 << 7) | (1 << 16),
+    CCAP_PIXEL_FORMAT_P010F = CCAP_PIXEL_FORMAT_P010 | (1 << 17),
     CCAP_PIXEL_FORMAT_RGB24 = (1 << 3) | (1 << 18),
     CCAP_PIXEL_FORMAT_BGR24 = (1 << 4) | (1 << 18),
     CCAP_PIXEL_FORMAT_RGBA32 = CCAP_PIXEL_FORMAT_RGB24 | (1 << 19),
-    CCAP_PIXEL_FORMAT_BGRA32 = CCAP_PIXEL_FORMAT_BGR24 | (1 << 19)
+    CCAP_PIXEL_FORMAT_BGRA32 = CCAP_PIXEL_FORMAT_BGR24 | (1 << 19),
+    CCAP_PIXEL_FORMAT_RGB565 = (1 << 5) | (1 << 18),
+    CCAP_PIXEL_FORMAT_MJPEG = (1 << 20)
 } CcapPixelFormat;
 
 /** @brief Frame orientation enumeration */
@@ -57,6 +65,20 @@ typedef enum {
     CCAP_FRAME_ORIENTATION_BOTTOM_TO_TOP = 1
 } CcapFrameOrientation;
 
+/** @brief Capture mode enumeration, see CCAP_PROPERTY_CAPTURE_MODE */
+typedef enum {
+    CCAP_CAPTURE_MODE_DEFAULT = 0,
+    CCAP_CAPTURE_MODE_LOW_LATENCY = 1,    /**< Keep only the newest driver buffer */
+    CCAP_CAPTURE_MODE_HIGH_THROUGHPUT = 2 /**< Deeper driver queue */
+} CcapCaptureMode;
+
+/** @brief Capture memory enumeration, see CCAP_PROPERTY_CAPTURE_MEMORY */
+typedef enum {
+    CCAP_CAPTURE_MEMORY_MMAP = 0,
+    CCAP_CAPTURE_MEMORY_USERPTR = 1, /**< Driver writes into memory of the frame allocator */
+    CCAP_CAPTURE_MEMORY_DMABUF = 2   /**< Like USERPTR, with dma-buf exported by the allocator */
+} CcapCaptureMemory;
+
 /** @brief Property name enumeration for camera configuration */
 typedef enum {
     CCAP_PROPERTY_WIDTH = 0x10001,
@@ -64,7 +86,24 @@ typedef enum {
     CCAP_PROPERTY_FRAME_RATE = 0x20000,
     CCAP_PROPERTY_PIXEL_FORMAT_INTERNAL = 0x30001,
     CCAP_PROPERTY_PIXEL_FORMAT_OUTPUT = 0x30002,
-    CCAP_PROPERTY_FRAME_ORIENTATION = 0x40000
+    CCAP_PROPERTY_FRAME_ORIENTATION = 0x40000,
+    CCAP_PROPERTY_OUTPUT_WIDTH = 0x50001,
+    CCAP_PROPERTY_OUTPUT_HEIGHT = 0x50002,
+    CCAP_PROPERTY_CROP_X = 0x60001,
+    CCAP_PROPERTY_CROP_Y = 0x60002,
+    CCAP_PROPERTY_CROP_WIDTH = 0x60003,
+    CCAP_PROPERTY_CROP_HEIGHT = 0x60004,
+    CCAP_PROPERTY_CONVERT_WORKER_COUNT = 0x70001,
+    CCAP_PROPERTY_CONVERT_QUEUE_DEPTH = 0x70002,
+    CCAP_PROPERTY_CONVERT_PENDING_FRAMES = 0x70003,      /**< Read only */
+    CCAP_PROPERTY_CONVERT_PEAK_PENDING_FRAMES = 0x70004, /**< Read only */
+    CCAP_PROPERTY_CONVERT_DROPPED_FRAMES = 0x70005,      /**< Read only */
+    CCAP_PROPERTY_CAPTURE_BUFFER_COUNT = 0x80001,
+    CCAP_PROPERTY_CAPTURE_MODE = 0x80002,   /**< A CcapCaptureMode value */
+    CCAP_PROPERTY_CAPTURE_MEMORY = 0x80003, /**< A CcapCaptureMemory value */
+    CCAP_PROPERTY_MOTION_THRESHOLD = 0x90001,
+    CCAP_PROPERTY_MOTION_MIN_BLOCKS = 0x90002,
+    CCAP_PROPERTY_MOTION_SKIPPED_FRAMES = 0x90003 /**< Read only */
 } CcapPropertyName;
 
 /** @brief Error codes for camera capture operations */
@@ -100,13 +139,37 @@ typedef struct {
     CcapPixelFormat pixelFormat;        /**< Pixel format of the frame */
     uint32_t width;                     /**< Frame width in pixels */
     uint32_t height;                    /**< Frame height in pixels */
-    uint32_t sizeInBytes;               /**< Total size of frame data in bytes */
+    uint32_t sizeInBytes;               /**< Size of frame data in bytes, cropped frames: see VideoFrame::sizeInBytes */
     uint64_t timestamp;                 /**< Frame timestamp in nanoseconds */
     uint64_t frameIndex;                /**< Unique, incremental frame index */
     CcapFrameOrientation orientation;   /**< Frame orientation */
     void* nativeHandle;                 /**< Platform-specific native handle */
 } CcapVideoFrameInfo;
 
+/** @brief Latency distribution in microseconds, bucket i counts samples in [2^i, 2^(i+1)) us */
+typedef struct {
+    uint64_t buckets[CCAP_LATENCY_HISTOGRAM_BUCKETS];
+    uint64_t count;   /**< Number of samples */
+    uint64_t totalUs; /**< Sum of all samples */
+    uint64_t maxUs;   /**< Largest sample */
+} CcapLatencyHistogram;
+
+/** @brief Capture statistics, see ccap::CaptureStats */
+typedef struct {
+    CcapLatencyHistogram captureToReceive;  /**< Driver capture to ccap receiving the frame (Linux) */
+    CcapLatencyHistogram conversion;        /**< Frame conversion time */
+    CcapLatencyHistogram receiveToDelivery; /**< ccap receiving the frame to grab() or the callback */
+    uint64_t receivedFrames;
+    uint64_t deliveredFrames;
+    uint64_t driverDroppedFrames;
+    uint64_t staleDroppedFrames;
+    uint64_t convertDroppedFrames;
+    uint64_t queueDroppedFrames;
+    double fps;                   /**< Delivered frames per second */
+    uint64_t motionSkippedFrames; /**< Frames filtered out by CCAP_PROPERTY_MOTION_THRESHOLD */
+    uint64_t decodeFailedFrames;  /**< MJPEG frames that could not be decoded */
+} CcapCaptureStats;
+
 /** @brief Resolution structure */
 typedef struct {
     uint32_t width;
@@ -305,6 +368,20 @@ CCAP_EXPORT void ccap_provider_set_max_available_frame_size(CcapProvider* provid
  */
 CCAP_EXPORT void ccap_provider_set_max_cache_frame_size(CcapProvider* provider, uint32_t size);
 
+/**
+ * @brief Get the capture statistics
+ * @param provider Pointer to CcapProvider instance
+ * @param stats Pointer to the statistics structure to fill
+ * @return true on success, false on failure
+ */
+CCAP_EXPORT bool ccap_provider_get_stats(const CcapProvider* provider, CcapCaptureStats* stats);
+
+/**
+ * @brief Clear the capture statistics
+ * @param provider Pointer to CcapProvider instance
+ */
+CCAP_EXPORT void ccap_provider_reset_stats(CcapProvider* provider);
+
 
 
 /* ========== Error Callback ========== */
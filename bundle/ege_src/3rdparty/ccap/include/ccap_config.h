@@ -78,6 +78,9 @@
 // Maximum number of resolutions per device
 #define CCAP_MAX_RESOLUTIONS 64
 
+// Number of buckets of a latency histogram, see CcapLatencyHistogram
+#define CCAP_LATENCY_HISTOGRAM_BUCKETS 24
+
 /* ========== Compatibility Macros ========== */
 
 #ifdef __cplusplus
@@ -40,6 +40,28 @@ CCAP_EXPORT bool canUseAVX2(); // Check if AVX2 is enabled, useful for testing
  */
 CCAP_EXPORT bool enableAVX2(bool enable); // Disable AVX2 implementation, useful for testing
 
+/// Check if AVX-512 (F + BW + VL + VBMI) is supported by the CPU and OS. If available, it is preferred over AVX2.
+CCAP_EXPORT bool hasAVX512();
+/// Check if AVX-512 is enabled, useful for testing
+CCAP_EXPORT bool canUseAVX512();
+/**
+ * @brief Enable or disable AVX-512 implementation.
+ * @param enable true to enable AVX-512, false to disable.
+ * @return true if AVX-512 is available and enabled, false otherwise.
+ */
+CCAP_EXPORT bool enableAVX512(bool enable);
+
+/// Check if SSSE3 is supported by the CPU. Used on x86 CPUs without AVX2.
+CCAP_EXPORT bool hasSSSE3();
+/// Check if SSSE3 is enabled, useful for testing
+CCAP_EXPORT bool canUseSSSE3();
+/**
+ * @brief Enable or disable SSSE3 implementation.
+ * @param enable true to enable SSSE3, false to disable.
+ * @return true if SSSE3 is available and enabled, false otherwise.
+ */
+CCAP_EXPORT bool enableSSSE3(bool enable);
+
 /// Check if Apple Accelerate is available. If available, use Apple Accelerate acceleration.
 CCAP_EXPORT bool hasAppleAccelerate();
 /// Check if Apple Accelerate is enabled, useful for testing
@@ -70,12 +92,16 @@ enum class ConvertBackend : uint32_t {
     AVX2,            ///< AVX2 implementation
     AppleAccelerate, ///< Apple Accelerate implementation
     NEON,            ///< NEON implementation
+    AVX512,          ///< AVX-512 (BW/VBMI) implementation
+    SSSE3,           ///< SSSE3 implementation, for x86 CPUs without AVX2
 };
 
 /**
  * @brief Check the current conversion backend that will be used.
  *  If Apple Accelerate is available and enabled, returns AppleAccelerate.
+ *  If AVX-512 is available and enabled, returns AVX512.
  *  If AVX2 is available and enabled, returns AVX2.
+ *  If SSSE3 is available and enabled, returns SSSE3.
  *  If NEON is available and enabled, returns NEON.
  *  Otherwise returns CPU.
  *
@@ -89,11 +115,24 @@ CCAP_EXPORT ConvertBackend getConvertBackend();
  * @param backend
  * @return true if the backend was set successfully.
  * @return false if the backend is not supported or the operation failed.
- * Note: When setting ConvertBackend::AVX2, Apple Accelerate will be automatically disabled.
+ * Note: When setting ConvertBackend::AVX2, Apple Accelerate and AVX-512 will be automatically disabled.
+ * Note: When setting ConvertBackend::AVX512, Apple Accelerate will be automatically disabled, AVX2 stays as the fallback.
+ * Note: When setting ConvertBackend::SSSE3, Apple Accelerate, AVX-512 and AVX2 will be automatically disabled.
  * Note: When setting ConvertBackend::NEON, Apple Accelerate and AVX2 will be automatically disabled.
  */
 CCAP_EXPORT bool setConvertBackend(ConvertBackend backend);
 
+/**
+ * @brief Set the number of threads used by frame conversion (`inplaceConvertFrame`, used by all providers).
+ *  Large frames are split into row bands that run on a shared worker pool, the calling thread takes one band.
+ *  The default is 1, which converts on the calling thread only.
+ * @param count Number of threads including the calling thread. 0 or negative uses `std::thread::hardware_concurrency()`.
+ */
+CCAP_EXPORT void setConvertThreadCount(int count);
+
+/// @return The number of threads used by frame conversion. @see setConvertThreadCount
+CCAP_EXPORT int getConvertThreadCount();
+
 /// @brief YUV 601 video-range to RGB (includes video range preprocessing)
 inline void yuv2rgb601v(int y, int u, int v, int& r, int& g, int& b) {
     y = y - 16;  // video range Y preprocessing
@@ -181,6 +220,29 @@ inline YuvToRgbFunc getYuvToRgbFunc(bool is601, bool isFullRange) {
     }
 }
 
+/// Fixed-point (x256) RGB -> YUV matrix, shared by the CPU/AVX2/NEON rgb -> yuv converters so they give identical results.
+/// Y = (yr * R + yg * G + yb * B + 128) >> 8 + yOffset, U and V are computed from the sums of 2x2 pixel blocks:
+/// U = (ur * R4 + ug * G4 + ub * B4 + 512) >> 10 + 128, clamped to 255, and the same for V.
+struct RgbToYuvCoefficients {
+    int yr, yg, yb, yOffset;
+    int ur, ug, ub;
+    int vr, vg, vb;
+};
+
+inline RgbToYuvCoefficients getRgbToYuvCoefficients(ConvertFlag flag) {
+    if (flag & ConvertFlag::BT601) {
+        if (flag & ConvertFlag::FullRange) {
+            return { 77, 150, 29, 0, -43, -85, 128, 128, -107, -21 };
+        }
+        return { 66, 129, 25, 16, -38, -74, 112, 112, -94, -18 };
+    }
+
+    if (flag & ConvertFlag::FullRange) {
+        return { 54, 183, 19, 0, -29, -99, 128, 128, -116, -12 };
+    }
+    return { 47, 157, 16, 16, -26, -86, 112, 112, -102, -10 };
+}
+
 ///////////// color shuffle /////////////
 
 // swapRB indicates whether to swap Red and Blue channels
@@ -307,6 +369,232 @@ CCAP_EXPORT void uyvyToRgba32(const uint8_t* src, int srcStride,
                   uint8_t* dst, int dstStride,
                   int width, int height, ConvertFlag flag = ConvertFlag::Default);
 
+// NV21 (YUV 4:2:0 semi-planar, interleaved VU) conversion functions
+CCAP_EXPORT void nv21ToBgr24(const uint8_t* srcY, int srcYStride,
+                 const uint8_t* srcVU, int srcVUStride,
+                 uint8_t* dst, int dstStride,
+                 int width, int height, ConvertFlag flag = ConvertFlag::Default);
+
+CCAP_EXPORT void nv21ToRgb24(const uint8_t* srcY, int srcYStride,
+                 const uint8_t* srcVU, int srcVUStride,
+                 uint8_t* dst, int dstStride,
+                 int width, int height, ConvertFlag flag = ConvertFlag::Default);
+
+CCAP_EXPORT void nv21ToBgra32(const uint8_t* srcY, int srcYStride,
+                  const uint8_t* srcVU, int srcVUStride,
+                  uint8_t* dst, int dstStride,
+                  int width, int height, ConvertFlag flag = ConvertFlag::Default);
+
+CCAP_EXPORT void nv21ToRgba32(const uint8_t* srcY, int srcYStride,
+                  const uint8_t* srcVU, int srcVUStride,
+                  uint8_t* dst, int dstStride,
+                  int width, int height, ConvertFlag flag = ConvertFlag::Default);
+
+// YV12 (YUV 4:2:0 planar, V plane first) is I420 with the chroma planes swapped, the planes are passed in memory order.
+inline void yv12ToBgr24(const uint8_t* srcY, int srcYStride, const uint8_t* srcV, int srcVStride, const uint8_t* srcU, int srcUStride,
+                        uint8_t* dst, int dstStride, int width, int height, ConvertFlag flag = ConvertFlag::Default) {
+    i420ToBgr24(srcY, srcYStride, srcU, srcUStride, srcV, srcVStride, dst, dstStride, width, height, flag);
+}
+
+inline void yv12ToRgb24(const uint8_t* srcY, int srcYStride, const uint8_t* srcV, int srcVStride, const uint8_t* srcU, int srcUStride,
+                        uint8_t* dst, int dstStride, int width, int height, ConvertFlag flag = ConvertFlag::Default) {
+    i420ToRgb24(srcY, srcYStride, srcU, srcUStride, srcV, srcVStride, dst, dstStride, width, height, flag);
+}
+
+inline void yv12ToBgra32(const uint8_t* srcY, int srcYStride, const uint8_t* srcV, int srcVStride, const uint8_t* srcU, int srcUStride,
+                         uint8_t* dst, int dstStride, int width, int height, ConvertFlag flag = ConvertFlag::Default) {
+    i420ToBgra32(srcY, srcYStride, srcU, srcUStride, srcV, srcVStride, dst, dstStride, width, height, flag);
+}
+
+inline void yv12ToRgba32(const uint8_t* srcY, int srcYStride, const uint8_t* srcV, int srcVStride, const uint8_t* srcU, int srcUStride,
+                         uint8_t* dst, int dstStride, int width, int height, ConvertFlag flag = ConvertFlag::Default) {
+    i420ToRgba32(srcY, srcYStride, srcU, srcUStride, srcV, srcVStride, dst, dstStride, width, height, flag);
+}
+
+/**
+ * P010 (10-bit YUV 4:2:0 semi-planar, 16-bit little-endian samples with the value in the high bits) conversion functions.
+ * The samples are rounded to 8 bits before the YUV -> RGB conversion. Strides are in bytes.
+ */
+CCAP_EXPORT void p010ToBgr24(const uint8_t* srcY, int srcYStride,
+                 const uint8_t* srcUV, int srcUVStride,
+                 uint8_t* dst, int dstStride,
+                 int width, int height, ConvertFlag flag = ConvertFlag::Default);
+
+CCAP_EXPORT void p010ToRgb24(const uint8_t* srcY, int srcYStride,
+                 const uint8_t* srcUV, int srcUVStride,
+                 uint8_t* dst, int dstStride,
+                 int width, int height, ConvertFlag flag = ConvertFlag::Default);
+
+CCAP_EXPORT void p010ToBgra32(const uint8_t* srcY, int srcYStride,
+                  const uint8_t* srcUV, int srcUVStride,
+                  uint8_t* dst, int dstStride,
+                  int width, int height, ConvertFlag flag = ConvertFlag::Default);
+
+CCAP_EXPORT void p010ToRgba32(const uint8_t* srcY, int srcYStride,
+                  const uint8_t* srcUV, int srcUVStride,
+                  uint8_t* dst, int dstStride,
+                  int width, int height, ConvertFlag flag = ConvertFlag::Default);
+
+//////////// rgb565 to rgb color /////////////
+
+/// 16-bit little-endian RGB565 (R in the high bits) to 8-bit channels, the 5/6-bit values are expanded to the full 0~255 range.
+CCAP_EXPORT void rgb565ToBgr24(const uint8_t* src, int srcStride, uint8_t* dst, int dstStride, int width, int height);
+
+CCAP_EXPORT void rgb565ToRgb24(const uint8_t* src, int srcStride, uint8_t* dst, int dstStride, int width, int height);
+
+CCAP_EXPORT void rgb565ToBgra32(const uint8_t* src, int srcStride, uint8_t* dst, int dstStride, int width, int height);
+
+CCAP_EXPORT void rgb565ToRgba32(const uint8_t* src, int srcStride, uint8_t* dst, int dstStride, int width, int height);
+
+//////////// rgb color to yuv color /////////////
+
+/**
+ * @brief RGB(A) to NV12/I420, e.g. to feed processed frames to a hardware encoder.
+ *  U and V are the average of each 2x2 pixel block, the last row/column is repeated for odd sizes. Alpha is ignored.
+ *  `flag` selects BT.601/BT.709 and video/full range of the output, a negative height flips the image vertically.
+ */
+CCAP_EXPORT void bgra32ToNv12(const uint8_t* src, int srcStride,
+                  uint8_t* dstY, int dstYStride,
+                  uint8_t* dstUV, int dstUVStride,
+                  int width, int height, ConvertFlag flag = ConvertFlag::Default);
+
+CCAP_EXPORT void rgba32ToNv12(const uint8_t* src, int srcStride,
+                  uint8_t* dstY, int dstYStride,
+                  uint8_t* dstUV, int dstUVStride,
+                  int width, int height, ConvertFlag flag = ConvertFlag::Default);
+
+CCAP_EXPORT void bgr24ToNv12(const uint8_t* src, int srcStride,
+                 uint8_t* dstY, int dstYStride,
+                 uint8_t* dstUV, int dstUVStride,
+                 int width, int height, ConvertFlag flag = ConvertFlag::Default);
+
+CCAP_EXPORT void rgb24ToNv12(const uint8_t* src, int srcStride,
+                 uint8_t* dstY, int dstYStride,
+                 uint8_t* dstUV, int dstUVStride,
+                 int width, int height, ConvertFlag flag = ConvertFlag::Default);
+
+/// @see bgra32ToNv12
+CCAP_EXPORT void bgra32ToI420(const uint8_t* src, int srcStride,
+                  uint8_t* dstY, int dstYStride,
+                  uint8_t* dstU, int dstUStride,
+                  uint8_t* dstV, int dstVStride,
+                  int width, int height, ConvertFlag flag = ConvertFlag::Default);
+
+CCAP_EXPORT void rgba32ToI420(const uint8_t* src, int srcStride,
+                  uint8_t* dstY, int dstYStride,
+                  uint8_t* dstU, int dstUStride,
+                  uint8_t* dstV, int dstVStride,
+                  int width, int height, ConvertFlag flag = ConvertFlag::Default);
+
+CCAP_EXPORT void bgr24ToI420(const uint8_t* src, int srcStride,
+                 uint8_t* dstY, int dstYStride,
+                 uint8_t* dstU, int dstUStride,
+                 uint8_t* dstV, int dstVStride,
+                 int width, int height, ConvertFlag flag = ConvertFlag::Default);
+
+CCAP_EXPORT void rgb24ToI420(const uint8_t* src, int srcStride,
+                 uint8_t* dstY, int dstYStride,
+                 uint8_t* dstU, int dstUStride,
+                 uint8_t* dstV, int dstVStride,
+                 int width, int height, ConvertFlag flag = ConvertFlag::Default);
+
+//////////// yuv color to rgb color with resize /////////////
+
+/// Resampling filter of the `*ToRgbScaled` functions.
+enum class ScaleFilter : uint32_t {
+    Auto,     ///< Box when the source is 2x or 4x the output size in both directions, bilinear otherwise
+    Box,      ///< Average of 2x2 or 4x4 source pixels, the source must be 2x or 4x the output size (a remainder row/column is skipped)
+    Bilinear, ///< Bilinear sampling to any output size
+};
+
+/**
+ * @brief Convert YUV to RGB and resize in a single pass, for preview streams that do not need the full camera resolution.
+ *  Only the output pixels are converted, no full-resolution RGB image is written.
+ * @param srcWidth, srcHeight The source size, srcHeight must be positive.
+ * @param dstWidth, dstHeight The output size. A negative dstHeight flips the output vertically.
+ * @param dstFormat One of BGR24, RGB24, BGRA32 and RGBA32.
+ * @return false if an argument is not supported (nothing is written), true otherwise.
+ */
+CCAP_EXPORT bool nv12ToRgbScaled(const uint8_t* srcY, int srcYStride,
+                     const uint8_t* srcUV, int srcUVStride,
+                     int srcWidth, int srcHeight,
+                     uint8_t* dst, int dstStride,
+                     int dstWidth, int dstHeight, PixelFormat dstFormat,
+                     ScaleFilter filter = ScaleFilter::Auto, ConvertFlag flag = ConvertFlag::Default);
+
+/// @see nv12ToRgbScaled
+CCAP_EXPORT bool i420ToRgbScaled(const uint8_t* srcY, int srcYStride,
+                     const uint8_t* srcU, int srcUStride,
+                     const uint8_t* srcV, int srcVStride,
+                     int srcWidth, int srcHeight,
+                     uint8_t* dst, int dstStride,
+                     int dstWidth, int dstHeight, PixelFormat dstFormat,
+                     ScaleFilter filter = ScaleFilter::Auto, ConvertFlag flag = ConvertFlag::Default);
+
+/// @see nv12ToRgbScaled
+CCAP_EXPORT bool yuyvToRgbScaled(const uint8_t* src, int srcStride,
+                     int srcWidth, int srcHeight,
+                     uint8_t* dst, int dstStride,
+                     int dstWidth, int dstHeight, PixelFormat dstFormat,
+                     ScaleFilter filter = ScaleFilter::Auto, ConvertFlag flag = ConvertFlag::Default);
+
+/// @see nv12ToRgbScaled
+CCAP_EXPORT bool uyvyToRgbScaled(const uint8_t* src, int srcStride,
+                     int srcWidth, int srcHeight,
+                     uint8_t* dst, int dstStride,
+                     int dstWidth, int dstHeight, PixelFormat dstFormat,
+                     ScaleFilter filter = ScaleFilter::Auto, ConvertFlag flag = ConvertFlag::Default);
+
+//////////// luma motion detection /////////////
+
+/**
+ * @brief Average of each blockSize x blockSize block of an 8-bit luma plane (the Y plane of a YUV frame).
+ *  The output is width / blockSize x height / blockSize, a remainder row/column is skipped.
+ * @param blockSize 1, 2, 4 or 8.
+ * @return false if an argument is not supported (nothing is written), true otherwise.
+ */
+CCAP_EXPORT bool lumaDownsample(const uint8_t* src, int srcStride, uint8_t* dst, int dstStride, int width, int height, int blockSize);
+
+/**
+ * @brief Downsampled absolute difference of two luma planes: each output pixel is the average of |srcA - srcB|
+ *  over a blockSize x blockSize block. Unlike diffing two `lumaDownsample` outputs, texture moving inside a block is seen.
+ * @see lumaDownsample for the output size and blockSize.
+ */
+CCAP_EXPORT bool lumaAbsDiff(const uint8_t* srcA, int srcAStride,
+                 const uint8_t* srcB, int srcBStride,
+                 uint8_t* dst, int dstStride,
+                 int width, int height, int blockSize);
+
+/**
+ * @brief Threshold a difference image (e.g. from `lumaAbsDiff`): mask pixels are 255 where diff > threshold, 0 elsewhere.
+ * @param mask Can be nullptr to only count the moving pixels.
+ * @param stopAt Early-out for "is there any motion" checks: stops after the row where the count reaches it,
+ *  the rest of the mask is not written.
+ * @return The number of pixels above the threshold, in the rows processed.
+ */
+CCAP_EXPORT uint32_t motionMask(const uint8_t* diff, int diffStride,
+                    uint8_t* mask, int maskStride,
+                    int width, int height, uint8_t threshold, uint32_t stopAt = UINT32_MAX);
+
+/// A connected region of a motion mask, in mask pixels (multiply by the blockSize to get frame pixels).
+struct MotionBox {
+    int x;
+    int y;
+    int width;
+    int height;
+    uint32_t pixelCount; ///< Non-zero mask pixels of the region
+};
+
+/**
+ * @brief Bounding boxes of the 8-connected regions of non-zero mask pixels, largest region first.
+ *  Meant for downsampled masks, a few thousand pixels.
+ * @param boxes Receives at most maxBoxes boxes, can be nullptr to only count the regions.
+ * @param minPixels Regions with fewer pixels are ignored, e.g. to filter out sensor noise.
+ * @return The number of regions found, can be larger than maxBoxes.
+ */
+CCAP_EXPORT int motionBoundingBoxes(const uint8_t* mask, int maskStride, int width, int height,
+                        MotionBox* boxes, int maxBoxes, uint32_t minPixels = 1);
+
 class Allocator;
 /// @brief Used to store some intermediate results, avoiding repeated memory allocation.
 /// If no shared memory allocator is set externally, use the default allocator.
@@ -29,6 +29,8 @@ typedef enum {
     CCAP_CONVERT_BACKEND_AVX2 = 2,             /**< AVX2 implementation */
     CCAP_CONVERT_BACKEND_APPLE_ACCELERATE = 3, /**< Apple Accelerate implementation */
     CCAP_CONVERT_BACKEND_NEON = 4,             /**< ARM NEON implementation */
+    CCAP_CONVERT_BACKEND_AVX512 = 5,           /**< AVX-512 (BW/VBMI) implementation */
+    CCAP_CONVERT_BACKEND_SSSE3 = 6,            /**< SSSE3 implementation, for x86 CPUs without AVX2 */
 } CcapConvertBackend;
 
 /** @brief Conversion flags for color space and range */
@@ -59,6 +61,44 @@ CCAP_EXPORT bool ccap_convert_can_use_avx2(void);
  */
 CCAP_EXPORT bool ccap_convert_enable_avx2(bool enable);
 
+/**
+ * @brief Check if AVX-512 (F/BW/VL/VBMI) is supported by the CPU
+ * @return true if AVX-512 is available, false otherwise
+ */
+CCAP_EXPORT bool ccap_convert_has_avx512(void);
+
+/**
+ * @brief Check if AVX-512 is currently enabled
+ * @return true if AVX-512 is enabled, false otherwise
+ */
+CCAP_EXPORT bool ccap_convert_can_use_avx512(void);
+
+/**
+ * @brief Enable or disable AVX-512 implementation
+ * @param enable true to enable AVX-512, false to disable
+ * @return true if AVX-512 is available and enabled, false otherwise
+ */
+CCAP_EXPORT bool ccap_convert_enable_avx512(bool enable);
+
+/**
+ * @brief Check if SSSE3 is supported by the CPU
+ * @return true if SSSE3 is available, false otherwise
+ */
+CCAP_EXPORT bool ccap_convert_has_ssse3(void);
+
+/**
+ * @brief Check if SSSE3 is currently enabled
+ * @return true if SSSE3 is enabled, false otherwise
+ */
+CCAP_EXPORT bool ccap_convert_can_use_ssse3(void);
+
+/**
+ * @brief Enable or disable SSSE3 implementation
+ * @param enable true to enable SSSE3, false to disable
+ * @return true if SSSE3 is available and enabled, false otherwise
+ */
+CCAP_EXPORT bool ccap_convert_enable_ssse3(bool enable);
+
 /**
  * @brief Check if Apple Accelerate is available
  * @return true if Apple Accelerate is available, false otherwise
@@ -110,6 +150,18 @@ CCAP_EXPORT CcapConvertBackend ccap_convert_get_backend(void);
  */
 CCAP_EXPORT bool ccap_convert_set_backend(CcapConvertBackend backend);
 
+/**
+ * @brief Set the number of threads used by frame conversion. Large frames are split into row bands.
+ * @param count Number of threads including the calling thread, 1 by default. 0 or negative uses all hardware threads.
+ */
+CCAP_EXPORT void ccap_convert_set_thread_count(int count);
+
+/**
+ * @brief Get the number of threads used by frame conversion
+ * @return Current conversion thread count
+ */
+CCAP_EXPORT int ccap_convert_get_thread_count(void);
+
 /* ========== Color Space Conversion Functions ========== */
 
 /**
@@ -40,6 +40,67 @@ private:
     size_t m_size = 0;
 };
 
+/// Huge page use of an AllocatorPool.
+enum class HugePages {
+    /// Regular pages.
+    None = 0,
+
+    /// Buffers of 2 MB or more are mapped separately and marked for transparent huge pages (Linux, `madvise(MADV_HUGEPAGE)`).
+    Transparent = 1,
+
+    /**
+     * @brief Buffers of 2 MB or more come from the reserved huge pages (Linux, `MAP_HUGETLB`, see /proc/sys/vm/nr_hugepages).
+     *     Falls back to Transparent when no huge page is left.
+     */
+    Explicit = 2,
+};
+
+struct AllocatorPoolOptions {
+    /// Alignment of the buffers in bytes, a power of two. 64 matches cache lines and AVX-512 loads.
+    size_t alignment = 64;
+
+    /// Huge pages for large buffers, only supported on Linux. Other platforms use regular pages.
+    HugePages hugePages = HugePages::None;
+
+    /// Idle buffers beyond this many bytes are returned to the system instead of being kept for reuse.
+    size_t maxCachedBytes = size_t(512) << 20;
+};
+
+struct AllocatorPoolStats {
+    uint64_t systemAllocations = 0; ///< Buffers obtained from the system
+    uint64_t reusedBuffers = 0;     ///< Requests served with an idle buffer of the pool
+    uint64_t systemReleases = 0;    ///< Buffers returned to the system
+    uint64_t hugePageFallbacks = 0; ///< Huge page requests that got regular pages
+
+    size_t buffersInUse = 0; ///< Buffers held by allocators
+    size_t bytesInUse = 0;
+    size_t cachedBuffers = 0; ///< Idle buffers kept for reuse
+    size_t cachedBytes = 0;
+    size_t peakBytes = 0;     ///< Highest bytesInUse + cachedBytes
+    size_t hugePageBytes = 0; ///< Bytes currently backed by huge pages (Explicit), or advised to use them (Transparent)
+};
+
+/**
+ * @brief A pool of frame buffers shared by its allocators. Buffers are recycled by size class (4 classes per power of two),
+ *     so frames of the same size reuse the memory of released frames instead of going through the system allocator.
+ *     Thread safe.
+ * @note Usage: `provider.setFrameAllocator(ccap::AllocatorPool::create()->allocatorFactory());`
+ *     The factory and its allocators keep the pool alive, the pool can be shared by several providers.
+ */
+class CCAP_EXPORT AllocatorPool {
+public:
+    static std::shared_ptr<AllocatorPool> create(const AllocatorPoolOptions& options = AllocatorPoolOptions());
+    virtual ~AllocatorPool();
+
+    /// @brief A factory for Provider::setFrameAllocator, creating allocators backed by this pool.
+    virtual std::function<std::shared_ptr<Allocator>()> allocatorFactory() = 0;
+
+    virtual AllocatorPoolStats stats() const = 0;
+
+    /// @brief Returns all idle buffers to the system.
+    virtual void trim() = 0;
+};
+
 enum {
     /// @brief The default maximum number of frames that can be cached.
     DEFAULT_MAX_CACHE_FRAME_SIZE = 15,
@@ -92,6 +153,9 @@ public:
      * @param autoStart Whether to start capturing frames automatically after opening the device. Default is true.
      * @return true if the device was successfully opened, false otherwise.
      * @note The device name can be obtained using the `findDeviceNames` method.
+     *       Virtual devices are available on all platforms and need no camera:
+     *       "pattern:nv12:1920x1080@60" generates a test pattern, "file:clip.y4m" or "file:dump.yuv?i420:1280x720@30" plays a file.
+     *       Omitted fields use the Width/Height/FrameRate/PixelFormatInternal properties; "@0" means as fast as frames are consumed.
      */
     bool open(std::string_view deviceName = "", bool autoStart = true);
 
@@ -216,6 +280,15 @@ public:
      */
     void setMaxCacheFrameSize(uint32_t size);
 
+    /**
+     * @brief Gets the capture statistics: latency histograms, frame and drop counters and the delivered frame rate.
+     *     Cheap enough to poll from a monitoring thread while capturing.
+     * @return The statistics since the first start() or the last `resetStats()`. @see CaptureStats
+     */
+    CaptureStats getStats() const;
+
+    /// @brief Clears the capture statistics.
+    void resetStats();
 
 
     // ↓ This part is not relevant to the user ↓
@@ -224,9 +297,70 @@ public:
     ~Provider();
 
 private:
+    friend class ProviderGroupImp;
     ProviderImp* m_imp;
 };
 
+class ProviderGroupImp;
+
+/**
+ * @brief Captures from several cameras together, e.g. for multi-view rigs.
+ *     On Linux the V4L2 devices of the group are serviced by one epoll loop instead of one capture thread per camera,
+ *     other providers keep their own thread.
+ * @note Frames are converted on the loop thread. With many cameras, keep the output format of the cameras
+ *     (zero-copy) or set PropertyName::ConvertWorkerCount so one slow conversion does not delay the other cameras.
+ */
+class CCAP_EXPORT ProviderGroup final {
+public:
+    ProviderGroup();
+    /// @brief Stops the group. The providers stay opened.
+    ~ProviderGroup();
+    ProviderGroup(const ProviderGroup&) = delete;
+    ProviderGroup& operator=(const ProviderGroup&) = delete;
+
+    /**
+     * @brief Adds an opened provider. The provider must stay alive, opened and in the group until `stop()`.
+     * @return false if the group is started or the provider is already in it.
+     */
+    bool add(Provider& provider);
+
+    /// @brief Removes a provider, only while the group is stopped.
+    bool remove(Provider& provider);
+
+    /// @brief The providers of the group, in the order they were added.
+    const std::vector<Provider*>& providers() const;
+
+    /**
+     * @brief Starts all providers of the group. Providers already started on their own are restarted by the group.
+     * @return false if a provider fails to start, the group is not started then.
+     */
+    bool start();
+
+    /// @brief Stops all providers of the group.
+    void stop();
+
+    bool isStarted() const;
+
+    /// @brief grabSynchronized() on the providers of the group.
+    std::vector<std::shared_ptr<VideoFrame>> grabSynchronized(uint32_t toleranceUs, uint32_t timeoutInMs = 0xffffffff);
+
+private:
+    ProviderGroupImp* m_imp;
+};
+
+/**
+ * @brief Grabs one frame from each provider, with capture times (VideoFrame::captureTime) within `toleranceUs` of each other.
+ *     Frames that cannot be part of a set any more are discarded, so the set is the newest one the cameras can provide.
+ * @param providers Started providers. Matching uses driver timestamps where available (Linux), the receive time otherwise.
+ * @param toleranceUs The largest capture time difference allowed within the set, in microseconds.
+ * @param timeoutInMs The maximum time to wait for a matching set.
+ * @return The frames in the order of `providers`, empty on timeout or if a provider stops.
+ * @note Up to 3 frames per provider are held while matching. For zero-copy frames, keep PropertyName::CaptureBufferCount
+ *     a few buffers above that so the drivers do not run out of buffers.
+ */
+CCAP_EXPORT std::vector<std::shared_ptr<VideoFrame>> grabSynchronized(const std::vector<Provider*>& providers, uint32_t toleranceUs,
+                                                                      uint32_t timeoutInMs = 0xffffffff);
+
 /**
  * @brief Sets the error callback function to handle errors from all camera operations.
  * @param callback The callback function to be invoked when an error occurs.
@@ -107,6 +107,31 @@ enum class PixelFormat : uint32_t {
     /// @brief FullRange YUV 4:2:2 packed format (UYVY)
     UYVYf = UYVY | kPixelFormatYUVColorFullRangeBit,
 
+    /**
+     * @brief YUV 4:2:0 semi-planar format like NV12, with the chroma plane interleaved as VU instead of UV.
+     * @note Default format of Android cameras and common on V4L2 devices. Input only, converted to RGB(A).
+     */
+    NV21 = 1 << 5 | kPixelFormatYUVColorBit,
+
+    NV21f = NV21 | kPixelFormatYUVColorFullRangeBit,
+
+    /**
+     * @brief YUV 4:2:0 planar format like I420, with the V plane stored before the U plane.
+     * @note `data[1]` is the V plane and `data[2]` the U plane, in memory order. Input only, converted to RGB(A).
+     */
+    YV12 = 1 << 6 | kPixelFormatYUVColorBit,
+
+    YV12f = YV12 | kPixelFormatYUVColorFullRangeBit,
+
+    /**
+     * @brief 10-bit YUV 4:2:0 semi-planar format, laid out like NV12 with 16-bit little-endian samples.
+     *    The 10 significant bits are stored in the high bits of each sample. Strides are in bytes.
+     * @note Input only. Reduced to 8-bit (rounded) when converted to RGB(A), the transfer curve is not changed.
+     */
+    P010 = 1 << 7 | kPixelFormatYUVColorBit,
+
+    P010f = P010 | kPixelFormatYUVColorFullRangeBit,
+
     /// @brief Not commonly used, likely unsupported, may fall back to BGR24 (Windows) or BGRA32 (MacOS)
     RGB24 = kPixelFormatRGBBit | kPixelFormatRGBColorBit, /// 3 bytes per pixel
 
@@ -124,6 +149,21 @@ enum class PixelFormat : uint32_t {
      *  @note This format is always supported on MacOS.
      */
     BGRA32 = BGR24 | kPixelFormatRGBAColorBit,
+
+    /**
+     * @brief 16-bit little-endian RGB, R in the high 5 bits, G in the middle 6 bits and B in the low 5 bits. 2 bytes per pixel.
+     * @note Input only, used by some embedded and low-cost cameras. Converted to RGB24/BGR24/RGBA32/BGRA32.
+     */
+    RGB565 = 1 << 5 | kPixelFormatRGBColorBit,
+
+    /**
+     * @brief Motion JPEG, each frame is one compressed JPEG image (usually 4:2:2 or 4:2:0, full range BT.601).
+     * @note Camera input only. Frames are decoded to the output pixel format, YUV outputs get NV12f or I420f.
+     *       When the output pixel format is MJPEG or Unknown the compressed image is delivered as is:
+     *       `data[0]` points to the bitstream and `sizeInBytes` is its length, the strides are 0.
+     *       Used by the Linux (V4L2) and virtual providers.
+     */
+    MJPEG = 1 << 20,
 };
 
 enum class FrameOrientation {
@@ -148,6 +188,39 @@ enum class FrameOrientation {
     Default = TopToBottom,
 };
 
+/// Trade-off between latency and drop resistance of the camera buffer queue, see PropertyName::CaptureMode.
+enum class CaptureMode {
+    /// Buffers are dequeued in capture order from a queue of 4 driver buffers.
+    Default = 0,
+
+    /**
+     * @brief Every wakeup drains the driver queue and keeps only the newest buffer, older ones go straight back to the driver.
+     *     3 driver buffers by default. Combined with setMaxAvailableFrameSize(1), grab() always returns the most recent image.
+     */
+    LowLatency = 1,
+
+    /// A deeper driver queue (8 buffers by default), so scheduling hiccups and slow consumers do not make the driver drop frames.
+    HighThroughput = 2,
+};
+
+/// Where the camera driver writes frames, see PropertyName::CaptureMemory.
+enum class CaptureMemory {
+    /// Buffers allocated by the driver and mapped by ccap (V4L2_MEMORY_MMAP).
+    Mmap = 0,
+
+    /**
+     * @brief The driver writes into memory of the frame allocator (V4L2_MEMORY_USERPTR): one allocator per camera buffer
+     *     is created with the `setFrameAllocator` factory. Frames delivered without conversion point into that memory.
+     *     Some drivers require page aligned memory.
+     */
+    UserPtr = 1,
+
+    /// Like UserPtr, the allocators export the memory as dma-buf (V4L2_MEMORY_DMABUF), see Allocator::dmabufFd.
+    DmaBuf = 2,
+
+    Default = Mmap,
+};
+
 /// check if the pixel format `lhs` includes all bits of the pixel format `rhs`.
 inline bool pixelFormatInclude(PixelFormat lhs, PixelFormatConstants rhs) {
     return (static_cast<uint32_t>(lhs) & rhs) == rhs;
@@ -192,7 +265,8 @@ enum class PropertyName {
     /**
      * @brief The output pixel format of ccap. Can be different from PixelFormatInternal.
      * @note If PixelFormatInternal is RGB(A), PixelFormatOutput cannot be set to a YUV format.
-     *       If PixelFormatInternal is YUV and PixelFormatOutput is RGB(A), BT.601 will be used for conversion.
+     *       If PixelFormatInternal is YUV and PixelFormatOutput is RGB(A), BT.601 will be used for conversion,
+     *       with full range coefficients for full range formats (NV12f, I420f..., decoded MJPEG) and video range coefficients otherwise.
      *       For other cases, there are no issues.
      *       If PixelFormatInternal and PixelFormatOutput are the same format, data conversion will be skipped and the original data will be used directly.
      *       In general, setting both PixelFormatInternal and PixelFormatOutput to YUV formats can achieve better performance.
@@ -205,6 +279,96 @@ enum class PropertyName {
      *      It is recommended that users do not set this option, but instead adapt to the orientation information obtained from the Frame.
      */
     FrameOrientation = 0x40000,
+
+    /**
+     * @brief The width of the delivered frames when YUV camera data is converted to RGB(A), for preview streams that do not need the full resolution.
+     * @note The frame is resized while it is converted, so only the output pixels are converted.
+     *       0 (default) keeps the camera size. If only one of OutputWidth/OutputHeight is set, the other one keeps the aspect ratio.
+     *       Sizes larger than the camera resolution are clamped, ccap only scales down.
+     *       Exact 1/2 and 1/4 sizes use a box filter, other sizes use bilinear sampling.
+     *       Has no effect when no YUV -> RGB(A) conversion happens, e.g. when PixelFormatOutput is a YUV format.
+     */
+    OutputWidth = 0x50001,
+
+    /// @brief The height of the delivered frames when YUV camera data is converted to RGB(A). @see OutputWidth
+    OutputHeight = 0x50002,
+
+    /**
+     * @brief Left edge of the crop rectangle (region of interest) in pixels, 0 by default.
+     * @note When any crop property is set, frames only contain the crop rectangle: conversions read only its rows and columns,
+     *       and without conversion the frame planes just point into the camera buffer (still zero-copy).
+     *       The rectangle is clamped to the camera resolution, and for YUV formats aligned to even pixels so chroma samples are not split.
+     *       Cropping happens before the resize of OutputWidth/OutputHeight. Coordinates are top-down, in the camera resolution.
+     */
+    CropX = 0x60001,
+
+    /// @brief Top edge of the crop rectangle in pixels, 0 by default. @see CropX
+    CropY = 0x60002,
+
+    /// @brief Width of the crop rectangle, 0 (default) extends it to the right edge of the frame. @see CropX
+    CropWidth = 0x60003,
+
+    /// @brief Height of the crop rectangle, 0 (default) extends it to the bottom edge of the frame. @see CropX
+    CropHeight = 0x60004,
+
+    /**
+     * @brief Number of worker threads converting frames off the capture thread, 0 (default) converts on the capture thread.
+     * @note With workers, the capture thread only dequeues and timestamps camera buffers, so a slow conversion (MJPEG decoding,
+     *       4K RGB output...) no longer delays the next dequeue. Frames are still delivered in capture order.
+     *       Each frame in conversion holds a camera buffer, more buffers are requested from the driver accordingly.
+     *       The new frame callback is then called from a worker thread. Takes effect at the next start(). Supported by the Linux (V4L2) and virtual providers.
+     */
+    ConvertWorkerCount = 0x70001,
+
+    /**
+     * @brief Frames that may wait for a free conversion worker, 2 by default. @see ConvertWorkerCount
+     * @note When ConvertWorkerCount + ConvertQueueDepth frames are in flight, new frames are dropped at once
+     *       (the camera buffer goes straight back to the driver) and counted in ConvertDroppedFrames. Takes effect at the next start().
+     */
+    ConvertQueueDepth = 0x70002,
+
+    /// @brief Read only: frames handed to the conversion workers and not delivered yet. @see ConvertWorkerCount
+    ConvertPendingFrames = 0x70003,
+
+    /// @brief Read only: highest ConvertPendingFrames since start(). Reaching ConvertWorkerCount + ConvertQueueDepth means frames were dropped.
+    ConvertPeakPendingFrames = 0x70004,
+
+    /// @brief Read only: frames dropped since start() because all conversion workers and queue slots were busy.
+    ConvertDroppedFrames = 0x70005,
+
+    /**
+     * @brief Number of buffers requested from the camera driver, 0 (default) picks it from CaptureMode.
+     * @note More buffers absorb longer stalls of the capture thread, fewer buffers keep frames fresher.
+     *       The driver may adjust the count. Takes effect at the next start(). Supported by the Linux (V4L2) provider.
+     */
+    CaptureBufferCount = 0x80001,
+
+    /// @brief The queueing strategy of camera buffers, a ccap::CaptureMode value. Takes effect at the next start(). @see CaptureMode
+    CaptureMode = 0x80002,
+
+    /**
+     * @brief Where the driver writes frames, a ccap::CaptureMemory value. Takes effect at the next start(). @see CaptureMemory
+     * @note Falls back to CaptureMemory::Mmap with a warning if the driver or the allocators do not support the requested memory.
+     *       Supported by the Linux (V4L2) provider.
+     */
+    CaptureMemory = 0x80003,
+
+    /**
+     * @brief Motion gate: frames whose luma did not change since the last delivered frame are dropped before any conversion,
+     *       0 (default) disables it. Useful to convert, record or analyze only the frames with motion.
+     * @note The luma plane is averaged over 8x8 blocks and compared with the blocks of the last delivered frame: a block moves when its
+     *       average changes by more than this value (1 ~ 254 luma levels). Frames with fewer than MotionMinBlocks moving blocks are dropped
+     *       and counted in MotionSkippedFrames. Slow changes (e.g. lighting) still pass once they add up, the first frame after start()
+     *       is always delivered. Only the crop rectangle is checked. Works on YUV camera formats (NV12, NV21, I420, YV12, YUYV, UYVY),
+     *       other frames are always delivered. Can be changed while capturing. See `lumaAbsDiff` to run the kernels on delivered frames.
+     */
+    MotionThreshold = 0x90001,
+
+    /// @brief Moving 8x8 blocks a frame needs to pass the motion gate, 1 by default. @see MotionThreshold
+    MotionMinBlocks = 0x90002,
+
+    /// @brief Read only: frames dropped by the motion gate since start(). @see MotionThreshold
+    MotionSkippedFrames = 0x90003,
 };
 
 /**
@@ -289,6 +453,12 @@ public:
 
     /// @brief Returns the size of the allocated memory.
     virtual size_t size() = 0;
+
+    /**
+     * @brief A dma-buf file descriptor of the memory returned by `data`, -1 (default) if the memory is not a dma-buf.
+     *     Used to import camera buffers with CaptureMemory::DmaBuf on Linux. The allocator keeps ownership of the fd.
+     */
+    virtual int dmabufFd() { return -1; }
 };
 
 struct CCAP_EXPORT VideoFrame {
@@ -301,6 +471,9 @@ struct CCAP_EXPORT VideoFrame {
      * @brief Frame data, stored the raw bytes of a frame.
      *     For pixel format I420: `data[0]` contains Y, `data[1]` contains U, and `data[2]` contains V.
      *     For pixel format NV12: `data[0]` contains Y, `data[1]` contains interleaved UV, and `data[2]` is nullptr.
+     *     For pixel format YV12: `data[0]` contains Y, `data[1]` contains V, and `data[2]` contains U.
+     *     For pixel format NV21/P010: like NV12, with interleaved VU for NV21 and 16-bit samples for P010.
+     *     For pixel format MJPEG: `data[0]` contains the compressed image of `sizeInBytes` bytes, all strides are 0.
      *     For other formats: `data[0]` contains the data, while `data[1]` and `data[2]` are nullptr.
      */
     uint8_t* data[3] = {};
@@ -319,15 +492,34 @@ struct CCAP_EXPORT VideoFrame {
     /// @brief The height of the frame in pixels.
     uint32_t height = 0;
 
-    /// @brief The size of the frame data in bytes.
+    /**
+     * @brief The size of the frame data in bytes.
+     * @note A cropped frame that still references the camera buffer (see PropertyName::CropX) keeps the full strides,
+     *     its size is the bytes from `data[0]` to the end of the last cropped row, including the pixels outside the crop in between.
+     */
     uint32_t sizeInBytes = 0;
 
-    /// @brief The timestamp of the frame in nanoseconds.
+    /**
+     * @brief The timestamp of the frame in nanoseconds.
+     * @note On Linux it is the time the driver captured the frame, relative to `start()`, when the driver reports monotonic timestamps.
+     */
     uint64_t timestamp = 0;
 
     /// @brief The unique, incremental index of the frame.
     uint64_t frameIndex = 0;
 
+    /**
+     * @brief The steady clock time in nanoseconds when ccap received the frame from the camera, 0 if unknown.
+     *     Used for the latency statistics, see Provider::getStats.
+     */
+    uint64_t receiveTime = 0;
+
+    /**
+     * @brief The steady clock time in nanoseconds when the camera captured the frame, `receiveTime` if the driver does not tell.
+     *     Comparable across providers, see ccap::grabSynchronized.
+     */
+    uint64_t captureTime = 0;
+
     /// @brief The orientation of the frame. @see #FrameOrientation
     FrameOrientation orientation = FrameOrientation::Default;
 
@@ -388,6 +580,65 @@ struct CCAP_EXPORT DeviceInfo {
     std::vector<Resolution> supportedResolutions;
 };
 
+/**
+ * @brief A latency distribution in microseconds. Bucket `i` counts the samples in [2^i, 2^(i+1)) us,
+ *     the first bucket also counts shorter samples and the last bucket longer ones.
+ */
+struct CCAP_EXPORT LatencyHistogram {
+    static constexpr int kBucketCount = 24; ///< The last bucket starts at about 8.4 seconds
+
+    uint64_t buckets[kBucketCount] = {};
+    uint64_t count = 0;   ///< Number of samples
+    uint64_t totalUs = 0; ///< Sum of all samples
+    uint64_t maxUs = 0;   ///< Largest sample
+
+    /// @brief The mean latency, 0 without samples.
+    double averageUs() const;
+
+    /**
+     * @brief An estimate of a percentile, the upper bound of the bucket holding it (capped at maxUs).
+     * @param percent The percentile in [0, 100], e.g. 99 for p99.
+     * @return 0 without samples.
+     */
+    uint64_t percentileUs(double percent) const;
+};
+
+/**
+ * @brief Capture statistics of a Provider, see Provider::getStats.
+ *     Counters accumulate from the first start() until Provider::resetStats(), they are kept when the provider restarts.
+ */
+struct CCAP_EXPORT CaptureStats {
+    /// @brief From the driver capturing a frame to ccap receiving it. Only backends with driver timestamps record it (Linux).
+    LatencyHistogram captureToReceive;
+
+    /// @brief Time spent converting frames (pixel format, flip, MJPEG decoding). Zero-copy frames are not counted.
+    LatencyHistogram conversion;
+
+    /// @brief From ccap receiving a frame to `grab()` returning it or the new frame callback taking it.
+    LatencyHistogram receiveToDelivery;
+
+    uint64_t receivedFrames = 0;  ///< Frames received from the camera
+    uint64_t deliveredFrames = 0; ///< Frames returned by `grab()` or taken by the new frame callback
+
+    uint64_t driverDroppedFrames = 0;  ///< Frames the driver dropped, from gaps in its frame sequence numbers (Linux)
+    uint64_t staleDroppedFrames = 0;   ///< Older frames skipped by CaptureMode::LowLatency
+    uint64_t convertDroppedFrames = 0; ///< Frames dropped because the conversion workers were busy, see PropertyName::ConvertWorkerCount
+    uint64_t queueDroppedFrames = 0;   ///< Frames discarded because `grab()` was not called in time, see Provider::setMaxAvailableFrameSize
+    uint64_t decodeFailedFrames = 0;   ///< Corrupt or truncated MJPEG frames that could not be decoded to the output format
+
+    /// @brief Frames without motion filtered out by PropertyName::MotionThreshold. Not a loss, so not part of droppedFrames().
+    ///     Received frames are delivered, dropped (except driverDroppedFrames, which are never received), skipped here, or in flight.
+    uint64_t motionSkippedFrames = 0;
+
+    /// @brief The rate of delivered frames over about the last second, 0 once frames stop arriving.
+    double fps = 0;
+
+    /// @brief The sum of all drop counters.
+    uint64_t droppedFrames() const {
+        return driverDroppedFrames + staleDroppedFrames + convertDroppedFrames + queueDroppedFrames + decodeFailedFrames;
+    }
+};
+
 } // namespace ccap
 
 #if defined(_MSC_VER)
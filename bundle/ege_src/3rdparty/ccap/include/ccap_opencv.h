@@ -32,6 +32,11 @@ inline cv::Mat convertRgbFrameToMat(const VideoFrame& frame)
         return {};
     }
 
+    if (frame.pixelFormat == PixelFormat::RGB565)
+    { // Same layout as OpenCV's BGR565, use cv::COLOR_BGR5652BGR to expand it
+        return cv::Mat(frame.height, frame.width, CV_8UC2, frame.data[0], frame.stride[0]);
+    }
+
     auto typeEnum = (uint32_t)frame.pixelFormat & (uint32_t)kPixelFormatAlphaColorBit ? CV_8UC4 : CV_8UC3;
     return cv::Mat(frame.height, frame.width, typeEnum, frame.data[0], frame.stride[0]);
 }
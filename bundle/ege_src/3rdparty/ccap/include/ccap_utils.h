@@ -36,7 +36,7 @@ CCAP_EXPORT std::string_view pixelFormatToString(PixelFormat format);
  * @param fileNameWithNoSuffix The name of the file to save the frame data.
  *        The suffix will be automatically added based on the pixel format.
  * @return The full path of the saved file if successful, or an empty string if the operation failed.
- * @note Note: This method uses a simple way to save data for debugging purposes. Not performance optimized. Do not use in performance-sensitive code.
+ * @note Note: This method uses a simple way to save data for debugging purposes. Not performance optimized. Do not use in performance-sensitive code, use FrameRecorder to record a capture session.
  */
 CCAP_EXPORT std::string dumpFrameToFile(VideoFrame* frame, std::string_view fileNameWithNoSuffix);
 
@@ -48,7 +48,7 @@ CCAP_EXPORT std::string dumpFrameToFile(VideoFrame* frame, std::string_view file
  * @param directory The directory to save the frame data.
  *        The file name will be automatically generated based on the current time and frame index.
  * @return The full path of the saved file if successful, or an empty string if the operation failed.
- * @note Note: This method uses a simple way to save data for debugging purposes. Not performance optimized. Do not use in performance-sensitive code.
+ * @note Note: This method uses a simple way to save data for debugging purposes. Not performance optimized. Do not use in performance-sensitive code, use FrameRecorder to record a capture session.
  */
 CCAP_EXPORT std::string dumpFrameToDirectory(VideoFrame* frame, std::string_view directory);
 
@@ -61,6 +61,93 @@ CCAP_EXPORT std::string dumpFrameToDirectory(VideoFrame* frame, std::string_view
  */
 CCAP_EXPORT bool saveRgbDataAsBMP(const char* filename, const unsigned char* data, uint32_t w, uint32_t lineOffset, uint32_t h, bool isBGR, bool hasAlpha, bool isTopToBottom = false);
 
+//////////////////// Recorder ////////////////////
+
+enum class RecordContainer
+{
+    /// @brief Y4M if the path ends with ".y4m", Raw otherwise.
+    Auto,
+    /**
+     * @brief YUV4MPEG2 file. I420, YV12, NV12 and NV21 frames are written as 4:2:0 planar (C420jpeg),
+     *     YUYV and UYVY frames as 4:2:2 planar (C422). Full range formats add `XCOLORRANGE=FULL`.
+     * @note Can be replayed with the virtual device `file:<path>`, 4:2:2 files are delivered as YUYV.
+     */
+    Y4M,
+    /**
+     * @brief Frames in their own pixel format, tightly packed, one after another (MJPEG images are concatenated).
+     *     An index `<path>.idx` gives the format and the timestamp, offset and size of each frame.
+     * @note Can be replayed with the virtual device `file:<path>?<format>:<width>x<height>@<fps>`.
+     */
+    Raw,
+};
+
+struct FrameRecorderOptions
+{
+    RecordContainer container = RecordContainer::Auto;
+
+    /// @brief Frames copied but not written yet. `FrameRecorder::record` drops frames beyond this.
+    uint32_t maxQueuedFrames = 16;
+
+    /// @brief Frame rate written in the Y4M header and the raw index.
+    double fps = 30.0;
+
+    /// @brief The file is written in blocks of this size, at offsets that are multiples of it.
+    uint32_t writeBlockSize = 4 << 20;
+};
+
+struct FrameRecorderStats
+{
+    uint64_t recordedFrames = 0; ///< Frames accepted by `record`
+    uint64_t droppedFrames = 0;  ///< Frames dropped because the queue was full or writing failed
+    uint64_t rejectedFrames = 0; ///< Frames whose format or size differs from the first frame
+    uint64_t bytesWritten = 0;
+    uint32_t queuedFrames = 0;
+    uint32_t peakQueuedFrames = 0;
+    bool writeFailed = false;
+};
+
+class FrameRecorderImp;
+
+/**
+ * @brief Records frames to a file on a writer thread, for lossless capture sessions that can be replayed offline.
+ *     `record` copies the frame into a recycled buffer and returns, the writer thread converts it to the container
+ *     layout and writes large blocks. The first recorded frame sets the pixel format and size of the file.
+ * @note Unlike `dumpFrameToFile`, this is meant to keep up with live capture: call `record` from the grab loop
+ *     or the new frame callback. When the disk is too slow the queue fills up and frames are dropped, see `stats`.
+ */
+class CCAP_EXPORT FrameRecorder
+{
+public:
+    FrameRecorder();
+    /// @brief Calls close().
+    ~FrameRecorder();
+    FrameRecorder(const FrameRecorder&) = delete;
+    FrameRecorder& operator=(const FrameRecorder&) = delete;
+
+    /**
+     * @brief Creates (or truncates) the file and starts the writer thread.
+     * @return false if the file cannot be created or a recording is already opened.
+     */
+    bool open(std::string_view path, const FrameRecorderOptions& options = FrameRecorderOptions());
+
+    bool isOpened() const;
+
+    /**
+     * @brief Queues a copy of the frame. Thread safe.
+     * @return false if the frame is dropped: the queue is full, writing failed,
+     *     or the frame cannot be stored in the container (format, size).
+     */
+    bool record(const VideoFrame& frame);
+
+    /// @brief Writes the queued frames and closes the file.
+    void close();
+
+    FrameRecorderStats stats() const;
+
+private:
+    FrameRecorderImp* m_imp;
+};
+
 //////////////////// Log ////////////////////
 
 #ifndef CCAP_NO_LOG          ///< Define this macro to remove log code during compilation.
@@ -0,0 +1,265 @@
+/**
+ * @file ccap_allocator_pool.cpp
+ * @author wysaid (this@wysaid.org)
+ * @brief Pooled frame allocator with optional huge pages, see ccap::AllocatorPool.
+ * @date 2025-10
+ *
+ */
+
+#include "ccap_core.h"
+#include "ccap_imp.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <mutex>
+#include <unordered_map>
+
+#if defined(__linux__) || defined(__linux) || defined(linux) || defined(__gnu_linux__)
+#define CCAP_POOL_HUGE_PAGES 1
+extern "C" {
+#include <sys/mman.h>
+}
+#endif
+
+#ifdef _MSC_VER
+#include <malloc.h>
+#endif
+
+namespace ccap {
+
+namespace {
+constexpr size_t kMinBufferSize = 4096;
+constexpr size_t kHugePageSize = size_t(2) << 20;
+
+uint8_t* alignedAlloc(size_t alignment, size_t size) {
+#ifdef _MSC_VER
+    return static_cast<uint8_t*>(_aligned_malloc(size, alignment));
+#elif __MINGW32__
+    return static_cast<uint8_t*>(__mingw_aligned_malloc(size, alignment));
+#else
+    return static_cast<uint8_t*>(std::aligned_alloc(alignment, size));
+#endif
+}
+
+void alignedFree(uint8_t* ptr) {
+#ifdef _MSC_VER
+    _aligned_free(ptr);
+#elif __MINGW32__
+    __mingw_aligned_free(ptr);
+#else
+    std::free(ptr);
+#endif
+}
+
+size_t roundUp(size_t value, size_t step) { return (value + step - 1) / step * step; }
+
+class AllocatorPoolImp : public AllocatorPool, public std::enable_shared_from_this<AllocatorPoolImp> {
+public:
+    enum class Memory : uint8_t {
+        Heap,
+        Mapped, ///< Anonymous mapping advised for transparent huge pages
+        HugeTlb,
+    };
+
+    struct Buffer {
+        uint8_t* data = nullptr;
+        size_t capacity = 0;
+        Memory memory = Memory::Heap;
+        bool hugePages = false; ///< Counted in AllocatorPoolStats::hugePageBytes
+    };
+
+    explicit AllocatorPoolImp(const AllocatorPoolOptions& options) :
+        m_options(options) {
+        if (m_options.alignment < sizeof(void*) || (m_options.alignment & (m_options.alignment - 1)) != 0) {
+            CCAP_LOG_W("ccap: AllocatorPool alignment %zu is not a power of two, using 64\n", m_options.alignment);
+            m_options.alignment = 64;
+        }
+#ifndef CCAP_POOL_HUGE_PAGES
+        m_options.hugePages = HugePages::None;
+#endif
+    }
+
+    ~AllocatorPoolImp() override { trim(); }
+
+    std::function<std::shared_ptr<Allocator>()> allocatorFactory() override;
+
+    AllocatorPoolStats stats() const override {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_stats;
+    }
+
+    void trim() override {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (auto& sizeClass : m_idle) {
+            for (auto& buffer : sizeClass.second) {
+                freeBuffer(buffer);
+            }
+        }
+        m_idle.clear();
+        m_stats.cachedBuffers = 0;
+        m_stats.cachedBytes = 0;
+    }
+
+    Buffer acquire(size_t size) {
+        const size_t capacity = sizeClass(size);
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        Buffer buffer;
+        auto it = m_idle.find(capacity);
+        if (it != m_idle.end() && !it->second.empty()) {
+            buffer = it->second.back();
+            it->second.pop_back();
+            ++m_stats.reusedBuffers;
+            --m_stats.cachedBuffers;
+            m_stats.cachedBytes -= buffer.capacity;
+        } else {
+            buffer = allocateBuffer(capacity);
+            if (!buffer.data) {
+                reportError(ErrorCode::MemoryAllocationFailed, "AllocatorPool failed to allocate " + std::to_string(capacity) + " bytes");
+                return buffer;
+            }
+        }
+
+        ++m_stats.buffersInUse;
+        m_stats.bytesInUse += buffer.capacity;
+        m_stats.peakBytes = std::max(m_stats.peakBytes, m_stats.bytesInUse + m_stats.cachedBytes);
+        return buffer;
+    }
+
+    void release(const Buffer& buffer) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        --m_stats.buffersInUse;
+        m_stats.bytesInUse -= buffer.capacity;
+
+        if (m_stats.cachedBytes + buffer.capacity > m_options.maxCachedBytes) {
+            freeBuffer(buffer);
+            return;
+        }
+
+        m_idle[buffer.capacity].push_back(buffer);
+        ++m_stats.cachedBuffers;
+        m_stats.cachedBytes += buffer.capacity;
+    }
+
+private:
+    /// Four classes per power of two: at most 25% more than requested, frames of one size always share a class.
+    size_t sizeClass(size_t size) const {
+        size = std::max(size, kMinBufferSize);
+        if (m_options.hugePages == HugePages::Explicit && size >= kHugePageSize) {
+            return roundUp(size, kHugePageSize); // MAP_HUGETLB maps whole huge pages
+        }
+
+        size_t octave = kMinBufferSize;
+        while (octave * 2 <= size) {
+            octave *= 2;
+        }
+        return roundUp(roundUp(size, octave / 4), m_options.alignment);
+    }
+
+    // Called with m_mutex held
+    Buffer allocateBuffer(size_t capacity) {
+        Buffer buffer;
+        buffer.capacity = capacity;
+
+#ifdef CCAP_POOL_HUGE_PAGES
+        if (m_options.hugePages != HugePages::None && capacity >= kHugePageSize && m_options.alignment <= kMinBufferSize) {
+            if (m_options.hugePages == HugePages::Explicit) {
+                void* ptr = mmap(nullptr, capacity, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+                if (ptr != MAP_FAILED) {
+                    buffer.data = static_cast<uint8_t*>(ptr);
+                    buffer.memory = Memory::HugeTlb;
+                    buffer.hugePages = true;
+                    m_stats.hugePageBytes += capacity;
+                    ++m_stats.systemAllocations;
+                    return buffer;
+                }
+
+                if (m_stats.hugePageFallbacks++ == 0) {
+                    CCAP_LOG_W("ccap: AllocatorPool: no reserved huge page left (see /proc/sys/vm/nr_hugepages), using transparent huge pages\n");
+                }
+            }
+
+            void* ptr = mmap(nullptr, capacity, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (ptr != MAP_FAILED) {
+                if (madvise(ptr, capacity, MADV_HUGEPAGE) == 0) {
+                    buffer.hugePages = true;
+                    m_stats.hugePageBytes += capacity;
+                } else if (m_options.hugePages == HugePages::Transparent) {
+                    ++m_stats.hugePageFallbacks; // Kernel without transparent huge pages
+                }
+                buffer.data = static_cast<uint8_t*>(ptr);
+                buffer.memory = Memory::Mapped;
+                ++m_stats.systemAllocations;
+                return buffer;
+            }
+        }
+#endif
+
+        buffer.data = alignedAlloc(m_options.alignment, capacity);
+        buffer.memory = Memory::Heap;
+        if (buffer.data) {
+            ++m_stats.systemAllocations;
+        }
+        return buffer;
+    }
+
+    // Called with m_mutex held
+    void freeBuffer(const Buffer& buffer) {
+        ++m_stats.systemReleases;
+        if (buffer.hugePages) {
+            m_stats.hugePageBytes -= buffer.capacity;
+        }
+#ifdef CCAP_POOL_HUGE_PAGES
+        if (buffer.memory != Memory::Heap) {
+            munmap(buffer.data, buffer.capacity);
+            return;
+        }
+#endif
+        alignedFree(buffer.data);
+    }
+
+private:
+    AllocatorPoolOptions m_options;
+    mutable std::mutex m_mutex;
+    std::unordered_map<size_t, std::vector<Buffer>> m_idle; ///< Idle buffers by capacity
+    AllocatorPoolStats m_stats;
+};
+
+class PooledAllocator : public Allocator {
+public:
+    explicit PooledAllocator(std::shared_ptr<AllocatorPoolImp> pool) :
+        m_pool(std::move(pool)) {}
+
+    ~PooledAllocator() override {
+        if (m_buffer.data) m_pool->release(m_buffer);
+    }
+
+    void resize(size_t size) override {
+        if (m_buffer.data && size <= m_buffer.capacity && size >= m_buffer.capacity / 2) return;
+
+        if (m_buffer.data) m_pool->release(m_buffer);
+        m_buffer = m_pool->acquire(size);
+    }
+
+    uint8_t* data() override { return m_buffer.data; }
+
+    size_t size() override { return m_buffer.data ? m_buffer.capacity : 0; }
+
+private:
+    std::shared_ptr<AllocatorPoolImp> m_pool;
+    AllocatorPoolImp::Buffer m_buffer;
+};
+
+std::function<std::shared_ptr<Allocator>()> AllocatorPoolImp::allocatorFactory() {
+    std::shared_ptr<AllocatorPoolImp> pool = shared_from_this(); // The factory keeps the pool alive too
+    return [pool]() -> std::shared_ptr<Allocator> { return std::make_shared<PooledAllocator>(pool); };
+}
+} // namespace
+
+AllocatorPool::~AllocatorPool() = default;
+
+std::shared_ptr<AllocatorPool> AllocatorPool::create(const AllocatorPoolOptions& options) {
+    return std::make_shared<AllocatorPoolImp>(options);
+}
+
+} // namespace ccap
@@ -361,6 +361,41 @@ void ccap_provider_set_max_cache_frame_size(CcapProvider* provider, uint32_t siz
     }
 }
 
+static void convert_latency_histogram_to_c(const ccap::LatencyHistogram& histogram, CcapLatencyHistogram* out) {
+    std::copy_n(histogram.buckets, CCAP_LATENCY_HISTOGRAM_BUCKETS, out->buckets);
+    out->count = histogram.count;
+    out->totalUs = histogram.totalUs;
+    out->maxUs = histogram.maxUs;
+}
+
+bool ccap_provider_get_stats(const CcapProvider* provider, CcapCaptureStats* stats) {
+    if (!provider || !stats) return false;
+
+    auto* cppProvider = reinterpret_cast<const ccap::Provider*>(provider);
+    auto cppStats = cppProvider->getStats();
+
+    convert_latency_histogram_to_c(cppStats.captureToReceive, &stats->captureToReceive);
+    convert_latency_histogram_to_c(cppStats.conversion, &stats->conversion);
+    convert_latency_histogram_to_c(cppStats.receiveToDelivery, &stats->receiveToDelivery);
+    stats->receivedFrames = cppStats.receivedFrames;
+    stats->deliveredFrames = cppStats.deliveredFrames;
+    stats->driverDroppedFrames = cppStats.driverDroppedFrames;
+    stats->staleDroppedFrames = cppStats.staleDroppedFrames;
+    stats->convertDroppedFrames = cppStats.convertDroppedFrames;
+    stats->queueDroppedFrames = cppStats.queueDroppedFrames;
+    stats->fps = cppStats.fps;
+    stats->motionSkippedFrames = cppStats.motionSkippedFrames;
+    stats->decodeFailedFrames = cppStats.decodeFailedFrames;
+    return true;
+}
+
+void ccap_provider_reset_stats(CcapProvider* provider) {
+    if (provider) {
+        auto* cppProvider = reinterpret_cast<ccap::Provider*>(provider);
+        cppProvider->resetStats();
+    }
+}
+
 /* ========== Global Error Callback ========== */
 
 bool ccap_set_error_callback(CcapErrorCallback callback, void* userData) {
@@ -436,6 +471,18 @@ static_assert(static_cast<uint32_t>(CCAP_PIXEL_FORMAT_UYVY) == static_cast<uint3
               "C and C++ PixelFormat::UYVY values must match");
 static_assert(static_cast<uint32_t>(CCAP_PIXEL_FORMAT_UYVY_F) == static_cast<uint32_t>(ccap::PixelFormat::UYVYf),
               "C and C++ PixelFormat::UYVYf values must match");
+static_assert(static_cast<uint32_t>(CCAP_PIXEL_FORMAT_NV21) == static_cast<uint32_t>(ccap::PixelFormat::NV21),
+              "C and C++ PixelFormat::NV21 values must match");
+static_assert(static_cast<uint32_t>(CCAP_PIXEL_FORMAT_NV21F) == static_cast<uint32_t>(ccap::PixelFormat::NV21f),
+              "C and C++ PixelFormat::NV21f values must match");
+static_assert(static_cast<uint32_t>(CCAP_PIXEL_FORMAT_YV12) == static_cast<uint32_t>(ccap::PixelFormat::YV12),
+              "C and C++ PixelFormat::YV12 values must match");
+static_assert(static_cast<uint32_t>(CCAP_PIXEL_FORMAT_YV12F) == static_cast<uint32_t>(ccap::PixelFormat::YV12f),
+              "C and C++ PixelFormat::YV12f values must match");
+static_assert(static_cast<uint32_t>(CCAP_PIXEL_FORMAT_P010) == static_cast<uint32_t>(ccap::PixelFormat::P010),
+              "C and C++ PixelFormat::P010 values must match");
+static_assert(static_cast<uint32_t>(CCAP_PIXEL_FORMAT_P010F) == static_cast<uint32_t>(ccap::PixelFormat::P010f),
+              "C and C++ PixelFormat::P010f values must match");
 static_assert(static_cast<uint32_t>(CCAP_PIXEL_FORMAT_RGB24) == static_cast<uint32_t>(ccap::PixelFormat::RGB24),
               "C and C++ PixelFormat::RGB24 values must match");
 static_assert(static_cast<uint32_t>(CCAP_PIXEL_FORMAT_BGR24) == static_cast<uint32_t>(ccap::PixelFormat::BGR24),
@@ -444,6 +491,10 @@ static_assert(static_cast<uint32_t>(CCAP_PIXEL_FORMAT_RGBA32) == static_cast<uin
               "C and C++ PixelFormat::RGBA32 values must match");
 static_assert(static_cast<uint32_t>(CCAP_PIXEL_FORMAT_BGRA32) == static_cast<uint32_t>(ccap::PixelFormat::BGRA32),
               "C and C++ PixelFormat::BGRA32 values must match");
+static_assert(static_cast<uint32_t>(CCAP_PIXEL_FORMAT_RGB565) == static_cast<uint32_t>(ccap::PixelFormat::RGB565),
+              "C and C++ PixelFormat::RGB565 values must match");
+static_assert(static_cast<uint32_t>(CCAP_PIXEL_FORMAT_MJPEG) == static_cast<uint32_t>(ccap::PixelFormat::MJPEG),
+              "C and C++ PixelFormat::MJPEG values must match");
 
 // FrameOrientation enum consistency checks
 static_assert(static_cast<uint32_t>(CCAP_FRAME_ORIENTATION_TOP_TO_BOTTOM) == static_cast<uint32_t>(ccap::FrameOrientation::TopToBottom),
@@ -464,6 +515,60 @@ static_assert(static_cast<uint32_t>(CCAP_PROPERTY_PIXEL_FORMAT_OUTPUT) == static
               "C and C++ PropertyName::PixelFormatOutput values must match");
 static_assert(static_cast<uint32_t>(CCAP_PROPERTY_FRAME_ORIENTATION) == static_cast<uint32_t>(ccap::PropertyName::FrameOrientation),
               "C and C++ PropertyName::FrameOrientation values must match");
+static_assert(static_cast<uint32_t>(CCAP_PROPERTY_OUTPUT_WIDTH) == static_cast<uint32_t>(ccap::PropertyName::OutputWidth),
+              "C and C++ PropertyName::OutputWidth values must match");
+static_assert(static_cast<uint32_t>(CCAP_PROPERTY_OUTPUT_HEIGHT) == static_cast<uint32_t>(ccap::PropertyName::OutputHeight),
+              "C and C++ PropertyName::OutputHeight values must match");
+static_assert(static_cast<uint32_t>(CCAP_PROPERTY_CROP_X) == static_cast<uint32_t>(ccap::PropertyName::CropX),
+              "C and C++ PropertyName::CropX values must match");
+static_assert(static_cast<uint32_t>(CCAP_PROPERTY_CROP_Y) == static_cast<uint32_t>(ccap::PropertyName::CropY),
+              "C and C++ PropertyName::CropY values must match");
+static_assert(static_cast<uint32_t>(CCAP_PROPERTY_CROP_WIDTH) == static_cast<uint32_t>(ccap::PropertyName::CropWidth),
+              "C and C++ PropertyName::CropWidth values must match");
+static_assert(static_cast<uint32_t>(CCAP_PROPERTY_CROP_HEIGHT) == static_cast<uint32_t>(ccap::PropertyName::CropHeight),
+              "C and C++ PropertyName::CropHeight values must match");
+static_assert(static_cast<uint32_t>(CCAP_PROPERTY_CONVERT_WORKER_COUNT) == static_cast<uint32_t>(ccap::PropertyName::ConvertWorkerCount),
+              "C and C++ PropertyName::ConvertWorkerCount values must match");
+static_assert(static_cast<uint32_t>(CCAP_PROPERTY_CONVERT_QUEUE_DEPTH) == static_cast<uint32_t>(ccap::PropertyName::ConvertQueueDepth),
+              "C and C++ PropertyName::ConvertQueueDepth values must match");
+static_assert(static_cast<uint32_t>(CCAP_PROPERTY_CONVERT_PENDING_FRAMES) == static_cast<uint32_t>(ccap::PropertyName::ConvertPendingFrames),
+              "C and C++ PropertyName::ConvertPendingFrames values must match");
+static_assert(static_cast<uint32_t>(CCAP_PROPERTY_CONVERT_PEAK_PENDING_FRAMES) ==
+                  static_cast<uint32_t>(ccap::PropertyName::ConvertPeakPendingFrames),
+              "C and C++ PropertyName::ConvertPeakPendingFrames values must match");
+static_assert(static_cast<uint32_t>(CCAP_PROPERTY_CONVERT_DROPPED_FRAMES) == static_cast<uint32_t>(ccap::PropertyName::ConvertDroppedFrames),
+              "C and C++ PropertyName::ConvertDroppedFrames values must match");
+static_assert(static_cast<uint32_t>(CCAP_PROPERTY_CAPTURE_BUFFER_COUNT) == static_cast<uint32_t>(ccap::PropertyName::CaptureBufferCount),
+              "C and C++ PropertyName::CaptureBufferCount values must match");
+static_assert(static_cast<uint32_t>(CCAP_PROPERTY_CAPTURE_MODE) == static_cast<uint32_t>(ccap::PropertyName::CaptureMode),
+              "C and C++ PropertyName::CaptureMode values must match");
+static_assert(static_cast<uint32_t>(CCAP_PROPERTY_CAPTURE_MEMORY) == static_cast<uint32_t>(ccap::PropertyName::CaptureMemory),
+              "C and C++ PropertyName::CaptureMemory values must match");
+static_assert(static_cast<uint32_t>(CCAP_PROPERTY_MOTION_THRESHOLD) == static_cast<uint32_t>(ccap::PropertyName::MotionThreshold),
+              "C and C++ PropertyName::MotionThreshold values must match");
+static_assert(static_cast<uint32_t>(CCAP_PROPERTY_MOTION_MIN_BLOCKS) == static_cast<uint32_t>(ccap::PropertyName::MotionMinBlocks),
+              "C and C++ PropertyName::MotionMinBlocks values must match");
+static_assert(static_cast<uint32_t>(CCAP_PROPERTY_MOTION_SKIPPED_FRAMES) == static_cast<uint32_t>(ccap::PropertyName::MotionSkippedFrames),
+              "C and C++ PropertyName::MotionSkippedFrames values must match");
+
+// CaptureMode enum consistency checks
+static_assert(static_cast<uint32_t>(CCAP_CAPTURE_MODE_DEFAULT) == static_cast<uint32_t>(ccap::CaptureMode::Default),
+              "C and C++ CaptureMode::Default values must match");
+static_assert(static_cast<uint32_t>(CCAP_CAPTURE_MODE_LOW_LATENCY) == static_cast<uint32_t>(ccap::CaptureMode::LowLatency),
+              "C and C++ CaptureMode::LowLatency values must match");
+static_assert(static_cast<uint32_t>(CCAP_CAPTURE_MODE_HIGH_THROUGHPUT) == static_cast<uint32_t>(ccap::CaptureMode::HighThroughput),
+              "C and C++ CaptureMode::HighThroughput values must match");
+
+static_assert(CCAP_LATENCY_HISTOGRAM_BUCKETS == ccap::LatencyHistogram::kBucketCount,
+              "C and C++ latency histogram bucket counts must match");
+
+// CaptureMemory enum consistency checks
+static_assert(static_cast<uint32_t>(CCAP_CAPTURE_MEMORY_MMAP) == static_cast<uint32_t>(ccap::CaptureMemory::Mmap),
+              "C and C++ CaptureMemory::Mmap values must match");
+static_assert(static_cast<uint32_t>(CCAP_CAPTURE_MEMORY_USERPTR) == static_cast<uint32_t>(ccap::CaptureMemory::UserPtr),
+              "C and C++ CaptureMemory::UserPtr values must match");
+static_assert(static_cast<uint32_t>(CCAP_CAPTURE_MEMORY_DMABUF) == static_cast<uint32_t>(ccap::CaptureMemory::DmaBuf),
+              "C and C++ CaptureMemory::DmaBuf values must match");
 
 // ErrorCode enum consistency checks
 static_assert(static_cast<uint32_t>(CCAP_ERROR_NONE) == static_cast<uint32_t>(ccap::ErrorCode::None),
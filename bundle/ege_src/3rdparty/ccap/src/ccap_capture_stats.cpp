@@ -0,0 +1,155 @@
+/**
+ * @file ccap_capture_stats.cpp
+ * @author wysaid (this@wysaid.org)
+ * @brief Lock-free recording of the capture statistics, see Provider::getStats.
+ * @date 2025-10
+ *
+ */
+
+#include "ccap_capture_stats.h"
+
+namespace ccap {
+
+namespace {
+constexpr uint64_t kFpsWindowNs = 1000000000;
+
+int bucketOf(uint64_t us) {
+    int bucket = 0;
+    while (us > 1 && bucket < LatencyHistogram::kBucketCount - 1) {
+        us >>= 1;
+        ++bucket;
+    }
+    return bucket;
+}
+} // namespace
+
+double LatencyHistogram::averageUs() const { return count ? static_cast<double>(totalUs) / count : 0.0; }
+
+uint64_t LatencyHistogram::percentileUs(double percent) const {
+    if (count == 0) return 0;
+
+    uint64_t rank = static_cast<uint64_t>(percent / 100.0 * count + 0.5);
+    if (rank < 1) rank = 1;
+    uint64_t seen = 0;
+    for (int i = 0; i < kBucketCount - 1; ++i) {
+        seen += buckets[i];
+        if (seen >= rank) {
+            uint64_t upper = (uint64_t(1) << (i + 1)) - 1;
+            return upper < maxUs ? upper : maxUs;
+        }
+    }
+    return maxUs;
+}
+
+void AtomicLatencyHistogram::record(uint64_t ns) {
+    uint64_t us = ns / 1000;
+    m_buckets[bucketOf(us)].fetch_add(1, std::memory_order_relaxed);
+    m_count.fetch_add(1, std::memory_order_relaxed);
+    m_totalUs.fetch_add(us, std::memory_order_relaxed);
+
+    uint64_t maxUs = m_maxUs.load(std::memory_order_relaxed);
+    while (us > maxUs && !m_maxUs.compare_exchange_weak(maxUs, us, std::memory_order_relaxed)) {
+    }
+}
+
+void AtomicLatencyHistogram::snapshot(LatencyHistogram& out) const {
+    // Not an atomic snapshot: a sample recorded meanwhile may show up in some fields only
+    for (int i = 0; i < LatencyHistogram::kBucketCount; ++i) {
+        out.buckets[i] = m_buckets[i].load(std::memory_order_relaxed);
+    }
+    out.count = m_count.load(std::memory_order_relaxed);
+    out.totalUs = m_totalUs.load(std::memory_order_relaxed);
+    out.maxUs = m_maxUs.load(std::memory_order_relaxed);
+}
+
+double AtomicLatencyHistogram::averageUs() const {
+    uint64_t count = m_count.load(std::memory_order_relaxed);
+    return count ? static_cast<double>(m_totalUs.load(std::memory_order_relaxed)) / count : 0.0;
+}
+
+void AtomicLatencyHistogram::reset() {
+    for (auto& bucket : m_buckets) {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+    m_count = 0;
+    m_totalUs = 0;
+    m_maxUs = 0;
+}
+
+void CaptureStatsRecorder::frameReceived(VideoFrame& frame, uint64_t captureTimeNs) {
+    frame.receiveTime = steadyNowNs();
+    frame.captureTime = captureTimeNs != 0 && captureTimeNs <= frame.receiveTime ? captureTimeNs : frame.receiveTime;
+    m_received.fetch_add(1, std::memory_order_relaxed);
+    if (captureTimeNs != 0 && captureTimeNs <= frame.receiveTime) {
+        m_captureToReceive.record(frame.receiveTime - captureTimeNs);
+    }
+}
+
+void CaptureStatsRecorder::frameDelivered(const VideoFrame& frame) {
+    uint64_t now = steadyNowNs();
+    m_delivered.fetch_add(1, std::memory_order_relaxed);
+    if (frame.receiveTime != 0 && frame.receiveTime <= now) {
+        m_receiveToDelivery.record(now - frame.receiveTime);
+    }
+
+    m_lastDeliveryNs.store(now, std::memory_order_relaxed);
+    uint64_t windowStart = m_windowStartNs.load(std::memory_order_relaxed);
+    if (windowStart == 0 || now - windowStart > 2 * kFpsWindowNs) {
+        // First frame, or frames stopped for a while: start over
+        if (m_windowStartNs.compare_exchange_strong(windowStart, now, std::memory_order_relaxed)) {
+            m_windowFrames.store(0, std::memory_order_relaxed);
+        }
+        return;
+    }
+
+    uint64_t frames = m_windowFrames.fetch_add(1, std::memory_order_relaxed) + 1;
+    if (now - windowStart >= kFpsWindowNs && m_windowStartNs.compare_exchange_strong(windowStart, now, std::memory_order_relaxed)) {
+        m_fps.store(frames * 1e9 / static_cast<double>(now - windowStart), std::memory_order_relaxed);
+        m_windowFrames.fetch_sub(frames, std::memory_order_relaxed);
+    }
+}
+
+double CaptureStatsRecorder::fps() const {
+    uint64_t lastDelivery = m_lastDeliveryNs.load(std::memory_order_relaxed);
+    if (lastDelivery == 0 || steadyNowNs() - lastDelivery > 2 * kFpsWindowNs) {
+        return 0.0;
+    }
+    return m_fps.load(std::memory_order_relaxed);
+}
+
+CaptureStats CaptureStatsRecorder::snapshot() const {
+    CaptureStats stats;
+    m_captureToReceive.snapshot(stats.captureToReceive);
+    m_conversion.snapshot(stats.conversion);
+    m_receiveToDelivery.snapshot(stats.receiveToDelivery);
+    stats.receivedFrames = m_received.load(std::memory_order_relaxed);
+    stats.deliveredFrames = m_delivered.load(std::memory_order_relaxed);
+    stats.driverDroppedFrames = m_driverDropped.load(std::memory_order_relaxed);
+    stats.staleDroppedFrames = m_staleDropped.load(std::memory_order_relaxed);
+    stats.convertDroppedFrames = m_convertDropped.load(std::memory_order_relaxed);
+    stats.queueDroppedFrames = m_queueDropped.load(std::memory_order_relaxed);
+    stats.motionSkippedFrames = m_motionSkipped.load(std::memory_order_relaxed);
+    stats.decodeFailedFrames = m_decodeFailed.load(std::memory_order_relaxed);
+    stats.fps = fps();
+    return stats;
+}
+
+void CaptureStatsRecorder::reset() {
+    m_captureToReceive.reset();
+    m_conversion.reset();
+    m_receiveToDelivery.reset();
+    m_received = 0;
+    m_delivered = 0;
+    m_driverDropped = 0;
+    m_staleDropped = 0;
+    m_convertDropped = 0;
+    m_queueDropped = 0;
+    m_motionSkipped = 0;
+    m_decodeFailed = 0;
+    m_windowStartNs = 0;
+    m_windowFrames = 0;
+    m_lastDeliveryNs = 0;
+    m_fps = 0;
+}
+
+} // namespace ccap
@@ -0,0 +1,89 @@
+/**
+ * @file ccap_capture_stats.h
+ * @author wysaid (this@wysaid.org)
+ * @brief Lock-free recording of the capture statistics, see Provider::getStats.
+ * @date 2025-10
+ *
+ */
+
+#pragma once
+#ifndef CCAP_CAPTURE_STATS_H
+#define CCAP_CAPTURE_STATS_H
+
+#include "ccap_def.h"
+
+#include <atomic>
+#include <chrono>
+
+namespace ccap {
+
+/// Current steady clock time in nanoseconds, the clock of VideoFrame::receiveTime.
+inline uint64_t steadyNowNs() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+/// LatencyHistogram that any thread can record into.
+class AtomicLatencyHistogram {
+public:
+    void record(uint64_t ns);
+    void snapshot(LatencyHistogram& out) const;
+    void reset();
+    double averageUs() const;
+
+private:
+    std::atomic_uint64_t m_buckets[LatencyHistogram::kBucketCount] = {};
+    std::atomic_uint64_t m_count{ 0 };
+    std::atomic_uint64_t m_totalUs{ 0 };
+    std::atomic_uint64_t m_maxUs{ 0 };
+};
+
+/**
+ * @brief Counters behind CaptureStats. Backends report received frames and conversions,
+ *  ProviderImp reports deliveries and drops. Recording is a handful of relaxed atomic adds per frame.
+ */
+class CaptureStatsRecorder {
+public:
+    /// @param captureTimeNs Driver capture time on the steady clock, 0 if the backend has none.
+    void frameReceived(VideoFrame& frame, uint64_t captureTimeNs);
+    void frameConverted(uint64_t durationNs) { m_conversion.record(durationNs); }
+    void frameDelivered(const VideoFrame& frame);
+
+    void driverDropped(uint64_t count) { m_driverDropped.fetch_add(count, std::memory_order_relaxed); }
+    void staleDropped() { m_staleDropped.fetch_add(1, std::memory_order_relaxed); }
+    void convertDropped() { m_convertDropped.fetch_add(1, std::memory_order_relaxed); }
+    void queueDropped() { m_queueDropped.fetch_add(1, std::memory_order_relaxed); }
+    void motionSkipped() { m_motionSkipped.fetch_add(1, std::memory_order_relaxed); }
+    void decodeFailed() { m_decodeFailed.fetch_add(1, std::memory_order_relaxed); }
+
+    CaptureStats snapshot() const;
+    void reset();
+
+    /// Delivered frames per second over the last window, also used by the verbose log.
+    double fps() const;
+    /// Mean conversion time in microseconds, for the verbose log.
+    double conversionAverageUs() const { return m_conversion.averageUs(); }
+
+private:
+    AtomicLatencyHistogram m_captureToReceive;
+    AtomicLatencyHistogram m_conversion;
+    AtomicLatencyHistogram m_receiveToDelivery;
+
+    std::atomic_uint64_t m_received{ 0 };
+    std::atomic_uint64_t m_delivered{ 0 };
+    std::atomic_uint64_t m_driverDropped{ 0 };
+    std::atomic_uint64_t m_staleDropped{ 0 };
+    std::atomic_uint64_t m_convertDropped{ 0 };
+    std::atomic_uint64_t m_queueDropped{ 0 };
+    std::atomic_uint64_t m_motionSkipped{ 0 };
+    std::atomic_uint64_t m_decodeFailed{ 0 };
+
+    // fps: deliveries are counted in windows of about one second, the last finished window gives the rate
+    std::atomic_uint64_t m_windowStartNs{ 0 };
+    std::atomic_uint64_t m_windowFrames{ 0 };
+    std::atomic_uint64_t m_lastDeliveryNs{ 0 };
+    std::atomic<double> m_fps{ 0 };
+};
+
+} // namespace ccap
+
+#endif // CCAP_CAPTURE_STATS_H
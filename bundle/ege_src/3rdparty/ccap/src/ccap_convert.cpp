@@ -10,11 +10,15 @@
 
 #include "ccap_convert_apple.h"
 #include "ccap_convert_avx2.h"
+#include "ccap_convert_avx512.h"
 #include "ccap_convert_neon.h"
+#include "ccap_convert_ssse3.h"
 #include "ccap_core.h"
 
 #include <cassert>
 #include <mutex>
+#include <type_traits>
+#include <vector>
 
 //////////////  Common Version //////////////
 
@@ -51,8 +55,12 @@ bool enableNEON(bool enable) {
 ConvertBackend getConvertBackend() {
     if (canUseAppleAccelerate()) {
         return ConvertBackend::AppleAccelerate;
+    } else if (canUseAVX512()) {
+        return ConvertBackend::AVX512;
     } else if (canUseAVX2()) {
         return ConvertBackend::AVX2;
+    } else if (canUseSSSE3()) {
+        return ConvertBackend::SSSE3;
     } else if (canUseNEON()) {
         return ConvertBackend::NEON;
     } else {
@@ -64,24 +72,42 @@ bool setConvertBackend(ConvertBackend backend) {
     switch (backend) {
     case ConvertBackend::AUTO:
         enableAppleAccelerate(true);
+        enableAVX512(true);
         enableAVX2(true);
+        enableSSSE3(true);
         enableNEON(true);
         return true;
+    case ConvertBackend::AVX512:
+        enableAppleAccelerate(false);
+        enableNEON(false);
+        enableAVX2(true); // Fallback for the functions without an AVX-512 version
+        return enableAVX512(true);
     case ConvertBackend::AVX2:
         enableAppleAccelerate(false);
+        enableAVX512(false);
         enableNEON(false);
         return enableAVX2(true);
+    case ConvertBackend::SSSE3:
+        enableAppleAccelerate(false);
+        enableAVX512(false);
+        enableAVX2(false);
+        enableNEON(false);
+        return enableSSSE3(true);
     case ConvertBackend::AppleAccelerate:
+        enableAVX512(false);
         enableAVX2(false);
         enableNEON(false);
         return enableAppleAccelerate(true);
     case ConvertBackend::NEON:
         enableAppleAccelerate(false);
+        enableAVX512(false);
         enableAVX2(false);
         return enableNEON(true);
     case ConvertBackend::CPU:
         enableAppleAccelerate(false);
+        enableAVX512(false);
         enableAVX2(false);
+        enableSSSE3(false);
         enableNEON(false);
         return true; // CPU implementation is always available
     default:
@@ -104,6 +130,13 @@ void colorShuffle(const uint8_t* src, int srcStride, uint8_t* dst, int dstStride
     }
 #endif
 
+#if ENABLE_AVX512_IMP
+    if (canUseAVX512()) {
+        colorShuffle_avx512<inputChannels, outputChannels, swapRB>(src, srcStride, dst, dstStride, width, height);
+        return;
+    }
+#endif
+
 #if ENABLE_AVX2_IMP
     if (canUseAVX2()) {
         colorShuffle_avx2<inputChannels, outputChannels, swapRB>(src, srcStride, dst, dstStride, width, height);
@@ -111,6 +144,13 @@ void colorShuffle(const uint8_t* src, int srcStride, uint8_t* dst, int dstStride
     }
 #endif
 
+#if ENABLE_SSSE3_IMP
+    if (canUseSSSE3()) {
+        colorShuffle_ssse3<inputChannels, outputChannels, swapRB>(src, srcStride, dst, dstStride, width, height);
+        return;
+    }
+#endif
+
 #if ENABLE_NEON_IMP
     if (canUseNEON()) {
         colorShuffle_neon<inputChannels, outputChannels, swapRB>(src, srcStride, dst, dstStride, width, height);
@@ -164,18 +204,132 @@ template void colorShuffle<3, 3, true>(const uint8_t* src, int srcStride, uint8_
 
 ///////////// YUV to RGB common functions /////////////
 
-template <bool isBgrColor, bool hasAlpha>
-void nv12ToRgb_common(const uint8_t* srcY, int srcYStride, const uint8_t* srcUV, int srcUVStride, uint8_t* dst, int dstStride, int width, int height, ConvertFlag flag) {
-    // If height < 0, write to dst in reverse order while reading src sequentially
-    if (height < 0) {
-        height = -height;
-        dst = dst + (height - 1) * dstStride;
-        dstStride = -dstStride;
+namespace {
+
+/// Lookup tables for one YUV matrix, the same math as `yuv2rgb601v` and friends without any multiplication:
+/// r = (y + rv) >> 8, g = (y + gu + gv) >> 8, b = (y + bu) >> 8, then clamped through `kClampTable`.
+struct YuvToRgbTable {
+    int32_t y[256]; ///< cy * (Y - yOffset) + 128, the rounding term is folded in here
+    int32_t rv[256];
+    int32_t gu[256];
+    int32_t gv[256];
+    int32_t bu[256];
+};
+
+constexpr YuvToRgbTable makeYuvToRgbTable(int yOffset, int cy, int cr, int cgu, int cgv, int cb) {
+    YuvToRgbTable table{};
+    for (int i = 0; i < 256; ++i) {
+        table.y[i] = cy * (i - yOffset) + 128;
+        table.rv[i] = cr * (i - 128);
+        table.gu[i] = -cgu * (i - 128);
+        table.gv[i] = -cgv * (i - 128);
+        table.bu[i] = cb * (i - 128);
+    }
+    return table;
+}
+
+enum YuvMatrix {
+    kMatrix601Video,
+    kMatrix601Full,
+    kMatrix709Video,
+    kMatrix709Full,
+};
+
+/// Indexed by `YuvMatrix`
+constexpr YuvToRgbTable kYuvToRgbTables[] = {
+    makeYuvToRgbTable(16, 298, 409, 100, 208, 516), // yuv2rgb601v
+    makeYuvToRgbTable(0, 256, 351, 86, 179, 443),   // yuv2rgb601f
+    makeYuvToRgbTable(16, 298, 459, 55, 136, 541),  // yuv2rgb709v
+    makeYuvToRgbTable(0, 256, 403, 48, 120, 475),   // yuv2rgb709f
+};
+
+/// Saturating clamp to 0~255 for the shifted sums, valid for indices in [-kClampOffset, 1024 - kClampOffset)
+constexpr int kClampOffset = 384;
+
+struct ClampTable {
+    uint8_t v[1024];
+};
+
+constexpr ClampTable makeClampTable() {
+    ClampTable table{};
+    for (int i = 0; i < 1024; ++i) {
+        int value = i - kClampOffset;
+        table.v[i] = static_cast<uint8_t>(value < 0 ? 0 : (value > 255 ? 255 : value));
+    }
+    return table;
+}
+
+constexpr ClampTable kClampTable = makeClampTable();
+
+constexpr bool clampTableCoversAllMatrices() {
+    for (const auto& table : kYuvToRgbTables) {
+        for (int y : { 0, 255 }) {
+            for (int c : { 0, 255 }) {
+                int sums[] = { table.y[y] + table.rv[c], table.y[y] + table.gu[c] + table.gv[c], table.y[y] + table.bu[c] };
+                for (int sum : sums) {
+                    if ((sum >> 8) < -kClampOffset || (sum >> 8) >= 1024 - kClampOffset) return false;
+                }
+            }
+        }
+    }
+    return true;
+}
+
+static_assert(clampTableCoversAllMatrices(), "kClampTable is too small for the YUV matrices");
+
+inline int getYuvMatrix(ConvertFlag flag) {
+    return ((flag & ConvertFlag::BT601) ? kMatrix601Video : kMatrix709Video) + ((flag & ConvertFlag::FullRange) ? 1 : 0);
+}
+
+/// Calls `fn(std::integral_constant<int, matrix>())`, so the loops below are compiled once per matrix.
+template <typename Fn>
+inline void dispatchYuvMatrix(ConvertFlag flag, Fn&& fn) {
+    switch (getYuvMatrix(flag)) {
+    case kMatrix601Video:
+        fn(std::integral_constant<int, kMatrix601Video>());
+        break;
+    case kMatrix601Full:
+        fn(std::integral_constant<int, kMatrix601Full>());
+        break;
+    case kMatrix709Video:
+        fn(std::integral_constant<int, kMatrix709Video>());
+        break;
+    default:
+        fn(std::integral_constant<int, kMatrix709Full>());
+        break;
     }
+}
+
+/// Convert two pixels sharing one U/V sample, the chroma terms are looked up once.
+template <bool isBgrColor, bool hasAlpha, int matrix>
+inline void yuvPairToRgb(int y0, int y1, int u, int v, uint8_t* dst) {
+    constexpr const YuvToRgbTable& table = kYuvToRgbTables[matrix];
+    constexpr int channels = hasAlpha ? 4 : 3;
+    const uint8_t* clamp = kClampTable.v + kClampOffset;
+
+    const int rv = table.rv[v];
+    const int guv = table.gu[u] + table.gv[v];
+    const int bu = table.bu[u];
+
+    auto writePixel = [&](int y, uint8_t* pixel) {
+        const int yy = table.y[y];
+        const uint8_t r = clamp[(yy + rv) >> 8];
+        const uint8_t g = clamp[(yy + guv) >> 8];
+        const uint8_t b = clamp[(yy + bu) >> 8];
+        pixel[0] = isBgrColor ? b : r;
+        pixel[1] = g;
+        pixel[2] = isBgrColor ? r : b;
+        if constexpr (hasAlpha) {
+            pixel[3] = 255;
+        }
+    };
+
+    writePixel(y0, dst);
+    writePixel(y1, dst + channels);
+}
 
-    const bool is601 = (flag & ConvertFlag::BT601) != 0;
-    const bool isFullRange = (flag & ConvertFlag::FullRange) != 0;
-    const auto convertFunc = getYuvToRgbFunc(is601, isFullRange);
+template <bool isBgrColor, bool hasAlpha, int matrix>
+void nv12ToRgb_common_imp(const uint8_t* srcY, int srcYStride, const uint8_t* srcUV, int srcUVStride, uint8_t* dst, int dstStride, int width, int height) {
     constexpr int channels = hasAlpha ? 4 : 3;
 
     for (int y = 0; y < height; ++y) {
@@ -184,52 +338,13 @@ void nv12ToRgb_common(const uint8_t* srcY, int srcYStride, const uint8_t* srcUV,
         uint8_t* dstRow = dst + y * dstStride;
 
         for (int x = 0; x < width; x += 2) {
-            int x1 = x + 1;
-            int y0 = srcRowY[x];
-            int y1 = srcRowY[x + 1];
-            int u = srcRowUV[x];
-            int v = srcRowUV[x + 1];
-
-            int r0, g0, b0, r1, g1, b1;
-            convertFunc(y0, u, v, r0, g0, b0);
-            convertFunc(y1, u, v, r1, g1, b1);
-
-            if constexpr (isBgrColor) {
-                dstRow[x * channels + 0] = b0;
-                dstRow[x * channels + 1] = g0;
-                dstRow[x * channels + 2] = r0;
-
-                dstRow[x1 * channels + 0] = b1;
-                dstRow[x1 * channels + 1] = g1;
-                dstRow[x1 * channels + 2] = r1;
-            } else {
-                dstRow[x * channels + 0] = r0;
-                dstRow[x * channels + 1] = g0;
-                dstRow[x * channels + 2] = b0;
-
-                dstRow[x1 * channels + 0] = r1;
-                dstRow[x1 * channels + 1] = g1;
-                dstRow[x1 * channels + 2] = b1;
-            }
-
-            if constexpr (hasAlpha) {
-                dstRow[x * channels + 3] = 255;
-                dstRow[x1 * channels + 3] = 255;
-            }
+            yuvPairToRgb<isBgrColor, hasAlpha, matrix>(srcRowY[x], srcRowY[x + 1], srcRowUV[x], srcRowUV[x + 1], dstRow + x * channels);
         }
     }
 }
 
-template <bool isBgrColor, bool hasAlpha>
-void i420ToRgb_common(const uint8_t* srcY, int srcYStride, const uint8_t* srcU, int srcUStride, const uint8_t* srcV, int srcVStride, uint8_t* dst, int dstStride, int width, int height, ConvertFlag flag) {
-    // If height < 0, write to dst in reverse order while reading src sequentially
-    if (height < 0) {
-        height = -height;
-        dst = dst + (height - 1) * dstStride;
-        dstStride = -dstStride;
-    }
-
-    const auto convertFunc = getYuvToRgbFunc((flag & ConvertFlag::BT601) != 0, (flag & ConvertFlag::FullRange) != 0);
+template <bool isBgrColor, bool hasAlpha, int matrix>
+void i420ToRgb_common_imp(const uint8_t* srcY, int srcYStride, const uint8_t* srcU, int srcUStride, const uint8_t* srcV, int srcVStride, uint8_t* dst, int dstStride, int width, int height) {
     constexpr int channels = hasAlpha ? 4 : 3;
 
     for (int y = 0; y < height; ++y) {
@@ -239,39 +354,39 @@ void i420ToRgb_common(const uint8_t* srcY, int srcYStride, const uint8_t* srcU,
         uint8_t* dstRow = dst + y * dstStride;
 
         for (int x = 0; x < width; x += 2) {
-            int y0 = srcRowY[x + 0];
-            int y1 = srcRowY[x + 1];
-            int u = srcRowU[x / 2];
-            int v = srcRowV[x / 2];
-
-            int r0, g0, b0, r1, g1, b1;
-            convertFunc(y0, u, v, r0, g0, b0);
-            convertFunc(y1, u, v, r1, g1, b1);
-
-            if constexpr (isBgrColor) {
-                dstRow[x * channels + 0] = b0;
-                dstRow[x * channels + 1] = g0;
-                dstRow[x * channels + 2] = r0;
-
-                dstRow[(x + 1) * channels + 0] = b1;
-                dstRow[(x + 1) * channels + 1] = g1;
-                dstRow[(x + 1) * channels + 2] = r1;
-            } else {
-                dstRow[x * channels + 0] = r0;
-                dstRow[x * channels + 1] = g0;
-                dstRow[x * channels + 2] = b0;
+            yuvPairToRgb<isBgrColor, hasAlpha, matrix>(srcRowY[x], srcRowY[x + 1], srcRowU[x / 2], srcRowV[x / 2], dstRow + x * channels);
+        }
+    }
+}
 
-                dstRow[(x + 1) * channels + 0] = r1;
-                dstRow[(x + 1) * channels + 1] = g1;
-                dstRow[(x + 1) * channels + 2] = b1;
-            }
+} // namespace
 
-            if constexpr (hasAlpha) {
-                dstRow[x * channels + 3] = 255;
-                dstRow[(x + 1) * channels + 3] = 255;
-            }
-        }
+template <bool isBgrColor, bool hasAlpha>
+void nv12ToRgb_common(const uint8_t* srcY, int srcYStride, const uint8_t* srcUV, int srcUVStride, uint8_t* dst, int dstStride, int width, int height, ConvertFlag flag) {
+    // If height < 0, write to dst in reverse order while reading src sequentially
+    if (height < 0) {
+        height = -height;
+        dst = dst + (height - 1) * dstStride;
+        dstStride = -dstStride;
     }
+
+    dispatchYuvMatrix(flag, [&](auto matrix) {
+        nv12ToRgb_common_imp<isBgrColor, hasAlpha, decltype(matrix)::value>(srcY, srcYStride, srcUV, srcUVStride, dst, dstStride, width, height);
+    });
+}
+
+template <bool isBgrColor, bool hasAlpha>
+void i420ToRgb_common(const uint8_t* srcY, int srcYStride, const uint8_t* srcU, int srcUStride, const uint8_t* srcV, int srcVStride, uint8_t* dst, int dstStride, int width, int height, ConvertFlag flag) {
+    // If height < 0, write to dst in reverse order while reading src sequentially
+    if (height < 0) {
+        height = -height;
+        dst = dst + (height - 1) * dstStride;
+        dstStride = -dstStride;
+    }
+
+    dispatchYuvMatrix(flag, [&](auto matrix) {
+        i420ToRgb_common_imp<isBgrColor, hasAlpha, decltype(matrix)::value>(srcY, srcYStride, srcU, srcUStride, srcV, srcVStride, dst, dstStride, width, height);
+    });
 }
 
 void nv12ToBgr24(const uint8_t* srcY, int srcYStride, const uint8_t* srcUV, int srcUVStride, uint8_t* dst, int dstStride, int width, int height, ConvertFlag flag) {
@@ -282,6 +397,13 @@ void nv12ToBgr24(const uint8_t* srcY, int srcYStride, const uint8_t* srcUV, int
     }
 #endif
 
+#if ENABLE_AVX512_IMP
+    if (canUseAVX512()) {
+        nv12ToBgr24_avx512(srcY, srcYStride, srcUV, srcUVStride, dst, dstStride, width, height, flag);
+        return;
+    }
+#endif
+
 #if ENABLE_AVX2_IMP
     if (canUseAVX2()) {
         nv12ToBgr24_avx2(srcY, srcYStride, srcUV, srcUVStride, dst, dstStride, width, height, flag);
@@ -289,6 +411,13 @@ void nv12ToBgr24(const uint8_t* srcY, int srcYStride, const uint8_t* srcUV, int
     }
 #endif
 
+#if ENABLE_SSSE3_IMP
+    if (canUseSSSE3()) {
+        nv12ToBgr24_ssse3(srcY, srcYStride, srcUV, srcUVStride, dst, dstStride, width, height, flag);
+        return;
+    }
+#endif
+
 #if ENABLE_NEON_IMP
     if (canUseNEON()) {
         nv12ToBgr24_neon(srcY, srcYStride, srcUV, srcUVStride, dst, dstStride, width, height, flag);
@@ -307,6 +436,13 @@ void nv12ToRgb24(const uint8_t* srcY, int srcYStride, const uint8_t* srcUV, int
     }
 #endif
 
+#if ENABLE_AVX512_IMP
+    if (canUseAVX512()) {
+        nv12ToRgb24_avx512(srcY, srcYStride, srcUV, srcUVStride, dst, dstStride, width, height, flag);
+        return;
+    }
+#endif
+
 #if ENABLE_AVX2_IMP
     if (canUseAVX2()) {
         nv12ToRgb24_avx2(srcY, srcYStride, srcUV, srcUVStride, dst, dstStride, width, height, flag);
@@ -314,6 +450,13 @@ void nv12ToRgb24(const uint8_t* srcY, int srcYStride, const uint8_t* srcUV, int
     }
 #endif
 
+#if ENABLE_SSSE3_IMP
+    if (canUseSSSE3()) {
+        nv12ToRgb24_ssse3(srcY, srcYStride, srcUV, srcUVStride, dst, dstStride, width, height, flag);
+        return;
+    }
+#endif
+
 #if ENABLE_NEON_IMP
     if (canUseNEON()) {
         nv12ToRgb24_neon(srcY, srcYStride, srcUV, srcUVStride, dst, dstStride, width, height, flag);
@@ -332,6 +475,13 @@ void nv12ToBgra32(const uint8_t* srcY, int srcYStride, const uint8_t* srcUV, int
     }
 #endif
 
+#if ENABLE_AVX512_IMP
+    if (canUseAVX512()) {
+        nv12ToBgra32_avx512(srcY, srcYStride, srcUV, srcUVStride, dst, dstStride, width, height, flag);
+        return;
+    }
+#endif
+
 #if ENABLE_AVX2_IMP
     if (canUseAVX2()) {
         nv12ToBgra32_avx2(srcY, srcYStride, srcUV, srcUVStride, dst, dstStride, width, height, flag);
@@ -339,6 +489,13 @@ void nv12ToBgra32(const uint8_t* srcY, int srcYStride, const uint8_t* srcUV, int
     }
 #endif
 
+#if ENABLE_SSSE3_IMP
+    if (canUseSSSE3()) {
+        nv12ToBgra32_ssse3(srcY, srcYStride, srcUV, srcUVStride, dst, dstStride, width, height, flag);
+        return;
+    }
+#endif
+
 #if ENABLE_NEON_IMP
     if (canUseNEON()) {
         nv12ToBgra32_neon(srcY, srcYStride, srcUV, srcUVStride, dst, dstStride, width, height, flag);
@@ -357,6 +514,13 @@ void nv12ToRgba32(const uint8_t* srcY, int srcYStride, const uint8_t* srcUV, int
     }
 #endif
 
+#if ENABLE_AVX512_IMP
+    if (canUseAVX512()) {
+        nv12ToRgba32_avx512(srcY, srcYStride, srcUV, srcUVStride, dst, dstStride, width, height, flag);
+        return;
+    }
+#endif
+
 #if ENABLE_AVX2_IMP
     if (canUseAVX2()) {
         nv12ToRgba32_avx2(srcY, srcYStride, srcUV, srcUVStride, dst, dstStride, width, height, flag);
@@ -364,6 +528,13 @@ void nv12ToRgba32(const uint8_t* srcY, int srcYStride, const uint8_t* srcUV, int
     }
 #endif
 
+#if ENABLE_SSSE3_IMP
+    if (canUseSSSE3()) {
+        nv12ToRgba32_ssse3(srcY, srcYStride, srcUV, srcUVStride, dst, dstStride, width, height, flag);
+        return;
+    }
+#endif
+
 #if ENABLE_NEON_IMP
     if (canUseNEON()) {
         nv12ToRgba32_neon(srcY, srcYStride, srcUV, srcUVStride, dst, dstStride, width, height, flag);
@@ -382,6 +553,13 @@ void i420ToBgr24(const uint8_t* srcY, int srcYStride, const uint8_t* srcU, int s
     }
 #endif
 
+#if ENABLE_AVX512_IMP
+    if (canUseAVX512()) {
+        i420ToBgr24_avx512(srcY, srcYStride, srcU, srcUStride, srcV, srcVStride, dst, dstStride, width, height, flag);
+        return;
+    }
+#endif
+
 #if ENABLE_AVX2_IMP
     if (canUseAVX2()) {
         i420ToBgr24_avx2(srcY, srcYStride, srcU, srcUStride, srcV, srcVStride, dst, dstStride, width, height, flag);
@@ -389,6 +567,13 @@ void i420ToBgr24(const uint8_t* srcY, int srcYStride, const uint8_t* srcU, int s
     }
 #endif
 
+#if ENABLE_SSSE3_IMP
+    if (canUseSSSE3()) {
+        i420ToBgr24_ssse3(srcY, srcYStride, srcU, srcUStride, srcV, srcVStride, dst, dstStride, width, height, flag);
+        return;
+    }
+#endif
+
 #if ENABLE_NEON_IMP
     if (canUseNEON()) {
         i420ToBgr24_neon(srcY, srcYStride, srcU, srcUStride, srcV, srcVStride, dst, dstStride, width, height, flag);
@@ -407,6 +592,13 @@ void i420ToRgb24(const uint8_t* srcY, int srcYStride, const uint8_t* srcU, int s
     }
 #endif
 
+#if ENABLE_AVX512_IMP
+    if (canUseAVX512()) {
+        i420ToRgb24_avx512(srcY, srcYStride, srcU, srcUStride, srcV, srcVStride, dst, dstStride, width, height, flag);
+        return;
+    }
+#endif
+
 #if ENABLE_AVX2_IMP
     if (canUseAVX2()) {
         i420ToRgb24_avx2(srcY, srcYStride, srcU, srcUStride, srcV, srcVStride, dst, dstStride, width, height, flag);
@@ -414,6 +606,13 @@ void i420ToRgb24(const uint8_t* srcY, int srcYStride, const uint8_t* srcU, int s
     }
 #endif
 
+#if ENABLE_SSSE3_IMP
+    if (canUseSSSE3()) {
+        i420ToRgb24_ssse3(srcY, srcYStride, srcU, srcUStride, srcV, srcVStride, dst, dstStride, width, height, flag);
+        return;
+    }
+#endif
+
 #if ENABLE_NEON_IMP
     if (canUseNEON()) {
         i420ToRgb24_neon(srcY, srcYStride, srcU, srcUStride, srcV, srcVStride, dst, dstStride, width, height, flag);
@@ -432,6 +631,13 @@ void i420ToBgra32(const uint8_t* srcY, int srcYStride, const uint8_t* srcU, int
     }
 #endif
 
+#if ENABLE_AVX512_IMP
+    if (canUseAVX512()) {
+        i420ToBgra32_avx512(srcY, srcYStride, srcU, srcUStride, srcV, srcVStride, dst, dstStride, width, height, flag);
+        return;
+    }
+#endif
+
 #if ENABLE_AVX2_IMP
     if (canUseAVX2()) {
         i420ToBgra32_avx2(srcY, srcYStride, srcU, srcUStride, srcV, srcVStride, dst, dstStride, width, height, flag);
@@ -439,6 +645,13 @@ void i420ToBgra32(const uint8_t* srcY, int srcYStride, const uint8_t* srcU, int
     }
 #endif
 
+#if ENABLE_SSSE3_IMP
+    if (canUseSSSE3()) {
+        i420ToBgra32_ssse3(srcY, srcYStride, srcU, srcUStride, srcV, srcVStride, dst, dstStride, width, height, flag);
+        return;
+    }
+#endif
+
 #if ENABLE_NEON_IMP
     if (canUseNEON()) {
         i420ToBgra32_neon(srcY, srcYStride, srcU, srcUStride, srcV, srcVStride, dst, dstStride, width, height, flag);
@@ -457,6 +670,13 @@ void i420ToRgba32(const uint8_t* srcY, int srcYStride, const uint8_t* srcU, int
     }
 #endif
 
+#if ENABLE_AVX512_IMP
+    if (canUseAVX512()) {
+        i420ToRgba32_avx512(srcY, srcYStride, srcU, srcUStride, srcV, srcVStride, dst, dstStride, width, height, flag);
+        return;
+    }
+#endif
+
 #if ENABLE_AVX2_IMP
     if (canUseAVX2()) {
         i420ToRgba32_avx2(srcY, srcYStride, srcU, srcUStride, srcV, srcVStride, dst, dstStride, width, height, flag);
@@ -464,6 +684,13 @@ void i420ToRgba32(const uint8_t* srcY, int srcYStride, const uint8_t* srcU, int
     }
 #endif
 
+#if ENABLE_SSSE3_IMP
+    if (canUseSSSE3()) {
+        i420ToRgba32_ssse3(srcY, srcYStride, srcU, srcUStride, srcV, srcVStride, dst, dstStride, width, height, flag);
+        return;
+    }
+#endif
+
 #if ENABLE_NEON_IMP
     if (canUseNEON()) {
         i420ToRgba32_neon(srcY, srcYStride, srcU, srcUStride, srcV, srcVStride, dst, dstStride, width, height, flag);
@@ -476,64 +703,32 @@ void i420ToRgba32(const uint8_t* srcY, int srcYStride, const uint8_t* srcU, int
 
 ///////////// YUYV/UYVY to RGB functions /////////////
 
-template <bool isBgrColor, bool hasAlpha>
-void yuyvToRgb_common(const uint8_t* src, int srcStride, uint8_t* dst, int dstStride, int width, int height, ConvertFlag flag) {
-    // If height < 0, write to dst in reverse order while reading src sequentially
-    if (height < 0) {
-        height = -height;
-        dst = dst + (height - 1) * dstStride;
-        dstStride = -dstStride;
-    }
+namespace {
 
-    const bool is601 = (flag & ConvertFlag::BT601) != 0;
-    const bool isFullRange = (flag & ConvertFlag::FullRange) != 0;
-    const auto convertFunc = getYuvToRgbFunc(is601, isFullRange);
+/// YUYV: Y0 U0 Y1 V0, UYVY: U0 Y0 V0 Y1 (4 bytes for 2 pixels)
+template <bool isBgrColor, bool hasAlpha, bool isYUYV, int matrix>
+void packedYuvToRgb_common_imp(const uint8_t* src, int srcStride, uint8_t* dst, int dstStride, int width, int height) {
     constexpr int channels = hasAlpha ? 4 : 3;
+    constexpr int y0Index = isYUYV ? 0 : 1;
+    constexpr int uIndex = isYUYV ? 1 : 0;
+    constexpr int y1Index = isYUYV ? 2 : 3;
+    constexpr int vIndex = isYUYV ? 3 : 2;
 
     for (int y = 0; y < height; ++y) {
         const uint8_t* srcRow = src + y * srcStride;
         uint8_t* dstRow = dst + y * dstStride;
 
         for (int x = 0; x < width; x += 2) {
-            // YUYV format: Y0 U0 Y1 V0 (4 bytes for 2 pixels)
-            int baseIdx = (x / 2) * 4;
-            int y0 = srcRow[baseIdx + 0]; // Y0
-            int u = srcRow[baseIdx + 1];  // U0
-            int y1 = srcRow[baseIdx + 2]; // Y1
-            int v = srcRow[baseIdx + 3];  // V0
-
-            int r0, g0, b0, r1, g1, b1;
-            convertFunc(y0, u, v, r0, g0, b0);
-            convertFunc(y1, u, v, r1, g1, b1);
-
-            if constexpr (isBgrColor) {
-                dstRow[x * channels + 0] = b0;
-                dstRow[x * channels + 1] = g0;
-                dstRow[x * channels + 2] = r0;
-
-                dstRow[(x + 1) * channels + 0] = b1;
-                dstRow[(x + 1) * channels + 1] = g1;
-                dstRow[(x + 1) * channels + 2] = r1;
-            } else {
-                dstRow[x * channels + 0] = r0;
-                dstRow[x * channels + 1] = g0;
-                dstRow[x * channels + 2] = b0;
-
-                dstRow[(x + 1) * channels + 0] = r1;
-                dstRow[(x + 1) * channels + 1] = g1;
-                dstRow[(x + 1) * channels + 2] = b1;
-            }
-
-            if constexpr (hasAlpha) {
-                dstRow[x * channels + 3] = 255;
-                dstRow[(x + 1) * channels + 3] = 255;
-            }
+            const uint8_t* pair = srcRow + x * 2;
+            yuvPairToRgb<isBgrColor, hasAlpha, matrix>(pair[y0Index], pair[y1Index], pair[uIndex], pair[vIndex], dstRow + x * channels);
         }
     }
 }
 
+} // namespace
+
 template <bool isBgrColor, bool hasAlpha>
-void uyvyToRgb_common(const uint8_t* src, int srcStride, uint8_t* dst, int dstStride, int width, int height, ConvertFlag flag) {
+void yuyvToRgb_common(const uint8_t* src, int srcStride, uint8_t* dst, int dstStride, int width, int height, ConvertFlag flag) {
     // If height < 0, write to dst in reverse order while reading src sequentially
     if (height < 0) {
         height = -height;
@@ -541,55 +736,34 @@ void uyvyToRgb_common(const uint8_t* src, int srcStride, uint8_t* dst, int dstSt
         dstStride = -dstStride;
     }
 
-    const bool is601 = (flag & ConvertFlag::BT601) != 0;
-    const bool isFullRange = (flag & ConvertFlag::FullRange) != 0;
-    const auto convertFunc = getYuvToRgbFunc(is601, isFullRange);
-    constexpr int channels = hasAlpha ? 4 : 3;
-
-    for (int y = 0; y < height; ++y) {
-        const uint8_t* srcRow = src + y * srcStride;
-        uint8_t* dstRow = dst + y * dstStride;
-
-        for (int x = 0; x < width; x += 2) {
-            // UYVY format: U0 Y0 V0 Y1 (4 bytes for 2 pixels)
-            int baseIdx = (x / 2) * 4;
-            int u = srcRow[baseIdx + 0];  // U0
-            int y0 = srcRow[baseIdx + 1]; // Y0
-            int v = srcRow[baseIdx + 2];  // V0
-            int y1 = srcRow[baseIdx + 3]; // Y1
-
-            int r0, g0, b0, r1, g1, b1;
-            convertFunc(y0, u, v, r0, g0, b0);
-            convertFunc(y1, u, v, r1, g1, b1);
-
-            if constexpr (isBgrColor) {
-                dstRow[x * channels + 0] = b0;
-                dstRow[x * channels + 1] = g0;
-                dstRow[x * channels + 2] = r0;
-
-                dstRow[(x + 1) * channels + 0] = b1;
-                dstRow[(x + 1) * channels + 1] = g1;
-                dstRow[(x + 1) * channels + 2] = r1;
-            } else {
-                dstRow[x * channels + 0] = r0;
-                dstRow[x * channels + 1] = g0;
-                dstRow[x * channels + 2] = b0;
-
-                dstRow[(x + 1) * channels + 0] = r1;
-                dstRow[(x + 1) * channels + 1] = g1;
-                dstRow[(x + 1) * channels + 2] = b1;
-            }
+    dispatchYuvMatrix(flag, [&](auto matrix) {
+        packedYuvToRgb_common_imp<isBgrColor, hasAlpha, true, decltype(matrix)::value>(src, srcStride, dst, dstStride, width, height);
+    });
+}
 
-            if constexpr (hasAlpha) {
-                dstRow[x * channels + 3] = 255;
-                dstRow[(x + 1) * channels + 3] = 255;
-            }
-        }
+template <bool isBgrColor, bool hasAlpha>
+void uyvyToRgb_common(const uint8_t* src, int srcStride, uint8_t* dst, int dstStride, int width, int height, ConvertFlag flag) {
+    // If height < 0, write to dst in reverse order while reading src sequentially
+    if (height < 0) {
+        height = -height;
+        dst = dst + (height - 1) * dstStride;
+        dstStride = -dstStride;
     }
+
+    dispatchYuvMatrix(flag, [&](auto matrix) {
+        packedYuvToRgb_common_imp<isBgrColor, hasAlpha, false, decltype(matrix)::value>(src, srcStride, dst, dstStride, width, height);
+    });
 }
 
 // YUYV conversion functions
 void yuyvToBgr24(const uint8_t* src, int srcStride, uint8_t* dst, int dstStride, int width, int height, ConvertFlag flag) {
+#if ENABLE_AVX512_IMP
+    if (canUseAVX512()) {
+        yuyvToBgr24_avx512(src, srcStride, dst, dstStride, width, height, flag);
+        return;
+    }
+#endif
+
 #if ENABLE_AVX2_IMP
     if (canUseAVX2()) {
         yuyvToBgr24_avx2(src, srcStride, dst, dstStride, width, height, flag);
@@ -597,6 +771,13 @@ void yuyvToBgr24(const uint8_t* src, int srcStride, uint8_t* dst, int dstStride,
     }
 #endif
 
+#if ENABLE_SSSE3_IMP
+    if (canUseSSSE3()) {
+        yuyvToBgr24_ssse3(src, srcStride, dst, dstStride, width, height, flag);
+        return;
+    }
+#endif
+
 #if ENABLE_NEON_IMP
     if (canUseNEON()) {
         yuyvToBgr24_neon(src, srcStride, dst, dstStride, width, height, flag);
@@ -608,6 +789,13 @@ void yuyvToBgr24(const uint8_t* src, int srcStride, uint8_t* dst, int dstStride,
 }
 
 void yuyvToRgb24(const uint8_t* src, int srcStride, uint8_t* dst, int dstStride, int width, int height, ConvertFlag flag) {
+#if ENABLE_AVX512_IMP
+    if (canUseAVX512()) {
+        yuyvToRgb24_avx512(src, srcStride, dst, dstStride, width, height, flag);
+        return;
+    }
+#endif
+
 #if ENABLE_AVX2_IMP
     if (canUseAVX2()) {
         yuyvToRgb24_avx2(src, srcStride, dst, dstStride, width, height, flag);
@@ -615,6 +803,13 @@ void yuyvToRgb24(const uint8_t* src, int srcStride, uint8_t* dst, int dstStride,
     }
 #endif
 
+#if ENABLE_SSSE3_IMP
+    if (canUseSSSE3()) {
+        yuyvToRgb24_ssse3(src, srcStride, dst, dstStride, width, height, flag);
+        return;
+    }
+#endif
+
 #if ENABLE_NEON_IMP
     if (canUseNEON()) {
         yuyvToRgb24_neon(src, srcStride, dst, dstStride, width, height, flag);
@@ -626,6 +821,13 @@ void yuyvToRgb24(const uint8_t* src, int srcStride, uint8_t* dst, int dstStride,
 }
 
 void yuyvToBgra32(const uint8_t* src, int srcStride, uint8_t* dst, int dstStride, int width, int height, ConvertFlag flag) {
+#if ENABLE_AVX512_IMP
+    if (canUseAVX512()) {
+        yuyvToBgra32_avx512(src, srcStride, dst, dstStride, width, height, flag);
+        return;
+    }
+#endif
+
 #if ENABLE_AVX2_IMP
     if (canUseAVX2()) {
         yuyvToBgra32_avx2(src, srcStride, dst, dstStride, width, height, flag);
@@ -633,6 +835,13 @@ void yuyvToBgra32(const uint8_t* src, int srcStride, uint8_t* dst, int dstStride
     }
 #endif
 
+#if ENABLE_SSSE3_IMP
+    if (canUseSSSE3()) {
+        yuyvToBgra32_ssse3(src, srcStride, dst, dstStride, width, height, flag);
+        return;
+    }
+#endif
+
 #if ENABLE_NEON_IMP
     if (canUseNEON()) {
         yuyvToBgra32_neon(src, srcStride, dst, dstStride, width, height, flag);
@@ -644,6 +853,13 @@ void yuyvToBgra32(const uint8_t* src, int srcStride, uint8_t* dst, int dstStride
 }
 
 void yuyvToRgba32(const uint8_t* src, int srcStride, uint8_t* dst, int dstStride, int width, int height, ConvertFlag flag) {
+#if ENABLE_AVX512_IMP
+    if (canUseAVX512()) {
+        yuyvToRgba32_avx512(src, srcStride, dst, dstStride, width, height, flag);
+        return;
+    }
+#endif
+
 #if ENABLE_AVX2_IMP
     if (canUseAVX2()) {
         yuyvToRgba32_avx2(src, srcStride, dst, dstStride, width, height, flag);
@@ -651,6 +867,13 @@ void yuyvToRgba32(const uint8_t* src, int srcStride, uint8_t* dst, int dstStride
     }
 #endif
 
+#if ENABLE_SSSE3_IMP
+    if (canUseSSSE3()) {
+        yuyvToRgba32_ssse3(src, srcStride, dst, dstStride, width, height, flag);
+        return;
+    }
+#endif
+
 #if ENABLE_NEON_IMP
     if (canUseNEON()) {
         yuyvToRgba32_neon(src, srcStride, dst, dstStride, width, height, flag);
@@ -663,6 +886,13 @@ void yuyvToRgba32(const uint8_t* src, int srcStride, uint8_t* dst, int dstStride
 
 // UYVY conversion functions
 void uyvyToBgr24(const uint8_t* src, int srcStride, uint8_t* dst, int dstStride, int width, int height, ConvertFlag flag) {
+#if ENABLE_AVX512_IMP
+    if (canUseAVX512()) {
+        uyvyToBgr24_avx512(src, srcStride, dst, dstStride, width, height, flag);
+        return;
+    }
+#endif
+
 #if ENABLE_AVX2_IMP
     if (canUseAVX2()) {
         uyvyToBgr24_avx2(src, srcStride, dst, dstStride, width, height, flag);
@@ -670,6 +900,13 @@ void uyvyToBgr24(const uint8_t* src, int srcStride, uint8_t* dst, int dstStride,
     }
 #endif
 
+#if ENABLE_SSSE3_IMP
+    if (canUseSSSE3()) {
+        uyvyToBgr24_ssse3(src, srcStride, dst, dstStride, width, height, flag);
+        return;
+    }
+#endif
+
 #if ENABLE_NEON_IMP
     if (canUseNEON()) {
         uyvyToBgr24_neon(src, srcStride, dst, dstStride, width, height, flag);
@@ -681,6 +918,13 @@ void uyvyToBgr24(const uint8_t* src, int srcStride, uint8_t* dst, int dstStride,
 }
 
 void uyvyToRgb24(const uint8_t* src, int srcStride, uint8_t* dst, int dstStride, int width, int height, ConvertFlag flag) {
+#if ENABLE_AVX512_IMP
+    if (canUseAVX512()) {
+        uyvyToRgb24_avx512(src, srcStride, dst, dstStride, width, height, flag);
+        return;
+    }
+#endif
+
 #if ENABLE_AVX2_IMP
     if (canUseAVX2()) {
         uyvyToRgb24_avx2(src, srcStride, dst, dstStride, width, height, flag);
@@ -688,6 +932,13 @@ void uyvyToRgb24(const uint8_t* src, int srcStride, uint8_t* dst, int dstStride,
     }
 #endif
 
+#if ENABLE_SSSE3_IMP
+    if (canUseSSSE3()) {
+        uyvyToRgb24_ssse3(src, srcStride, dst, dstStride, width, height, flag);
+        return;
+    }
+#endif
+
 #if ENABLE_NEON_IMP
     if (canUseNEON()) {
         uyvyToRgb24_neon(src, srcStride, dst, dstStride, width, height, flag);
@@ -699,6 +950,13 @@ void uyvyToRgb24(const uint8_t* src, int srcStride, uint8_t* dst, int dstStride,
 }
 
 void uyvyToBgra32(const uint8_t* src, int srcStride, uint8_t* dst, int dstStride, int width, int height, ConvertFlag flag) {
+#if ENABLE_AVX512_IMP
+    if (canUseAVX512()) {
+        uyvyToBgra32_avx512(src, srcStride, dst, dstStride, width, height, flag);
+        return;
+    }
+#endif
+
 #if ENABLE_AVX2_IMP
     if (canUseAVX2()) {
         uyvyToBgra32_avx2(src, srcStride, dst, dstStride, width, height, flag);
@@ -706,6 +964,13 @@ void uyvyToBgra32(const uint8_t* src, int srcStride, uint8_t* dst, int dstStride
     }
 #endif
 
+#if ENABLE_SSSE3_IMP
+    if (canUseSSSE3()) {
+        uyvyToBgra32_ssse3(src, srcStride, dst, dstStride, width, height, flag);
+        return;
+    }
+#endif
+
 #if ENABLE_NEON_IMP
     if (canUseNEON()) {
         uyvyToBgra32_neon(src, srcStride, dst, dstStride, width, height, flag);
@@ -717,6 +982,13 @@ void uyvyToBgra32(const uint8_t* src, int srcStride, uint8_t* dst, int dstStride
 }
 
 void uyvyToRgba32(const uint8_t* src, int srcStride, uint8_t* dst, int dstStride, int width, int height, ConvertFlag flag) {
+#if ENABLE_AVX512_IMP
+    if (canUseAVX512()) {
+        uyvyToRgba32_avx512(src, srcStride, dst, dstStride, width, height, flag);
+        return;
+    }
+#endif
+
 #if ENABLE_AVX2_IMP
     if (canUseAVX2()) {
         uyvyToRgba32_avx2(src, srcStride, dst, dstStride, width, height, flag);
@@ -724,6 +996,13 @@ void uyvyToRgba32(const uint8_t* src, int srcStride, uint8_t* dst, int dstStride
     }
 #endif
 
+#if ENABLE_SSSE3_IMP
+    if (canUseSSSE3()) {
+        uyvyToRgba32_ssse3(src, srcStride, dst, dstStride, width, height, flag);
+        return;
+    }
+#endif
+
 #if ENABLE_NEON_IMP
     if (canUseNEON()) {
         uyvyToRgba32_neon(src, srcStride, dst, dstStride, width, height, flag);
@@ -734,6 +1013,362 @@ void uyvyToRgba32(const uint8_t* src, int srcStride, uint8_t* dst, int dstStride
     uyvyToRgb_common<false, true>(src, srcStride, dst, dstStride, width, height, flag);
 }
 
+///////////// NV21/P010 to RGB functions /////////////
+
+namespace {
+
+/// NV21 and P010 are repacked as NV12 strips of this many rows, small enough to stay in cache.
+/// Even, so a strip never splits a 4:2:0 chroma row.
+constexpr int kStripRows = 16;
+
+using Nv12ToRgbFunc = void (*)(const uint8_t* srcY, int srcYStride, const uint8_t* srcUV, int srcUVStride, uint8_t* dst, int dstStride,
+                               int width, int height, ConvertFlag flag);
+
+void swapUVRow(const uint8_t* src, uint8_t* dst, int byteCount) {
+#if ENABLE_AVX2_IMP
+    if (canUseAVX2()) {
+        swapUVRow_avx2(src, dst, byteCount);
+        return;
+    }
+#endif
+
+#if ENABLE_NEON_IMP
+    if (canUseNEON()) {
+        swapUVRow_neon(src, dst, byteCount);
+        return;
+    }
+#endif
+
+    for (int i = 0; i + 1 < byteCount; i += 2) {
+        uint8_t v = src[i];
+        dst[i] = src[i + 1];
+        dst[i + 1] = v;
+    }
+}
+
+void p010ToU8Row(const uint8_t* src, uint8_t* dst, int count) {
+#if ENABLE_AVX2_IMP
+    if (canUseAVX2()) {
+        p010ToU8Row_avx2(src, dst, count);
+        return;
+    }
+#endif
+
+#if ENABLE_NEON_IMP
+    if (canUseNEON()) {
+        p010ToU8Row_neon(src, dst, count);
+        return;
+    }
+#endif
+
+    for (int i = 0; i < count; ++i) {
+        int v = src[i * 2] | (src[i * 2 + 1] << 8);
+        dst[i] = static_cast<uint8_t>(std::min((v + 128) >> 8, 255));
+    }
+}
+
+/// Per thread, frame conversion runs row bands on the conversion thread pool.
+uint8_t* getStripBuffer(size_t size) {
+    thread_local std::vector<uint8_t> buffer;
+    if (buffer.size() < size) {
+        buffer.resize(size);
+    }
+    return buffer.data();
+}
+
+/// Repack NV21 (VU order) or P010 (16-bit samples) strip by strip as NV12, and convert each strip with `nv12ToRgb`,
+/// so every NV12 backend is reused.
+void semiPlanarToRgbByStrips(bool isP010, Nv12ToRgbFunc nv12ToRgb, const uint8_t* srcY, int srcYStride, const uint8_t* srcUV, int srcUVStride,
+                             uint8_t* dst, int dstStride, int width, int height, ConvertFlag flag) {
+    const bool flip = height < 0;
+    if (flip) {
+        height = -height;
+    }
+
+    const int chromaCount = (width + 1) & ~1; // Bytes of an NV12 chroma row, samples of a P010 one
+    const int scratchStride = (chromaCount + 31) & ~31;
+    uint8_t* scratchUV = getStripBuffer(static_cast<size_t>(scratchStride) * (isP010 ? kStripRows * 3 / 2 : kStripRows / 2));
+    uint8_t* scratchY = scratchUV + scratchStride * (kStripRows / 2);
+
+    for (int row = 0; row < height; row += kStripRows) {
+        const int rows = std::min(kStripRows, height - row);
+        const uint8_t* stripUV = srcUV + (row / 2) * srcUVStride;
+        for (int i = 0; i < (rows + 1) / 2; ++i) {
+            if (isP010) {
+                p010ToU8Row(stripUV + i * srcUVStride, scratchUV + i * scratchStride, chromaCount);
+            } else {
+                swapUVRow(stripUV + i * srcUVStride, scratchUV + i * scratchStride, chromaCount);
+            }
+        }
+
+        const uint8_t* stripY = srcY + row * srcYStride;
+        int stripYStride = srcYStride;
+        if (isP010) {
+            for (int i = 0; i < rows; ++i) {
+                p010ToU8Row(stripY + i * srcYStride, scratchY + i * scratchStride, width);
+            }
+            stripY = scratchY;
+            stripYStride = scratchStride;
+        }
+
+        uint8_t* stripDst = dst + (flip ? height - row - rows : row) * dstStride;
+        nv12ToRgb(stripY, stripYStride, scratchUV, scratchStride, stripDst, dstStride, width, flip ? -rows : rows, flag);
+    }
+}
+
+} // namespace
+
+void nv21ToBgr24(const uint8_t* srcY, int srcYStride, const uint8_t* srcVU, int srcVUStride, uint8_t* dst, int dstStride, int width, int height, ConvertFlag flag) {
+    semiPlanarToRgbByStrips(false, nv12ToBgr24, srcY, srcYStride, srcVU, srcVUStride, dst, dstStride, width, height, flag);
+}
+
+void nv21ToRgb24(const uint8_t* srcY, int srcYStride, const uint8_t* srcVU, int srcVUStride, uint8_t* dst, int dstStride, int width, int height, ConvertFlag flag) {
+    semiPlanarToRgbByStrips(false, nv12ToRgb24, srcY, srcYStride, srcVU, srcVUStride, dst, dstStride, width, height, flag);
+}
+
+void nv21ToBgra32(const uint8_t* srcY, int srcYStride, const uint8_t* srcVU, int srcVUStride, uint8_t* dst, int dstStride, int width, int height, ConvertFlag flag) {
+    semiPlanarToRgbByStrips(false, nv12ToBgra32, srcY, srcYStride, srcVU, srcVUStride, dst, dstStride, width, height, flag);
+}
+
+void nv21ToRgba32(const uint8_t* srcY, int srcYStride, const uint8_t* srcVU, int srcVUStride, uint8_t* dst, int dstStride, int width, int height, ConvertFlag flag) {
+    semiPlanarToRgbByStrips(false, nv12ToRgba32, srcY, srcYStride, srcVU, srcVUStride, dst, dstStride, width, height, flag);
+}
+
+void p010ToBgr24(const uint8_t* srcY, int srcYStride, const uint8_t* srcUV, int srcUVStride, uint8_t* dst, int dstStride, int width, int height, ConvertFlag flag) {
+    semiPlanarToRgbByStrips(true, nv12ToBgr24, srcY, srcYStride, srcUV, srcUVStride, dst, dstStride, width, height, flag);
+}
+
+void p010ToRgb24(const uint8_t* srcY, int srcYStride, const uint8_t* srcUV, int srcUVStride, uint8_t* dst, int dstStride, int width, int height, ConvertFlag flag) {
+    semiPlanarToRgbByStrips(true, nv12ToRgb24, srcY, srcYStride, srcUV, srcUVStride, dst, dstStride, width, height, flag);
+}
+
+void p010ToBgra32(const uint8_t* srcY, int srcYStride, const uint8_t* srcUV, int srcUVStride, uint8_t* dst, int dstStride, int width, int height, ConvertFlag flag) {
+    semiPlanarToRgbByStrips(true, nv12ToBgra32, srcY, srcYStride, srcUV, srcUVStride, dst, dstStride, width, height, flag);
+}
+
+void p010ToRgba32(const uint8_t* srcY, int srcYStride, const uint8_t* srcUV, int srcUVStride, uint8_t* dst, int dstStride, int width, int height, ConvertFlag flag) {
+    semiPlanarToRgbByStrips(true, nv12ToRgba32, srcY, srcYStride, srcUV, srcUVStride, dst, dstStride, width, height, flag);
+}
+
+///////////// RGB565 to RGB functions /////////////
+
+template <bool isBgrColor, bool hasAlpha>
+void rgb565ToRgb_common(const uint8_t* src, int srcStride, uint8_t* dst, int dstStride, int width, int height) {
+    // If height < 0, write to dst in reverse order while reading src sequentially
+    if (height < 0) {
+        height = -height;
+        dst = dst + (height - 1) * dstStride;
+        dstStride = -dstStride;
+    }
+
+    constexpr int channels = hasAlpha ? 4 : 3;
+
+    for (int y = 0; y < height; ++y) {
+        const uint8_t* srcRow = src + y * srcStride;
+        uint8_t* dstRow = dst + y * dstStride;
+
+        for (int x = 0; x < width; ++x) {
+            int v = srcRow[x * 2] | (srcRow[x * 2 + 1] << 8);
+            int r5 = v >> 11, g6 = (v >> 5) & 0x3F, b5 = v & 0x1F;
+            uint8_t* pixel = dstRow + x * channels;
+            // Replicate the high bits, so 0x1F/0x3F expand to 255
+            pixel[isBgrColor ? 2 : 0] = static_cast<uint8_t>((r5 << 3) | (r5 >> 2));
+            pixel[1] = static_cast<uint8_t>((g6 << 2) | (g6 >> 4));
+            pixel[isBgrColor ? 0 : 2] = static_cast<uint8_t>((b5 << 3) | (b5 >> 2));
+            if constexpr (hasAlpha) {
+                pixel[3] = 255;
+            }
+        }
+    }
+}
+
+void rgb565ToBgr24(const uint8_t* src, int srcStride, uint8_t* dst, int dstStride, int width, int height) {
+#if ENABLE_AVX2_IMP
+    if (canUseAVX2()) {
+        rgb565ToBgr24_avx2(src, srcStride, dst, dstStride, width, height);
+        return;
+    }
+#endif
+
+#if ENABLE_NEON_IMP
+    if (canUseNEON()) {
+        rgb565ToBgr24_neon(src, srcStride, dst, dstStride, width, height);
+        return;
+    }
+#endif
+
+    rgb565ToRgb_common<true, false>(src, srcStride, dst, dstStride, width, height);
+}
+
+void rgb565ToRgb24(const uint8_t* src, int srcStride, uint8_t* dst, int dstStride, int width, int height) {
+#if ENABLE_AVX2_IMP
+    if (canUseAVX2()) {
+        rgb565ToRgb24_avx2(src, srcStride, dst, dstStride, width, height);
+        return;
+    }
+#endif
+
+#if ENABLE_NEON_IMP
+    if (canUseNEON()) {
+        rgb565ToRgb24_neon(src, srcStride, dst, dstStride, width, height);
+        return;
+    }
+#endif
+
+    rgb565ToRgb_common<false, false>(src, srcStride, dst, dstStride, width, height);
+}
+
+void rgb565ToBgra32(const uint8_t* src, int srcStride, uint8_t* dst, int dstStride, int width, int height) {
+#if ENABLE_AVX2_IMP
+    if (canUseAVX2()) {
+        rgb565ToBgra32_avx2(src, srcStride, dst, dstStride, width, height);
+        return;
+    }
+#endif
+
+#if ENABLE_NEON_IMP
+    if (canUseNEON()) {
+        rgb565ToBgra32_neon(src, srcStride, dst, dstStride, width, height);
+        return;
+    }
+#endif
+
+    rgb565ToRgb_common<true, true>(src, srcStride, dst, dstStride, width, height);
+}
+
+void rgb565ToRgba32(const uint8_t* src, int srcStride, uint8_t* dst, int dstStride, int width, int height) {
+#if ENABLE_AVX2_IMP
+    if (canUseAVX2()) {
+        rgb565ToRgba32_avx2(src, srcStride, dst, dstStride, width, height);
+        return;
+    }
+#endif
+
+#if ENABLE_NEON_IMP
+    if (canUseNEON()) {
+        rgb565ToRgba32_neon(src, srcStride, dst, dstStride, width, height);
+        return;
+    }
+#endif
+
+    rgb565ToRgb_common<false, true>(src, srcStride, dst, dstStride, width, height);
+}
+
+///////////// RGB to YUV functions /////////////
+
+template <int inputChannels, bool isBgrColor>
+void rgbToYuv420_common(const uint8_t* src, int srcStride,
+                        uint8_t* dstY, int dstYStride,
+                        uint8_t* dstU, int dstUStride,
+                        uint8_t* dstV, int dstVStride,
+                        int width, int height, ConvertFlag flag) {
+    // If height < 0, read src in reverse order while writing dst sequentially
+    if (height < 0) {
+        height = -height;
+        src = src + (height - 1) * srcStride;
+        srcStride = -srcStride;
+    }
+
+    const auto k = getRgbToYuvCoefficients(flag);
+    constexpr int rIndex = isBgrColor ? 2 : 0;
+    constexpr int bIndex = isBgrColor ? 0 : 2;
+
+    for (int y = 0; y < height; y += 2) {
+        // The last row of an odd height is paired with itself, its Y row is simply written twice.
+        bool hasRow1 = y + 1 < height;
+        const uint8_t* srcRow0 = src + y * srcStride;
+        const uint8_t* srcRow1 = hasRow1 ? srcRow0 + srcStride : srcRow0;
+        uint8_t* yRow0 = dstY + y * dstYStride;
+        uint8_t* yRow1 = hasRow1 ? yRow0 + dstYStride : yRow0;
+        uint8_t* uRow = dstU + (y / 2) * dstUStride;
+        uint8_t* vRow = dstV ? dstV + (y / 2) * dstVStride : nullptr;
+
+        for (int x = 0; x < width; x += 2) {
+            int x1 = x + 1 < width ? x + 1 : x;
+            const uint8_t* p[4] = { srcRow0 + x * inputChannels, srcRow0 + x1 * inputChannels,
+                                    srcRow1 + x * inputChannels, srcRow1 + x1 * inputChannels };
+            uint8_t* yOut[4] = { yRow0 + x, yRow0 + x1, yRow1 + x, yRow1 + x1 };
+
+            int rs = 0, gs = 0, bs = 0;
+            for (int i = 0; i < 4; ++i) {
+                int r = p[i][rIndex], g = p[i][1], b = p[i][bIndex];
+                *yOut[i] = static_cast<uint8_t>(((k.yr * r + k.yg * g + k.yb * b + 128) >> 8) + k.yOffset);
+                rs += r;
+                gs += g;
+                bs += b;
+            }
+
+            int u = ((k.ur * rs + k.ug * gs + k.ub * bs + 512) >> 10) + 128;
+            int v = ((k.vr * rs + k.vg * gs + k.vb * bs + 512) >> 10) + 128;
+            u = u > 255 ? 255 : u;
+            v = v > 255 ? 255 : v;
+
+            if (vRow) {
+                uRow[x / 2] = static_cast<uint8_t>(u);
+                vRow[x / 2] = static_cast<uint8_t>(v);
+            } else {
+                uRow[x] = static_cast<uint8_t>(u);
+                uRow[x + 1] = static_cast<uint8_t>(v);
+            }
+        }
+    }
+}
+
+template <int inputChannels, bool isBgrColor>
+void rgbToYuv420(const uint8_t* src, int srcStride,
+                 uint8_t* dstY, int dstYStride,
+                 uint8_t* dstU, int dstUStride,
+                 uint8_t* dstV, int dstVStride,
+                 int width, int height, ConvertFlag flag) {
+#if ENABLE_AVX2_IMP
+    if (canUseAVX2()) {
+        rgbToYuv420_avx2<inputChannels, isBgrColor>(src, srcStride, dstY, dstYStride, dstU, dstUStride, dstV, dstVStride, width, height, flag);
+        return;
+    }
+#endif
+
+#if ENABLE_NEON_IMP
+    if (canUseNEON()) {
+        rgbToYuv420_neon<inputChannels, isBgrColor>(src, srcStride, dstY, dstYStride, dstU, dstUStride, dstV, dstVStride, width, height, flag);
+        return;
+    }
+#endif
+
+    rgbToYuv420_common<inputChannels, isBgrColor>(src, srcStride, dstY, dstYStride, dstU, dstUStride, dstV, dstVStride, width, height, flag);
+}
+
+void bgra32ToNv12(const uint8_t* src, int srcStride, uint8_t* dstY, int dstYStride, uint8_t* dstUV, int dstUVStride, int width, int height, ConvertFlag flag) {
+    rgbToYuv420<4, true>(src, srcStride, dstY, dstYStride, dstUV, dstUVStride, nullptr, 0, width, height, flag);
+}
+
+void rgba32ToNv12(const uint8_t* src, int srcStride, uint8_t* dstY, int dstYStride, uint8_t* dstUV, int dstUVStride, int width, int height, ConvertFlag flag) {
+    rgbToYuv420<4, false>(src, srcStride, dstY, dstYStride, dstUV, dstUVStride, nullptr, 0, width, height, flag);
+}
+
+void bgr24ToNv12(const uint8_t* src, int srcStride, uint8_t* dstY, int dstYStride, uint8_t* dstUV, int dstUVStride, int width, int height, ConvertFlag flag) {
+    rgbToYuv420<3, true>(src, srcStride, dstY, dstYStride, dstUV, dstUVStride, nullptr, 0, width, height, flag);
+}
+
+void rgb24ToNv12(const uint8_t* src, int srcStride, uint8_t* dstY, int dstYStride, uint8_t* dstUV, int dstUVStride, int width, int height, ConvertFlag flag) {
+    rgbToYuv420<3, false>(src, srcStride, dstY, dstYStride, dstUV, dstUVStride, nullptr, 0, width, height, flag);
+}
+
+void bgra32ToI420(const uint8_t* src, int srcStride, uint8_t* dstY, int dstYStride, uint8_t* dstU, int dstUStride, uint8_t* dstV, int dstVStride, int width, int height, ConvertFlag flag) {
+    rgbToYuv420<4, true>(src, srcStride, dstY, dstYStride, dstU, dstUStride, dstV, dstVStride, width, height, flag);
+}
+
+void rgba32ToI420(const uint8_t* src, int srcStride, uint8_t* dstY, int dstYStride, uint8_t* dstU, int dstUStride, uint8_t* dstV, int dstVStride, int width, int height, ConvertFlag flag) {
+    rgbToYuv420<4, false>(src, srcStride, dstY, dstYStride, dstU, dstUStride, dstV, dstVStride, width, height, flag);
+}
+
+void bgr24ToI420(const uint8_t* src, int srcStride, uint8_t* dstY, int dstYStride, uint8_t* dstU, int dstUStride, uint8_t* dstV, int dstVStride, int width, int height, ConvertFlag flag) {
+    rgbToYuv420<3, true>(src, srcStride, dstY, dstYStride, dstU, dstUStride, dstV, dstVStride, width, height, flag);
+}
+
+void rgb24ToI420(const uint8_t* src, int srcStride, uint8_t* dstY, int dstYStride, uint8_t* dstU, int dstUStride, uint8_t* dstV, int dstVStride, int width, int height, ConvertFlag flag) {
+    rgbToYuv420<3, false>(src, srcStride, dstY, dstYStride, dstU, dstUStride, dstV, dstVStride, width, height, flag);
+}
+
 static thread_local std::shared_ptr<ccap::Allocator> sSharedAllocator, sSharedAllocator2;
 static std::mutex sAllocatorMutex;
 static std::vector<std::pair<std::weak_ptr<ccap::Allocator>, std::shared_ptr<ccap::Allocator>*>> sAllAllocators;
@@ -207,8 +207,8 @@ AVX2_TARGET void colorShuffle_avx2(const uint8_t* src, int srcStride, uint8_t* d
                 _mm_storeu_si128((__m128i*)(dstRow + x * outputChannels + 16), result_hi);
             } else if constexpr (outputChannels == 3 && inputChannels == 4) { // 4 -> 3
                 /// Split into 16 + 16, reading 32 bytes each time
-                __m128i pixels_lo = _mm_load_si128((__m128i*)(srcRow + x * inputChannels));
-                __m128i pixels_hi = _mm_load_si128((__m128i*)(srcRow + x * inputChannels + 16));
+                __m128i pixels_lo = _mm_loadu_si128((__m128i*)(srcRow + x * inputChannels)); // Unaligned: cropped rows start anywhere
+                __m128i pixels_hi = _mm_loadu_si128((__m128i*)(srcRow + x * inputChannels + 16));
 
                 __m128i result_lo = _mm_shuffle_epi8(pixels_lo, shuffle128); // Only the first 12 bytes are useful
                 __m128i result_hi = _mm_shuffle_epi8(pixels_hi, shuffle128); // Only the first 12 bytes are useful
@@ -1549,5 +1549,520 @@ void uyvyToRgba32_avx2(const uint8_t* src, int srcStride, uint8_t* dst, int dstS
     }
 }
 
+///////////// NV21/P010 row repacking and RGB565 /////////////
+
+AVX2_TARGET
+void swapUVRow_avx2(const uint8_t* src, uint8_t* dst, int byteCount) {
+    const __m256i swapMask = _mm256_setr_epi8(1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14,
+                                              1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14);
+    int i = 0;
+    for (; i + 32 <= byteCount; i += 32) {
+        __m256i vu = _mm256_loadu_si256((const __m256i*)(src + i));
+        _mm256_storeu_si256((__m256i*)(dst + i), _mm256_shuffle_epi8(vu, swapMask));
+    }
+
+    for (; i + 1 < byteCount; i += 2) {
+        uint8_t v = src[i];
+        dst[i] = src[i + 1];
+        dst[i + 1] = v;
+    }
+}
+
+AVX2_TARGET
+void p010ToU8Row_avx2(const uint8_t* src, uint8_t* dst, int count) {
+    const __m256i round = _mm256_set1_epi16(128);
+    int i = 0;
+    for (; i + 32 <= count; i += 32) {
+        __m256i lo = _mm256_loadu_si256((const __m256i*)(src + i * 2));
+        __m256i hi = _mm256_loadu_si256((const __m256i*)(src + i * 2 + 32));
+        // Saturating add, so 0xFFC0 + 128 stays 0xFFFF and maps to 255
+        lo = _mm256_srli_epi16(_mm256_adds_epu16(lo, round), 8);
+        hi = _mm256_srli_epi16(_mm256_adds_epu16(hi, round), 8);
+        // packus works per 128-bit lane, put the 64-bit blocks back in order
+        __m256i packed = _mm256_permute4x64_epi64(_mm256_packus_epi16(lo, hi), 0xD8);
+        _mm256_storeu_si256((__m256i*)(dst + i), packed);
+    }
+
+    for (; i < count; ++i) {
+        int v = src[i * 2] | (src[i * 2 + 1] << 8);
+        dst[i] = static_cast<uint8_t>(std::min((v + 128) >> 8, 255));
+    }
+}
+
+template <bool isBgrColor, bool hasAlpha>
+AVX2_TARGET void rgb565ToRgb_avx2_imp(const uint8_t* src, int srcStride, uint8_t* dst, int dstStride, int width, int height) {
+    // If height < 0, write dst in reverse order while reading src in normal order
+    if (height < 0) {
+        height = -height;
+        dst = dst + (height - 1) * dstStride;
+        dstStride = -dstStride;
+    }
+
+    constexpr int channels = hasAlpha ? 4 : 3;
+    const __m256i mask5 = _mm256_set1_epi16(0x1F);
+    const __m256i mask6 = _mm256_set1_epi16(0x3F);
+    const __m128i a8 = _mm_set1_epi8((char)255);
+    // Drop the 4th byte of each pixel, the last 4 bytes are zeroed
+    const __m128i dropAlpha = _mm_setr_epi8(0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1);
+
+    for (int y = 0; y < height; ++y) {
+        const uint8_t* srcRow = src + y * srcStride;
+        uint8_t* dstRow = dst + y * dstStride;
+        int x = 0;
+
+        for (; x + 16 <= width; x += 16) {
+            __m256i pixels = _mm256_loadu_si256((const __m256i*)(srcRow + x * 2));
+
+            // Expand 5/6-bit channels to 8 bits by replicating the high bits: (c << 3) | (c >> 2)
+            __m256i r5 = _mm256_srli_epi16(pixels, 11);
+            __m256i g6 = _mm256_and_si256(_mm256_srli_epi16(pixels, 5), mask6);
+            __m256i b5 = _mm256_and_si256(pixels, mask5);
+            __m256i r = _mm256_or_si256(_mm256_slli_epi16(r5, 3), _mm256_srli_epi16(r5, 2));
+            __m256i g = _mm256_or_si256(_mm256_slli_epi16(g6, 2), _mm256_srli_epi16(g6, 4));
+            __m256i b = _mm256_or_si256(_mm256_slli_epi16(b5, 3), _mm256_srli_epi16(b5, 2));
+
+            __m128i r8 = _mm_packus_epi16(_mm256_castsi256_si128(r), _mm256_extracti128_si256(r, 1));
+            __m128i g8 = _mm_packus_epi16(_mm256_castsi256_si128(g), _mm256_extracti128_si256(g, 1));
+            __m128i b8 = _mm_packus_epi16(_mm256_castsi256_si128(b), _mm256_extracti128_si256(b, 1));
+
+            __m128i c0 = isBgrColor ? b8 : r8;
+            __m128i c2 = isBgrColor ? r8 : b8;
+            __m128i c01lo = _mm_unpacklo_epi8(c0, g8);
+            __m128i c23lo = _mm_unpacklo_epi8(c2, a8);
+            __m128i c01hi = _mm_unpackhi_epi8(c0, g8);
+            __m128i c23hi = _mm_unpackhi_epi8(c2, a8);
+            __m128i p0 = _mm_unpacklo_epi16(c01lo, c23lo); // pixels 0 ~ 3
+            __m128i p1 = _mm_unpackhi_epi16(c01lo, c23lo); // pixels 4 ~ 7
+            __m128i p2 = _mm_unpacklo_epi16(c01hi, c23hi); // pixels 8 ~ 11
+            __m128i p3 = _mm_unpackhi_epi16(c01hi, c23hi); // pixels 12 ~ 15
+
+            if constexpr (hasAlpha) {
+                _mm_storeu_si128((__m128i*)(dstRow + x * 4), p0);
+                _mm_storeu_si128((__m128i*)(dstRow + x * 4 + 16), p1);
+                _mm_storeu_si128((__m128i*)(dstRow + x * 4 + 32), p2);
+                _mm_storeu_si128((__m128i*)(dstRow + x * 4 + 48), p3);
+            } else {
+                // 4 x 12 bytes -> 3 x 16 bytes
+                __m128i q0 = _mm_shuffle_epi8(p0, dropAlpha);
+                __m128i q1 = _mm_shuffle_epi8(p1, dropAlpha);
+                __m128i q2 = _mm_shuffle_epi8(p2, dropAlpha);
+                __m128i q3 = _mm_shuffle_epi8(p3, dropAlpha);
+                _mm_storeu_si128((__m128i*)(dstRow + x * 3), _mm_or_si128(q0, _mm_slli_si128(q1, 12)));
+                _mm_storeu_si128((__m128i*)(dstRow + x * 3 + 16), _mm_or_si128(_mm_srli_si128(q1, 4), _mm_slli_si128(q2, 8)));
+                _mm_storeu_si128((__m128i*)(dstRow + x * 3 + 32), _mm_or_si128(_mm_srli_si128(q2, 8), _mm_slli_si128(q3, 4)));
+            }
+        }
+
+        for (; x < width; ++x) {
+            int v = srcRow[x * 2] | (srcRow[x * 2 + 1] << 8);
+            int r5 = v >> 11, g6 = (v >> 5) & 0x3F, b5 = v & 0x1F;
+            uint8_t* pixel = dstRow + x * channels;
+            pixel[isBgrColor ? 2 : 0] = static_cast<uint8_t>((r5 << 3) | (r5 >> 2));
+            pixel[1] = static_cast<uint8_t>((g6 << 2) | (g6 >> 4));
+            pixel[isBgrColor ? 0 : 2] = static_cast<uint8_t>((b5 << 3) | (b5 >> 2));
+            if constexpr (hasAlpha) {
+                pixel[3] = 255;
+            }
+        }
+    }
+}
+
+AVX2_TARGET
+void rgb565ToBgr24_avx2(const uint8_t* src, int srcStride, uint8_t* dst, int dstStride, int width, int height) {
+    rgb565ToRgb_avx2_imp<true, false>(src, srcStride, dst, dstStride, width, height);
+}
+
+AVX2_TARGET
+void rgb565ToRgb24_avx2(const uint8_t* src, int srcStride, uint8_t* dst, int dstStride, int width, int height) {
+    rgb565ToRgb_avx2_imp<false, false>(src, srcStride, dst, dstStride, width, height);
+}
+
+AVX2_TARGET
+void rgb565ToBgra32_avx2(const uint8_t* src, int srcStride, uint8_t* dst, int dstStride, int width, int height) {
+    rgb565ToRgb_avx2_imp<true, true>(src, srcStride, dst, dstStride, width, height);
+}
+
+AVX2_TARGET
+void rgb565ToRgba32_avx2(const uint8_t* src, int srcStride, uint8_t* dst, int dstStride, int width, int height) {
+    rgb565ToRgb_avx2_imp<false, true>(src, srcStride, dst, dstStride, width, height);
+}
+
+///////////// RGB to YUV /////////////
+
+// Load 8 pixels as 4 bytes each (lane0: pixel 0~3, lane1: pixel 4~7), 24-bit input reads exactly 24 bytes.
+template <int inputChannels>
+AVX2_TARGET inline __m256i loadPixels8_avx2(const uint8_t* src) {
+    if constexpr (inputChannels == 4) {
+        return _mm256_loadu_si256((const __m256i*)src);
+    } else {
+        const __m128i shuffleLo = _mm_setr_epi8(0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1);
+        const __m128i shuffleHi = _mm_setr_epi8(4, 5, 6, -1, 7, 8, 9, -1, 10, 11, 12, -1, 13, 14, 15, -1);
+        __m128i lo = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)src), shuffleLo);
+        __m128i hi = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(src + 8)), shuffleHi);
+        return _mm256_inserti128_si256(_mm256_castsi128_si256(lo), hi, 1);
+    }
+}
+
+// 8 + 8 int32 -> 16 uint8 with saturation, order preserved.
+AVX2_TARGET inline __m128i packInt32x16_avx2(__m256i a, __m256i b) {
+    __m256i packed = _mm256_permute4x64_epi64(_mm256_packs_epi32(a, b), 0xD8);
+    return _mm_packus_epi16(_mm256_castsi256_si128(packed), _mm256_extracti128_si256(packed, 1));
+}
+
+// Y of 8 pixels as int32, `lo`/`hi` are the 16-bit unpacked pixels.
+AVX2_TARGET inline __m256i rgbToY_avx2(__m256i lo, __m256i hi, __m256i kY, __m256i yBias) {
+    __m256i sum = _mm256_hadd_epi32(_mm256_madd_epi16(lo, kY), _mm256_madd_epi16(hi, kY));
+    return _mm256_srai_epi32(_mm256_add_epi32(sum, yBias), 8);
+}
+
+template <int inputChannels, bool isBgrColor>
+AVX2_TARGET void rgbToYuv420_avx2(const uint8_t* src, int srcStride, uint8_t* dstY, int dstYStride, uint8_t* dstU, int dstUStride,
+                                  uint8_t* dstV, int dstVStride, int width, int height, ConvertFlag flag) {
+    // If height < 0, read src in reverse order while writing dst sequentially
+    if (height < 0) {
+        height = -height;
+        src = src + (height - 1) * srcStride;
+        srcStride = -srcStride;
+    }
+
+    const auto k = getRgbToYuvCoefficients(flag);
+    constexpr int rIndex = isBgrColor ? 2 : 0;
+    constexpr int bIndex = isBgrColor ? 0 : 2;
+    const int c0 = isBgrColor ? k.yb : k.yr, c2 = isBgrColor ? k.yr : k.yb;
+    const int u0 = isBgrColor ? k.ub : k.ur, u2 = isBgrColor ? k.ur : k.ub;
+    const int v0 = isBgrColor ? k.vb : k.vr, v2 = isBgrColor ? k.vr : k.vb;
+
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i kY = _mm256_setr_epi16(c0, k.yg, c2, 0, c0, k.yg, c2, 0, c0, k.yg, c2, 0, c0, k.yg, c2, 0);
+    const __m256i kUV = _mm256_setr_epi16(u0, k.ug, u2, 0, v0, k.vg, v2, 0, u0, k.ug, u2, 0, v0, k.vg, v2, 0);
+    const __m256i yBias = _mm256_set1_epi32(128 + (k.yOffset << 8));
+    const __m256i uvBias = _mm256_set1_epi32(512 + (128 << 10));
+    const __m128i splitUV = _mm_setr_epi8(0, 2, 4, 6, 8, 10, 12, 14, 1, 3, 5, 7, 9, 11, 13, 15);
+
+    for (int y = 0; y < height; y += 2) {
+        // The last row of an odd height is paired with itself, its Y row is simply written twice.
+        bool hasRow1 = y + 1 < height;
+        const uint8_t* srcRow0 = src + y * srcStride;
+        const uint8_t* srcRow1 = hasRow1 ? srcRow0 + srcStride : srcRow0;
+        uint8_t* yRow0 = dstY + y * dstYStride;
+        uint8_t* yRow1 = hasRow1 ? yRow0 + dstYStride : yRow0;
+        uint8_t* uRow = dstU + (y / 2) * dstUStride;
+        uint8_t* vRow = dstV ? dstV + (y / 2) * dstVStride : nullptr;
+
+        int x = 0;
+        for (; x + 16 <= width; x += 16) {
+            __m256i y0[2], y1[2], uv[2];
+            for (int i = 0; i < 2; ++i) {
+                __m256i p0 = loadPixels8_avx2<inputChannels>(srcRow0 + (x + i * 8) * inputChannels);
+                __m256i p1 = loadPixels8_avx2<inputChannels>(srcRow1 + (x + i * 8) * inputChannels);
+                __m256i lo0 = _mm256_unpacklo_epi8(p0, zero), hi0 = _mm256_unpackhi_epi8(p0, zero);
+                __m256i lo1 = _mm256_unpacklo_epi8(p1, zero), hi1 = _mm256_unpackhi_epi8(p1, zero);
+                y0[i] = rgbToY_avx2(lo0, hi0, kY, yBias);
+                y1[i] = rgbToY_avx2(lo1, hi1, kY, yBias);
+
+                // Each 128-bit half of lo/hi holds two horizontal neighbours, sum them into a 2x2 block sum.
+                __m256i lo = _mm256_add_epi16(lo0, lo1), hi = _mm256_add_epi16(hi0, hi1);
+                lo = _mm256_add_epi16(lo, _mm256_shuffle_epi32(lo, 0x4E));
+                hi = _mm256_add_epi16(hi, _mm256_shuffle_epi32(hi, 0x4E));
+                // U0 V0 U1 V1 | U2 V2 U3 V3
+                __m256i sum = _mm256_hadd_epi32(_mm256_madd_epi16(lo, kUV), _mm256_madd_epi16(hi, kUV));
+                uv[i] = _mm256_srai_epi32(_mm256_add_epi32(sum, uvBias), 10);
+            }
+
+            _mm_storeu_si128((__m128i*)(yRow0 + x), packInt32x16_avx2(y0[0], y0[1]));
+            _mm_storeu_si128((__m128i*)(yRow1 + x), packInt32x16_avx2(y1[0], y1[1]));
+
+            __m128i uvBytes = packInt32x16_avx2(uv[0], uv[1]);
+            if (vRow) {
+                uvBytes = _mm_shuffle_epi8(uvBytes, splitUV);
+                _mm_storel_epi64((__m128i*)(uRow + x / 2), uvBytes);
+                _mm_storel_epi64((__m128i*)(vRow + x / 2), _mm_srli_si128(uvBytes, 8));
+            } else {
+                _mm_storeu_si128((__m128i*)(uRow + x), uvBytes);
+            }
+        }
+
+        for (; x < width; x += 2) {
+            int x1 = x + 1 < width ? x + 1 : x;
+            const uint8_t* p[4] = { srcRow0 + x * inputChannels, srcRow0 + x1 * inputChannels,
+                                    srcRow1 + x * inputChannels, srcRow1 + x1 * inputChannels };
+            uint8_t* yOut[4] = { yRow0 + x, yRow0 + x1, yRow1 + x, yRow1 + x1 };
+
+            int rs = 0, gs = 0, bs = 0;
+            for (int i = 0; i < 4; ++i) {
+                int r = p[i][rIndex], g = p[i][1], b = p[i][bIndex];
+                *yOut[i] = static_cast<uint8_t>(((k.yr * r + k.yg * g + k.yb * b + 128) >> 8) + k.yOffset);
+                rs += r;
+                gs += g;
+                bs += b;
+            }
+
+            int u = ((k.ur * rs + k.ug * gs + k.ub * bs + 512) >> 10) + 128;
+            int v = ((k.vr * rs + k.vg * gs + k.vb * bs + 512) >> 10) + 128;
+            u = u > 255 ? 255 : u;
+            v = v > 255 ? 255 : v;
+
+            if (vRow) {
+                uRow[x / 2] = static_cast<uint8_t>(u);
+                vRow[x / 2] = static_cast<uint8_t>(v);
+            } else {
+                uRow[x] = static_cast<uint8_t>(u);
+                uRow[x + 1] = static_cast<uint8_t>(v);
+            }
+        }
+    }
+}
+
+template void rgbToYuv420_avx2<4, true>(const uint8_t* src, int srcStride, uint8_t* dstY, int dstYStride, uint8_t* dstU, int dstUStride,
+                                        uint8_t* dstV, int dstVStride, int width, int height, ConvertFlag flag);
+
+template void rgbToYuv420_avx2<4, false>(const uint8_t* src, int srcStride, uint8_t* dstY, int dstYStride, uint8_t* dstU, int dstUStride,
+                                         uint8_t* dstV, int dstVStride, int width, int height, ConvertFlag flag);
+
+template void rgbToYuv420_avx2<3, true>(const uint8_t* src, int srcStride, uint8_t* dstY, int dstYStride, uint8_t* dstU, int dstUStride,
+                                        uint8_t* dstV, int dstVStride, int width, int height, ConvertFlag flag);
+
+template void rgbToYuv420_avx2<3, false>(const uint8_t* src, int srcStride, uint8_t* dstY, int dstYStride, uint8_t* dstU, int dstUStride,
+                                         uint8_t* dstV, int dstVStride, int width, int height, ConvertFlag flag);
+
+
+///////////// JPEG IDCT /////////////
+
+AVX2_TARGET inline __m256i mulConst_avx2(__m256i a, int32_t k) { return _mm256_mullo_epi32(a, _mm256_set1_epi32(k)); }
+
+// 1-D islow IDCT on 8 columns at once, v[i] holds row i. The results are not descaled. Same arithmetic as `idct8x8`.
+AVX2_TARGET inline void idct1D_avx2(__m256i* v) {
+    // Even part
+    __m256i z1 = mulConst_avx2(_mm256_add_epi32(v[2], v[6]), 4433);
+    __m256i tmp2 = _mm256_add_epi32(z1, mulConst_avx2(v[6], -15137));
+    __m256i tmp3 = _mm256_add_epi32(z1, mulConst_avx2(v[2], 6270));
+    __m256i tmp0 = _mm256_slli_epi32(_mm256_add_epi32(v[0], v[4]), 13);
+    __m256i tmp1 = _mm256_slli_epi32(_mm256_sub_epi32(v[0], v[4]), 13);
+    __m256i tmp10 = _mm256_add_epi32(tmp0, tmp3), tmp13 = _mm256_sub_epi32(tmp0, tmp3);
+    __m256i tmp11 = _mm256_add_epi32(tmp1, tmp2), tmp12 = _mm256_sub_epi32(tmp1, tmp2);
+
+    // Odd part
+    tmp0 = v[7];
+    tmp1 = v[5];
+    tmp2 = v[3];
+    tmp3 = v[1];
+    z1 = _mm256_add_epi32(tmp0, tmp3);
+    __m256i z2 = _mm256_add_epi32(tmp1, tmp2);
+    __m256i z3 = _mm256_add_epi32(tmp0, tmp2);
+    __m256i z4 = _mm256_add_epi32(tmp1, tmp3);
+    __m256i z5 = mulConst_avx2(_mm256_add_epi32(z3, z4), 9633);
+    tmp0 = mulConst_avx2(tmp0, 2446);
+    tmp1 = mulConst_avx2(tmp1, 16819);
+    tmp2 = mulConst_avx2(tmp2, 25172);
+    tmp3 = mulConst_avx2(tmp3, 12299);
+    z1 = mulConst_avx2(z1, -7373);
+    z2 = mulConst_avx2(z2, -20995);
+    z3 = _mm256_add_epi32(mulConst_avx2(z3, -16069), z5);
+    z4 = _mm256_add_epi32(mulConst_avx2(z4, -3196), z5);
+    tmp0 = _mm256_add_epi32(tmp0, _mm256_add_epi32(z1, z3));
+    tmp1 = _mm256_add_epi32(tmp1, _mm256_add_epi32(z2, z4));
+    tmp2 = _mm256_add_epi32(tmp2, _mm256_add_epi32(z2, z3));
+    tmp3 = _mm256_add_epi32(tmp3, _mm256_add_epi32(z1, z4));
+
+    v[0] = _mm256_add_epi32(tmp10, tmp3);
+    v[7] = _mm256_sub_epi32(tmp10, tmp3);
+    v[1] = _mm256_add_epi32(tmp11, tmp2);
+    v[6] = _mm256_sub_epi32(tmp11, tmp2);
+    v[2] = _mm256_add_epi32(tmp12, tmp1);
+    v[5] = _mm256_sub_epi32(tmp12, tmp1);
+    v[3] = _mm256_add_epi32(tmp13, tmp0);
+    v[4] = _mm256_sub_epi32(tmp13, tmp0);
+}
+
+AVX2_TARGET inline void transpose8x8Int32_avx2(__m256i* v) {
+    __m256i t0 = _mm256_unpacklo_epi32(v[0], v[1]), t1 = _mm256_unpackhi_epi32(v[0], v[1]);
+    __m256i t2 = _mm256_unpacklo_epi32(v[2], v[3]), t3 = _mm256_unpackhi_epi32(v[2], v[3]);
+    __m256i t4 = _mm256_unpacklo_epi32(v[4], v[5]), t5 = _mm256_unpackhi_epi32(v[4], v[5]);
+    __m256i t6 = _mm256_unpacklo_epi32(v[6], v[7]), t7 = _mm256_unpackhi_epi32(v[6], v[7]);
+    __m256i u0 = _mm256_unpacklo_epi64(t0, t2), u1 = _mm256_unpackhi_epi64(t0, t2);
+    __m256i u2 = _mm256_unpacklo_epi64(t1, t3), u3 = _mm256_unpackhi_epi64(t1, t3);
+    __m256i u4 = _mm256_unpacklo_epi64(t4, t6), u5 = _mm256_unpackhi_epi64(t4, t6);
+    __m256i u6 = _mm256_unpacklo_epi64(t5, t7), u7 = _mm256_unpackhi_epi64(t5, t7);
+    v[0] = _mm256_permute2x128_si256(u0, u4, 0x20);
+    v[1] = _mm256_permute2x128_si256(u1, u5, 0x20);
+    v[2] = _mm256_permute2x128_si256(u2, u6, 0x20);
+    v[3] = _mm256_permute2x128_si256(u3, u7, 0x20);
+    v[4] = _mm256_permute2x128_si256(u0, u4, 0x31);
+    v[5] = _mm256_permute2x128_si256(u1, u5, 0x31);
+    v[6] = _mm256_permute2x128_si256(u2, u6, 0x31);
+    v[7] = _mm256_permute2x128_si256(u3, u7, 0x31);
+}
+
+AVX2_TARGET
+void idct8x8_avx2(const int16_t* coefficients, uint8_t* dst, int dstStride) {
+    __m256i v[8];
+    for (int i = 0; i < 8; ++i) {
+        v[i] = _mm256_cvtepi16_epi32(_mm_loadu_si128((const __m128i*)(coefficients + i * 8)));
+    }
+
+    // Pass 1: columns, descale by CONST_BITS - PASS1_BITS
+    idct1D_avx2(v);
+    const __m256i bias1 = _mm256_set1_epi32(1 << 10);
+    for (int i = 0; i < 8; ++i) {
+        v[i] = _mm256_srai_epi32(_mm256_add_epi32(v[i], bias1), 11);
+    }
+
+    // Pass 2: rows, descale by CONST_BITS + PASS1_BITS + 3 and shift the level
+    transpose8x8Int32_avx2(v);
+    idct1D_avx2(v);
+    const __m256i bias2 = _mm256_set1_epi32(1 << 17);
+    const __m256i level = _mm256_set1_epi32(128);
+    for (int i = 0; i < 8; ++i) {
+        v[i] = _mm256_add_epi32(_mm256_srai_epi32(_mm256_add_epi32(v[i], bias2), 18), level);
+    }
+    transpose8x8Int32_avx2(v);
+
+    const __m256i order = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+    for (int i = 0; i < 8; i += 4) {
+        __m256i rows = _mm256_packus_epi16(_mm256_packs_epi32(v[i], v[i + 1]), _mm256_packs_epi32(v[i + 2], v[i + 3]));
+        rows = _mm256_permutevar8x32_epi32(rows, order);
+        __m128i lo = _mm256_castsi256_si128(rows), hi = _mm256_extracti128_si256(rows, 1);
+        uint8_t* row = dst + i * dstStride;
+        _mm_storel_epi64((__m128i*)row, lo);
+        _mm_storel_epi64((__m128i*)(row + dstStride), _mm_unpackhi_epi64(lo, lo));
+        _mm_storel_epi64((__m128i*)(row + 2 * dstStride), hi);
+        _mm_storel_epi64((__m128i*)(row + 3 * dstStride), _mm_unpackhi_epi64(hi, hi));
+    }
+}
+
+///////////// Luma motion detection /////////////
+
+template <int blockSize, bool isDiff>
+AVX2_TARGET void lumaBlockAverageRow_avx2_imp(const uint8_t* src, int srcStride, const uint8_t* ref, int refStride, uint8_t* dst, int dstWidth) {
+    constexpr int outputsPerVector = 32 / blockSize;
+    constexpr int shift = blockSize == 1 ? 0 : (blockSize == 2 ? 2 : (blockSize == 4 ? 4 : 6)); // log2(blockSize * blockSize)
+    const __m256i ones8 = _mm256_set1_epi8(1);
+    const __m256i ones16 = _mm256_set1_epi16(1);
+    const __m256i zero = _mm256_setzero_si256();
+
+    int x = 0;
+    for (; x + outputsPerVector <= dstWidth; x += outputsPerVector) {
+        const int offset = x * blockSize;
+        __m256i sum = zero;
+        for (int row = 0; row < blockSize; ++row) {
+            __m256i v = _mm256_loadu_si256((const __m256i*)(src + row * srcStride + offset));
+            if constexpr (isDiff) {
+                __m256i w = _mm256_loadu_si256((const __m256i*)(ref + row * refStride + offset));
+                v = _mm256_or_si256(_mm256_subs_epu8(v, w), _mm256_subs_epu8(w, v));
+            }
+
+            // Horizontal sums of blockSize pixels, in order: pairs (16-bit), quads (32-bit), or 8 pixels (64-bit)
+            if constexpr (blockSize == 1) {
+                sum = v;
+            } else if constexpr (blockSize == 2) {
+                sum = _mm256_add_epi16(sum, _mm256_maddubs_epi16(v, ones8));
+            } else if constexpr (blockSize == 4) {
+                sum = _mm256_add_epi32(sum, _mm256_madd_epi16(_mm256_maddubs_epi16(v, ones8), ones16));
+            } else {
+                sum = _mm256_add_epi64(sum, _mm256_sad_epu8(v, zero));
+            }
+        }
+
+        if constexpr (blockSize == 1) {
+            _mm256_storeu_si256((__m256i*)(dst + x), sum);
+        } else if constexpr (blockSize == 2) {
+            sum = _mm256_srli_epi16(_mm256_add_epi16(sum, _mm256_set1_epi16(2)), shift);
+            // packus works per 128-bit lane, take the first 64-bit block of each lane
+            __m256i packed = _mm256_permute4x64_epi64(_mm256_packus_epi16(sum, sum), 0x08);
+            _mm_storeu_si128((__m128i*)(dst + x), _mm256_castsi256_si128(packed));
+        } else if constexpr (blockSize == 4) {
+            sum = _mm256_srli_epi32(_mm256_add_epi32(sum, _mm256_set1_epi32(8)), shift);
+            __m256i packed = _mm256_packus_epi16(_mm256_packs_epi32(sum, sum), zero);
+            packed = _mm256_permutevar8x32_epi32(packed, _mm256_setr_epi32(0, 4, 0, 0, 0, 0, 0, 0));
+            _mm_storel_epi64((__m128i*)(dst + x), _mm256_castsi256_si128(packed));
+        } else {
+            sum = _mm256_srli_epi64(_mm256_add_epi64(sum, _mm256_set1_epi64x(32)), shift);
+            __m128i sums = _mm256_castsi256_si128(_mm256_permutevar8x32_epi32(sum, _mm256_setr_epi32(0, 2, 4, 6, 0, 0, 0, 0)));
+            sums = _mm_packus_epi16(_mm_packus_epi32(sums, sums), sums);
+            uint32_t packed = static_cast<uint32_t>(_mm_cvtsi128_si32(sums));
+            std::memcpy(dst + x, &packed, sizeof(packed));
+        }
+    }
+
+    for (; x < dstWidth; ++x) {
+        uint32_t sum = 0;
+        for (int row = 0; row < blockSize; ++row) {
+            const uint8_t* s = src + row * srcStride + x * blockSize;
+            for (int i = 0; i < blockSize; ++i) {
+                if constexpr (isDiff) {
+                    const uint8_t* r = ref + row * refStride + x * blockSize;
+                    sum += s[i] > r[i] ? s[i] - r[i] : r[i] - s[i];
+                } else {
+                    sum += s[i];
+                }
+            }
+        }
+        dst[x] = static_cast<uint8_t>((sum + (blockSize * blockSize / 2)) >> shift);
+    }
+}
+
+template <bool isDiff>
+AVX2_TARGET void lumaBlockAverageRow_avx2_dispatch(const uint8_t* src, int srcStride, const uint8_t* ref, int refStride, uint8_t* dst, int dstWidth,
+                                                   int blockSize) {
+    switch (blockSize) {
+    case 1:
+        lumaBlockAverageRow_avx2_imp<1, isDiff>(src, srcStride, ref, refStride, dst, dstWidth);
+        break;
+    case 2:
+        lumaBlockAverageRow_avx2_imp<2, isDiff>(src, srcStride, ref, refStride, dst, dstWidth);
+        break;
+    case 4:
+        lumaBlockAverageRow_avx2_imp<4, isDiff>(src, srcStride, ref, refStride, dst, dstWidth);
+        break;
+    default:
+        assert(blockSize == 8);
+        lumaBlockAverageRow_avx2_imp<8, isDiff>(src, srcStride, ref, refStride, dst, dstWidth);
+        break;
+    }
+}
+
+AVX2_TARGET
+void lumaBlockAverageRow_avx2(const uint8_t* src, int srcStride, const uint8_t* ref, int refStride, uint8_t* dst, int dstWidth, int blockSize) {
+    if (ref) {
+        lumaBlockAverageRow_avx2_dispatch<true>(src, srcStride, ref, refStride, dst, dstWidth, blockSize);
+    } else {
+        lumaBlockAverageRow_avx2_dispatch<false>(src, srcStride, ref, refStride, dst, dstWidth, blockSize);
+    }
+}
+
+AVX2_TARGET
+uint32_t motionMaskRow_avx2(const uint8_t* diff, uint8_t* mask, int width, uint8_t threshold) {
+    if (threshold == 255) { // Nothing is above, and threshold + 1 would wrap
+        if (mask) std::memset(mask, 0, width);
+        return 0;
+    }
+
+    // Unsigned diff > threshold  <=>  max(diff, threshold + 1) == diff
+    const __m256i limit = _mm256_set1_epi8(static_cast<char>(threshold + 1));
+    const __m256i ones = _mm256_set1_epi8(1);
+    const __m256i zero = _mm256_setzero_si256();
+    __m256i counts = zero;
+
+    int x = 0;
+    for (; x + 32 <= width; x += 32) {
+        __m256i d = _mm256_loadu_si256((const __m256i*)(diff + x));
+        __m256i moving = _mm256_cmpeq_epi8(_mm256_max_epu8(d, limit), d);
+        if (mask) {
+            _mm256_storeu_si256((__m256i*)(mask + x), moving);
+        }
+        counts = _mm256_add_epi64(counts, _mm256_sad_epu8(_mm256_and_si256(moving, ones), zero));
+    }
+
+    __m128i counts128 = _mm_add_epi64(_mm256_castsi256_si128(counts), _mm256_extracti128_si256(counts, 1));
+    uint32_t count = static_cast<uint32_t>(_mm_cvtsi128_si32(counts128) + _mm_extract_epi32(counts128, 2));
+
+    for (; x < width; ++x) {
+        const bool moving = diff[x] > threshold;
+        if (mask) mask[x] = moving ? 255 : 0;
+        count += moving;
+    }
+    return count;
+}
+
 #endif // ENABLE_AVX2_IMP
 } // namespace ccap
@@ -0,0 +1,491 @@
+/**
+ * @file ccap_convert_avx512.cpp
+ * @author wysaid (this@wysaid.org)
+ * @date 2025-10
+ *
+ */
+
+#include "ccap_convert_avx512.h"
+
+#include <cassert>
+#include <cstring>
+
+#if ENABLE_AVX512_IMP
+
+// Only the kernels get the AVX-512 target, so the rest of this file (CPU detection) stays safe to run on any x86-64 CPU.
+#if defined(__GNUC__) || defined(__clang__)
+#define AVX512_TARGET __attribute__((target("avx512f,avx512bw,avx512vl,avx512vbmi")))
+#else
+#define AVX512_TARGET
+#endif
+
+#include <immintrin.h> // AVX-512
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+inline bool hasAVX512_() {
+    int cpuInfo[4];
+    __cpuid(cpuInfo, 0);
+    if (cpuInfo[0] < 7) return false;
+    __cpuid(cpuInfo, 1);
+    if ((cpuInfo[2] & (1 << 27)) == 0) return false; // OSXSAVE
+    // Check XGETBV to confirm OS saves XMM, YMM, opmask and both ZMM halves
+    unsigned long long xcrFeatureMask = _xgetbv(0);
+    if ((xcrFeatureMask & 0xE6) != 0xE6) return false;
+    __cpuidex(cpuInfo, 7, 0);
+    bool f = (cpuInfo[1] & (1 << 16)) != 0;
+    bool bw = (cpuInfo[1] & (1 << 30)) != 0;
+    bool vl = (cpuInfo[1] & (1u << 31)) != 0;
+    bool vbmi = (cpuInfo[2] & (1 << 1)) != 0;
+    return f && bw && vl && vbmi;
+}
+#elif defined(__GNUC__) || defined(__clang__)
+#include <cpuid.h>
+inline bool hasAVX512_() {
+    unsigned int eax, ebx, ecx, edx;
+
+    // 1. Check basic CPUID support, need function 7
+    if (!__get_cpuid(0, &eax, &ebx, &ecx, &edx)) return false;
+    if (eax < 7) return false;
+
+    // 2. Check OSXSAVE
+    if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx)) return false;
+    if ((ecx & (1 << 27)) == 0) return false;
+
+    // 3. Check XGETBV to confirm OS saves XMM, YMM, opmask and both ZMM halves
+    unsigned int xcr0_lo = 0, xcr0_hi = 0;
+    asm volatile("xgetbv"
+                 : "=a"(xcr0_lo), "=d"(xcr0_hi)
+                 : "c"(0));
+    if ((xcr0_lo & 0xE6) != 0xE6) return false;
+
+    // 4. Check AVX512F, AVX512BW, AVX512VL and AVX512VBMI
+    if (!__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx)) return false;
+    bool f = (ebx & (1u << 16)) != 0;
+    bool bw = (ebx & (1u << 30)) != 0;
+    bool vl = (ebx & (1u << 31)) != 0;
+    bool vbmi = (ecx & (1u << 1)) != 0;
+    return f && bw && vl && vbmi;
+}
+#else
+inline bool hasAVX512_() { return false; }
+#endif
+
+#endif
+
+namespace ccap {
+bool sEnableAVX512 = true;
+
+bool enableAVX512(bool enable) {
+    sEnableAVX512 = enable;
+    return hasAVX512() && sEnableAVX512;
+}
+
+bool hasAVX512() {
+#if ENABLE_AVX512_IMP
+    static bool s_hasAVX512 = hasAVX512_();
+    return s_hasAVX512;
+#else
+    return false;
+#endif
+}
+
+bool canUseAVX512() {
+    return hasAVX512() && sEnableAVX512;
+}
+
+const char* getAVX512SupportInfo() {
+#if ENABLE_AVX512_IMP
+    if (hasAVX512()) {
+        return sEnableAVX512 ? "AVX-512: Hardware supported and enabled" : "AVX-512: Hardware supported but disabled by software";
+    }
+    return "AVX-512: Not supported by hardware or OS (needs F/BW/VL/VBMI)";
+#else
+    return "AVX-512: Disabled at compile time";
+#endif
+}
+
+#if ENABLE_AVX512_IMP
+
+namespace {
+
+/// Byte index table for `vpermb` / `vpermt2b`
+struct ByteTable {
+    alignas(64) uint8_t v[64];
+};
+
+template <typename Fn>
+constexpr ByteTable makeByteTable(Fn fn) {
+    ByteTable table{};
+    for (int i = 0; i < 64; ++i) table.v[i] = static_cast<uint8_t>(fn(i));
+    return table;
+}
+
+// Chroma up-sampling, one U/V sample for two pixels
+constexpr ByteTable kNV12U = makeByteTable([](int i) { return i & ~1; });
+constexpr ByteTable kNV12V = makeByteTable([](int i) { return (i | 1) & 31; });
+constexpr ByteTable kI420UV = makeByteTable([](int i) { return (i >> 1) & 15; });
+
+// Packed 4:2:2, 32 pixels are 64 bytes
+constexpr ByteTable kYUYV_Y = makeByteTable([](int i) { return (i * 2) & 63; });
+constexpr ByteTable kYUYV_U = makeByteTable([](int i) { return ((i >> 1) * 4 + 1) & 63; });
+constexpr ByteTable kYUYV_V = makeByteTable([](int i) { return ((i >> 1) * 4 + 3) & 63; });
+constexpr ByteTable kUYVY_Y = makeByteTable([](int i) { return (i * 2 + 1) & 63; });
+constexpr ByteTable kUYVY_U = makeByteTable([](int i) { return ((i >> 1) * 4) & 63; });
+constexpr ByteTable kUYVY_V = makeByteTable([](int i) { return ((i >> 1) * 4 + 2) & 63; });
+
+/// Interleave 32 pixels of planar c0..c3 into 4 channels.
+/// The sources are laid out as a = (c0 | c2), b = (c1 | c3), so index < 64 picks from a, otherwise from b.
+constexpr int interleave4(int outByte) {
+    int pixel = outByte / 4, channel = outByte % 4;
+    constexpr int base[4] = { 0, 64, 32, 96 };
+    return base[channel] + pixel;
+}
+
+constexpr ByteTable kInterleave4Lo = makeByteTable([](int i) { return interleave4(i); });
+constexpr ByteTable kInterleave4Hi = makeByteTable([](int i) { return interleave4(i + 64); });
+
+/// Interleave 32 pixels of planar c0..c2 into 3 channels (96 bytes), with a = (c0 | c2), b = c1.
+constexpr int interleave3(int outByte) {
+    int pixel = outByte / 3, channel = outByte % 3;
+    if (pixel >= 32) return 0;
+    constexpr int base[3] = { 0, 64, 32 };
+    return base[channel] + pixel;
+}
+
+constexpr ByteTable kInterleave3Lo = makeByteTable([](int i) { return interleave3(i); });
+constexpr ByteTable kInterleave3Hi = makeByteTable([](int i) { return interleave3(i + 64); });
+
+inline __mmask64 byteMask64(int count) {
+    return count >= 64 ? ~0ull : (count <= 0 ? 0ull : ((1ull << count) - 1));
+}
+
+inline __mmask32 byteMask32(int count) {
+    return count >= 32 ? ~0u : (count <= 0 ? 0u : ((1u << count) - 1));
+}
+
+inline __mmask16 byteMask16(int count) {
+    return static_cast<__mmask16>(count >= 16 ? 0xFFFF : (count <= 0 ? 0 : ((1u << count) - 1)));
+}
+
+AVX512_TARGET inline __m512i loadTable(const ByteTable& table) {
+    return _mm512_load_si512((const void*)table.v);
+}
+
+inline void getYuvToRgbCoefficients(bool isBT601, bool isFullRange, int& cy, int& cr, int& cgu, int& cgv, int& cb) {
+    if (isBT601) {
+        if (isFullRange) { // BT.601 Full Range: 256, 351, 86, 179, 443 (divided by 4)
+            cy = 64;
+            cr = 88;
+            cgu = 22;
+            cgv = 45;
+            cb = 111;
+        } else { // BT.601 Video Range: 298, 409, 100, 208, 516 (divided by 4)
+            cy = 75;
+            cr = 102;
+            cgu = 25;
+            cgv = 52;
+            cb = 129;
+        }
+    } else {
+        if (isFullRange) { // BT.709 Full Range: 256, 403, 48, 120, 475 (divided by 4)
+            cy = 64;
+            cr = 101;
+            cgu = 12;
+            cgv = 30;
+            cb = 119;
+        } else { // BT.709 Video Range: 298, 459, 55, 136, 541 (divided by 4)
+            cy = 75;
+            cr = 115;
+            cgu = 14;
+            cgv = 34;
+            cb = 135;
+        }
+    }
+}
+
+enum class YuvLayout {
+    NV12,
+    I420,
+    YUYV,
+    UYVY,
+};
+
+/// YUV -> RGB for all layouts, 32 pixels per iteration.
+/// The last (partial) block of each row uses masked loads and stores, so nothing is read or written past the row.
+template <YuvLayout layout, bool isBGR, bool hasAlpha, bool isFullRange>
+AVX512_TARGET void yuvToRgb_avx512_imp(const uint8_t* src0, int stride0, const uint8_t* src1, int stride1, const uint8_t* src2, int stride2,
+                                       uint8_t* dst, int dstStride, int width, int height, bool is601) {
+    if (height < 0) {
+        height = -height;
+        dst = dst + (height - 1) * dstStride;
+        dstStride = -dstStride;
+    }
+
+    int cy, cr, cgu, cgv, cb;
+    getYuvToRgbCoefficients(is601, isFullRange, cy, cr, cgu, cgv, cb);
+
+    const __m512i c_y = _mm512_set1_epi16(cy);
+    const __m512i c_r = _mm512_set1_epi16(cr);
+    const __m512i c_gu = _mm512_set1_epi16(cgu);
+    const __m512i c_gv = _mm512_set1_epi16(cgv);
+    const __m512i c_b = _mm512_set1_epi16(cb);
+    const __m512i c16 = _mm512_set1_epi16(16);
+    const __m512i c32 = _mm512_set1_epi16(32);
+    const __m512i c128 = _mm512_set1_epi16(128);
+    const __m512i zero = _mm512_setzero_si512();
+    const __m256i a8 = _mm256_set1_epi8((char)255);
+
+    __m512i idxY, idxU, idxV;
+    if constexpr (layout == YuvLayout::NV12) {
+        idxU = loadTable(kNV12U);
+        idxV = loadTable(kNV12V);
+    } else if constexpr (layout == YuvLayout::I420) {
+        idxU = idxV = loadTable(kI420UV);
+    } else if constexpr (layout == YuvLayout::YUYV) {
+        idxY = loadTable(kYUYV_Y);
+        idxU = loadTable(kYUYV_U);
+        idxV = loadTable(kYUYV_V);
+    } else {
+        idxY = loadTable(kUYVY_Y);
+        idxU = loadTable(kUYVY_U);
+        idxV = loadTable(kUYVY_V);
+    }
+
+    constexpr int channels = hasAlpha ? 4 : 3;
+    const __m512i idxLo = loadTable(hasAlpha ? kInterleave4Lo : kInterleave3Lo);
+    const __m512i idxHi = loadTable(hasAlpha ? kInterleave4Hi : kInterleave3Hi);
+
+    for (int y = 0; y < height; ++y) {
+        const uint8_t* row0 = src0 + y * stride0;
+        const uint8_t* row1 = src1 + (y / 2) * stride1;
+        const uint8_t* row2 = src2 + (y / 2) * stride2;
+        uint8_t* dstRow = dst + y * dstStride;
+
+        for (int x = 0; x < width; x += 32) {
+            const int count = width - x < 32 ? width - x : 32;
+            const int chromaCount = (count + 1) & ~1;
+
+            // 1. Load 32 Y and the matching U/V, with U/V already repeated for each pixel
+            __m256i y8, u8, v8;
+            if constexpr (layout == YuvLayout::NV12) {
+                y8 = _mm256_maskz_loadu_epi8(byteMask32(count), row0 + x);
+                __m256i uv = _mm256_maskz_loadu_epi8(byteMask32(chromaCount), row1 + x);
+                u8 = _mm256_permutexvar_epi8(_mm512_castsi512_si256(idxU), uv);
+                v8 = _mm256_permutexvar_epi8(_mm512_castsi512_si256(idxV), uv);
+            } else if constexpr (layout == YuvLayout::I420) {
+                y8 = _mm256_maskz_loadu_epi8(byteMask32(count), row0 + x);
+                __m256i u = _mm256_castsi128_si256(_mm_maskz_loadu_epi8(byteMask16(chromaCount / 2), row1 + x / 2));
+                __m256i v = _mm256_castsi128_si256(_mm_maskz_loadu_epi8(byteMask16(chromaCount / 2), row2 + x / 2));
+                u8 = _mm256_permutexvar_epi8(_mm512_castsi512_si256(idxU), u);
+                v8 = _mm256_permutexvar_epi8(_mm512_castsi512_si256(idxV), v);
+            } else {
+                __m512i packed = _mm512_maskz_loadu_epi8(byteMask64(chromaCount * 2), row0 + x * 2);
+                y8 = _mm512_castsi512_si256(_mm512_permutexvar_epi8(idxY, packed));
+                u8 = _mm512_castsi512_si256(_mm512_permutexvar_epi8(idxU, packed));
+                v8 = _mm512_castsi512_si256(_mm512_permutexvar_epi8(idxV, packed));
+            }
+
+            // 2. Widen to 16 bit and remove offsets
+            __m512i y_16 = _mm512_cvtepu8_epi16(y8);
+            __m512i u_16 = _mm512_sub_epi16(_mm512_cvtepu8_epi16(u8), c128);
+            __m512i v_16 = _mm512_sub_epi16(_mm512_cvtepu8_epi16(v8), c128);
+            if constexpr (!isFullRange) { // Video Range: Y - 16
+                y_16 = _mm512_sub_epi16(y_16, c16);
+            }
+
+            // 3. YUV to RGB, saturating adds keep extreme inputs from wrapping around
+            __m512i y_scaled = _mm512_mullo_epi16(y_16, c_y);
+
+            __m512i r = _mm512_adds_epi16(y_scaled, _mm512_mullo_epi16(v_16, c_r));
+            r = _mm512_srai_epi16(_mm512_adds_epi16(r, c32), 6);
+
+            __m512i g = _mm512_subs_epi16(y_scaled, _mm512_mullo_epi16(u_16, c_gu));
+            g = _mm512_subs_epi16(g, _mm512_mullo_epi16(v_16, c_gv));
+            g = _mm512_srai_epi16(_mm512_adds_epi16(g, c32), 6);
+
+            __m512i b = _mm512_adds_epi16(y_scaled, _mm512_mullo_epi16(u_16, c_b));
+            b = _mm512_srai_epi16(_mm512_adds_epi16(b, c32), 6);
+
+            // 4. Clamp to 0~255: drop negatives, then narrow with unsigned saturation
+            __m256i r8 = _mm512_cvtusepi16_epi8(_mm512_max_epi16(r, zero));
+            __m256i g8 = _mm512_cvtusepi16_epi8(_mm512_max_epi16(g, zero));
+            __m256i b8 = _mm512_cvtusepi16_epi8(_mm512_max_epi16(b, zero));
+
+            __m256i c0 = isBGR ? b8 : r8;
+            __m256i c2 = isBGR ? r8 : b8;
+
+            // 5. Interleave and store, the tail stores are masked to `count` pixels
+            __m512i planes02 = _mm512_inserti64x4(_mm512_castsi256_si512(c0), c2, 1);
+            __m512i planes13 = hasAlpha ? _mm512_inserti64x4(_mm512_castsi256_si512(g8), a8, 1) : _mm512_castsi256_si512(g8);
+            __m512i out0 = _mm512_permutex2var_epi8(planes02, idxLo, planes13);
+            __m512i out1 = _mm512_permutex2var_epi8(planes02, idxHi, planes13);
+
+            const int bytes = count * channels;
+            uint8_t* out = dstRow + x * channels;
+            _mm512_mask_storeu_epi8(out, byteMask64(bytes), out0);
+            _mm512_mask_storeu_epi8(out + 64, byteMask64(bytes - 64), out1);
+        }
+    }
+}
+
+template <int inputChannels, int outputChannels, int swapRB>
+AVX512_TARGET void colorShuffle_avx512_imp(const uint8_t* src, int srcStride, uint8_t* dst, int dstStride, int width, int height) {
+    static_assert((inputChannels == 3 || inputChannels == 4) && (outputChannels == 3 || outputChannels == 4),
+                  "inputChannels and outputChannels must be 3 or 4");
+
+    static_assert(inputChannels != outputChannels || swapRB, "swapRB must be true when inputChannels == outputChannels");
+
+    if (height < 0) {
+        height = -height;
+        dst = dst + (height - 1) * dstStride;
+        dstStride = -dstStride;
+    }
+
+    // 16 pixels per iteration: at most 64 bytes on either side, so one `vpermb` does the whole shuffle.
+    constexpr int patchSize = 16;
+    alignas(64) uint8_t shuffleData[64] = {};
+    alignas(64) uint8_t alphaData[64] = {};
+
+    for (int i = 0; i < patchSize * outputChannels; ++i) {
+        int pixel = i / outputChannels;
+        int channel = i % outputChannels;
+        if (channel == 3) {
+            if constexpr (inputChannels == 4)
+                shuffleData[i] = pixel * inputChannels + 3;
+            else
+                alphaData[i] = 0xFF; // no alpha
+        } else {
+            int srcChannel = swapRB ? 2 - channel : channel;
+            shuffleData[i] = pixel * inputChannels + srcChannel;
+        }
+    }
+
+    const __m512i shuffle512 = _mm512_load_si512((const void*)shuffleData);
+    const __m512i alpha512 = _mm512_load_si512((const void*)alphaData);
+
+    for (int y = 0; y < height; ++y) {
+        const uint8_t* srcRow = src + y * srcStride;
+        uint8_t* dstRow = dst + y * dstStride;
+
+        for (int x = 0; x < width; x += patchSize) {
+            const int count = width - x < patchSize ? width - x : patchSize;
+            __m512i pixels = _mm512_maskz_loadu_epi8(byteMask64(count * inputChannels), srcRow + x * inputChannels);
+            __m512i result = _mm512_permutexvar_epi8(shuffle512, pixels);
+            if constexpr (inputChannels == 3 && outputChannels == 4) {
+                result = _mm512_or_si512(result, alpha512);
+            }
+            _mm512_mask_storeu_epi8(dstRow + x * outputChannels, byteMask64(count * outputChannels), result);
+        }
+    }
+}
+
+} // namespace
+
+template <int inputChannels, int outputChannels, int swapRB>
+void colorShuffle_avx512(const uint8_t* src, int srcStride, uint8_t* dst, int dstStride, int width, int height) {
+    colorShuffle_avx512_imp<inputChannels, outputChannels, swapRB>(src, srcStride, dst, dstStride, width, height);
+}
+
+template void colorShuffle_avx512<4, 4, true>(const uint8_t* src, int srcStride, uint8_t* dst, int dstStride, int width, int height);
+
+template void colorShuffle_avx512<4, 3, true>(const uint8_t* src, int srcStride, uint8_t* dst, int dstStride, int width, int height);
+
+template void colorShuffle_avx512<4, 3, false>(const uint8_t* src, int srcStride, uint8_t* dst, int dstStride, int width, int height);
+
+template void colorShuffle_avx512<3, 4, true>(const uint8_t* src, int srcStride, uint8_t* dst, int dstStride, int width, int height);
+
+template void colorShuffle_avx512<3, 4, false>(const uint8_t* src, int srcStride, uint8_t* dst, int dstStride, int width, int height);
+
+template void colorShuffle_avx512<3, 3, true>(const uint8_t* src, int srcStride, uint8_t* dst, int dstStride, int width, int height);
+
+template <YuvLayout layout, bool isBGR, bool hasAlpha>
+void yuvToRgb_avx512(const uint8_t* src0, int stride0, const uint8_t* src1, int stride1, const uint8_t* src2, int stride2,
+                     uint8_t* dst, int dstStride, int width, int height, ConvertFlag flag) {
+    const bool is601 = (flag & ConvertFlag::BT601) != 0;
+    const bool isFullRange = (flag & ConvertFlag::FullRange) != 0;
+
+    if (isFullRange) {
+        yuvToRgb_avx512_imp<layout, isBGR, hasAlpha, true>(src0, stride0, src1, stride1, src2, stride2, dst, dstStride, width, height, is601);
+    } else {
+        yuvToRgb_avx512_imp<layout, isBGR, hasAlpha, false>(src0, stride0, src1, stride1, src2, stride2, dst, dstStride, width, height, is601);
+    }
+}
+
+void nv12ToBgra32_avx512(const uint8_t* srcY, int srcYStride, const uint8_t* srcUV, int srcUVStride, uint8_t* dst, int dstStride, int width,
+                         int height, ConvertFlag flag) {
+    yuvToRgb_avx512<YuvLayout::NV12, true, true>(srcY, srcYStride, srcUV, srcUVStride, nullptr, 0, dst, dstStride, width, height, flag);
+}
+
+void nv12ToRgba32_avx512(const uint8_t* srcY, int srcYStride, const uint8_t* srcUV, int srcUVStride, uint8_t* dst, int dstStride, int width,
+                         int height, ConvertFlag flag) {
+    yuvToRgb_avx512<YuvLayout::NV12, false, true>(srcY, srcYStride, srcUV, srcUVStride, nullptr, 0, dst, dstStride, width, height, flag);
+}
+
+void nv12ToBgr24_avx512(const uint8_t* srcY, int srcYStride, const uint8_t* srcUV, int srcUVStride, uint8_t* dst, int dstStride, int width,
+                        int height, ConvertFlag flag) {
+    yuvToRgb_avx512<YuvLayout::NV12, true, false>(srcY, srcYStride, srcUV, srcUVStride, nullptr, 0, dst, dstStride, width, height, flag);
+}
+
+void nv12ToRgb24_avx512(const uint8_t* srcY, int srcYStride, const uint8_t* srcUV, int srcUVStride, uint8_t* dst, int dstStride, int width,
+                        int height, ConvertFlag flag) {
+    yuvToRgb_avx512<YuvLayout::NV12, false, false>(srcY, srcYStride, srcUV, srcUVStride, nullptr, 0, dst, dstStride, width, height, flag);
+}
+
+void i420ToBgra32_avx512(const uint8_t* srcY, int srcYStride, const uint8_t* srcU, int srcUStride, const uint8_t* srcV, int srcVStride,
+                         uint8_t* dst, int dstStride, int width, int height, ConvertFlag flag) {
+    yuvToRgb_avx512<YuvLayout::I420, true, true>(srcY, srcYStride, srcU, srcUStride, srcV, srcVStride, dst, dstStride, width, height, flag);
+}
+
+void i420ToRgba32_avx512(const uint8_t* srcY, int srcYStride, const uint8_t* srcU, int srcUStride, const uint8_t* srcV, int srcVStride,
+                         uint8_t* dst, int dstStride, int width, int height, ConvertFlag flag) {
+    yuvToRgb_avx512<YuvLayout::I420, false, true>(srcY, srcYStride, srcU, srcUStride, srcV, srcVStride, dst, dstStride, width, height, flag);
+}
+
+void i420ToBgr24_avx512(const uint8_t* srcY, int srcYStride, const uint8_t* srcU, int srcUStride, const uint8_t* srcV, int srcVStride,
+                        uint8_t* dst, int dstStride, int width, int height, ConvertFlag flag) {
+    yuvToRgb_avx512<YuvLayout::I420, true, false>(srcY, srcYStride, srcU, srcUStride, srcV, srcVStride, dst, dstStride, width, height, flag);
+}
+
+void i420ToRgb24_avx512(const uint8_t* srcY, int srcYStride, const uint8_t* srcU, int srcUStride, const uint8_t* srcV, int srcVStride,
+                        uint8_t* dst, int dstStride, int width, int height, ConvertFlag flag) {
+    yuvToRgb_avx512<YuvLayout::I420, false, false>(srcY, srcYStride, srcU, srcUStride, srcV, srcVStride, dst, dstStride, width, height, flag);
+}
+
+///////////// YUYV/UYVY to RGB functions /////////////
+
+void yuyvToBgr24_avx512(const uint8_t* src, int srcStride, uint8_t* dst, int dstStride, int width, int height, ConvertFlag flag) {
+    yuvToRgb_avx512<YuvLayout::YUYV, true, false>(src, srcStride, src, 0, src, 0, dst, dstStride, width, height, flag);
+}
+
+void yuyvToRgb24_avx512(const uint8_t* src, int srcStride, uint8_t* dst, int dstStride, int width, int height, ConvertFlag flag) {
+    yuvToRgb_avx512<YuvLayout::YUYV, false, false>(src, srcStride, src, 0, src, 0, dst, dstStride, width, height, flag);
+}
+
+void yuyvToBgra32_avx512(const uint8_t* src, int srcStride, uint8_t* dst, int dstStride, int width, int height, ConvertFlag flag) {
+    yuvToRgb_avx512<YuvLayout::YUYV, true, true>(src, srcStride, src, 0, src, 0, dst, dstStride, width, height, flag);
+}
+
+void yuyvToRgba32_avx512(const uint8_t* src, int srcStride, uint8_t* dst, int dstStride, int width, int height, ConvertFlag flag) {
+    yuvToRgb_avx512<YuvLayout::YUYV, false, true>(src, srcStride, src, 0, src, 0, dst, dstStride, width, height, flag);
+}
+
+void uyvyToBgr24_avx512(const uint8_t* src, int srcStride, uint8_t* dst, int dstStride, int width, int height, ConvertFlag flag) {
+    yuvToRgb_avx512<YuvLayout::UYVY, true, false>(src, srcStride, src, 0, src, 0, dst, dstStride, width, height, flag);
+}
+
+void uyvyToRgb24_avx512(const uint8_t* src, int srcStride, uint8_t* dst, int dstStride, int width, int height, ConvertFlag flag) {
+    yuvToRgb_avx512<YuvLayout::UYVY, false, false>(src, srcStride, src, 0, src, 0, dst, dstStride, width, height, flag);
+}
+
+void uyvyToBgra32_avx512(const uint8_t* src, int srcStride, uint8_t* dst, int dstStride, int width, int height, ConvertFlag flag) {
+    yuvToRgb_avx512<YuvLayout::UYVY, true, true>(src, srcStride, src, 0, src, 0, dst, dstStride, width, height, flag);
+}
+
+void uyvyToRgba32_avx512(const uint8_t* src, int srcStride, uint8_t* dst, int dstStride, int width, int height, ConvertFlag flag) {
+    yuvToRgb_avx512<YuvLayout::UYVY, false, true>(src, srcStride, src, 0, src, 0, dst, dstStride, width, height, flag);
+}
+
+#endif
+
+} // namespace ccap
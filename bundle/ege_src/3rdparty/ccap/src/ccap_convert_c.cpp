@@ -26,6 +26,10 @@ static_assert(static_cast<uint32_t>(CCAP_CONVERT_BACKEND_APPLE_ACCELERATE) == st
               "C and C++ ConvertBackend::AppleAccelerate values must match");
 static_assert(static_cast<uint32_t>(CCAP_CONVERT_BACKEND_NEON) == static_cast<uint32_t>(ccap::ConvertBackend::NEON),
               "C and C++ ConvertBackend::NEON values must match");
+static_assert(static_cast<uint32_t>(CCAP_CONVERT_BACKEND_AVX512) == static_cast<uint32_t>(ccap::ConvertBackend::AVX512),
+              "C and C++ ConvertBackend::AVX512 values must match");
+static_assert(static_cast<uint32_t>(CCAP_CONVERT_BACKEND_SSSE3) == static_cast<uint32_t>(ccap::ConvertBackend::SSSE3),
+              "C and C++ ConvertBackend::SSSE3 values must match");
 
 // ConvertFlag enum consistency checks
 static_assert(static_cast<uint32_t>(CCAP_CONVERT_FLAG_BT601) == static_cast<uint32_t>(ccap::ConvertFlag::BT601),
@@ -55,6 +59,30 @@ bool ccap_convert_enable_avx2(bool enable) {
     return ccap::enableAVX2(enable);
 }
 
+bool ccap_convert_has_avx512(void) {
+    return ccap::hasAVX512();
+}
+
+bool ccap_convert_can_use_avx512(void) {
+    return ccap::canUseAVX512();
+}
+
+bool ccap_convert_enable_avx512(bool enable) {
+    return ccap::enableAVX512(enable);
+}
+
+bool ccap_convert_has_ssse3(void) {
+    return ccap::hasSSSE3();
+}
+
+bool ccap_convert_can_use_ssse3(void) {
+    return ccap::canUseSSSE3();
+}
+
+bool ccap_convert_enable_ssse3(bool enable) {
+    return ccap::enableSSSE3(enable);
+}
+
 bool ccap_convert_has_apple_accelerate(void) {
     return ccap::hasAppleAccelerate();
 }
@@ -92,6 +120,10 @@ CcapConvertBackend ccap_convert_get_backend(void) {
         return CCAP_CONVERT_BACKEND_APPLE_ACCELERATE;
     case ccap::ConvertBackend::NEON:
         return CCAP_CONVERT_BACKEND_NEON;
+    case ccap::ConvertBackend::AVX512:
+        return CCAP_CONVERT_BACKEND_AVX512;
+    case ccap::ConvertBackend::SSSE3:
+        return CCAP_CONVERT_BACKEND_SSSE3;
     default:
         return CCAP_CONVERT_BACKEND_AUTO;
     }
@@ -115,12 +147,26 @@ bool ccap_convert_set_backend(CcapConvertBackend backend) {
     case CCAP_CONVERT_BACKEND_NEON:
         cppBackend = ccap::ConvertBackend::NEON;
         break;
+    case CCAP_CONVERT_BACKEND_AVX512:
+        cppBackend = ccap::ConvertBackend::AVX512;
+        break;
+    case CCAP_CONVERT_BACKEND_SSSE3:
+        cppBackend = ccap::ConvertBackend::SSSE3;
+        break;
     default:
         return false;
     }
     return ccap::setConvertBackend(cppBackend);
 }
 
+void ccap_convert_set_thread_count(int count) {
+    ccap::setConvertThreadCount(count);
+}
+
+int ccap_convert_get_thread_count(void) {
+    return ccap::getConvertThreadCount();
+}
+
 /* ========== Helper function to convert flags ========== */
 
 static ccap::ConvertFlag convertFlags(CcapConvertFlag flag) {
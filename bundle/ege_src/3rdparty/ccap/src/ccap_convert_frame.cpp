@@ -9,23 +9,85 @@
 #include "ccap_convert_frame.h"
 
 #include "ccap_convert.h"
+#include "ccap_convert_scale.h"
 #include "ccap_imp.h"
+#include "ccap_thread_pool.h"
 
+#include <algorithm>
 #include <cassert>
 #include <cstring>
 
 namespace ccap {
-bool inplaceConvertFrameYUV2RGBColor(VideoFrame* frame, PixelFormat toFormat, bool verticalFlip) { /// (NV12/I420/YUYV/UYVY) -> (BGR24/BGRA32)
+
+namespace {
+constexpr int kMinRowsPerBand = 128; ///< Smaller bands cost more in synchronization than they save
+
+/// Split [0, height) into bands with even start rows, and run `convertRows(rowBegin, rowEnd)` on the conversion thread pool.
+template <typename Fn>
+void convertInRowBands(int height, Fn&& convertRows) {
+    int bandCount = std::min(ThreadPool::shared().threadCount(), height / kMinRowsPerBand);
+    if (bandCount <= 1) {
+        convertRows(0, height);
+        return;
+    }
+
+    int bandRows = ((height + bandCount - 1) / bandCount + 1) & ~1; // Even, so 4:2:0 chroma rows are not shared
+    bandCount = (height + bandRows - 1) / bandRows;
+    ThreadPool::shared().parallelFor(bandCount, [&](int band) {
+        int rowBegin = band * bandRows;
+        convertRows(rowBegin, std::min(rowBegin + bandRows, height));
+    });
+}
+
+/// Resolve the requested output size against the frame size: a 0 side keeps the aspect ratio, a side larger than the frame is clamped.
+/// Returns false if the frame keeps its size.
+bool resolveOutputSize(const VideoFrame* frame, int& outputWidth, int& outputHeight) {
+    const int width = static_cast<int>(frame->width);
+    const int height = static_cast<int>(frame->height);
+    if ((outputWidth <= 0 && outputHeight <= 0) || width <= 0 || height <= 0) {
+        return false;
+    }
+
+    if (outputWidth <= 0) {
+        outputWidth = static_cast<int>((static_cast<int64_t>(width) * outputHeight + height / 2) / height);
+    } else if (outputHeight <= 0) {
+        outputHeight = static_cast<int>((static_cast<int64_t>(height) * outputWidth + width / 2) / width);
+    }
+
+    outputWidth = std::clamp(outputWidth, 1, width);
+    outputHeight = std::clamp(outputHeight, 1, height);
+    return outputWidth != width || outputHeight != height;
+}
+
+/// Bytes per pixel of the single plane RGB formats
+inline int rgbBytesPerPixel(PixelFormat format) {
+    if (format == PixelFormat::RGB565) {
+        return 2;
+    }
+    return (format & kPixelFormatAlphaColorBit) ? 4 : 3;
+}
+
+/// Full range input (NV12f, decoded MJPEG...) is converted with the full range matrix, the rest with the default video range one.
+inline ConvertFlag yuvConvertFlag(PixelFormat format) {
+    return pixelFormatInclude(format, kPixelFormatFullRangeBit) ? ConvertFlag::BT601 | ConvertFlag::FullRange : ConvertFlag::Default;
+}
+} // namespace
+
+bool inplaceConvertFrameYUV2RGBColor(VideoFrame* frame, PixelFormat toFormat, bool verticalFlip) { /// (NV12/NV21/I420/YV12/P010/YUYV/UYVY) -> (BGR24/BGRA32)
 
     /// TODO: Fix toFormat here, only support YUV -> (BGR24/BGRA32). Simplify SDK design. Will improve later.
 
     auto inputFormat = frame->pixelFormat;
     assert((inputFormat & kPixelFormatYUVColorBit) != 0 && (toFormat & kPixelFormatYUVColorBit) == 0);
     bool isInputNV12 = pixelFormatInclude(inputFormat, PixelFormat::NV12);
+    bool isInputNV21 = pixelFormatInclude(inputFormat, PixelFormat::NV21);
+    bool isInputP010 = pixelFormatInclude(inputFormat, PixelFormat::P010);
+    bool isInputYV12 = pixelFormatInclude(inputFormat, PixelFormat::YV12);
     bool isInputYUYV = pixelFormatInclude(inputFormat, PixelFormat::YUYV);
     bool isInputUYVY = pixelFormatInclude(inputFormat, PixelFormat::UYVY);
     bool outputHasAlpha = toFormat & kPixelFormatAlphaColorBit;
     bool isOutputBGR = toFormat & kPixelFormatBGRBit; // If not BGR, then RGB
+    const ConvertFlag flag = yuvConvertFlag(inputFormat);
 
     uint8_t* inputData0 = frame->data[0];
     uint8_t* inputData1 = frame->data[1];
@@ -34,7 +96,7 @@ bool inplaceConvertFrameYUV2RGBColor(VideoFrame* frame, PixelFormat toFormat, bo
     int stride1 = frame->stride[1];
     int stride2 = frame->stride[2];
     int width = frame->width;
-    int height = verticalFlip ? -(int)frame->height : frame->height;
+    int frameHeight = frame->height;
 
     auto newLineSize = outputHasAlpha ? frame->width * 4 : (frame->width * 3 + 31) & ~31;
 
@@ -47,77 +109,274 @@ bool inplaceConvertFrameYUV2RGBColor(VideoFrame* frame, PixelFormat toFormat, bo
     frame->stride[2] = 0;
     frame->pixelFormat = toFormat;
 
-    if (isInputNV12) { // NV12 -> BGR24, RGB24 in libyuv is actually BGR24
+    uint8_t* outputData = frame->data[0];
 
-        if (outputHasAlpha) {
-            if (isOutputBGR) {
-                nv12ToBgra32(inputData0, stride0, inputData1, stride1, frame->data[0], newLineSize, width, height);
+    // Convert source rows [rowBegin, rowEnd). rowBegin is even, so the 4:2:0 chroma row is rowBegin / 2.
+    auto convertRows = [&](int rowBegin, int rowEnd) {
+        const uint8_t* srcY = inputData0 + rowBegin * stride0;
+        int rows = rowEnd - rowBegin;
+        uint8_t* dst = outputData + (verticalFlip ? frameHeight - rowEnd : rowBegin) * newLineSize;
+        int height = verticalFlip ? -rows : rows;
+
+        if (isInputNV12) { // NV12 -> BGR24, RGB24 in libyuv is actually BGR24
+            const uint8_t* srcUV = inputData1 + (rowBegin / 2) * stride1;
+
+            if (outputHasAlpha) {
+                if (isOutputBGR) {
+                    nv12ToBgra32(srcY, stride0, srcUV, stride1, dst, newLineSize, width, height, flag);
+                } else {
+                    nv12ToRgba32(srcY, stride0, srcUV, stride1, dst, newLineSize, width, height, flag);
+                }
             } else {
-                nv12ToRgba32(inputData0, stride0, inputData1, stride1, frame->data[0], newLineSize, width, height);
+                if (isOutputBGR) {
+                    nv12ToBgr24(srcY, stride0, srcUV, stride1, dst, newLineSize, width, height, flag);
+                } else {
+                    nv12ToRgb24(srcY, stride0, srcUV, stride1, dst, newLineSize, width, height, flag);
+                }
             }
-            return true;
-        } else {
-            if (isOutputBGR) {
-                nv12ToBgr24(inputData0, stride0, inputData1, stride1, frame->data[0], newLineSize, width, height);
+        } else if (isInputNV21) { // NV21 -> BGR24/BGRA32
+            const uint8_t* srcVU = inputData1 + (rowBegin / 2) * stride1;
+
+            if (outputHasAlpha) {
+                if (isOutputBGR) {
+                    nv21ToBgra32(srcY, stride0, srcVU, stride1, dst, newLineSize, width, height, flag);
+                } else {
+                    nv21ToRgba32(srcY, stride0, srcVU, stride1, dst, newLineSize, width, height, flag);
+                }
             } else {
-                nv12ToRgb24(inputData0, stride0, inputData1, stride1, frame->data[0], newLineSize, width, height);
+                if (isOutputBGR) {
+                    nv21ToBgr24(srcY, stride0, srcVU, stride1, dst, newLineSize, width, height, flag);
+                } else {
+                    nv21ToRgb24(srcY, stride0, srcVU, stride1, dst, newLineSize, width, height, flag);
+                }
             }
-            return true;
-        }
-    } else if (isInputYUYV) { // YUYV -> BGR24/BGRA32
+        } else if (isInputP010) { // P010 -> BGR24/BGRA32, strides are in bytes
+            const uint8_t* srcUV = inputData1 + (rowBegin / 2) * stride1;
 
-        if (outputHasAlpha) {
-            if (isOutputBGR) {
-                yuyvToBgra32(inputData0, stride0, frame->data[0], newLineSize, width, height);
+            if (outputHasAlpha) {
+                if (isOutputBGR) {
+                    p010ToBgra32(srcY, stride0, srcUV, stride1, dst, newLineSize, width, height, flag);
+                } else {
+                    p010ToRgba32(srcY, stride0, srcUV, stride1, dst, newLineSize, width, height, flag);
+                }
             } else {
-                yuyvToRgba32(inputData0, stride0, frame->data[0], newLineSize, width, height);
+                if (isOutputBGR) {
+                    p010ToBgr24(srcY, stride0, srcUV, stride1, dst, newLineSize, width, height, flag);
+                } else {
+                    p010ToRgb24(srcY, stride0, srcUV, stride1, dst, newLineSize, width, height, flag);
+                }
             }
-            return true;
-        } else {
-            if (isOutputBGR) {
-                yuyvToBgr24(inputData0, stride0, frame->data[0], newLineSize, width, height);
+        } else if (isInputYUYV) { // YUYV -> BGR24/BGRA32
+
+            if (outputHasAlpha) {
+                if (isOutputBGR) {
+                    yuyvToBgra32(srcY, stride0, dst, newLineSize, width, height, flag);
+                } else {
+                    yuyvToRgba32(srcY, stride0, dst, newLineSize, width, height, flag);
+                }
             } else {
-                yuyvToRgb24(inputData0, stride0, frame->data[0], newLineSize, width, height);
+                if (isOutputBGR) {
+                    yuyvToBgr24(srcY, stride0, dst, newLineSize, width, height, flag);
+                } else {
+                    yuyvToRgb24(srcY, stride0, dst, newLineSize, width, height, flag);
+                }
             }
-            return true;
-        }
-    } else if (isInputUYVY) { // UYVY -> BGR24/BGRA32
+        } else if (isInputUYVY) { // UYVY -> BGR24/BGRA32
 
-        if (outputHasAlpha) {
-            if (isOutputBGR) {
-                uyvyToBgra32(inputData0, stride0, frame->data[0], newLineSize, width, height);
+            if (outputHasAlpha) {
+                if (isOutputBGR) {
+                    uyvyToBgra32(srcY, stride0, dst, newLineSize, width, height, flag);
+                } else {
+                    uyvyToRgba32(srcY, stride0, dst, newLineSize, width, height, flag);
+                }
             } else {
-                uyvyToRgba32(inputData0, stride0, frame->data[0], newLineSize, width, height);
+                if (isOutputBGR) {
+                    uyvyToBgr24(srcY, stride0, dst, newLineSize, width, height, flag);
+                } else {
+                    uyvyToRgb24(srcY, stride0, dst, newLineSize, width, height, flag);
+                }
             }
-            return true;
-        } else {
-            if (isOutputBGR) {
-                uyvyToBgr24(inputData0, stride0, frame->data[0], newLineSize, width, height);
+        } else { // I420/YV12 -> BGR24, YV12 stores the V plane first
+            const uint8_t* srcU = isInputYV12 ? inputData2 + (rowBegin / 2) * stride2 : inputData1 + (rowBegin / 2) * stride1;
+            const uint8_t* srcV = isInputYV12 ? inputData1 + (rowBegin / 2) * stride1 : inputData2 + (rowBegin / 2) * stride2;
+            int strideU = isInputYV12 ? stride2 : stride1;
+            int strideV = isInputYV12 ? stride1 : stride2;
+
+            if (outputHasAlpha) {
+                if (isOutputBGR) {
+                    i420ToBgra32(srcY, stride0, srcU, strideU, srcV, strideV, dst, newLineSize, width, height, flag);
+                } else {
+                    i420ToRgba32(srcY, stride0, srcU, strideU, srcV, strideV, dst, newLineSize, width, height, flag);
+                }
             } else {
-                uyvyToRgb24(inputData0, stride0, frame->data[0], newLineSize, width, height);
+                if (isOutputBGR) {
+                    i420ToBgr24(srcY, stride0, srcU, strideU, srcV, strideV, dst, newLineSize, width, height, flag);
+                } else {
+                    i420ToRgb24(srcY, stride0, srcU, strideU, srcV, strideV, dst, newLineSize, width, height, flag);
+                }
             }
-            return true;
         }
-    } else { // I420 -> BGR24
+    };
 
-        if (outputHasAlpha) {
-            if (isOutputBGR) {
-                i420ToBgra32(inputData0, stride0, inputData1, stride1, inputData2, stride2, frame->data[0], newLineSize, width, height);
-            } else {
-                i420ToRgba32(inputData0, stride0, inputData1, stride1, inputData2, stride2, frame->data[0], newLineSize, width, height);
+    convertInRowBands(frameHeight, convertRows);
+    return true;
+}
+
+bool inplaceConvertFrameYUV2RGBScaled(VideoFrame* frame, PixelFormat toFormat, bool verticalFlip, int outputWidth, int outputHeight) {
+    ScaleSource src;
+    src.format = frame->pixelFormat;
+    for (int i = 0; i < 3; ++i) {
+        src.data[i] = frame->data[i];
+        src.stride[i] = frame->stride[i];
+    }
+    src.width = frame->width;
+    src.height = frame->height;
+
+    bool outputHasAlpha = toFormat & kPixelFormatAlphaColorBit;
+    int newLineSize = outputHasAlpha ? outputWidth * 4 : (outputWidth * 3 + 31) & ~31;
+    int dstHeight = verticalFlip ? -outputHeight : outputHeight;
+    const ConvertFlag flag = yuvConvertFlag(src.format);
+
+    // Validate with an empty row range first, so the frame is left untouched if the conversion is not supported.
+    if (!yuvToRgbScaledRows(src, nullptr, newLineSize, outputWidth, dstHeight, toFormat, ScaleFilter::Auto, flag, 0, 0)) {
+        return false;
+    }
+
+    frame->allocator->resize(newLineSize * outputHeight);
+    uint8_t* outputData = frame->allocator->data();
+
+    convertInRowBands(outputHeight, [&](int rowBegin, int rowEnd) {
+        yuvToRgbScaledRows(src, outputData, newLineSize, outputWidth, dstHeight, toFormat, ScaleFilter::Auto, flag, rowBegin, rowEnd);
+    });
+
+    frame->data[0] = outputData;
+    frame->stride[0] = newLineSize;
+    frame->data[1] = nullptr;
+    frame->data[2] = nullptr;
+    frame->stride[1] = 0;
+    frame->stride[2] = 0;
+    frame->width = outputWidth;
+    frame->height = outputHeight;
+    frame->pixelFormat = toFormat;
+    return true;
+}
+
+bool cropFrame(VideoFrame* frame, int cropX, int cropY, int cropWidth, int cropHeight, bool isBottomUp) {
+    const int width = static_cast<int>(frame->width);
+    const int height = static_cast<int>(frame->height);
+    const PixelFormat format = frame->pixelFormat;
+    if (cropX <= 0 && cropY <= 0 && cropWidth <= 0 && cropHeight <= 0) {
+        return false;
+    }
+
+    bool isInputYUV = (format & kPixelFormatYUVColorBit) != 0;
+    bool isInputSemiPlanar = pixelFormatInclude(format, PixelFormat::NV12) || pixelFormatInclude(format, PixelFormat::NV21);
+    bool isInputPlanar = pixelFormatInclude(format, PixelFormat::I420) || pixelFormatInclude(format, PixelFormat::YV12);
+    bool isInputP010 = pixelFormatInclude(format, PixelFormat::P010);
+    bool isInput420 = isInputSemiPlanar || isInputPlanar || isInputP010;
+    // One chroma sample covers 2x1 (4:2:2) or 2x2 (4:2:0) pixels, the rectangle must not split it.
+    const int alignX = isInputYUV ? 2 : 1;
+    const int alignY = isInput420 ? 2 : 1;
+    if (format == PixelFormat::Unknown || format == PixelFormat::MJPEG || width < alignX || height < alignY) {
+        return false;
+    }
+
+    int x = std::clamp(cropX, 0, width - alignX) & ~(alignX - 1);
+    int y = std::clamp(cropY, 0, height - alignY) & ~(alignY - 1);
+    int w = cropWidth > 0 ? std::min(cropWidth, width - x) : width - x;
+    int h = cropHeight > 0 ? std::min(cropHeight, height - y) : height - y;
+    w = std::max(w & ~(alignX - 1), alignX);
+    h = std::max(h & ~(alignY - 1), alignY);
+    if (x == 0 && y == 0 && w == width && h == height) {
+        return false;
+    }
+
+    // Bytes of one cropped row of each plane
+    int rowBytes[3] = {};
+    if (isInputSemiPlanar) {
+        frame->data[0] += y * frame->stride[0] + x;
+        frame->data[1] += (y / 2) * frame->stride[1] + x; // Interleaved UV, x is even
+        rowBytes[0] = rowBytes[1] = w;
+    } else if (isInputP010) { // 2 bytes per sample
+        frame->data[0] += y * frame->stride[0] + x * 2;
+        frame->data[1] += (y / 2) * frame->stride[1] + x * 2;
+        rowBytes[0] = rowBytes[1] = w * 2;
+    } else if (isInputPlanar) {
+        frame->data[0] += y * frame->stride[0] + x;
+        frame->data[1] += (y / 2) * frame->stride[1] + x / 2;
+        frame->data[2] += (y / 2) * frame->stride[2] + x / 2;
+        rowBytes[0] = w;
+        rowBytes[1] = rowBytes[2] = w / 2;
+    } else if (isInputYUV) { // YUYV/UYVY: 2 bytes per pixel
+        frame->data[0] += y * frame->stride[0] + x * 2;
+        rowBytes[0] = w * 2;
+    } else {
+        int memoryRow = isBottomUp ? height - (y + h) : y;
+        frame->data[0] += memoryRow * frame->stride[0] + x * rgbBytesPerPixel(format);
+        rowBytes[0] = w * rgbBytesPerPixel(format);
+    }
+
+    // The view spans from data[0] to the end of the last cropped row of the last plane
+    const uint8_t* end = frame->data[0];
+    for (int i = 0; i < 3; ++i) {
+        if (rowBytes[i] > 0) {
+            int rows = i == 0 || !isInput420 ? h : h / 2;
+            end = std::max<const uint8_t*>(end, frame->data[i] + static_cast<size_t>(rows - 1) * frame->stride[i] + rowBytes[i]);
+        }
+    }
+
+    frame->width = w;
+    frame->height = h;
+    frame->sizeInBytes = static_cast<uint32_t>(end - frame->data[0]);
+    return true;
+}
+
+bool inplaceConvertFrameI420ToYUV(VideoFrame* frame, PixelFormat toFormat) {
+    const bool toNV12 = pixelFormatInclude(toFormat, PixelFormat::NV12);
+    if (!pixelFormatInclude(frame->pixelFormat, PixelFormat::I420) || (!toNV12 && !pixelFormatInclude(toFormat, PixelFormat::I420))) {
+        return false;
+    }
+
+    const int width = frame->width, height = frame->height;
+    const int chromaWidth = (width + 1) / 2, chromaHeight = (height + 1) / 2;
+    const int chromaStride = toNV12 ? chromaWidth * 2 : chromaWidth;
+    const size_t lumaSize = static_cast<size_t>(width) * height;
+    const size_t chromaSize = static_cast<size_t>(chromaStride) * chromaHeight;
+
+    const uint8_t* src[3] = { frame->data[0], frame->data[1], frame->data[2] };
+    const uint32_t srcStride[3] = { frame->stride[0], frame->stride[1], frame->stride[2] };
+    frame->allocator->resize(lumaSize + chromaSize * (toNV12 ? 1 : 2));
+    uint8_t* dst = frame->allocator->data();
+
+    for (int y = 0; y < height; ++y) {
+        memcpy(dst + y * width, src[0] + y * srcStride[0], width);
+    }
+
+    uint8_t* dstChroma = dst + lumaSize;
+    for (int y = 0; y < chromaHeight; ++y) {
+        const uint8_t* srcU = src[1] + y * srcStride[1];
+        const uint8_t* srcV = src[2] + y * srcStride[2];
+        if (toNV12) {
+            uint8_t* uv = dstChroma + y * chromaStride;
+            for (int x = 0; x < chromaWidth; ++x) {
+                uv[x * 2] = srcU[x];
+                uv[x * 2 + 1] = srcV[x];
             }
-            return true;
         } else {
-            if (isOutputBGR) {
-                i420ToBgr24(inputData0, stride0, inputData1, stride1, inputData2, stride2, frame->data[0], newLineSize, width, height);
-            } else {
-                i420ToRgb24(inputData0, stride0, inputData1, stride1, inputData2, stride2, frame->data[0], newLineSize, width, height);
-            }
-            return true;
+            memcpy(dstChroma + y * chromaStride, srcU, chromaWidth);
+            memcpy(dstChroma + chromaSize + y * chromaStride, srcV, chromaWidth);
         }
     }
 
-    return false;
+    frame->data[0] = dst;
+    frame->data[1] = dstChroma;
+    frame->data[2] = toNV12 ? nullptr : dstChroma + chromaSize;
+    frame->stride[0] = width;
+    frame->stride[1] = chromaStride;
+    frame->stride[2] = toNV12 ? 0 : chromaStride;
+    frame->pixelFormat = toFormat;
+    frame->sizeInBytes = static_cast<uint32_t>(frame->allocator->size());
+    return true;
 }
 
 bool inplaceConvertFrameRGB(VideoFrame* frame, PixelFormat toFormat, bool verticalFlip) {
@@ -157,7 +416,7 @@ bool inplaceConvertFrameRGB(VideoFrame* frame, PixelFormat toFormat, bool vertic
 #endif
         } else // RGB <-> BGR
         {
-            rgbaToBgra(inputBytes, inputLineSize, outputBytes, newLineSize, frame->width, height);
+            rgbToBgr(inputBytes, inputLineSize, outputBytes, newLineSize, frame->width, height);
         }
     } else /// Different number of channels, only 4 channels <-> 3 channels
     {
@@ -180,21 +439,56 @@ bool inplaceConvertFrameRGB(VideoFrame* frame, PixelFormat toFormat, bool vertic
     return true;
 }
 
-inline bool inplaceConvertFrameImp(VideoFrame* frame, PixelFormat toFormat, bool verticalFlip) {
+bool inplaceConvertFrameRGB565(VideoFrame* frame, PixelFormat toFormat, bool verticalFlip) {
+    uint8_t* inputBytes = frame->data[0];
+    int inputLineSize = frame->stride[0];
+    bool outputHasAlpha = toFormat & kPixelFormatAlphaColorBit;
+    bool isOutputBGR = toFormat & kPixelFormatBGRBit; // If not BGR, then RGB
+    auto newLineSize = outputHasAlpha ? frame->width * 4 : (frame->width * 3 + 31) & ~31;
+
+    frame->allocator->resize(newLineSize * frame->height);
+
+    uint8_t* outputBytes = frame->allocator->data();
+    int height = verticalFlip ? -(int)frame->height : frame->height;
+
+    frame->stride[0] = newLineSize;
+    frame->data[0] = outputBytes;
+    frame->pixelFormat = toFormat;
+
+    if (outputHasAlpha) {
+        if (isOutputBGR) {
+            rgb565ToBgra32(inputBytes, inputLineSize, outputBytes, newLineSize, frame->width, height);
+        } else {
+            rgb565ToRgba32(inputBytes, inputLineSize, outputBytes, newLineSize, frame->width, height);
+        }
+    } else {
+        if (isOutputBGR) {
+            rgb565ToBgr24(inputBytes, inputLineSize, outputBytes, newLineSize, frame->width, height);
+        } else {
+            rgb565ToRgb24(inputBytes, inputLineSize, outputBytes, newLineSize, frame->width, height);
+        }
+    }
+    return true;
+}
+
+inline bool inplaceConvertFrameImp(VideoFrame* frame, PixelFormat toFormat, bool verticalFlip, int outputWidth, int outputHeight) {
     if (frame->pixelFormat == toFormat) {
         if (verticalFlip && (toFormat & kPixelFormatRGBColorBit)) { // flip upside down
             int srcStride = (int)frame->stride[0];
-            int dstStride = srcStride;
+            // Only the pixels are copied, the source rows may be a crop of wider rows.
+            int lineSize = frame->width * rgbBytesPerPixel(toFormat);
+            int dstStride = (toFormat & kPixelFormatAlphaColorBit) ? lineSize : (lineSize + 31) & ~31;
             auto height = frame->height;
             auto* src = frame->data[0];
-            frame->allocator->resize(srcStride * height);
+            frame->allocator->resize(dstStride * height);
             auto* dst = frame->allocator->data();
             frame->data[0] = dst;
+            frame->stride[0] = dstStride;
             /// Read in reverse order
             src = src + srcStride * (height - 1);
             srcStride = -srcStride;
             for (uint32_t i = 0; i < height; ++i) {
-                memcpy(dst, src, dstStride);
+                memcpy(dst, src, lineSize);
                 dst += dstStride;
                 src += srcStride;
             }
@@ -205,6 +499,10 @@ inline bool inplaceConvertFrameImp(VideoFrame* frame, PixelFormat toFormat, bool
         return false;
     }
 
+    if (toFormat == PixelFormat::RGB565) {
+        return false; // Input only
+    }
+
     bool isInputYUV = (frame->pixelFormat & kPixelFormatYUVColorBit) != 0;
     bool isOutputYUV = (toFormat & kPixelFormatYUVColorBit) != 0;
     if (isInputYUV || isOutputYUV) // yuv <-> rgb
@@ -214,16 +512,24 @@ inline bool inplaceConvertFrameImp(VideoFrame* frame, PixelFormat toFormat, bool
             return inplaceConvertFrameYUV2YUV(frame, toFormat, verticalFlip);
 #endif
 
-        if (isInputYUV) // yuv -> BGR
+        if (isInputYUV) { // yuv -> BGR
+            // P010 has no scaled path, it is converted at full size
+            if (resolveOutputSize(frame, outputWidth, outputHeight) &&
+                inplaceConvertFrameYUV2RGBScaled(frame, toFormat, verticalFlip, outputWidth, outputHeight))
+                return true;
             return inplaceConvertFrameYUV2RGBColor(frame, toFormat, verticalFlip);
+        }
         return false; // no rgb -> yuv
     }
 
+    if (frame->pixelFormat == PixelFormat::RGB565) {
+        return inplaceConvertFrameRGB565(frame, toFormat, verticalFlip);
+    }
     return inplaceConvertFrameRGB(frame, toFormat, verticalFlip);
 }
 
-bool inplaceConvertFrame(VideoFrame* frame, PixelFormat toFormat, bool verticalFlip) {
-    auto ret = inplaceConvertFrameImp(frame, toFormat, verticalFlip);
+bool inplaceConvertFrame(VideoFrame* frame, PixelFormat toFormat, bool verticalFlip, int outputWidth, int outputHeight) {
+    auto ret = inplaceConvertFrameImp(frame, toFormat, verticalFlip, outputWidth, outputHeight);
     if (ret) {
         assert(frame->pixelFormat == toFormat);
         assert(frame->allocator != nullptr && frame->data[0] == frame->allocator->data());
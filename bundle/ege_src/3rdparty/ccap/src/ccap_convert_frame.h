@@ -17,9 +17,25 @@
 
 namespace ccap {
 
-bool inplaceConvertFrame(VideoFrame* frame, PixelFormat toFormat, bool verticalFlip);
+/// `outputWidth`/`outputHeight` downscale YUV frames while converting them to RGB, see `PropertyName::OutputWidth`.
+/// 0 for both keeps the frame size.
+bool inplaceConvertFrame(VideoFrame* frame, PixelFormat toFormat, bool verticalFlip, int outputWidth = 0, int outputHeight = 0);
+/**
+ * @brief Narrow the planes of `frame` to a crop rectangle without copying: data pointers are moved, strides are kept.
+ *  The rectangle is clamped to the frame, and for YUV formats aligned to the chroma subsampling.
+ *  0 for cropWidth/cropHeight extends the rectangle to the right/bottom edge.
+ *  `sizeInBytes` becomes the bytes from `data[0]` to the end of the last cropped row, the planes stay in the source buffer.
+ * @param isBottomUp Rows of an RGB frame are stored bottom-up in memory (DirectShow), cropY is always counted from the top.
+ * @return true if the frame was narrowed.
+ */
+bool cropFrame(VideoFrame* frame, int cropX, int cropY, int cropWidth, int cropHeight, bool isBottomUp = false);
 bool inplaceConvertFrameRGB(VideoFrame* frame, PixelFormat toFormat, bool verticalFlip);
+bool inplaceConvertFrameRGB565(VideoFrame* frame, PixelFormat toFormat, bool verticalFlip);
 bool inplaceConvertFrameYUV2RGBColor(VideoFrame* frame, PixelFormat toFormat, bool verticalFlip);
+bool inplaceConvertFrameYUV2RGBScaled(VideoFrame* frame, PixelFormat toFormat, bool verticalFlip, int outputWidth, int outputHeight);
+/// Repack an I420 frame with any strides (e.g. a decoder view) as a tightly packed NV12 or I420 frame, no color conversion.
+/// The range bit of `toFormat` is applied as given. Odd sizes are supported.
+bool inplaceConvertFrameI420ToYUV(VideoFrame* frame, PixelFormat toFormat);
 
 } // namespace ccap
 
@@ -0,0 +1,214 @@
+/**
+ * @file ccap_convert_motion.cpp
+ * @author wysaid (this@wysaid.org)
+ * @brief Luma frame difference, motion mask and motion bounding boxes.
+ * @date 2025-10
+ *
+ * The kernels read the Y plane only, so motion can be checked before a frame is converted to RGB.
+ */
+
+#include "ccap_convert_motion.h"
+
+#include "ccap_convert_avx2.h"
+#include "ccap_convert_neon.h"
+
+#include <algorithm>
+#include <cassert>
+
+namespace ccap {
+
+namespace {
+
+bool isSupportedBlockSize(int blockSize) { return blockSize == 1 || blockSize == 2 || blockSize == 4 || blockSize == 8; }
+
+int log2BlockArea(int blockSize) { return blockSize == 1 ? 0 : (blockSize == 2 ? 2 : (blockSize == 4 ? 4 : 6)); }
+
+/// One output row: average of blockSize x blockSize blocks of src, or of |src - ref| if ref is not nullptr.
+void lumaBlockAverageRow(const uint8_t* src, int srcStride, const uint8_t* ref, int refStride, uint8_t* dst, int dstWidth, int blockSize) {
+#if ENABLE_AVX2_IMP
+    if (canUseAVX2()) {
+        lumaBlockAverageRow_avx2(src, srcStride, ref, refStride, dst, dstWidth, blockSize);
+        return;
+    }
+#endif
+
+#if ENABLE_NEON_IMP
+    if (canUseNEON()) {
+        lumaBlockAverageRow_neon(src, srcStride, ref, refStride, dst, dstWidth, blockSize);
+        return;
+    }
+#endif
+
+    const int shift = log2BlockArea(blockSize);
+    const uint32_t half = (blockSize * blockSize) / 2;
+    for (int x = 0; x < dstWidth; ++x) {
+        uint32_t sum = 0;
+        for (int row = 0; row < blockSize; ++row) {
+            const uint8_t* s = src + row * srcStride + x * blockSize;
+            const uint8_t* r = ref ? ref + row * refStride + x * blockSize : nullptr;
+            for (int i = 0; i < blockSize; ++i) {
+                sum += r ? (s[i] > r[i] ? s[i] - r[i] : r[i] - s[i]) : s[i];
+            }
+        }
+        dst[x] = static_cast<uint8_t>((sum + half) >> shift);
+    }
+}
+
+uint32_t motionMaskRow(const uint8_t* diff, uint8_t* mask, int width, uint8_t threshold) {
+#if ENABLE_AVX2_IMP
+    if (canUseAVX2()) {
+        return motionMaskRow_avx2(diff, mask, width, threshold);
+    }
+#endif
+
+#if ENABLE_NEON_IMP
+    if (canUseNEON()) {
+        return motionMaskRow_neon(diff, mask, width, threshold);
+    }
+#endif
+
+    uint32_t count = 0;
+    for (int x = 0; x < width; ++x) {
+        const bool moving = diff[x] > threshold;
+        if (mask) mask[x] = moving ? 255 : 0;
+        count += moving;
+    }
+    return count;
+}
+
+bool lumaBlockAverage(const uint8_t* src, int srcStride, const uint8_t* ref, int refStride, uint8_t* dst, int dstStride, int width, int height,
+                      int blockSize) {
+    if (!src || !dst || width <= 0 || height <= 0 || !isSupportedBlockSize(blockSize)) {
+        return false;
+    }
+
+    const int dstWidth = width / blockSize;
+    const int dstHeight = height / blockSize;
+    for (int y = 0; y < dstHeight; ++y) {
+        const int srcRow = y * blockSize;
+        lumaBlockAverageRow(src + srcRow * srcStride, srcStride, ref ? ref + srcRow * refStride : nullptr, refStride, dst + y * dstStride, dstWidth,
+                            blockSize);
+    }
+    return true;
+}
+
+/// Block sums of a packed 4:2:2 luma (one sample every 2 bytes). No SIMD version: the gate is the only user.
+void lumaDownsamplePacked(const uint8_t* src, int srcStride, uint8_t* dst, int dstWidth, int dstHeight, int blockSize) {
+    const int shift = log2BlockArea(blockSize);
+    const uint32_t half = (blockSize * blockSize) / 2;
+    for (int y = 0; y < dstHeight; ++y) {
+        for (int x = 0; x < dstWidth; ++x) {
+            uint32_t sum = 0;
+            for (int row = 0; row < blockSize; ++row) {
+                const uint8_t* s = src + (y * blockSize + row) * srcStride + x * blockSize * 2;
+                for (int i = 0; i < blockSize; ++i) {
+                    sum += s[i * 2];
+                }
+            }
+            dst[y * dstWidth + x] = static_cast<uint8_t>((sum + half) >> shift);
+        }
+    }
+}
+
+} // namespace
+
+bool lumaDownsample(const uint8_t* src, int srcStride, uint8_t* dst, int dstStride, int width, int height, int blockSize) {
+    return lumaBlockAverage(src, srcStride, nullptr, 0, dst, dstStride, width, height, blockSize);
+}
+
+bool lumaAbsDiff(const uint8_t* srcA, int srcAStride, const uint8_t* srcB, int srcBStride, uint8_t* dst, int dstStride, int width, int height,
+                 int blockSize) {
+    return srcB && lumaBlockAverage(srcA, srcAStride, srcB, srcBStride, dst, dstStride, width, height, blockSize);
+}
+
+uint32_t motionMask(const uint8_t* diff, int diffStride, uint8_t* mask, int maskStride, int width, int height, uint8_t threshold, uint32_t stopAt) {
+    uint32_t count = 0;
+    for (int y = 0; y < height && count < stopAt; ++y) {
+        count += motionMaskRow(diff + y * diffStride, mask ? mask + y * maskStride : nullptr, width, threshold);
+    }
+    return count;
+}
+
+int motionBoundingBoxes(const uint8_t* mask, int maskStride, int width, int height, MotionBox* boxes, int maxBoxes, uint32_t minPixels) {
+    if (!mask || width <= 0 || height <= 0) {
+        return 0;
+    }
+
+    // Flood fill from each unvisited mask pixel, the stack holds pixel indices
+    std::vector<uint8_t> visited(static_cast<size_t>(width) * height, 0);
+    std::vector<int> stack;
+    std::vector<MotionBox> regions;
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            if (!mask[y * maskStride + x] || visited[y * width + x]) continue;
+
+            int left = x, right = x, top = y, bottom = y;
+            uint32_t pixelCount = 0;
+            visited[y * width + x] = 1;
+            stack.push_back(y * width + x);
+            while (!stack.empty()) {
+                const int index = stack.back();
+                stack.pop_back();
+                const int px = index % width, py = index / width;
+                ++pixelCount;
+                left = std::min(left, px);
+                right = std::max(right, px);
+                top = std::min(top, py);
+                bottom = std::max(bottom, py);
+
+                for (int ny = std::max(py - 1, 0); ny <= std::min(py + 1, height - 1); ++ny) {
+                    for (int nx = std::max(px - 1, 0); nx <= std::min(px + 1, width - 1); ++nx) {
+                        if (mask[ny * maskStride + nx] && !visited[ny * width + nx]) {
+                            visited[ny * width + nx] = 1;
+                            stack.push_back(ny * width + nx);
+                        }
+                    }
+                }
+            }
+
+            if (pixelCount >= minPixels) {
+                regions.push_back({ left, top, right - left + 1, bottom - top + 1, pixelCount });
+            }
+        }
+    }
+
+    std::stable_sort(regions.begin(), regions.end(), [](const MotionBox& a, const MotionBox& b) { return a.pixelCount > b.pixelCount; });
+    if (boxes) {
+        std::copy_n(regions.begin(), std::min<size_t>(regions.size(), static_cast<size_t>(std::max(maxBoxes, 0))), boxes);
+    }
+    return static_cast<int>(regions.size());
+}
+
+bool lumaDownsampleFrame(const VideoFrame& frame, int blockSize, std::vector<uint8_t>& dst, int& dstWidth, int& dstHeight) {
+    const uint8_t* luma = frame.data[0];
+    bool isPacked = false;
+    if (pixelFormatInclude(frame.pixelFormat, PixelFormat::YUYV)) {
+        isPacked = true;
+    } else if (pixelFormatInclude(frame.pixelFormat, PixelFormat::UYVY)) { // U0 Y0 V0 Y1
+        isPacked = true;
+        luma = luma ? luma + 1 : nullptr;
+    } else if (!pixelFormatInclude(frame.pixelFormat, PixelFormat::NV12) && !pixelFormatInclude(frame.pixelFormat, PixelFormat::NV21) &&
+               !pixelFormatInclude(frame.pixelFormat, PixelFormat::I420) && !pixelFormatInclude(frame.pixelFormat, PixelFormat::YV12)) {
+        return false;
+    }
+
+    if (!luma || !isSupportedBlockSize(blockSize)) {
+        return false;
+    }
+
+    dstWidth = static_cast<int>(frame.width) / blockSize;
+    dstHeight = static_cast<int>(frame.height) / blockSize;
+    if (dstWidth <= 0 || dstHeight <= 0) {
+        return false;
+    }
+
+    dst.resize(static_cast<size_t>(dstWidth) * dstHeight);
+    const int stride = static_cast<int>(frame.stride[0]);
+    if (isPacked) {
+        lumaDownsamplePacked(luma, stride, dst.data(), dstWidth, dstHeight, blockSize);
+        return true;
+    }
+    return lumaDownsample(luma, stride, dst.data(), dstWidth, static_cast<int>(frame.width), static_cast<int>(frame.height), blockSize);
+}
+
+} // namespace ccap
@@ -0,0 +1,29 @@
+/**
+ * @file ccap_convert_motion.h
+ * @author wysaid (this@wysaid.org)
+ * @brief Luma motion detection on captured frames, used by the motion gate of the providers.
+ * @date 2025-10
+ *
+ */
+
+#pragma once
+#ifndef CCAP_CONVERT_MOTION_H
+#define CCAP_CONVERT_MOTION_H
+
+#include "ccap_convert.h"
+#include "ccap_core.h"
+
+#include <vector>
+
+namespace ccap {
+
+/**
+ * @brief Block averages of the luma of a YUV frame (NV12/NV21/I420/YV12/YUYV/UYVY, video or full range), see `lumaDownsample`.
+ *  `dst` is resized to (width / blockSize) x (height / blockSize), tightly packed.
+ * @return false if the frame has no 8-bit luma (RGB, MJPEG, P010) or is smaller than one block.
+ */
+bool lumaDownsampleFrame(const VideoFrame& frame, int blockSize, std::vector<uint8_t>& dst, int& dstWidth, int& dstHeight);
+
+} // namespace ccap
+
+#endif // CCAP_CONVERT_MOTION_H
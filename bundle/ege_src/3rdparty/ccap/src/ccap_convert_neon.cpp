@@ -9,6 +9,8 @@
 
 #include "ccap_convert.h"
 
+#include <algorithm>
+#include <cassert>
 #include <cstring>
 
 namespace ccap {
@@ -1757,5 +1759,450 @@ void uyvyToRgba32_neon(const uint8_t* src, int srcStride,
     _uyvyToRgba_neon_imp<false>(src, srcStride, dst, dstStride, width, height, flag);
 }
 
+///////////// NV21/P010 row repacking and RGB565 /////////////
+
+void swapUVRow_neon(const uint8_t* src, uint8_t* dst, int byteCount) {
+    int i = 0;
+    for (; i + 16 <= byteCount; i += 16) {
+        vst1q_u8(dst + i, vrev16q_u8(vld1q_u8(src + i)));
+    }
+
+    for (; i + 1 < byteCount; i += 2) {
+        uint8_t v = src[i];
+        dst[i] = src[i + 1];
+        dst[i + 1] = v;
+    }
+}
+
+void p010ToU8Row_neon(const uint8_t* src, uint8_t* dst, int count) {
+    int i = 0;
+    for (; i + 16 <= count; i += 16) {
+        uint16x8_t lo = vreinterpretq_u16_u8(vld1q_u8(src + i * 2));
+        uint16x8_t hi = vreinterpretq_u16_u8(vld1q_u8(src + i * 2 + 16));
+        // Rounding, saturating narrow: min((v + 128) >> 8, 255)
+        vst1q_u8(dst + i, vcombine_u8(vqrshrn_n_u16(lo, 8), vqrshrn_n_u16(hi, 8)));
+    }
+
+    for (; i < count; ++i) {
+        int v = src[i * 2] | (src[i * 2 + 1] << 8);
+        dst[i] = static_cast<uint8_t>(std::min((v + 128) >> 8, 255));
+    }
+}
+
+template <bool isBgrColor, bool hasAlpha>
+void rgb565ToRgb_neon_imp(const uint8_t* src, int srcStride, uint8_t* dst, int dstStride, int width, int height) {
+    // If height < 0, write dst in reverse order while reading src in normal order
+    if (height < 0) {
+        height = -height;
+        dst = dst + (height - 1) * dstStride;
+        dstStride = -dstStride;
+    }
+
+    constexpr int channels = hasAlpha ? 4 : 3;
+    const uint8x8_t mask5 = vdup_n_u8(0x1F);
+    const uint8x8_t mask6 = vdup_n_u8(0x3F);
+
+    for (int y = 0; y < height; ++y) {
+        const uint8_t* srcRow = src + y * srcStride;
+        uint8_t* dstRow = dst + y * dstStride;
+        int x = 0;
+
+        for (; x + 8 <= width; x += 8) {
+            uint16x8_t pixels = vreinterpretq_u16_u8(vld1q_u8(srcRow + x * 2));
+
+            // Expand 5/6-bit channels to 8 bits by replicating the high bits: (c << 3) | (c >> 2)
+            uint8x8_t r5 = vmovn_u16(vshrq_n_u16(pixels, 11));
+            uint8x8_t g6 = vand_u8(vshrn_n_u16(pixels, 5), mask6);
+            uint8x8_t b5 = vand_u8(vmovn_u16(pixels), mask5);
+            uint8x8_t r = vorr_u8(vshl_n_u8(r5, 3), vshr_n_u8(r5, 2));
+            uint8x8_t g = vorr_u8(vshl_n_u8(g6, 2), vshr_n_u8(g6, 4));
+            uint8x8_t b = vorr_u8(vshl_n_u8(b5, 3), vshr_n_u8(b5, 2));
+
+            if constexpr (hasAlpha) {
+                uint8x8x4_t out;
+                out.val[0] = isBgrColor ? b : r;
+                out.val[1] = g;
+                out.val[2] = isBgrColor ? r : b;
+                out.val[3] = vdup_n_u8(255);
+                vst4_u8(dstRow + x * 4, out);
+            } else {
+                uint8x8x3_t out;
+                out.val[0] = isBgrColor ? b : r;
+                out.val[1] = g;
+                out.val[2] = isBgrColor ? r : b;
+                vst3_u8(dstRow + x * 3, out);
+            }
+        }
+
+        for (; x < width; ++x) {
+            int v = srcRow[x * 2] | (srcRow[x * 2 + 1] << 8);
+            int r5 = v >> 11, g6 = (v >> 5) & 0x3F, b5 = v & 0x1F;
+            uint8_t* pixel = dstRow + x * channels;
+            pixel[isBgrColor ? 2 : 0] = static_cast<uint8_t>((r5 << 3) | (r5 >> 2));
+            pixel[1] = static_cast<uint8_t>((g6 << 2) | (g6 >> 4));
+            pixel[isBgrColor ? 0 : 2] = static_cast<uint8_t>((b5 << 3) | (b5 >> 2));
+            if constexpr (hasAlpha) {
+                pixel[3] = 255;
+            }
+        }
+    }
+}
+
+void rgb565ToBgr24_neon(const uint8_t* src, int srcStride, uint8_t* dst, int dstStride, int width, int height) {
+    rgb565ToRgb_neon_imp<true, false>(src, srcStride, dst, dstStride, width, height);
+}
+
+void rgb565ToRgb24_neon(const uint8_t* src, int srcStride, uint8_t* dst, int dstStride, int width, int height) {
+    rgb565ToRgb_neon_imp<false, false>(src, srcStride, dst, dstStride, width, height);
+}
+
+void rgb565ToBgra32_neon(const uint8_t* src, int srcStride, uint8_t* dst, int dstStride, int width, int height) {
+    rgb565ToRgb_neon_imp<true, true>(src, srcStride, dst, dstStride, width, height);
+}
+
+void rgb565ToRgba32_neon(const uint8_t* src, int srcStride, uint8_t* dst, int dstStride, int width, int height) {
+    rgb565ToRgb_neon_imp<false, true>(src, srcStride, dst, dstStride, width, height);
+}
+
+///////////// RGB to YUV /////////////
+
+// Y of 16 pixels: ((kr * r + kg * g + kb * b + 128) >> 8) + offset, the weighted sum never exceeds 255 * 256.
+inline uint8x16_t rgbToY_neon(uint8x16_t r, uint8x16_t g, uint8x16_t b, uint8x8_t kr, uint8x8_t kg, uint8x8_t kb, uint8x16_t offset) {
+    uint16x8_t lo = vmull_u8(vget_low_u8(r), kr);
+    lo = vmlal_u8(lo, vget_low_u8(g), kg);
+    lo = vmlal_u8(lo, vget_low_u8(b), kb);
+    uint16x8_t hi = vmull_u8(vget_high_u8(r), kr);
+    hi = vmlal_u8(hi, vget_high_u8(g), kg);
+    hi = vmlal_u8(hi, vget_high_u8(b), kb);
+    return vaddq_u8(vcombine_u8(vrshrn_n_u16(lo, 8), vrshrn_n_u16(hi, 8)), offset);
+}
+
+// U or V of 8 2x2 blocks from the block sums: min(((kr * rs + kg * gs + kb * bs + 512) >> 10) + 128, 255)
+inline uint8x8_t rgbSumToChroma_neon(int16x8_t rs, int16x8_t gs, int16x8_t bs, int16_t kr, int16_t kg, int16_t kb, int32x4_t bias) {
+    int32x4_t lo = vmlal_n_s16(vmlal_n_s16(vmlal_n_s16(bias, vget_low_s16(rs), kr), vget_low_s16(gs), kg), vget_low_s16(bs), kb);
+    int32x4_t hi = vmlal_n_s16(vmlal_n_s16(vmlal_n_s16(bias, vget_high_s16(rs), kr), vget_high_s16(gs), kg), vget_high_s16(bs), kb);
+    return vqmovn_u16(vcombine_u16(vqshrun_n_s32(lo, 10), vqshrun_n_s32(hi, 10)));
+}
+
+template <int inputChannels, bool isBgrColor>
+void rgbToYuv420_neon(const uint8_t* src, int srcStride, uint8_t* dstY, int dstYStride, uint8_t* dstU, int dstUStride,
+                      uint8_t* dstV, int dstVStride, int width, int height, ConvertFlag flag) {
+    // If height < 0, read src in reverse order while writing dst sequentially
+    if (height < 0) {
+        height = -height;
+        src = src + (height - 1) * srcStride;
+        srcStride = -srcStride;
+    }
+
+    const auto k = getRgbToYuvCoefficients(flag);
+    constexpr int rIndex = isBgrColor ? 2 : 0;
+    constexpr int bIndex = isBgrColor ? 0 : 2;
+
+    const uint8x8_t kyr = vdup_n_u8(static_cast<uint8_t>(k.yr));
+    const uint8x8_t kyg = vdup_n_u8(static_cast<uint8_t>(k.yg));
+    const uint8x8_t kyb = vdup_n_u8(static_cast<uint8_t>(k.yb));
+    const uint8x16_t yOffset = vdupq_n_u8(static_cast<uint8_t>(k.yOffset));
+    const int32x4_t uvBias = vdupq_n_s32(512 + (128 << 10));
+
+    for (int y = 0; y < height; y += 2) {
+        // The last row of an odd height is paired with itself, its Y row is simply written twice.
+        bool hasRow1 = y + 1 < height;
+        const uint8_t* srcRow0 = src + y * srcStride;
+        const uint8_t* srcRow1 = hasRow1 ? srcRow0 + srcStride : srcRow0;
+        uint8_t* yRow0 = dstY + y * dstYStride;
+        uint8_t* yRow1 = hasRow1 ? yRow0 + dstYStride : yRow0;
+        uint8_t* uRow = dstU + (y / 2) * dstUStride;
+        uint8_t* vRow = dstV ? dstV + (y / 2) * dstVStride : nullptr;
+
+        int x = 0;
+        for (; x + 16 <= width; x += 16) {
+            uint8x16_t r0, g0, b0, r1, g1, b1;
+            if constexpr (inputChannels == 4) {
+                uint8x16x4_t p0 = vld4q_u8(srcRow0 + x * 4);
+                uint8x16x4_t p1 = vld4q_u8(srcRow1 + x * 4);
+                r0 = p0.val[rIndex], g0 = p0.val[1], b0 = p0.val[bIndex];
+                r1 = p1.val[rIndex], g1 = p1.val[1], b1 = p1.val[bIndex];
+            } else {
+                uint8x16x3_t p0 = vld3q_u8(srcRow0 + x * 3);
+                uint8x16x3_t p1 = vld3q_u8(srcRow1 + x * 3);
+                r0 = p0.val[rIndex], g0 = p0.val[1], b0 = p0.val[bIndex];
+                r1 = p1.val[rIndex], g1 = p1.val[1], b1 = p1.val[bIndex];
+            }
+
+            vst1q_u8(yRow0 + x, rgbToY_neon(r0, g0, b0, kyr, kyg, kyb, yOffset));
+            vst1q_u8(yRow1 + x, rgbToY_neon(r1, g1, b1, kyr, kyg, kyb, yOffset));
+
+            // 2x2 block sums: add horizontal neighbours, then the second row
+            int16x8_t rs = vreinterpretq_s16_u16(vpadalq_u8(vpaddlq_u8(r0), r1));
+            int16x8_t gs = vreinterpretq_s16_u16(vpadalq_u8(vpaddlq_u8(g0), g1));
+            int16x8_t bs = vreinterpretq_s16_u16(vpadalq_u8(vpaddlq_u8(b0), b1));
+
+            uint8x8x2_t uv;
+            uv.val[0] = rgbSumToChroma_neon(rs, gs, bs, k.ur, k.ug, k.ub, uvBias);
+            uv.val[1] = rgbSumToChroma_neon(rs, gs, bs, k.vr, k.vg, k.vb, uvBias);
+
+            if (vRow) {
+                vst1_u8(uRow + x / 2, uv.val[0]);
+                vst1_u8(vRow + x / 2, uv.val[1]);
+            } else {
+                vst2_u8(uRow + x, uv);
+            }
+        }
+
+        for (; x < width; x += 2) {
+            int x1 = x + 1 < width ? x + 1 : x;
+            const uint8_t* p[4] = { srcRow0 + x * inputChannels, srcRow0 + x1 * inputChannels,
+                                    srcRow1 + x * inputChannels, srcRow1 + x1 * inputChannels };
+            uint8_t* yOut[4] = { yRow0 + x, yRow0 + x1, yRow1 + x, yRow1 + x1 };
+
+            int rs = 0, gs = 0, bs = 0;
+            for (int i = 0; i < 4; ++i) {
+                int r = p[i][rIndex], g = p[i][1], b = p[i][bIndex];
+                *yOut[i] = static_cast<uint8_t>(((k.yr * r + k.yg * g + k.yb * b + 128) >> 8) + k.yOffset);
+                rs += r;
+                gs += g;
+                bs += b;
+            }
+
+            int u = ((k.ur * rs + k.ug * gs + k.ub * bs + 512) >> 10) + 128;
+            int v = ((k.vr * rs + k.vg * gs + k.vb * bs + 512) >> 10) + 128;
+            u = u > 255 ? 255 : u;
+            v = v > 255 ? 255 : v;
+
+            if (vRow) {
+                uRow[x / 2] = static_cast<uint8_t>(u);
+                vRow[x / 2] = static_cast<uint8_t>(v);
+            } else {
+                uRow[x] = static_cast<uint8_t>(u);
+                uRow[x + 1] = static_cast<uint8_t>(v);
+            }
+        }
+    }
+}
+
+template void rgbToYuv420_neon<4, true>(const uint8_t* src, int srcStride, uint8_t* dstY, int dstYStride, uint8_t* dstU, int dstUStride,
+                                        uint8_t* dstV, int dstVStride, int width, int height, ConvertFlag flag);
+
+template void rgbToYuv420_neon<4, false>(const uint8_t* src, int srcStride, uint8_t* dstY, int dstYStride, uint8_t* dstU, int dstUStride,
+                                         uint8_t* dstV, int dstVStride, int width, int height, ConvertFlag flag);
+
+template void rgbToYuv420_neon<3, true>(const uint8_t* src, int srcStride, uint8_t* dstY, int dstYStride, uint8_t* dstU, int dstUStride,
+                                        uint8_t* dstV, int dstVStride, int width, int height, ConvertFlag flag);
+
+template void rgbToYuv420_neon<3, false>(const uint8_t* src, int srcStride, uint8_t* dstY, int dstYStride, uint8_t* dstU, int dstUStride,
+                                         uint8_t* dstV, int dstVStride, int width, int height, ConvertFlag flag);
+
+
+///////////// JPEG IDCT /////////////
+
+// 1-D islow IDCT on 4 columns, v[i] holds row i. The results are not descaled. Same arithmetic as `idct8x8`.
+inline void idct1D_neon(int32x4_t* v) {
+    // Even part
+    int32x4_t z1 = vmulq_n_s32(vaddq_s32(v[2], v[6]), 4433);
+    int32x4_t tmp2 = vmlaq_n_s32(z1, v[6], -15137);
+    int32x4_t tmp3 = vmlaq_n_s32(z1, v[2], 6270);
+    int32x4_t tmp0 = vshlq_n_s32(vaddq_s32(v[0], v[4]), 13);
+    int32x4_t tmp1 = vshlq_n_s32(vsubq_s32(v[0], v[4]), 13);
+    int32x4_t tmp10 = vaddq_s32(tmp0, tmp3), tmp13 = vsubq_s32(tmp0, tmp3);
+    int32x4_t tmp11 = vaddq_s32(tmp1, tmp2), tmp12 = vsubq_s32(tmp1, tmp2);
+
+    // Odd part
+    tmp0 = v[7];
+    tmp1 = v[5];
+    tmp2 = v[3];
+    tmp3 = v[1];
+    z1 = vaddq_s32(tmp0, tmp3);
+    int32x4_t z2 = vaddq_s32(tmp1, tmp2);
+    int32x4_t z3 = vaddq_s32(tmp0, tmp2);
+    int32x4_t z4 = vaddq_s32(tmp1, tmp3);
+    int32x4_t z5 = vmulq_n_s32(vaddq_s32(z3, z4), 9633);
+    tmp0 = vmulq_n_s32(tmp0, 2446);
+    tmp1 = vmulq_n_s32(tmp1, 16819);
+    tmp2 = vmulq_n_s32(tmp2, 25172);
+    tmp3 = vmulq_n_s32(tmp3, 12299);
+    z1 = vmulq_n_s32(z1, -7373);
+    z2 = vmulq_n_s32(z2, -20995);
+    z3 = vmlaq_n_s32(z5, z3, -16069);
+    z4 = vmlaq_n_s32(z5, z4, -3196);
+    tmp0 = vaddq_s32(tmp0, vaddq_s32(z1, z3));
+    tmp1 = vaddq_s32(tmp1, vaddq_s32(z2, z4));
+    tmp2 = vaddq_s32(tmp2, vaddq_s32(z2, z3));
+    tmp3 = vaddq_s32(tmp3, vaddq_s32(z1, z4));
+
+    v[0] = vaddq_s32(tmp10, tmp3);
+    v[7] = vsubq_s32(tmp10, tmp3);
+    v[1] = vaddq_s32(tmp11, tmp2);
+    v[6] = vsubq_s32(tmp11, tmp2);
+    v[2] = vaddq_s32(tmp12, tmp1);
+    v[5] = vsubq_s32(tmp12, tmp1);
+    v[3] = vaddq_s32(tmp13, tmp0);
+    v[4] = vsubq_s32(tmp13, tmp0);
+}
+
+inline void transpose4x4Int32_neon(int32x4_t a0, int32x4_t a1, int32x4_t a2, int32x4_t a3, int32x4_t* out) {
+    int32x4x2_t t01 = vtrnq_s32(a0, a1);
+    int32x4x2_t t23 = vtrnq_s32(a2, a3);
+    out[0] = vcombine_s32(vget_low_s32(t01.val[0]), vget_low_s32(t23.val[0]));
+    out[1] = vcombine_s32(vget_low_s32(t01.val[1]), vget_low_s32(t23.val[1]));
+    out[2] = vcombine_s32(vget_high_s32(t01.val[0]), vget_high_s32(t23.val[0]));
+    out[3] = vcombine_s32(vget_high_s32(t01.val[1]), vget_high_s32(t23.val[1]));
+}
+
+// lo[i] / hi[i]: columns 0~3 / 4~7 of row i.
+inline void transpose8x8Int32_neon(int32x4_t* lo, int32x4_t* hi) {
+    int32x4_t a[4], b[4], c[4], d[4];
+    transpose4x4Int32_neon(lo[0], lo[1], lo[2], lo[3], a);
+    transpose4x4Int32_neon(hi[0], hi[1], hi[2], hi[3], b);
+    transpose4x4Int32_neon(lo[4], lo[5], lo[6], lo[7], c);
+    transpose4x4Int32_neon(hi[4], hi[5], hi[6], hi[7], d);
+    for (int i = 0; i < 4; ++i) {
+        lo[i] = a[i];
+        hi[i] = c[i];
+        lo[i + 4] = b[i];
+        hi[i + 4] = d[i];
+    }
+}
+
+void idct8x8_neon(const int16_t* coefficients, uint8_t* dst, int dstStride) {
+    int32x4_t lo[8], hi[8];
+    for (int i = 0; i < 8; ++i) {
+        int16x8_t row = vld1q_s16(coefficients + i * 8);
+        lo[i] = vmovl_s16(vget_low_s16(row));
+        hi[i] = vmovl_s16(vget_high_s16(row));
+    }
+
+    // Pass 1: columns, descale by CONST_BITS - PASS1_BITS
+    idct1D_neon(lo);
+    idct1D_neon(hi);
+    for (int i = 0; i < 8; ++i) {
+        lo[i] = vrshrq_n_s32(lo[i], 11);
+        hi[i] = vrshrq_n_s32(hi[i], 11);
+    }
+
+    // Pass 2: rows, descale by CONST_BITS + PASS1_BITS + 3 and shift the level
+    transpose8x8Int32_neon(lo, hi);
+    idct1D_neon(lo);
+    idct1D_neon(hi);
+    const int32x4_t level = vdupq_n_s32(128);
+    for (int i = 0; i < 8; ++i) {
+        lo[i] = vaddq_s32(vrshrq_n_s32(lo[i], 18), level);
+        hi[i] = vaddq_s32(vrshrq_n_s32(hi[i], 18), level);
+    }
+    transpose8x8Int32_neon(lo, hi);
+
+    for (int i = 0; i < 8; ++i) {
+        int16x8_t row = vcombine_s16(vqmovn_s32(lo[i]), vqmovn_s32(hi[i]));
+        vst1_u8(dst + i * dstStride, vqmovun_s16(row));
+    }
+}
+
+///////////// Luma motion detection /////////////
+
+template <int blockSize, bool isDiff>
+void lumaBlockAverageRow_neon_imp(const uint8_t* src, int srcStride, const uint8_t* ref, int refStride, uint8_t* dst, int dstWidth) {
+    constexpr int outputsPerVector = 16 / blockSize;
+    constexpr int shift = blockSize == 1 ? 0 : (blockSize == 2 ? 2 : (blockSize == 4 ? 4 : 6)); // log2(blockSize * blockSize)
+
+    int x = 0;
+    for (; x + outputsPerVector <= dstWidth; x += outputsPerVector) {
+        const int offset = x * blockSize;
+        uint16x8_t pairs = vdupq_n_u16(0); // At most 8 rows * 2 * 255, no overflow
+        uint8x16_t v = vdupq_n_u8(0);
+        for (int row = 0; row < blockSize; ++row) {
+            v = vld1q_u8(src + row * srcStride + offset);
+            if constexpr (isDiff) {
+                v = vabdq_u8(v, vld1q_u8(ref + row * refStride + offset));
+            }
+            if constexpr (blockSize > 1) {
+                pairs = vpadalq_u8(pairs, v);
+            }
+        }
+
+        // Rounding narrow shifts: (sum + half) >> shift
+        if constexpr (blockSize == 1) {
+            vst1q_u8(dst + x, v);
+        } else if constexpr (blockSize == 2) {
+            vst1_u8(dst + x, vrshrn_n_u16(pairs, shift));
+        } else if constexpr (blockSize == 4) {
+            uint16x4_t quads = vrshrn_n_u32(vpaddlq_u16(pairs), shift);
+            uint32_t packed = vget_lane_u32(vreinterpret_u32_u8(vmovn_u16(vcombine_u16(quads, quads))), 0);
+            std::memcpy(dst + x, &packed, sizeof(packed));
+        } else {
+            uint32x2_t blocks = vrshrn_n_u64(vpaddlq_u32(vpaddlq_u16(pairs)), shift);
+            dst[x] = static_cast<uint8_t>(vget_lane_u32(blocks, 0));
+            dst[x + 1] = static_cast<uint8_t>(vget_lane_u32(blocks, 1));
+        }
+    }
+
+    for (; x < dstWidth; ++x) {
+        uint32_t sum = 0;
+        for (int row = 0; row < blockSize; ++row) {
+            const uint8_t* s = src + row * srcStride + x * blockSize;
+            for (int i = 0; i < blockSize; ++i) {
+                if constexpr (isDiff) {
+                    const uint8_t* r = ref + row * refStride + x * blockSize;
+                    sum += s[i] > r[i] ? s[i] - r[i] : r[i] - s[i];
+                } else {
+                    sum += s[i];
+                }
+            }
+        }
+        dst[x] = static_cast<uint8_t>((sum + (blockSize * blockSize / 2)) >> shift);
+    }
+}
+
+template <bool isDiff>
+void lumaBlockAverageRow_neon_dispatch(const uint8_t* src, int srcStride, const uint8_t* ref, int refStride, uint8_t* dst, int dstWidth, int blockSize) {
+    switch (blockSize) {
+    case 1:
+        lumaBlockAverageRow_neon_imp<1, isDiff>(src, srcStride, ref, refStride, dst, dstWidth);
+        break;
+    case 2:
+        lumaBlockAverageRow_neon_imp<2, isDiff>(src, srcStride, ref, refStride, dst, dstWidth);
+        break;
+    case 4:
+        lumaBlockAverageRow_neon_imp<4, isDiff>(src, srcStride, ref, refStride, dst, dstWidth);
+        break;
+    default:
+        assert(blockSize == 8);
+        lumaBlockAverageRow_neon_imp<8, isDiff>(src, srcStride, ref, refStride, dst, dstWidth);
+        break;
+    }
+}
+
+void lumaBlockAverageRow_neon(const uint8_t* src, int srcStride, const uint8_t* ref, int refStride, uint8_t* dst, int dstWidth, int blockSize) {
+    if (ref) {
+        lumaBlockAverageRow_neon_dispatch<true>(src, srcStride, ref, refStride, dst, dstWidth, blockSize);
+    } else {
+        lumaBlockAverageRow_neon_dispatch<false>(src, srcStride, ref, refStride, dst, dstWidth, blockSize);
+    }
+}
+
+uint32_t motionMaskRow_neon(const uint8_t* diff, uint8_t* mask, int width, uint8_t threshold) {
+    const uint8x16_t limit = vdupq_n_u8(threshold);
+    uint32_t count = 0;
+
+    int x = 0;
+    while (x + 16 <= width) {
+        // 16-bit counters, flushed before they can overflow
+        uint16x8_t counts = vdupq_n_u16(0);
+        for (int i = 0; i < 4096 && x + 16 <= width; ++i, x += 16) {
+            uint8x16_t moving = vcgtq_u8(vld1q_u8(diff + x), limit);
+            if (mask) {
+                vst1q_u8(mask + x, moving);
+            }
+            counts = vpadalq_u8(counts, vshrq_n_u8(moving, 7));
+        }
+        count += vaddlvq_u16(counts);
+    }
+
+    for (; x < width; ++x) {
+        const bool moving = diff[x] > threshold;
+        if (mask) mask[x] = moving ? 255 : 0;
+        count += moving;
+    }
+    return count;
+}
+
 #endif // ENABLE_NEON_IMP
 } // namespace ccap
@@ -154,6 +154,51 @@ void uyvyToRgba32_neon(const uint8_t* src, int srcStride,
                        uint8_t* dst, int dstStride,
                        int width, int height, ConvertFlag flag);
 
+// Swap the two bytes of each pair (VU <-> UV), byteCount is even. Used to repack NV21 chroma rows as NV12.
+void swapUVRow_neon(const uint8_t* src, uint8_t* dst, int byteCount);
+
+// 16-bit little-endian P010 samples to 8-bit with rounding: min((v + 128) >> 8, 255)
+void p010ToU8Row_neon(const uint8_t* src, uint8_t* dst, int count);
+
+// RGB565 to BGR24, NEON accelerated
+void rgb565ToBgr24_neon(const uint8_t* src, int srcStride,
+                        uint8_t* dst, int dstStride,
+                        int width, int height);
+
+// RGB565 to RGB24, NEON accelerated
+void rgb565ToRgb24_neon(const uint8_t* src, int srcStride,
+                        uint8_t* dst, int dstStride,
+                        int width, int height);
+
+// RGB565 to BGRA32, NEON accelerated
+void rgb565ToBgra32_neon(const uint8_t* src, int srcStride,
+                         uint8_t* dst, int dstStride,
+                         int width, int height);
+
+// RGB565 to RGBA32, NEON accelerated
+void rgb565ToRgba32_neon(const uint8_t* src, int srcStride,
+                         uint8_t* dst, int dstStride,
+                         int width, int height);
+
+// RGB(A) to NV12 (dstV == nullptr, interleaved UV written to dstU) or I420, NEON accelerated. See `getRgbToYuvCoefficients`.
+template <int inputChannels, bool isBgrColor>
+void rgbToYuv420_neon(const uint8_t* src, int srcStride,
+                      uint8_t* dstY, int dstYStride,
+                      uint8_t* dstU, int dstUStride,
+                      uint8_t* dstV, int dstVStride,
+                      int width, int height, ConvertFlag flag);
+
+// 8x8 islow IDCT of dequantized coefficients with level shift, NEON accelerated. Bit-exact with `idct8x8`.
+void idct8x8_neon(const int16_t* coefficients, uint8_t* dst, int dstStride);
+
+// One output row of `lumaDownsample` (ref == nullptr) or `lumaAbsDiff`, reads blockSize rows. blockSize is 1, 2, 4 or 8.
+void lumaBlockAverageRow_neon(const uint8_t* src, int srcStride,
+                              const uint8_t* ref, int refStride,
+                              uint8_t* dst, int dstWidth, int blockSize);
+
+// One row of `motionMask` (mask can be nullptr), returns the number of pixels above the threshold.
+uint32_t motionMaskRow_neon(const uint8_t* diff, uint8_t* mask, int width, uint8_t threshold);
+
 #else
 
 #define nv12ToBgr24_neon(...) assert(0 && "NEON not supported")
@@ -172,6 +217,15 @@ void uyvyToRgba32_neon(const uint8_t* src, int srcStride,
 #define uyvyToRgb24_neon(...) assert(0 && "NEON not supported")
 #define uyvyToBgra32_neon(...) assert(0 && "NEON not supported")
 #define uyvyToRgba32_neon(...) assert(0 && "NEON not supported")
+#define swapUVRow_neon(...) assert(0 && "NEON not supported")
+#define p010ToU8Row_neon(...) assert(0 && "NEON not supported")
+#define rgb565ToBgr24_neon(...) assert(0 && "NEON not supported")
+#define rgb565ToRgb24_neon(...) assert(0 && "NEON not supported")
+#define rgb565ToBgra32_neon(...) assert(0 && "NEON not supported")
+#define rgb565ToRgba32_neon(...) assert(0 && "NEON not supported")
+#define idct8x8_neon(...) assert(0 && "NEON not supported")
+#define lumaBlockAverageRow_neon(...) assert(0 && "NEON not supported")
+#define motionMaskRow_neon(...) assert(0 && "NEON not supported")
 
 #endif
 
@@ -0,0 +1,90 @@
+/**
+ * @file ccap_convert_pipeline.cpp
+ * @author wysaid (this@wysaid.org)
+ * @brief Worker stage converting captured frames off the capture thread, see PropertyName::ConvertWorkerCount.
+ * @date 2025-10
+ *
+ */
+
+#include "ccap_convert_pipeline.h"
+
+#include "ccap_utils.h"
+
+#include <algorithm>
+
+namespace ccap {
+
+ConvertPipeline::ConvertPipeline(int workerCount, int queueDepth, ConvertPipelineStats& stats, Deliver deliver) :
+    m_capacity(static_cast<uint32_t>(std::max(workerCount, 1) + std::max(queueDepth, 0))),
+    m_stats(stats),
+    m_deliver(std::move(deliver)) {
+    m_stats.reset();
+    for (int i = 0; i < std::max(workerCount, 1); ++i) {
+        m_workers.emplace_back(&ConvertPipeline::workerLoop, this);
+    }
+    CCAP_LOG_V("ccap: Convert pipeline started, %d workers, %u frames in flight at most\n", std::max(workerCount, 1), m_capacity);
+}
+
+ConvertPipeline::~ConvertPipeline() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_condition.notify_all();
+    for (auto& worker : m_workers) {
+        worker.join();
+    }
+}
+
+bool ConvertPipeline::submit(Task task) {
+    uint32_t pending = m_stats.pendingFrames.load(std::memory_order_acquire);
+    if (pending >= m_capacity) {
+        m_stats.droppedFrames.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    // Only the capture thread submits, the count can only drop in between
+    m_stats.pendingFrames.fetch_add(1, std::memory_order_acq_rel);
+    if (pending + 1 > m_stats.peakPendingFrames.load(std::memory_order_relaxed)) {
+        m_stats.peakPendingFrames.store(pending + 1, std::memory_order_relaxed);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_tasks.emplace_back(m_nextSequence++, std::move(task));
+    }
+    m_condition.notify_one();
+    return true;
+}
+
+void ConvertPipeline::workerLoop() {
+    for (;;) {
+        std::pair<uint64_t, Task> task;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_condition.wait(lock, [this]() { return m_stop || !m_tasks.empty(); });
+            if (m_tasks.empty()) return; // Stopped and drained
+            task = std::move(m_tasks.front());
+            m_tasks.pop_front();
+        }
+        complete(task.first, task.second());
+    }
+}
+
+void ConvertPipeline::complete(uint64_t sequence, std::shared_ptr<VideoFrame> frame) {
+    std::lock_guard<std::mutex> lock(m_deliverMutex);
+    m_finished.emplace(sequence, std::move(frame));
+
+    // Deliver every frame whose predecessors are all done
+    while (!m_finished.empty() && m_finished.begin()->first == m_nextDelivery) {
+        auto ready = std::move(m_finished.begin()->second);
+        m_finished.erase(m_finished.begin());
+        ++m_nextDelivery;
+        if (ready) {
+            m_deliver(std::move(ready));
+        }
+        m_stats.pendingFrames.fetch_sub(1, std::memory_order_acq_rel);
+    }
+}
+
+} // namespace ccap
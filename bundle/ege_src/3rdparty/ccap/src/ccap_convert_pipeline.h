@@ -0,0 +1,84 @@
+/**
+ * @file ccap_convert_pipeline.h
+ * @author wysaid (this@wysaid.org)
+ * @brief Worker stage converting captured frames off the capture thread, see PropertyName::ConvertWorkerCount.
+ * @date 2025-10
+ *
+ */
+
+#pragma once
+#ifndef CCAP_CONVERT_PIPELINE_H
+#define CCAP_CONVERT_PIPELINE_H
+
+#include "ccap_def.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace ccap {
+
+/// Backpressure counters of a ConvertPipeline, owned by the provider so they can be read while the pipeline restarts.
+struct ConvertPipelineStats {
+    std::atomic_uint32_t pendingFrames{ 0 };     ///< Submitted and not delivered yet
+    std::atomic_uint32_t peakPendingFrames{ 0 }; ///< Highest pendingFrames since start
+    std::atomic_uint64_t droppedFrames{ 0 };     ///< Rejected by submit() because the pipeline was full
+
+    void reset() {
+        pendingFrames = 0;
+        peakPendingFrames = 0;
+        droppedFrames = 0;
+    }
+};
+
+/**
+ * @brief The capture thread submits frames that still reference the camera buffer, worker threads convert them and
+ *  the results are delivered in submission order, one at a time.
+ *  At most workerCount + queueDepth frames are in flight (converting, queued, or waiting for an earlier frame),
+ *  this bounds the number of camera buffers held by the pipeline.
+ */
+class ConvertPipeline {
+public:
+    /// Converts one frame and returns the frame to deliver, nullptr to drop it. Runs on a worker thread.
+    using Task = std::function<std::shared_ptr<VideoFrame>()>;
+    using Deliver = std::function<void(std::shared_ptr<VideoFrame>)>;
+
+    ConvertPipeline(int workerCount, int queueDepth, ConvertPipelineStats& stats, Deliver deliver);
+
+    /// Runs the tasks already submitted (they hold camera buffers), delivers their frames and joins the workers.
+    ~ConvertPipeline();
+
+    /// @return false if the pipeline is full, the task is not run and the caller drops the frame.
+    bool submit(Task task);
+    bool isFull() const { return m_stats.pendingFrames.load(std::memory_order_acquire) >= m_capacity; }
+
+private:
+    void workerLoop();
+    void complete(uint64_t sequence, std::shared_ptr<VideoFrame> frame);
+
+private:
+    std::vector<std::thread> m_workers;
+    const uint32_t m_capacity;
+    ConvertPipelineStats& m_stats;
+    Deliver m_deliver;
+
+    std::mutex m_mutex;
+    std::condition_variable m_condition;
+    std::deque<std::pair<uint64_t, Task>> m_tasks;
+    uint64_t m_nextSequence = 0;
+    bool m_stop = false;
+
+    std::mutex m_deliverMutex; ///< Held while delivering, keeps frames in order
+    std::map<uint64_t, std::shared_ptr<VideoFrame>> m_finished;
+    uint64_t m_nextDelivery = 0;
+};
+
+} // namespace ccap
+
+#endif // CCAP_CONVERT_PIPELINE_H
@@ -0,0 +1,340 @@
+/**
+ * @file ccap_convert_scale.cpp
+ * @author wysaid (this@wysaid.org)
+ * @brief Fused YUV -> RGB conversion and resize.
+ * @date 2025-10
+ *
+ * Output rows are produced in strips of two: the source is resampled into a small I420 strip at the output size
+ * (box or bilinear), which is converted by the regular `i420To*` functions, so every conversion backend is used.
+ */
+
+#include "ccap_convert_scale.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+namespace ccap {
+
+namespace {
+
+/// One image plane, `step` is the byte distance between two samples of the plane (2 or 4 inside packed formats).
+struct Plane {
+    const uint8_t* data;
+    int stride;
+    int step;
+    int width;
+    int height;
+};
+
+/// Y, U and V planes of `src`, returns false for unsupported formats.
+bool getPlanes(const ScaleSource& src, Plane (&planes)[3]) {
+    const int chromaWidth = (src.width + 1) / 2;
+    const int chromaHeight = (src.height + 1) / 2;
+
+    if (pixelFormatInclude(src.format, PixelFormat::NV12)) {
+        planes[0] = { src.data[0], src.stride[0], 1, src.width, src.height };
+        planes[1] = { src.data[1], src.stride[1], 2, chromaWidth, chromaHeight };
+        planes[2] = { src.data[1] + 1, src.stride[1], 2, chromaWidth, chromaHeight };
+    } else if (pixelFormatInclude(src.format, PixelFormat::I420)) {
+        planes[0] = { src.data[0], src.stride[0], 1, src.width, src.height };
+        planes[1] = { src.data[1], src.stride[1], 1, chromaWidth, chromaHeight };
+        planes[2] = { src.data[2], src.stride[2], 1, chromaWidth, chromaHeight };
+    } else if (pixelFormatInclude(src.format, PixelFormat::NV21)) { // Interleaved VU
+        planes[0] = { src.data[0], src.stride[0], 1, src.width, src.height };
+        planes[1] = { src.data[1] + 1, src.stride[1], 2, chromaWidth, chromaHeight };
+        planes[2] = { src.data[1], src.stride[1], 2, chromaWidth, chromaHeight };
+    } else if (pixelFormatInclude(src.format, PixelFormat::YV12)) { // V plane first
+        planes[0] = { src.data[0], src.stride[0], 1, src.width, src.height };
+        planes[1] = { src.data[2], src.stride[2], 1, chromaWidth, chromaHeight };
+        planes[2] = { src.data[1], src.stride[1], 1, chromaWidth, chromaHeight };
+    } else if (pixelFormatInclude(src.format, PixelFormat::YUYV)) { // Y0 U0 Y1 V0
+        planes[0] = { src.data[0], src.stride[0], 2, src.width, src.height };
+        planes[1] = { src.data[0] + 1, src.stride[0], 4, chromaWidth, src.height };
+        planes[2] = { src.data[0] + 3, src.stride[0], 4, chromaWidth, src.height };
+    } else if (pixelFormatInclude(src.format, PixelFormat::UYVY)) { // U0 Y0 V0 Y1
+        planes[0] = { src.data[0] + 1, src.stride[0], 2, src.width, src.height };
+        planes[1] = { src.data[0], src.stride[0], 4, chromaWidth, src.height };
+        planes[2] = { src.data[0] + 2, src.stride[0], 4, chromaWidth, src.height };
+    } else {
+        return false;
+    }
+    return true;
+}
+
+typedef void (*I420ToRgbFunc)(const uint8_t* srcY, int srcYStride, const uint8_t* srcU, int srcUStride, const uint8_t* srcV, int srcVStride,
+                              uint8_t* dst, int dstStride, int width, int height, ConvertFlag flag);
+
+I420ToRgbFunc getI420ToRgbFunc(PixelFormat dstFormat) {
+    switch (dstFormat) {
+    case PixelFormat::BGR24:
+        return i420ToBgr24;
+    case PixelFormat::RGB24:
+        return i420ToRgb24;
+    case PixelFormat::BGRA32:
+        return i420ToBgra32;
+    case PixelFormat::RGBA32:
+        return i420ToRgba32;
+    default:
+        return nullptr;
+    }
+}
+
+/// 2 or 4 if the source is that multiple of the output size in both directions, 0 otherwise.
+int getBoxFactor(int srcWidth, int srcHeight, int dstWidth, int dstHeight) {
+    for (int factor : { 2, 4 }) {
+        if (srcWidth / factor == dstWidth && srcHeight / factor == dstHeight) {
+            return factor;
+        }
+    }
+    return 0;
+}
+
+inline int alignTo32(int size) { return (size + 31) & ~31; }
+
+constexpr int log2OfPowerOfTwo(int value) { return value > 1 ? 1 + log2OfPowerOfTwo(value / 2) : 0; }
+
+/// Average of `fx x fy` blocks, `rows` are the fy source rows of the block row.
+template <int step, int fx, int fy>
+void boxRow_imp(const uint8_t* const* rows, uint8_t* out, int count) {
+    constexpr int shift = log2OfPowerOfTwo(fx * fy);
+    for (int x = 0; x < count; ++x) {
+        const int offset = x * fx * step;
+        int sum = 0;
+        for (int j = 0; j < fy; ++j) {
+            for (int i = 0; i < fx; ++i) {
+                sum += rows[j][offset + i * step];
+            }
+        }
+        out[x] = static_cast<uint8_t>((sum + (1 << shift >> 1)) >> shift);
+    }
+}
+
+/// Only the block sizes used by 2x and 4x reduction to a 4:2:0 strip: luma and 4:2:0 chroma use fx == fy, 4:2:2 chroma fy == 2 * fx.
+template <int step>
+void boxRowStep(const uint8_t* const* rows, int fx, int fy, uint8_t* out, int count) {
+    if (fx == 2) {
+        if (fy == 2) {
+            boxRow_imp<step, 2, 2>(rows, out, count);
+        } else {
+            boxRow_imp<step, 2, 4>(rows, out, count);
+        }
+    } else {
+        if (fy == 4) {
+            boxRow_imp<step, 4, 4>(rows, out, count);
+        } else {
+            boxRow_imp<step, 4, 8>(rows, out, count);
+        }
+    }
+}
+
+/// Box filter block row `blockRow` of `plane` into `count` samples. Blocks crossing the plane border (odd output sizes) are clamped.
+void boxRow(const Plane& plane, int fx, int fy, int blockRow, uint8_t* out, int count) {
+    const uint8_t* rows[8];
+    for (int j = 0; j < fy; ++j) {
+        rows[j] = plane.data + std::min(blockRow * fy + j, plane.height - 1) * plane.stride;
+    }
+
+    const int fullBlocks = std::min(count, plane.width / fx);
+    switch (plane.step) {
+    case 1:
+        boxRowStep<1>(rows, fx, fy, out, fullBlocks);
+        break;
+    case 2:
+        boxRowStep<2>(rows, fx, fy, out, fullBlocks);
+        break;
+    default:
+        boxRowStep<4>(rows, fx, fy, out, fullBlocks);
+        break;
+    }
+
+    for (int x = fullBlocks; x < count; ++x) {
+        int sum = 0;
+        for (int j = 0; j < fy; ++j) {
+            for (int i = 0; i < fx; ++i) {
+                sum += rows[j][std::min(x * fx + i, plane.width - 1) * plane.step];
+            }
+        }
+        out[x] = static_cast<uint8_t>((sum + fx * fy / 2) / (fx * fy));
+    }
+}
+
+/// Two neighbouring source samples and the weight of the second one in 1/256.
+struct Tap {
+    int offset0; ///< Sample index multiplied by the step (columns) or the sample index (rows)
+    int offset1;
+    int weight;
+};
+
+/// Output sample `i` maps to this source position in 1/256, with pixel centers aligned and clamped to the plane.
+inline Tap makeTap(int i, int srcSize, int dstSize, int step) {
+    int64_t pos = ((2 * static_cast<int64_t>(i) + 1) * srcSize * 256) / (2 * static_cast<int64_t>(dstSize)) - 128;
+    pos = std::clamp<int64_t>(pos, 0, static_cast<int64_t>(srcSize - 1) * 256);
+    int index = static_cast<int>(pos >> 8);
+    return { index * step, std::min(index + 1, srcSize - 1) * step, static_cast<int>(pos & 255) };
+}
+
+void bilinearRow(const Plane& plane, const Tap* columns, const Tap& row, uint8_t* out, int count) {
+    const uint8_t* row0 = plane.data + row.offset0 * plane.stride;
+    const uint8_t* row1 = plane.data + row.offset1 * plane.stride;
+    const int wy = row.weight;
+
+    for (int x = 0; x < count; ++x) {
+        const Tap& tap = columns[x];
+        int top = row0[tap.offset0] * (256 - tap.weight) + row0[tap.offset1] * tap.weight;
+        int bottom = row1[tap.offset0] * (256 - tap.weight) + row1[tap.offset1] * tap.weight;
+        out[x] = static_cast<uint8_t>((top * (256 - wy) + bottom * wy + 32768) >> 16);
+    }
+}
+
+} // namespace
+
+bool yuvToRgbScaledRows(const ScaleSource& src, uint8_t* dst, int dstStride, int dstWidth, int dstHeight, PixelFormat dstFormat,
+                        ScaleFilter filter, ConvertFlag flag, int rowBegin, int rowEnd) {
+    Plane planes[3];
+    const int height = std::abs(dstHeight);
+    if (src.width <= 0 || src.height <= 0 || dstWidth <= 0 || dstHeight == 0 || rowBegin < 0 || (rowBegin & 1) != 0 || rowEnd > height ||
+        !getPlanes(src, planes)) {
+        return false;
+    }
+
+    I420ToRgbFunc convert = getI420ToRgbFunc(dstFormat);
+    if (convert == nullptr) {
+        return false;
+    }
+
+    const int boxFactor = filter == ScaleFilter::Bilinear ? 0 : getBoxFactor(src.width, src.height, dstWidth, height);
+    if (filter == ScaleFilter::Box && boxFactor == 0) {
+        return false;
+    }
+
+    if (rowBegin >= rowEnd) {
+        return true;
+    }
+
+    const Plane& lumaPlane = planes[0];
+    const Plane& chromaPlane = planes[1]; // U and V share the layout
+
+    // The strip is 4:2:0 at the output size. The converters write pixel pairs, so an odd width is converted to a scratch strip first.
+    const int chromaWidth = (dstWidth + 1) / 2;
+    const int chromaHeight = (height + 1) / 2;
+    const int stripWidth = chromaWidth * 2;
+    const int channels = pixelFormatInclude(dstFormat, kPixelFormatAlphaColorBit) ? 4 : 3;
+    const bool isOddWidth = stripWidth != dstWidth;
+    const int lumaStride = alignTo32(stripWidth);
+    const int chromaStride = alignTo32(chromaWidth);
+    const int scratchStride = isOddWidth ? alignTo32(stripWidth * channels) : 0;
+
+    std::vector<uint8_t> buffer(lumaStride * 2 + chromaStride * 2 + scratchStride * 2 + 31);
+    uint8_t* stripY = reinterpret_cast<uint8_t*>((reinterpret_cast<uintptr_t>(buffer.data()) + 31) & ~static_cast<uintptr_t>(31));
+    uint8_t* stripU = stripY + lumaStride * 2;
+    uint8_t* stripV = stripU + chromaStride;
+    uint8_t* scratch = stripV + chromaStride;
+
+    // Box: 4:2:2 chroma has full height, so its blocks are twice as tall.
+    const int chromaFy = chromaPlane.height == lumaPlane.height ? boxFactor * 2 : boxFactor;
+
+    std::vector<Tap> lumaColumns, chromaColumns;
+    if (boxFactor == 0) {
+        lumaColumns.resize(dstWidth);
+        chromaColumns.resize(chromaWidth);
+        for (int x = 0; x < dstWidth; ++x) {
+            lumaColumns[x] = makeTap(x, lumaPlane.width, dstWidth, lumaPlane.step);
+        }
+        for (int x = 0; x < chromaWidth; ++x) {
+            chromaColumns[x] = makeTap(x, chromaPlane.width, chromaWidth, chromaPlane.step);
+        }
+    }
+
+    for (int y = rowBegin; y < rowEnd; y += 2) {
+        const int rows = std::min(2, rowEnd - y);
+
+        for (int r = 0; r < rows; ++r) {
+            uint8_t* rowY = stripY + r * lumaStride;
+            if (boxFactor != 0) {
+                boxRow(lumaPlane, boxFactor, boxFactor, y + r, rowY, dstWidth);
+            } else {
+                bilinearRow(lumaPlane, lumaColumns.data(), makeTap(y + r, lumaPlane.height, height, 1), rowY, dstWidth);
+            }
+            if (isOddWidth) {
+                rowY[dstWidth] = rowY[dstWidth - 1];
+            }
+        }
+
+        if (boxFactor != 0) {
+            boxRow(planes[1], boxFactor, chromaFy, y / 2, stripU, chromaWidth);
+            boxRow(planes[2], boxFactor, chromaFy, y / 2, stripV, chromaWidth);
+        } else {
+            Tap chromaRow = makeTap(y / 2, chromaPlane.height, chromaHeight, 1);
+            bilinearRow(planes[1], chromaColumns.data(), chromaRow, stripU, chromaWidth);
+            bilinearRow(planes[2], chromaColumns.data(), chromaRow, stripV, chromaWidth);
+        }
+
+        if (isOddWidth) {
+            convert(stripY, lumaStride, stripU, chromaStride, stripV, chromaStride, scratch, scratchStride, stripWidth, rows, flag);
+            for (int r = 0; r < rows; ++r) {
+                int dstRow = dstHeight < 0 ? height - 1 - (y + r) : y + r;
+                std::memcpy(dst + dstRow * dstStride, scratch + r * scratchStride, dstWidth * channels);
+            }
+        } else {
+            // A negative height writes the strip bottom-up, starting from its last row.
+            uint8_t* dstStrip = dst + (dstHeight < 0 ? height - y - rows : y) * dstStride;
+            convert(stripY, lumaStride, stripU, chromaStride, stripV, chromaStride, dstStrip, dstStride, stripWidth, dstHeight < 0 ? -rows : rows, flag);
+        }
+    }
+    return true;
+}
+
+bool nv12ToRgbScaled(const uint8_t* srcY, int srcYStride, const uint8_t* srcUV, int srcUVStride, int srcWidth, int srcHeight, uint8_t* dst,
+                     int dstStride, int dstWidth, int dstHeight, PixelFormat dstFormat, ScaleFilter filter, ConvertFlag flag) {
+    ScaleSource src;
+    src.format = PixelFormat::NV12;
+    src.data[0] = srcY;
+    src.data[1] = srcUV;
+    src.stride[0] = srcYStride;
+    src.stride[1] = srcUVStride;
+    src.width = srcWidth;
+    src.height = srcHeight;
+    return yuvToRgbScaledRows(src, dst, dstStride, dstWidth, dstHeight, dstFormat, filter, flag, 0, std::abs(dstHeight));
+}
+
+bool i420ToRgbScaled(const uint8_t* srcY, int srcYStride, const uint8_t* srcU, int srcUStride, const uint8_t* srcV, int srcVStride, int srcWidth,
+                     int srcHeight, uint8_t* dst, int dstStride, int dstWidth, int dstHeight, PixelFormat dstFormat, ScaleFilter filter,
+                     ConvertFlag flag) {
+    ScaleSource src;
+    src.format = PixelFormat::I420;
+    src.data[0] = srcY;
+    src.data[1] = srcU;
+    src.data[2] = srcV;
+    src.stride[0] = srcYStride;
+    src.stride[1] = srcUStride;
+    src.stride[2] = srcVStride;
+    src.width = srcWidth;
+    src.height = srcHeight;
+    return yuvToRgbScaledRows(src, dst, dstStride, dstWidth, dstHeight, dstFormat, filter, flag, 0, std::abs(dstHeight));
+}
+
+bool yuyvToRgbScaled(const uint8_t* src, int srcStride, int srcWidth, int srcHeight, uint8_t* dst, int dstStride, int dstWidth, int dstHeight,
+                     PixelFormat dstFormat, ScaleFilter filter, ConvertFlag flag) {
+    ScaleSource source;
+    source.format = PixelFormat::YUYV;
+    source.data[0] = src;
+    source.stride[0] = srcStride;
+    source.width = srcWidth;
+    source.height = srcHeight;
+    return yuvToRgbScaledRows(source, dst, dstStride, dstWidth, dstHeight, dstFormat, filter, flag, 0, std::abs(dstHeight));
+}
+
+bool uyvyToRgbScaled(const uint8_t* src, int srcStride, int srcWidth, int srcHeight, uint8_t* dst, int dstStride, int dstWidth, int dstHeight,
+                     PixelFormat dstFormat, ScaleFilter filter, ConvertFlag flag) {
+    ScaleSource source;
+    source.format = PixelFormat::UYVY;
+    source.data[0] = src;
+    source.stride[0] = srcStride;
+    source.width = srcWidth;
+    source.height = srcHeight;
+    return yuvToRgbScaledRows(source, dst, dstStride, dstWidth, dstHeight, dstFormat, filter, flag, 0, std::abs(dstHeight));
+}
+
+} // namespace ccap
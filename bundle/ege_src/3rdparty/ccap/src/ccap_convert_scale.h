@@ -0,0 +1,36 @@
+/**
+ * @file ccap_convert_scale.h
+ * @author wysaid (this@wysaid.org)
+ * @brief Fused YUV -> RGB conversion and resize, row range entry used by frame conversion.
+ * @date 2025-10
+ *
+ */
+
+#pragma once
+#ifndef CCAP_CONVERT_SCALE_H
+#define CCAP_CONVERT_SCALE_H
+
+#include "ccap_convert.h"
+
+namespace ccap {
+
+/// A YUV image for the scaled converters, only the planes used by `format` (NV12/NV21/I420/YV12/YUYV/UYVY) are read.
+struct ScaleSource {
+    PixelFormat format = PixelFormat::Unknown;
+    const uint8_t* data[3] = {};
+    int stride[3] = {};
+    int width = 0;
+    int height = 0;
+};
+
+/**
+ * @brief Convert the output rows [rowBegin, rowEnd) of a `dstWidth x abs(dstHeight)` image, see `nv12ToRgbScaled`.
+ *  `dst` always points to the whole output image, so row bands can run on different threads. rowBegin must be even.
+ * @return false if an argument is not supported, nothing is written in that case.
+ */
+bool yuvToRgbScaledRows(const ScaleSource& src, uint8_t* dst, int dstStride, int dstWidth, int dstHeight, PixelFormat dstFormat,
+                        ScaleFilter filter, ConvertFlag flag, int rowBegin, int rowEnd);
+
+} // namespace ccap
+
+#endif // CCAP_CONVERT_SCALE_H
@@ -0,0 +1,484 @@
+/**
+ * @file ccap_convert_ssse3.cpp
+ * @author wysaid (this@wysaid.org)
+ * @date 2025-10
+ *
+ */
+
+#include "ccap_convert_ssse3.h"
+
+#include <cassert>
+#include <cstring>
+
+#if ENABLE_SSSE3_IMP
+
+#if defined(__GNUC__) || defined(__clang__)
+#define SSSE3_TARGET __attribute__((target("ssse3")))
+#else
+#define SSSE3_TARGET
+#endif
+
+#include <tmmintrin.h> // SSSE3
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+inline bool hasSSSE3_() {
+    int cpuInfo[4];
+    __cpuid(cpuInfo, 1);
+    return (cpuInfo[2] & (1 << 9)) != 0;
+}
+#elif defined(__GNUC__) || defined(__clang__)
+#include <cpuid.h>
+inline bool hasSSSE3_() {
+    unsigned int eax, ebx, ecx, edx;
+    if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx)) return false;
+    return (ecx & (1 << 9)) != 0; // SSSE3 bit
+}
+#else
+inline bool hasSSSE3_() { return false; }
+#endif
+
+#endif
+
+namespace ccap {
+bool sEnableSSSE3 = true;
+
+bool enableSSSE3(bool enable) {
+    sEnableSSSE3 = enable;
+    return hasSSSE3() && sEnableSSSE3;
+}
+
+bool hasSSSE3() {
+#if ENABLE_SSSE3_IMP
+    static bool s_hasSSSE3 = hasSSSE3_();
+    return s_hasSSSE3;
+#else
+    return false;
+#endif
+}
+
+bool canUseSSSE3() {
+    return hasSSSE3() && sEnableSSSE3;
+}
+
+const char* getSSSE3SupportInfo() {
+#if ENABLE_SSSE3_IMP
+    if (hasSSSE3()) {
+        return sEnableSSSE3 ? "SSSE3: Hardware supported and enabled" : "SSSE3: Hardware supported but disabled by software";
+    }
+    return "SSSE3: Not supported by hardware";
+#else
+    return "SSSE3: Disabled at compile time";
+#endif
+}
+
+#if ENABLE_SSSE3_IMP
+
+namespace {
+
+/// Shuffle control for `pshufb`, 0x80 clears the byte
+struct ShuffleTable {
+    alignas(16) uint8_t v[16];
+};
+
+template <typename Fn>
+constexpr ShuffleTable makeShuffleTable(Fn fn) {
+    ShuffleTable table{};
+    for (int i = 0; i < 16; ++i) table.v[i] = static_cast<uint8_t>(fn(i));
+    return table;
+}
+
+// NV12 chroma up-sampling, 8 UV pairs -> 16 U and 16 V
+constexpr ShuffleTable kNV12U = makeShuffleTable([](int i) { return i & ~1; });
+constexpr ShuffleTable kNV12V = makeShuffleTable([](int i) { return i | 1; });
+
+// Packed 4:2:2, 8 pixels (16 bytes) -> 8 Y / U / V in the low half
+constexpr ShuffleTable kYUYV_Y = makeShuffleTable([](int i) { return i < 8 ? i * 2 : 0x80; });
+constexpr ShuffleTable kYUYV_U = makeShuffleTable([](int i) { return i < 8 ? (i >> 1) * 4 + 1 : 0x80; });
+constexpr ShuffleTable kYUYV_V = makeShuffleTable([](int i) { return i < 8 ? (i >> 1) * 4 + 3 : 0x80; });
+constexpr ShuffleTable kUYVY_Y = makeShuffleTable([](int i) { return i < 8 ? i * 2 + 1 : 0x80; });
+constexpr ShuffleTable kUYVY_U = makeShuffleTable([](int i) { return i < 8 ? (i >> 1) * 4 : 0x80; });
+constexpr ShuffleTable kUYVY_V = makeShuffleTable([](int i) { return i < 8 ? (i >> 1) * 4 + 2 : 0x80; });
+
+/// 16 pixels of 3 planes -> 48 interleaved bytes: output vector `part`, bytes taken from plane `channel`
+constexpr int interleave3(int part, int channel, int i) {
+    int outByte = part * 16 + i;
+    return outByte % 3 == channel ? outByte / 3 : 0x80;
+}
+
+constexpr ShuffleTable kInterleave3[3][3] = {
+    { makeShuffleTable([](int i) { return interleave3(0, 0, i); }), makeShuffleTable([](int i) { return interleave3(0, 1, i); }),
+      makeShuffleTable([](int i) { return interleave3(0, 2, i); }) },
+    { makeShuffleTable([](int i) { return interleave3(1, 0, i); }), makeShuffleTable([](int i) { return interleave3(1, 1, i); }),
+      makeShuffleTable([](int i) { return interleave3(1, 2, i); }) },
+    { makeShuffleTable([](int i) { return interleave3(2, 0, i); }), makeShuffleTable([](int i) { return interleave3(2, 1, i); }),
+      makeShuffleTable([](int i) { return interleave3(2, 2, i); }) },
+};
+
+SSSE3_TARGET inline __m128i loadTable(const ShuffleTable& table) {
+    return _mm_load_si128((const __m128i*)table.v);
+}
+
+inline void getYuvToRgbCoefficients(bool isBT601, bool isFullRange, int& cy, int& cr, int& cgu, int& cgv, int& cb) {
+    if (isBT601) {
+        if (isFullRange) { // BT.601 Full Range: 256, 351, 86, 179, 443 (divided by 4)
+            cy = 64;
+            cr = 88;
+            cgu = 22;
+            cgv = 45;
+            cb = 111;
+        } else { // BT.601 Video Range: 298, 409, 100, 208, 516 (divided by 4)
+            cy = 75;
+            cr = 102;
+            cgu = 25;
+            cgv = 52;
+            cb = 129;
+        }
+    } else {
+        if (isFullRange) { // BT.709 Full Range: 256, 403, 48, 120, 475 (divided by 4)
+            cy = 64;
+            cr = 101;
+            cgu = 12;
+            cgv = 30;
+            cb = 119;
+        } else { // BT.709 Video Range: 298, 459, 55, 136, 541 (divided by 4)
+            cy = 75;
+            cr = 115;
+            cgu = 14;
+            cgv = 34;
+            cb = 135;
+        }
+    }
+}
+
+enum class YuvLayout {
+    NV12,
+    I420,
+    YUYV,
+    UYVY,
+};
+
+/// Bytes of each source plane read for 16 pixels
+template <YuvLayout layout>
+constexpr int kPlaneBytes[3] = {
+    layout == YuvLayout::YUYV || layout == YuvLayout::UYVY ? 32 : 16,
+    layout == YuvLayout::NV12 ? 16 : (layout == YuvLayout::I420 ? 8 : 0),
+    layout == YuvLayout::I420 ? 8 : 0,
+};
+
+struct YuvCoefficients {
+    __m128i y, r, gu, gv, b;
+};
+
+/// Converts 16 pixels. `p0`, `p1`, `p2` point at the first pixel of the block in each plane.
+template <YuvLayout layout, bool isBGR, bool hasAlpha, bool isFullRange>
+SSSE3_TARGET inline void yuvToRgbBlock_ssse3(const uint8_t* p0, const uint8_t* p1, const uint8_t* p2, uint8_t* out, const YuvCoefficients& c) {
+    const __m128i zero = _mm_setzero_si128();
+
+    // 1. Load 16 Y and the matching U/V, with U/V already repeated for each pixel
+    __m128i y8, u8, v8;
+    if constexpr (layout == YuvLayout::NV12) {
+        y8 = _mm_loadu_si128((const __m128i*)p0);
+        __m128i uv = _mm_loadu_si128((const __m128i*)p1);
+        u8 = _mm_shuffle_epi8(uv, loadTable(kNV12U));
+        v8 = _mm_shuffle_epi8(uv, loadTable(kNV12V));
+    } else if constexpr (layout == YuvLayout::I420) {
+        y8 = _mm_loadu_si128((const __m128i*)p0);
+        __m128i u = _mm_loadl_epi64((const __m128i*)p1);
+        __m128i v = _mm_loadl_epi64((const __m128i*)p2);
+        u8 = _mm_unpacklo_epi8(u, u);
+        v8 = _mm_unpacklo_epi8(v, v);
+    } else {
+        constexpr bool isYUYV = layout == YuvLayout::YUYV;
+        __m128i lo = _mm_loadu_si128((const __m128i*)p0);
+        __m128i hi = _mm_loadu_si128((const __m128i*)(p0 + 16));
+        __m128i shufY = loadTable(isYUYV ? kYUYV_Y : kUYVY_Y);
+        __m128i shufU = loadTable(isYUYV ? kYUYV_U : kUYVY_U);
+        __m128i shufV = loadTable(isYUYV ? kYUYV_V : kUYVY_V);
+        y8 = _mm_unpacklo_epi64(_mm_shuffle_epi8(lo, shufY), _mm_shuffle_epi8(hi, shufY));
+        u8 = _mm_unpacklo_epi64(_mm_shuffle_epi8(lo, shufU), _mm_shuffle_epi8(hi, shufU));
+        v8 = _mm_unpacklo_epi64(_mm_shuffle_epi8(lo, shufV), _mm_shuffle_epi8(hi, shufV));
+    }
+
+    // 2. YUV to RGB in two halves of 8 x 16 bit, saturating adds keep extreme inputs from wrapping around
+    __m128i rgb[3][2];
+    for (int half = 0; half < 2; ++half) {
+        __m128i y16 = half == 0 ? _mm_unpacklo_epi8(y8, zero) : _mm_unpackhi_epi8(y8, zero);
+        __m128i u16 = half == 0 ? _mm_unpacklo_epi8(u8, zero) : _mm_unpackhi_epi8(u8, zero);
+        __m128i v16 = half == 0 ? _mm_unpacklo_epi8(v8, zero) : _mm_unpackhi_epi8(v8, zero);
+
+        u16 = _mm_sub_epi16(u16, _mm_set1_epi16(128));
+        v16 = _mm_sub_epi16(v16, _mm_set1_epi16(128));
+        if constexpr (!isFullRange) { // Video Range: Y - 16
+            y16 = _mm_sub_epi16(y16, _mm_set1_epi16(16));
+        }
+
+        __m128i yScaled = _mm_mullo_epi16(y16, c.y);
+        __m128i round = _mm_set1_epi16(32);
+
+        __m128i r = _mm_adds_epi16(yScaled, _mm_mullo_epi16(v16, c.r));
+        __m128i g = _mm_subs_epi16(_mm_subs_epi16(yScaled, _mm_mullo_epi16(u16, c.gu)), _mm_mullo_epi16(v16, c.gv));
+        __m128i b = _mm_adds_epi16(yScaled, _mm_mullo_epi16(u16, c.b));
+
+        rgb[0][half] = _mm_srai_epi16(_mm_adds_epi16(r, round), 6);
+        rgb[1][half] = _mm_srai_epi16(_mm_adds_epi16(g, round), 6);
+        rgb[2][half] = _mm_srai_epi16(_mm_adds_epi16(b, round), 6);
+    }
+
+    // 3. Narrow with unsigned saturation, which is the 0~255 clamp
+    __m128i r8 = _mm_packus_epi16(rgb[0][0], rgb[0][1]);
+    __m128i g8 = _mm_packus_epi16(rgb[1][0], rgb[1][1]);
+    __m128i b8 = _mm_packus_epi16(rgb[2][0], rgb[2][1]);
+    __m128i c0 = isBGR ? b8 : r8;
+    __m128i c2 = isBGR ? r8 : b8;
+
+    // 4. Interleave and store
+    if constexpr (hasAlpha) {
+        __m128i a8 = _mm_set1_epi8((char)255);
+        __m128i c01lo = _mm_unpacklo_epi8(c0, g8);
+        __m128i c23lo = _mm_unpacklo_epi8(c2, a8);
+        __m128i c01hi = _mm_unpackhi_epi8(c0, g8);
+        __m128i c23hi = _mm_unpackhi_epi8(c2, a8);
+        _mm_storeu_si128((__m128i*)(out + 0), _mm_unpacklo_epi16(c01lo, c23lo));
+        _mm_storeu_si128((__m128i*)(out + 16), _mm_unpackhi_epi16(c01lo, c23lo));
+        _mm_storeu_si128((__m128i*)(out + 32), _mm_unpacklo_epi16(c01hi, c23hi));
+        _mm_storeu_si128((__m128i*)(out + 48), _mm_unpackhi_epi16(c01hi, c23hi));
+    } else {
+        for (int part = 0; part < 3; ++part) {
+            __m128i v = _mm_shuffle_epi8(c0, loadTable(kInterleave3[part][0]));
+            v = _mm_or_si128(v, _mm_shuffle_epi8(g8, loadTable(kInterleave3[part][1])));
+            v = _mm_or_si128(v, _mm_shuffle_epi8(c2, loadTable(kInterleave3[part][2])));
+            _mm_storeu_si128((__m128i*)(out + part * 16), v);
+        }
+    }
+}
+
+/// YUV -> RGB for all layouts, 16 pixels per iteration.
+/// The row tail is staged through a small stack buffer and converted by the same vector code.
+template <YuvLayout layout, bool isBGR, bool hasAlpha, bool isFullRange>
+SSSE3_TARGET void yuvToRgb_ssse3_imp(const uint8_t* src0, int stride0, const uint8_t* src1, int stride1, const uint8_t* src2, int stride2,
+                                     uint8_t* dst, int dstStride, int width, int height, bool is601) {
+    if (height < 0) {
+        height = -height;
+        dst = dst + (height - 1) * dstStride;
+        dstStride = -dstStride;
+    }
+
+    int cy, cr, cgu, cgv, cb;
+    getYuvToRgbCoefficients(is601, isFullRange, cy, cr, cgu, cgv, cb);
+
+    YuvCoefficients coeffs;
+    coeffs.y = _mm_set1_epi16(cy);
+    coeffs.r = _mm_set1_epi16(cr);
+    coeffs.gu = _mm_set1_epi16(cgu);
+    coeffs.gv = _mm_set1_epi16(cgv);
+    coeffs.b = _mm_set1_epi16(cb);
+
+    constexpr int channels = hasAlpha ? 4 : 3;
+    constexpr int bytesPerPixel0 = kPlaneBytes<layout>[0] / 16;
+    constexpr bool isPlanar = layout == YuvLayout::NV12 || layout == YuvLayout::I420;
+
+    for (int y = 0; y < height; ++y) {
+        const uint8_t* row0 = src0 + y * stride0;
+        const uint8_t* row1 = isPlanar ? src1 + (y / 2) * stride1 : nullptr;
+        const uint8_t* row2 = layout == YuvLayout::I420 ? src2 + (y / 2) * stride2 : nullptr;
+        uint8_t* dstRow = dst + y * dstStride;
+
+        int x = 0;
+        for (; x + 16 <= width; x += 16) {
+            const uint8_t* p1 = row1 ? row1 + (layout == YuvLayout::I420 ? x / 2 : x) : nullptr;
+            const uint8_t* p2 = row2 ? row2 + x / 2 : nullptr;
+            yuvToRgbBlock_ssse3<layout, isBGR, hasAlpha, isFullRange>(row0 + x * bytesPerPixel0, p1, p2, dstRow + x * channels, coeffs);
+        }
+
+        if (x < width) {
+            const int count = width - x;
+            const int chromaCount = (count + 1) & ~1;
+            alignas(16) uint8_t tail0[32] = {}, tail1[16] = {}, tail2[16] = {};
+            alignas(16) uint8_t tailOut[64];
+
+            memcpy(tail0, row0 + x * bytesPerPixel0, (layout == YuvLayout::YUYV || layout == YuvLayout::UYVY) ? chromaCount * 2 : count);
+            if constexpr (layout == YuvLayout::NV12) {
+                memcpy(tail1, row1 + x, chromaCount);
+            } else if constexpr (layout == YuvLayout::I420) {
+                memcpy(tail1, row1 + x / 2, chromaCount / 2);
+                memcpy(tail2, row2 + x / 2, chromaCount / 2);
+            }
+
+            yuvToRgbBlock_ssse3<layout, isBGR, hasAlpha, isFullRange>(tail0, tail1, tail2, tailOut, coeffs);
+            memcpy(dstRow + x * channels, tailOut, count * channels);
+        }
+    }
+}
+
+template <int inputChannels, int outputChannels, int swapRB>
+SSSE3_TARGET void colorShuffle_ssse3_imp(const uint8_t* src, int srcStride, uint8_t* dst, int dstStride, int width, int height) {
+    static_assert((inputChannels == 3 || inputChannels == 4) && (outputChannels == 3 || outputChannels == 4),
+                  "inputChannels and outputChannels must be 3 or 4");
+
+    static_assert(inputChannels != outputChannels || swapRB, "swapRB must be true when inputChannels == outputChannels");
+
+    if (height < 0) {
+        height = -height;
+        dst = dst + (height - 1) * dstStride;
+        dstStride = -dstStride;
+    }
+
+    // Pixels per `pshufb`: both sides must fit in 16 bytes
+    constexpr int patchSize = (inputChannels == 4 || outputChannels == 4) ? 4 : 5;
+
+    alignas(16) uint8_t shuffleData[16];
+    alignas(16) uint8_t alphaData[16] = {};
+    memset(shuffleData, 0x80, sizeof(shuffleData));
+    for (int i = 0; i < patchSize * outputChannels; ++i) {
+        int pixel = i / outputChannels;
+        int channel = i % outputChannels;
+        if (channel == 3) {
+            if constexpr (inputChannels == 4)
+                shuffleData[i] = pixel * inputChannels + 3;
+            else
+                alphaData[i] = 0xFF; // no alpha
+        } else {
+            int srcChannel = swapRB ? 2 - channel : channel;
+            shuffleData[i] = pixel * inputChannels + srcChannel;
+        }
+    }
+
+    const __m128i shuffle128 = _mm_load_si128((const __m128i*)shuffleData);
+    const __m128i alpha128 = _mm_load_si128((const __m128i*)alphaData);
+
+    // 16-byte loads/stores may only run while a full vector is left on both sides of the row
+    const int srcRowBytes = width * inputChannels;
+    const int dstRowBytes = width * outputChannels;
+
+    for (int y = 0; y < height; ++y) {
+        const uint8_t* srcRow = src + y * srcStride;
+        uint8_t* dstRow = dst + y * dstStride;
+
+        int x = 0;
+        for (; x * inputChannels + 16 <= srcRowBytes && x * outputChannels + 16 <= dstRowBytes; x += patchSize) {
+            __m128i pixels = _mm_loadu_si128((const __m128i*)(srcRow + x * inputChannels));
+            __m128i result = _mm_or_si128(_mm_shuffle_epi8(pixels, shuffle128), alpha128);
+            _mm_storeu_si128((__m128i*)(dstRow + x * outputChannels), result);
+        }
+
+        for (; x < width; x += patchSize) {
+            const int count = width - x < patchSize ? width - x : patchSize;
+            alignas(16) uint8_t tail[16] = {};
+            memcpy(tail, srcRow + x * inputChannels, count * inputChannels);
+            __m128i result = _mm_or_si128(_mm_shuffle_epi8(_mm_load_si128((const __m128i*)tail), shuffle128), alpha128);
+            _mm_store_si128((__m128i*)tail, result);
+            memcpy(dstRow + x * outputChannels, tail, count * outputChannels);
+        }
+    }
+}
+
+} // namespace
+
+template <int inputChannels, int outputChannels, int swapRB>
+void colorShuffle_ssse3(const uint8_t* src, int srcStride, uint8_t* dst, int dstStride, int width, int height) {
+    colorShuffle_ssse3_imp<inputChannels, outputChannels, swapRB>(src, srcStride, dst, dstStride, width, height);
+}
+
+template void colorShuffle_ssse3<4, 4, true>(const uint8_t* src, int srcStride, uint8_t* dst, int dstStride, int width, int height);
+
+template void colorShuffle_ssse3<4, 3, true>(const uint8_t* src, int srcStride, uint8_t* dst, int dstStride, int width, int height);
+
+template void colorShuffle_ssse3<4, 3, false>(const uint8_t* src, int srcStride, uint8_t* dst, int dstStride, int width, int height);
+
+template void colorShuffle_ssse3<3, 4, true>(const uint8_t* src, int srcStride, uint8_t* dst, int dstStride, int width, int height);
+
+template void colorShuffle_ssse3<3, 4, false>(const uint8_t* src, int srcStride, uint8_t* dst, int dstStride, int width, int height);
+
+template void colorShuffle_ssse3<3, 3, true>(const uint8_t* src, int srcStride, uint8_t* dst, int dstStride, int width, int height);
+
+template <YuvLayout layout, bool isBGR, bool hasAlpha>
+void yuvToRgb_ssse3(const uint8_t* src0, int stride0, const uint8_t* src1, int stride1, const uint8_t* src2, int stride2,
+                    uint8_t* dst, int dstStride, int width, int height, ConvertFlag flag) {
+    const bool is601 = (flag & ConvertFlag::BT601) != 0;
+    const bool isFullRange = (flag & ConvertFlag::FullRange) != 0;
+
+    if (isFullRange) {
+        yuvToRgb_ssse3_imp<layout, isBGR, hasAlpha, true>(src0, stride0, src1, stride1, src2, stride2, dst, dstStride, width, height, is601);
+    } else {
+        yuvToRgb_ssse3_imp<layout, isBGR, hasAlpha, false>(src0, stride0, src1, stride1, src2, stride2, dst, dstStride, width, height, is601);
+    }
+}
+
+void nv12ToBgra32_ssse3(const uint8_t* srcY, int srcYStride, const uint8_t* srcUV, int srcUVStride, uint8_t* dst, int dstStride, int width,
+                        int height, ConvertFlag flag) {
+    yuvToRgb_ssse3<YuvLayout::NV12, true, true>(srcY, srcYStride, srcUV, srcUVStride, nullptr, 0, dst, dstStride, width, height, flag);
+}
+
+void nv12ToRgba32_ssse3(const uint8_t* srcY, int srcYStride, const uint8_t* srcUV, int srcUVStride, uint8_t* dst, int dstStride, int width,
+                        int height, ConvertFlag flag) {
+    yuvToRgb_ssse3<YuvLayout::NV12, false, true>(srcY, srcYStride, srcUV, srcUVStride, nullptr, 0, dst, dstStride, width, height, flag);
+}
+
+void nv12ToBgr24_ssse3(const uint8_t* srcY, int srcYStride, const uint8_t* srcUV, int srcUVStride, uint8_t* dst, int dstStride, int width,
+                       int height, ConvertFlag flag) {
+    yuvToRgb_ssse3<YuvLayout::NV12, true, false>(srcY, srcYStride, srcUV, srcUVStride, nullptr, 0, dst, dstStride, width, height, flag);
+}
+
+void nv12ToRgb24_ssse3(const uint8_t* srcY, int srcYStride, const uint8_t* srcUV, int srcUVStride, uint8_t* dst, int dstStride, int width,
+                       int height, ConvertFlag flag) {
+    yuvToRgb_ssse3<YuvLayout::NV12, false, false>(srcY, srcYStride, srcUV, srcUVStride, nullptr, 0, dst, dstStride, width, height, flag);
+}
+
+void i420ToBgra32_ssse3(const uint8_t* srcY, int srcYStride, const uint8_t* srcU, int srcUStride, const uint8_t* srcV, int srcVStride,
+                        uint8_t* dst, int dstStride, int width, int height, ConvertFlag flag) {
+    yuvToRgb_ssse3<YuvLayout::I420, true, true>(srcY, srcYStride, srcU, srcUStride, srcV, srcVStride, dst, dstStride, width, height, flag);
+}
+
+void i420ToRgba32_ssse3(const uint8_t* srcY, int srcYStride, const uint8_t* srcU, int srcUStride, const uint8_t* srcV, int srcVStride,
+                        uint8_t* dst, int dstStride, int width, int height, ConvertFlag flag) {
+    yuvToRgb_ssse3<YuvLayout::I420, false, true>(srcY, srcYStride, srcU, srcUStride, srcV, srcVStride, dst, dstStride, width, height, flag);
+}
+
+void i420ToBgr24_ssse3(const uint8_t* srcY, int srcYStride, const uint8_t* srcU, int srcUStride, const uint8_t* srcV, int srcVStride,
+                       uint8_t* dst, int dstStride, int width, int height, ConvertFlag flag) {
+    yuvToRgb_ssse3<YuvLayout::I420, true, false>(srcY, srcYStride, srcU, srcUStride, srcV, srcVStride, dst, dstStride, width, height, flag);
+}
+
+void i420ToRgb24_ssse3(const uint8_t* srcY, int srcYStride, const uint8_t* srcU, int srcUStride, const uint8_t* srcV, int srcVStride,
+                       uint8_t* dst, int dstStride, int width, int height, ConvertFlag flag) {
+    yuvToRgb_ssse3<YuvLayout::I420, false, false>(srcY, srcYStride, srcU, srcUStride, srcV, srcVStride, dst, dstStride, width, height, flag);
+}
+
+///////////// YUYV/UYVY to RGB functions /////////////
+
+void yuyvToBgr24_ssse3(const uint8_t* src, int srcStride, uint8_t* dst, int dstStride, int width, int height, ConvertFlag flag) {
+    yuvToRgb_ssse3<YuvLayout::YUYV, true, false>(src, srcStride, nullptr, 0, nullptr, 0, dst, dstStride, width, height, flag);
+}
+
+void yuyvToRgb24_ssse3(const uint8_t* src, int srcStride, uint8_t* dst, int dstStride, int width, int height, ConvertFlag flag) {
+    yuvToRgb_ssse3<YuvLayout::YUYV, false, false>(src, srcStride, nullptr, 0, nullptr, 0, dst, dstStride, width, height, flag);
+}
+
+void yuyvToBgra32_ssse3(const uint8_t* src, int srcStride, uint8_t* dst, int dstStride, int width, int height, ConvertFlag flag) {
+    yuvToRgb_ssse3<YuvLayout::YUYV, true, true>(src, srcStride, nullptr, 0, nullptr, 0, dst, dstStride, width, height, flag);
+}
+
+void yuyvToRgba32_ssse3(const uint8_t* src, int srcStride, uint8_t* dst, int dstStride, int width, int height, ConvertFlag flag) {
+    yuvToRgb_ssse3<YuvLayout::YUYV, false, true>(src, srcStride, nullptr, 0, nullptr, 0, dst, dstStride, width, height, flag);
+}
+
+void uyvyToBgr24_ssse3(const uint8_t* src, int srcStride, uint8_t* dst, int dstStride, int width, int height, ConvertFlag flag) {
+    yuvToRgb_ssse3<YuvLayout::UYVY, true, false>(src, srcStride, nullptr, 0, nullptr, 0, dst, dstStride, width, height, flag);
+}
+
+void uyvyToRgb24_ssse3(const uint8_t* src, int srcStride, uint8_t* dst, int dstStride, int width, int height, ConvertFlag flag) {
+    yuvToRgb_ssse3<YuvLayout::UYVY, false, false>(src, srcStride, nullptr, 0, nullptr, 0, dst, dstStride, width, height, flag);
+}
+
+void uyvyToBgra32_ssse3(const uint8_t* src, int srcStride, uint8_t* dst, int dstStride, int width, int height, ConvertFlag flag) {
+    yuvToRgb_ssse3<YuvLayout::UYVY, true, true>(src, srcStride, nullptr, 0, nullptr, 0, dst, dstStride, width, height, flag);
+}
+
+void uyvyToRgba32_ssse3(const uint8_t* src, int srcStride, uint8_t* dst, int dstStride, int width, int height, ConvertFlag flag) {
+    yuvToRgb_ssse3<YuvLayout::UYVY, false, true>(src, srcStride, nullptr, 0, nullptr, 0, dst, dstStride, width, height, flag);
+}
+
+#endif
+
+} // namespace ccap
@@ -0,0 +1,157 @@
+/**
+ * @file ccap_convert_ssse3.h
+ * @author wysaid (this@wysaid.org)
+ * @date 2025-10
+ *
+ */
+
+#pragma once
+#ifndef CCAP_CONVERT_SSSE3_H
+#define CCAP_CONVERT_SSSE3_H
+
+#include "ccap_convert.h"
+
+#include <cstdint>
+
+#if __APPLE__
+#include <TargetConditionals.h>
+#endif
+
+#ifndef ENABLE_SSSE3_IMP
+#if (defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)) && \
+    !(defined(__APPLE__) && ((defined(TARGET_OS_IOS) && TARGET_OS_IOS) || (defined(TARGET_OS_IPHONE) && TARGET_OS_IPHONE)))
+#define ENABLE_SSSE3_IMP 1
+#else
+#define ENABLE_SSSE3_IMP 0
+#endif
+#endif
+
+namespace ccap {
+
+// Get detailed SSSE3 support information (for debugging)
+const char* getSSSE3SupportInfo();
+
+#if ENABLE_SSSE3_IMP
+
+/// 128-bit fallback for x86 CPUs without AVX2, only SSSE3 (`pshufb`) is required, see `hasSSSE3()`.
+
+template <int inputChannels, int outputChannels, int swapRB>
+void colorShuffle_ssse3(const uint8_t* src, int srcStride,
+                         uint8_t* dst, int dstStride,
+                         int width, int height);
+
+// NV12 to BGRA32, SSSE3 accelerated
+void nv12ToBgra32_ssse3(const uint8_t* srcY, int srcYStride,
+                         const uint8_t* srcUV, int srcUVStride,
+                         uint8_t* dst, int dstStride,
+                         int width, int height, ConvertFlag flag);
+
+// NV12 to RGBA32, SSSE3 accelerated
+void nv12ToRgba32_ssse3(const uint8_t* srcY, int srcYStride,
+                         const uint8_t* srcUV, int srcUVStride,
+                         uint8_t* dst, int dstStride,
+                         int width, int height, ConvertFlag flag);
+
+// NV12 to BGR24, SSSE3 accelerated
+void nv12ToBgr24_ssse3(const uint8_t* srcY, int srcYStride,
+                        const uint8_t* srcUV, int srcUVStride,
+                        uint8_t* dst, int dstStride,
+                        int width, int height, ConvertFlag flag);
+
+// NV12 to RGB24, SSSE3 accelerated
+void nv12ToRgb24_ssse3(const uint8_t* srcY, int srcYStride,
+                        const uint8_t* srcUV, int srcUVStride,
+                        uint8_t* dst, int dstStride,
+                        int width, int height, ConvertFlag flag);
+
+// I420 to BGRA32, SSSE3 accelerated
+void i420ToBgra32_ssse3(const uint8_t* srcY, int srcYStride,
+                         const uint8_t* srcU, int srcUStride,
+                         const uint8_t* srcV, int srcVStride,
+                         uint8_t* dst, int dstStride,
+                         int width, int height, ConvertFlag flag);
+
+// I420 to RGBA32, SSSE3 accelerated
+void i420ToRgba32_ssse3(const uint8_t* srcY, int srcYStride,
+                         const uint8_t* srcU, int srcUStride,
+                         const uint8_t* srcV, int srcVStride,
+                         uint8_t* dst, int dstStride,
+                         int width, int height, ConvertFlag flag);
+
+// I420 to BGR24, SSSE3 accelerated
+void i420ToBgr24_ssse3(const uint8_t* srcY, int srcYStride,
+                        const uint8_t* srcU, int srcUStride,
+                        const uint8_t* srcV, int srcVStride,
+                        uint8_t* dst, int dstStride,
+                        int width, int height, ConvertFlag flag);
+
+// I420 to RGB24, SSSE3 accelerated
+void i420ToRgb24_ssse3(const uint8_t* srcY, int srcYStride,
+                        const uint8_t* srcU, int srcUStride,
+                        const uint8_t* srcV, int srcVStride,
+                        uint8_t* dst, int dstStride,
+                        int width, int height, ConvertFlag flag);
+
+// YUYV to BGR24, SSSE3 accelerated
+void yuyvToBgr24_ssse3(const uint8_t* src, int srcStride,
+                        uint8_t* dst, int dstStride,
+                        int width, int height, ConvertFlag flag);
+
+// YUYV to RGB24, SSSE3 accelerated
+void yuyvToRgb24_ssse3(const uint8_t* src, int srcStride,
+                        uint8_t* dst, int dstStride,
+                        int width, int height, ConvertFlag flag);
+
+// YUYV to BGRA32, SSSE3 accelerated
+void yuyvToBgra32_ssse3(const uint8_t* src, int srcStride,
+                         uint8_t* dst, int dstStride,
+                         int width, int height, ConvertFlag flag);
+
+// YUYV to RGBA32, SSSE3 accelerated
+void yuyvToRgba32_ssse3(const uint8_t* src, int srcStride,
+                         uint8_t* dst, int dstStride,
+                         int width, int height, ConvertFlag flag);
+
+// UYVY to BGR24, SSSE3 accelerated
+void uyvyToBgr24_ssse3(const uint8_t* src, int srcStride,
+                        uint8_t* dst, int dstStride,
+                        int width, int height, ConvertFlag flag);
+
+// UYVY to RGB24, SSSE3 accelerated
+void uyvyToRgb24_ssse3(const uint8_t* src, int srcStride,
+                        uint8_t* dst, int dstStride,
+                        int width, int height, ConvertFlag flag);
+
+// UYVY to BGRA32, SSSE3 accelerated
+void uyvyToBgra32_ssse3(const uint8_t* src, int srcStride,
+                         uint8_t* dst, int dstStride,
+                         int width, int height, ConvertFlag flag);
+
+// UYVY to RGBA32, SSSE3 accelerated
+void uyvyToRgba32_ssse3(const uint8_t* src, int srcStride,
+                         uint8_t* dst, int dstStride,
+                         int width, int height, ConvertFlag flag);
+#else
+
+#define nv12ToBgr24_ssse3(...) assert(0 && "SSSE3 not supported")
+#define nv12ToRgb24_ssse3(...) assert(0 && "SSSE3 not supported")
+#define nv12ToBgra32_ssse3(...) assert(0 && "SSSE3 not supported")
+#define nv12ToRgba32_ssse3(...) assert(0 && "SSSE3 not supported")
+#define i420ToBgra32_ssse3(...) assert(0 && "SSSE3 not supported")
+#define i420ToRgba32_ssse3(...) assert(0 && "SSSE3 not supported")
+#define i420ToBgr24_ssse3(...) assert(0 && "SSSE3 not supported")
+#define i420ToRgb24_ssse3(...) assert(0 && "SSSE3 not supported")
+#define yuyvToBgr24_ssse3(...) assert(0 && "SSSE3 not supported")
+#define yuyvToRgb24_ssse3(...) assert(0 && "SSSE3 not supported")
+#define yuyvToBgra32_ssse3(...) assert(0 && "SSSE3 not supported")
+#define yuyvToRgba32_ssse3(...) assert(0 && "SSSE3 not supported")
+#define uyvyToBgr24_ssse3(...) assert(0 && "SSSE3 not supported")
+#define uyvyToRgb24_ssse3(...) assert(0 && "SSSE3 not supported")
+#define uyvyToBgra32_ssse3(...) assert(0 && "SSSE3 not supported")
+#define uyvyToRgba32_ssse3(...) assert(0 && "SSSE3 not supported")
+
+#endif
+
+} // namespace ccap
+
+#endif // CCAP_CONVERT_SSSE3_H
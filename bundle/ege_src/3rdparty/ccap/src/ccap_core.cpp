@@ -9,6 +9,7 @@
 #include "ccap_core.h"
 
 #include "ccap_imp.h"
+#include "ccap_imp_virtual.h"
 
 #include <cassert>
 #include <chrono>
@@ -137,7 +138,7 @@ Provider::~Provider() {
 }
 
 Provider::Provider(std::string_view deviceName, std::string_view extraInfo) :
-    m_imp(createProvider(extraInfo)) {
+    m_imp(isVirtualDeviceName(deviceName) ? createProviderVirtual() : createProvider(extraInfo)) {
     if (m_imp) {
         open(deviceName);
     } else {
@@ -161,7 +162,20 @@ bool Provider::open(std::string_view deviceName, bool autoStart) {
         reportError(ErrorCode::InitializationFailed, ErrorMessages::PROVIDER_IMPLEMENTATION_NULL);
         return false;
     }
-    return m_imp->open(deviceName) && (!autoStart || m_imp->start());
+
+    if (isVirtualDeviceName(deviceName) != m_imp->isVirtual()) { // Switch between the platform provider and the virtual provider
+        ProviderImp* imp = m_imp->isVirtual() ? createProvider("") : createProviderVirtual();
+        if (!imp) {
+            reportError(ErrorCode::InitializationFailed, ErrorMessages::FAILED_TO_CREATE_PROVIDER);
+            return false;
+        }
+        m_imp->close();
+        imp->inheritSettings(*m_imp);
+        delete m_imp;
+        m_imp = imp;
+    }
+
+    return m_imp->open(deviceName) && (!autoStart || start());
 }
 
 bool Provider::open(int deviceIndex, bool autoStart) {
@@ -181,7 +195,7 @@ bool Provider::open(int deviceIndex, bool autoStart) {
         }
     }
 
-    return open(deviceName) && (!autoStart || m_imp->start());
+    return open(deviceName) && (!autoStart || start());
 }
 
 bool Provider::isOpened() const { return m_imp && m_imp->isOpened(); }
@@ -199,6 +213,7 @@ bool Provider::start() {
         reportError(ErrorCode::InitializationFailed, ErrorMessages::PROVIDER_IMPLEMENTATION_NULL);
         return false;
     }
+    m_imp->resetMotionGate();
     return m_imp->start();
 }
 
@@ -258,4 +273,12 @@ void Provider::setMaxCacheFrameSize(uint32_t size) {
     m_imp->setMaxCacheFrameSize(size);
 }
 
+CaptureStats Provider::getStats() const { return m_imp ? m_imp->getStats() : CaptureStats{}; }
+
+void Provider::resetStats() {
+    if (m_imp) {
+        m_imp->resetStats();
+    }
+}
+
 } // namespace ccap
\ No newline at end of file
@@ -0,0 +1,199 @@
+/**
+ * @file ccap_frame_queue.cpp
+ * @author wysaid (this@wysaid.org)
+ * @brief Lock-free frame handoff between the capture thread and grab(): available-frame ring and free-frame pool.
+ * @date 2025-10
+ *
+ */
+
+#include "ccap_frame_queue.h"
+
+#include "ccap_utils.h"
+
+#include <climits>
+
+#ifdef __linux__
+#include <ctime>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace ccap {
+
+#ifdef __linux__
+namespace {
+inline void futexWait(std::atomic<uint32_t>* word, uint32_t expected, const timespec* timeout) {
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(word), FUTEX_WAIT_PRIVATE, expected, timeout, nullptr, 0);
+}
+
+inline void futexWakeAll(std::atomic<uint32_t>* word) {
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(word), FUTEX_WAKE_PRIVATE, INT_MAX, nullptr, nullptr, 0);
+}
+} // namespace
+#endif
+
+FrameQueue::FrameQueue(uint32_t capacity) {
+    size_t size = 2;
+    while (size < capacity) size <<= 1;
+    m_mask = size - 1;
+    m_slots = std::make_unique<Slot[]>(size);
+    for (size_t i = 0; i < size; ++i) {
+        m_slots[i].sequence.store(i, std::memory_order_relaxed);
+    }
+}
+
+FrameQueue::~FrameQueue() = default;
+
+bool FrameQueue::tryPush(std::shared_ptr<VideoFrame>& frame) {
+    size_t pos = m_tail.load(std::memory_order_relaxed);
+    Slot* slot;
+    for (;;) {
+        slot = &m_slots[pos & m_mask];
+        size_t sequence = slot->sequence.load(std::memory_order_acquire);
+        auto diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+        if (diff == 0) {
+            if (m_tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+        } else if (diff < 0) {
+            return false; // Full
+        } else {
+            pos = m_tail.load(std::memory_order_relaxed);
+        }
+    }
+    slot->frame = std::move(frame);
+    slot->sequence.store(pos + 1, std::memory_order_release);
+    return true;
+}
+
+bool FrameQueue::tryPop(std::shared_ptr<VideoFrame>& frame) {
+    size_t pos = m_head.load(std::memory_order_relaxed);
+    Slot* slot;
+    for (;;) {
+        slot = &m_slots[pos & m_mask];
+        size_t sequence = slot->sequence.load(std::memory_order_acquire);
+        auto diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos + 1);
+        if (diff == 0) {
+            if (m_head.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+        } else if (diff < 0) {
+            return false; // Empty
+        } else {
+            pos = m_head.load(std::memory_order_relaxed);
+        }
+    }
+    frame = std::move(slot->frame);
+    slot->sequence.store(pos + m_mask + 1, std::memory_order_release);
+    return true;
+}
+
+uint32_t FrameQueue::size() const {
+    size_t head = m_head.load(std::memory_order_acquire);
+    size_t tail = m_tail.load(std::memory_order_acquire);
+    return tail > head ? static_cast<uint32_t>(tail - head) : 0;
+}
+
+void FrameQueue::notify() {
+    m_epoch.fetch_add(1, std::memory_order_seq_cst);
+    if (m_waiters.load(std::memory_order_seq_cst) == 0) return; // Nobody is blocked in grab(), no syscall
+
+#ifdef __linux__
+    futexWakeAll(&m_epoch);
+#else
+    { std::lock_guard<std::mutex> lock(m_waitMutex); }
+    m_waitCondition.notify_all();
+#endif
+}
+
+bool FrameQueue::waitFor(uint32_t epoch, std::chrono::steady_clock::time_point deadline) {
+    m_waiters.fetch_add(1, std::memory_order_seq_cst);
+    bool notified = m_epoch.load(std::memory_order_seq_cst) != epoch;
+    if (!notified) {
+        auto now = std::chrono::steady_clock::now();
+        if (now < deadline) {
+#ifdef __linux__
+            auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(deadline - now).count();
+            timespec timeout{ static_cast<time_t>(ns / 1000000000), static_cast<long>(ns % 1000000000) };
+            futexWait(&m_epoch, epoch, &timeout); // Returns at once if the epoch already changed
+            notified = m_epoch.load(std::memory_order_seq_cst) != epoch || std::chrono::steady_clock::now() < deadline;
+#else
+            std::unique_lock<std::mutex> lock(m_waitMutex);
+            notified = m_waitCondition.wait_until(lock, deadline, [&]() { return m_epoch.load(std::memory_order_seq_cst) != epoch; });
+#endif
+        }
+    }
+    m_waiters.fetch_sub(1, std::memory_order_seq_cst);
+    return notified;
+}
+
+FramePool::~FramePool() {
+    freeList(m_free);
+    freeList(m_released.exchange(nullptr, std::memory_order_acquire));
+}
+
+std::shared_ptr<VideoFrame> FramePool::acquire() {
+    if (!m_free) {
+        m_free = m_released.exchange(nullptr, std::memory_order_acquire);
+    }
+
+    const uint32_t generation = m_generation.load(std::memory_order_acquire);
+    Node* node = nullptr;
+    while (m_free && !node) {
+        Node* candidate = m_free;
+        m_free = candidate->next;
+        if (candidate->generation == generation) {
+            node = candidate;
+        } else {
+            freeNode(candidate); // Cached before clear()
+        }
+    }
+
+    if (!node) {
+        if (m_frameCount.load(std::memory_order_relaxed) >= m_maxSize.load(std::memory_order_relaxed)) {
+            CCAP_LOG_W("ccap: VideoFrame pool is full, new frame allocated...\n");
+        }
+        node = new Node();
+        node->generation = generation;
+        m_frameCount.fetch_add(1, std::memory_order_relaxed);
+    }
+    node->next = nullptr;
+    return std::shared_ptr<VideoFrame>(&node->frame, Recycler{ shared_from_this(), node });
+}
+
+void FramePool::close() {
+    m_closed.store(true, std::memory_order_seq_cst);
+    freeList(m_free);
+    m_free = nullptr;
+    freeList(m_released.exchange(nullptr, std::memory_order_seq_cst));
+}
+
+void FramePool::Recycler::operator()(VideoFrame*) const { pool->release(node); }
+
+void FramePool::release(Node* node) {
+    if (m_closed.load(std::memory_order_acquire) || node->generation != m_generation.load(std::memory_order_acquire) ||
+        m_frameCount.load(std::memory_order_relaxed) > m_maxSize.load(std::memory_order_relaxed)) {
+        freeNode(node);
+        return;
+    }
+
+    node->next = m_released.load(std::memory_order_relaxed);
+    while (!m_released.compare_exchange_weak(node->next, node, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+    }
+
+    if (m_closed.load(std::memory_order_seq_cst)) { // Closed while pushing: nobody will acquire it anymore
+        freeList(m_released.exchange(nullptr, std::memory_order_seq_cst));
+    }
+}
+
+void FramePool::freeNode(Node* node) {
+    delete node;
+    m_frameCount.fetch_sub(1, std::memory_order_relaxed);
+}
+
+void FramePool::freeList(Node* list) {
+    while (list) {
+        Node* next = list->next;
+        freeNode(list);
+        list = next;
+    }
+}
+
+} // namespace ccap
@@ -0,0 +1,126 @@
+/**
+ * @file ccap_frame_queue.h
+ * @author wysaid (this@wysaid.org)
+ * @brief Lock-free frame handoff between the capture thread and grab(): available-frame ring and free-frame pool.
+ * @date 2025-10
+ *
+ */
+
+#pragma once
+#ifndef CCAP_FRAME_QUEUE_H
+#define CCAP_FRAME_QUEUE_H
+
+#include "ccap_def.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+
+namespace ccap {
+
+/**
+ * @brief Bounded lock-free ring of frames (sequence numbered slots, see D. Vyukov's bounded MPMC queue).
+ *  Any thread may push or pop, so the producer can drop the oldest frame itself when the ring is full.
+ *  Consumers can block in `waitFor`, producers only pay for a wakeup when someone is waiting.
+ */
+class FrameQueue {
+public:
+    /// `capacity` is rounded up to a power of two, at least 2.
+    explicit FrameQueue(uint32_t capacity);
+    ~FrameQueue();
+
+    FrameQueue(const FrameQueue&) = delete;
+    FrameQueue& operator=(const FrameQueue&) = delete;
+
+    /// @return false if the ring is full, `frame` is left untouched.
+    bool tryPush(std::shared_ptr<VideoFrame>& frame);
+    bool tryPop(std::shared_ptr<VideoFrame>& frame);
+
+    /// Approximate when other threads push or pop at the same time.
+    uint32_t size() const;
+    uint32_t capacity() const { return static_cast<uint32_t>(m_mask + 1); }
+
+    /// Wake every thread blocked in `waitFor`, call after each successful push.
+    void notify();
+
+    /**
+     * @brief Block until a frame is pushed, `notify` is called, or `deadline` passes. Spurious returns are possible,
+     *  callers check the ring again. The value of `waitEpoch()` read before the emptiness check avoids lost wakeups.
+     * @return false on timeout.
+     */
+    bool waitFor(uint32_t epoch, std::chrono::steady_clock::time_point deadline);
+    uint32_t waitEpoch() const { return m_epoch.load(std::memory_order_seq_cst); }
+
+private:
+    struct Slot {
+        std::atomic<size_t> sequence;
+        std::shared_ptr<VideoFrame> frame;
+    };
+
+    std::unique_ptr<Slot[]> m_slots;
+    size_t m_mask;
+    alignas(64) std::atomic<size_t> m_head{ 0 }; ///< Next slot to pop
+    alignas(64) std::atomic<size_t> m_tail{ 0 }; ///< Next slot to push
+
+    alignas(64) std::atomic<uint32_t> m_epoch{ 0 }; ///< Bumped by notify, futex word on Linux
+    std::atomic<uint32_t> m_waiters{ 0 };
+#ifndef __linux__
+    std::mutex m_waitMutex;
+    std::condition_variable m_waitCondition;
+#endif
+};
+
+/**
+ * @brief Pool of reusable frames. Frames are handed out as shared_ptr whose deleter pushes them back onto an intrusive
+ *  lock-free free list, so a free frame is found in O(1) and a released frame is recycled without any scan or lock.
+ *  `acquire` must only be called from one thread at a time (the capture thread), frames may be released from any thread.
+ *  The pool stays alive until the last frame handed out is released.
+ */
+class FramePool : public std::enable_shared_from_this<FramePool> {
+public:
+    explicit FramePool(uint32_t maxSize) :
+        m_maxSize(maxSize) {}
+    ~FramePool();
+
+    std::shared_ptr<VideoFrame> acquire();
+
+    /// Number of frames kept for reuse, frames released while more than this are alive are freed.
+    void setMaxSize(uint32_t size) { m_maxSize.store(size, std::memory_order_relaxed); }
+
+    /// Drop every cached frame (e.g. when the allocator changes), frames in use are freed when released.
+    void clear() { m_generation.fetch_add(1, std::memory_order_acq_rel); }
+
+    /// Free all cached frames, frames released afterwards are freed instead of recycled. The pool cannot be used anymore.
+    void close();
+
+private:
+    struct Node {
+        VideoFrame frame;
+        Node* next = nullptr;
+        uint32_t generation = 0;
+    };
+
+    struct Recycler {
+        std::shared_ptr<FramePool> pool;
+        Node* node;
+        void operator()(VideoFrame* frame) const;
+    };
+
+    void release(Node* node);
+    void freeNode(Node* node);
+    void freeList(Node* list);
+
+private:
+    std::atomic<Node*> m_released{ nullptr }; ///< Pushed by any thread
+    Node* m_free = nullptr;                   ///< Owned by the acquiring thread
+    std::atomic<uint32_t> m_frameCount{ 0 };  ///< Frames alive, in use or cached
+    std::atomic<uint32_t> m_maxSize;
+    std::atomic<uint32_t> m_generation{ 0 };
+    std::atomic<bool> m_closed{ false };
+};
+
+} // namespace ccap
+
+#endif // CCAP_FRAME_QUEUE_H
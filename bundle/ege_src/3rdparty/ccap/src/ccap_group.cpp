@@ -0,0 +1,356 @@
+/**
+ * @file ccap_group.cpp
+ * @author wysaid (this@wysaid.org)
+ * @brief Multi-camera capture: ProviderGroup and grabSynchronized.
+ * @date 2025-10
+ *
+ */
+
+#include "ccap_core.h"
+#include "ccap_imp.h"
+
+#include <algorithm>
+#include <chrono>
+#include <deque>
+#include <thread>
+
+#if defined(__linux__) || defined(__linux) || defined(linux) || defined(__gnu_linux__)
+#define CCAP_GROUP_EPOLL 1
+extern "C" {
+#include <errno.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+}
+#include <cstring>
+#endif
+
+namespace ccap {
+
+class ProviderGroupImp {
+public:
+    ~ProviderGroupImp() { stop(); }
+
+    bool start();
+    void stop();
+
+    static ProviderImp* imp(Provider* provider) { return provider->m_imp; }
+
+    std::vector<Provider*> providers;
+    bool started = false;
+
+private:
+#if CCAP_GROUP_EPOLL
+    struct Watch {
+        ProviderImp* imp;
+        int fd;
+        bool paused;
+        std::chrono::steady_clock::time_point resumeAt;
+    };
+
+    bool startCaptureLoop();
+    void stopCaptureLoop();
+    void captureLoop();
+
+    std::vector<Watch> m_watches; ///< Not resized while the loop runs, epoll events point into it
+    int m_epollFd = -1;
+    int m_wakeFd = -1;
+    std::thread m_thread;
+#endif
+};
+
+bool ProviderGroupImp::start() {
+    if (started) return true;
+
+    for (size_t i = 0; i < providers.size(); ++i) {
+        ProviderImp* provider = imp(providers[i]);
+        bool ok = provider && provider->isOpened();
+        if (ok) {
+            if (provider->isStarted()) {
+                provider->stop(); // Restart without its own capture thread
+            }
+            provider->setExternalCapture(true);
+            ok = provider->start();
+        }
+
+        if (!ok) {
+            reportError(ErrorCode::DeviceStartFailed, "ProviderGroup: provider " + std::to_string(i) + " cannot be started");
+            for (size_t j = 0; j <= i; ++j) {
+                if (ProviderImp* p = imp(providers[j])) {
+                    p->stop();
+                    p->setExternalCapture(false);
+                }
+            }
+            return false;
+        }
+    }
+
+#if CCAP_GROUP_EPOLL
+    if (!startCaptureLoop()) {
+        for (auto* provider : providers) {
+            imp(provider)->stop();
+            imp(provider)->setExternalCapture(false);
+        }
+        return false;
+    }
+#endif
+
+    started = true;
+    return true;
+}
+
+void ProviderGroupImp::stop() {
+    if (!started) return;
+    started = false;
+
+#if CCAP_GROUP_EPOLL
+    stopCaptureLoop(); // Before the devices stop, a stopped device would keep the loop busy
+#endif
+
+    for (auto* provider : providers) {
+        if (ProviderImp* p = imp(provider)) {
+            p->stop();
+            p->setExternalCapture(false);
+        }
+    }
+}
+
+#if CCAP_GROUP_EPOLL
+
+bool ProviderGroupImp::startCaptureLoop() {
+    m_watches.clear();
+    for (auto* provider : providers) {
+        int fd = imp(provider)->captureFd();
+        if (fd >= 0) {
+            m_watches.push_back({ imp(provider), fd, false, {} });
+        }
+    }
+
+    if (m_watches.empty()) {
+        return true; // No provider to drive, they all run their own capture thread
+    }
+
+    m_epollFd = epoll_create1(EPOLL_CLOEXEC);
+    m_wakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    bool ok = m_epollFd >= 0 && m_wakeFd >= 0;
+
+    if (ok) {
+        struct epoll_event event = {};
+        event.events = EPOLLIN;
+        event.data.ptr = nullptr; // The wake fd
+        ok = epoll_ctl(m_epollFd, EPOLL_CTL_ADD, m_wakeFd, &event) == 0;
+    }
+
+    for (size_t i = 0; ok && i < m_watches.size(); ++i) {
+        struct epoll_event event = {};
+        event.events = EPOLLIN;
+        event.data.ptr = &m_watches[i];
+        ok = epoll_ctl(m_epollFd, EPOLL_CTL_ADD, m_watches[i].fd, &event) == 0;
+    }
+
+    if (!ok) {
+        reportError(ErrorCode::DeviceStartFailed, "ProviderGroup: epoll setup failed: " + std::string(strerror(errno)));
+        stopCaptureLoop();
+        return false;
+    }
+
+    m_thread = std::thread(&ProviderGroupImp::captureLoop, this);
+    CCAP_LOG_V("ccap: ProviderGroup capture loop started for %zu devices\n", m_watches.size());
+    return true;
+}
+
+void ProviderGroupImp::stopCaptureLoop() {
+    if (m_thread.joinable()) {
+        uint64_t one = 1;
+        (void)!write(m_wakeFd, &one, sizeof(one));
+        m_thread.join();
+    }
+
+    if (m_epollFd >= 0) {
+        ::close(m_epollFd);
+        m_epollFd = -1;
+    }
+    if (m_wakeFd >= 0) {
+        ::close(m_wakeFd);
+        m_wakeFd = -1;
+    }
+    m_watches.clear();
+}
+
+void ProviderGroupImp::captureLoop() {
+    constexpr int kMaxEvents = 16;
+    struct epoll_event events[kMaxEvents];
+
+    for (;;) {
+        // Watch again the devices whose backoff is over, and wait no longer than the next one
+        int timeoutMs = -1;
+        auto now = std::chrono::steady_clock::now();
+        for (auto& watch : m_watches) {
+            if (!watch.paused) continue;
+
+            if (watch.resumeAt <= now) {
+                struct epoll_event event = {};
+                event.events = EPOLLIN;
+                event.data.ptr = &watch;
+                epoll_ctl(m_epollFd, EPOLL_CTL_MOD, watch.fd, &event);
+                watch.paused = false;
+            } else {
+                int ms = static_cast<int>(std::chrono::duration_cast<std::chrono::milliseconds>(watch.resumeAt - now).count()) + 1;
+                timeoutMs = timeoutMs < 0 ? ms : std::min(timeoutMs, ms);
+            }
+        }
+
+        int count = epoll_wait(m_epollFd, events, kMaxEvents, timeoutMs);
+        if (count < 0) {
+            if (errno != EINTR) {
+                CCAP_LOG_E("ccap: ProviderGroup epoll_wait failed: %s\n", strerror(errno));
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            }
+            continue;
+        }
+
+        for (int i = 0; i < count; ++i) {
+            auto* watch = static_cast<Watch*>(events[i].data.ptr);
+            if (!watch) {
+                return; // Woken by stop()
+            }
+
+            int backoffMs = watch->imp->serviceCapture();
+            if (backoffMs > 0) {
+                // Level triggered: a device left readable (e.g. grab() lagging) would spin the loop
+                struct epoll_event event = {};
+                event.data.ptr = watch;
+                epoll_ctl(m_epollFd, EPOLL_CTL_MOD, watch->fd, &event);
+                watch->paused = true;
+                watch->resumeAt = std::chrono::steady_clock::now() + std::chrono::milliseconds(backoffMs);
+            }
+        }
+    }
+}
+
+#endif // CCAP_GROUP_EPOLL
+
+ProviderGroup::ProviderGroup() :
+    m_imp(new ProviderGroupImp()) {}
+
+ProviderGroup::~ProviderGroup() { delete m_imp; }
+
+bool ProviderGroup::add(Provider& provider) {
+    if (m_imp->started) {
+        reportError(ErrorCode::InitializationFailed, "ProviderGroup::add called while the group is started");
+        return false;
+    }
+    if (std::find(m_imp->providers.begin(), m_imp->providers.end(), &provider) != m_imp->providers.end()) {
+        return false;
+    }
+    m_imp->providers.push_back(&provider);
+    return true;
+}
+
+bool ProviderGroup::remove(Provider& provider) {
+    if (m_imp->started) {
+        reportError(ErrorCode::InitializationFailed, "ProviderGroup::remove called while the group is started");
+        return false;
+    }
+    auto it = std::find(m_imp->providers.begin(), m_imp->providers.end(), &provider);
+    if (it == m_imp->providers.end()) {
+        return false;
+    }
+    m_imp->providers.erase(it);
+    return true;
+}
+
+const std::vector<Provider*>& ProviderGroup::providers() const { return m_imp->providers; }
+
+bool ProviderGroup::start() { return m_imp->start(); }
+
+void ProviderGroup::stop() { m_imp->stop(); }
+
+bool ProviderGroup::isStarted() const { return m_imp->started; }
+
+std::vector<std::shared_ptr<VideoFrame>> ProviderGroup::grabSynchronized(uint32_t toleranceUs, uint32_t timeoutInMs) {
+    return ccap::grabSynchronized(m_imp->providers, toleranceUs, timeoutInMs);
+}
+
+std::vector<std::shared_ptr<VideoFrame>> grabSynchronized(const std::vector<Provider*>& providers, uint32_t toleranceUs, uint32_t timeoutInMs) {
+    constexpr size_t kHistory = 3; // Frames kept per provider while matching
+    const size_t count = providers.size();
+    if (count == 0) return {};
+
+    const uint64_t tolerance = static_cast<uint64_t>(toleranceUs) * 1000;
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutInMs);
+    std::vector<std::deque<std::shared_ptr<VideoFrame>>> pending(count);
+
+    auto remainingMs = [&]() -> uint32_t {
+        auto left = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now()).count();
+        return left > 0 ? static_cast<uint32_t>(left) : 0;
+    };
+
+    auto push = [&](size_t i, std::shared_ptr<VideoFrame> frame) {
+        pending[i].push_back(std::move(frame));
+        if (pending[i].size() > kHistory) {
+            pending[i].pop_front();
+        }
+    };
+
+    // Blocks for a new frame of provider i, false on timeout or stop
+    auto waitFrame = [&](size_t i) {
+        uint32_t timeout = remainingMs();
+        auto frame = timeout > 0 ? providers[i]->grab(timeout) : nullptr;
+        if (!frame) return false;
+        push(i, std::move(frame));
+        return true;
+    };
+
+    for (;;) {
+        for (size_t i = 0; i < count; ++i) {
+            while (auto frame = providers[i]->grab(0)) {
+                push(i, std::move(frame));
+            }
+            if (pending[i].empty() && !waitFrame(i)) {
+                return {};
+            }
+        }
+
+        // The newest frame of the slowest camera is the target, no set can be older
+        size_t slowest = 0;
+        for (size_t i = 1; i < count; ++i) {
+            if (pending[i].back()->captureTime < pending[slowest].back()->captureTime) {
+                slowest = i;
+            }
+        }
+        const uint64_t target = pending[slowest].back()->captureTime;
+
+        std::vector<std::shared_ptr<VideoFrame>> result(count);
+        uint64_t earliest = target, latest = target;
+        for (size_t i = 0; i < count; ++i) {
+            // Frames too old for this or any later target
+            while (pending[i].size() > 1 && pending[i].front()->captureTime + tolerance < target) {
+                pending[i].pop_front();
+            }
+
+            uint64_t bestDistance = UINT64_MAX;
+            for (auto& frame : pending[i]) {
+                uint64_t t = frame->captureTime;
+                uint64_t distance = t > target ? t - target : target - t;
+                if (distance < bestDistance) {
+                    bestDistance = distance;
+                    result[i] = frame;
+                }
+            }
+            earliest = std::min(earliest, result[i]->captureTime);
+            latest = std::max(latest, result[i]->captureTime);
+        }
+
+        if (latest - earliest <= tolerance) {
+            return result;
+        }
+
+        // Another camera is ahead of the target: the slowest one has to catch up
+        if (!waitFrame(slowest)) {
+            return {};
+        }
+    }
+}
+
+} // namespace ccap
@@ -8,6 +8,10 @@
 
 #include "ccap_imp.h"
 
+#include "ccap_convert_frame.h"
+#include "ccap_convert_motion.h"
+#include "ccap_jpeg.h"
+
 #include <algorithm>
 #include <cassert>
 #include <cmath>
@@ -20,9 +24,13 @@ uint8_t* DefaultAllocator::data() { return m_data; }
 
 size_t DefaultAllocator::size() { return m_size; }
 
-ProviderImp::ProviderImp() {}
+ProviderImp::ProviderImp() :
+    m_availableFrames(std::make_unique<FrameQueue>(DEFAULT_MAX_AVAILABLE_FRAME_SIZE)),
+    m_framePool(std::make_shared<FramePool>(DEFAULT_MAX_CACHE_FRAME_SIZE)) {}
 
 ProviderImp::~ProviderImp() {
+    m_convertPipeline.reset();
+    m_framePool->close();
     ccap::resetSharedAllocator();
 }
 
@@ -65,6 +73,51 @@ bool ProviderImp::set(PropertyName prop, double value) {
     case PropertyName::FrameOrientation:
         m_frameOrientation = static_cast<FrameOrientation>(static_cast<int>(value));
         break;
+    case PropertyName::OutputWidth:
+        m_frameProp.outputWidth = std::max(static_cast<int>(value), 0);
+        break;
+    case PropertyName::OutputHeight:
+        m_frameProp.outputHeight = std::max(static_cast<int>(value), 0);
+        break;
+    case PropertyName::CropX:
+        m_frameProp.cropX = std::max(static_cast<int>(value), 0);
+        break;
+    case PropertyName::CropY:
+        m_frameProp.cropY = std::max(static_cast<int>(value), 0);
+        break;
+    case PropertyName::CropWidth:
+        m_frameProp.cropWidth = std::max(static_cast<int>(value), 0);
+        break;
+    case PropertyName::CropHeight:
+        m_frameProp.cropHeight = std::max(static_cast<int>(value), 0);
+        break;
+    case PropertyName::ConvertWorkerCount:
+        m_convertWorkerCount = std::clamp(static_cast<int>(value), 0, 64);
+        break;
+    case PropertyName::ConvertQueueDepth:
+        m_convertQueueDepth = std::clamp(static_cast<int>(value), 0, 64);
+        break;
+    case PropertyName::CaptureBufferCount:
+        m_captureBufferCount = std::clamp(static_cast<int>(value), 0, 32);
+        break;
+    case PropertyName::CaptureMode: {
+        auto mode = static_cast<int>(value);
+        if (mode < static_cast<int>(CaptureMode::Default) || mode > static_cast<int>(CaptureMode::HighThroughput)) return false;
+        m_captureMode = static_cast<CaptureMode>(mode);
+        break;
+    }
+    case PropertyName::CaptureMemory: {
+        auto memory = static_cast<int>(value);
+        if (memory < static_cast<int>(CaptureMemory::Mmap) || memory > static_cast<int>(CaptureMemory::DmaBuf)) return false;
+        m_captureMemory = static_cast<CaptureMemory>(memory);
+        break;
+    }
+    case PropertyName::MotionThreshold:
+        m_motionThreshold = std::clamp(static_cast<int>(value), 0, 254);
+        break;
+    case PropertyName::MotionMinBlocks:
+        m_motionMinBlocks = std::max(static_cast<int>(value), 1);
+        break;
     default:
         return false;
     }
@@ -85,12 +138,164 @@ double ProviderImp::get(PropertyName prop) {
         return static_cast<double>(m_frameProp.cameraPixelFormat);
     case PropertyName::PixelFormatOutput:
         return static_cast<double>(m_frameProp.outputPixelFormat);
+    case PropertyName::OutputWidth:
+        return static_cast<double>(m_frameProp.outputWidth);
+    case PropertyName::OutputHeight:
+        return static_cast<double>(m_frameProp.outputHeight);
+    case PropertyName::CropX:
+        return static_cast<double>(m_frameProp.cropX);
+    case PropertyName::CropY:
+        return static_cast<double>(m_frameProp.cropY);
+    case PropertyName::CropWidth:
+        return static_cast<double>(m_frameProp.cropWidth);
+    case PropertyName::CropHeight:
+        return static_cast<double>(m_frameProp.cropHeight);
+    case PropertyName::ConvertWorkerCount:
+        return static_cast<double>(m_convertWorkerCount);
+    case PropertyName::ConvertQueueDepth:
+        return static_cast<double>(m_convertQueueDepth);
+    case PropertyName::ConvertPendingFrames:
+        return static_cast<double>(m_convertStats.pendingFrames.load());
+    case PropertyName::ConvertPeakPendingFrames:
+        return static_cast<double>(m_convertStats.peakPendingFrames.load());
+    case PropertyName::ConvertDroppedFrames:
+        return static_cast<double>(m_convertStats.droppedFrames.load());
+    case PropertyName::CaptureBufferCount:
+        return static_cast<double>(m_captureBufferCount);
+    case PropertyName::CaptureMode:
+        return static_cast<double>(m_captureMode);
+    case PropertyName::CaptureMemory:
+        return static_cast<double>(m_captureMemory);
+    case PropertyName::MotionThreshold:
+        return static_cast<double>(m_motionThreshold.load());
+    case PropertyName::MotionMinBlocks:
+        return static_cast<double>(m_motionMinBlocks.load());
+    case PropertyName::MotionSkippedFrames:
+        return static_cast<double>(m_motionSkippedFrames.load());
     default:
         break;
     }
     return NAN;
 }
 
+void ProviderImp::inheritSettings(const ProviderImp& other) {
+    m_frameProp = other.m_frameProp;
+    m_frameOrientation = other.m_frameOrientation;
+    m_callback = other.m_callback;
+    m_allocatorFactory = other.m_allocatorFactory;
+    setMaxAvailableFrameSize(other.m_maxAvailableFrameSize);
+    setMaxCacheFrameSize(other.m_maxCacheFrameSize);
+    m_convertWorkerCount = other.m_convertWorkerCount;
+    m_convertQueueDepth = other.m_convertQueueDepth;
+    m_captureBufferCount = other.m_captureBufferCount;
+    m_captureMode = other.m_captureMode;
+    m_captureMemory = other.m_captureMemory;
+    m_motionThreshold = other.m_motionThreshold.load();
+    m_motionMinBlocks = other.m_motionMinBlocks.load();
+}
+
+bool ProviderImp::applyCrop(VideoFrame* frame, bool isBottomUp) const {
+    return cropFrame(frame, m_frameProp.cropX, m_frameProp.cropY, m_frameProp.cropWidth, m_frameProp.cropHeight, isBottomUp);
+}
+
+bool ProviderImp::decodeMJPEGFrame(VideoFrame* frame, bool verticalFlip) {
+    // One decoder per thread decoding at the same time (conversion workers), reused between frames
+    std::unique_ptr<JpegDecoder> decoder;
+    {
+        std::lock_guard<std::mutex> lock(m_jpegDecoderMutex);
+        if (!m_jpegDecoders.empty()) {
+            decoder = std::move(m_jpegDecoders.back());
+            m_jpegDecoders.pop_back();
+        }
+    }
+    if (!decoder) {
+        decoder = std::make_unique<JpegDecoder>();
+    }
+
+    bool ok = decodeMJPEGFrame(frame, verticalFlip, *decoder);
+
+    std::lock_guard<std::mutex> lock(m_jpegDecoderMutex);
+    m_jpegDecoders.push_back(std::move(decoder));
+    return ok;
+}
+
+bool ProviderImp::decodeMJPEGFrame(VideoFrame* frame, bool verticalFlip, JpegDecoder& decoder) {
+    JpegDecoder::I420View view;
+    if (!decoder.decode(frame->data[0], frame->sizeInBytes, view)) {
+        CCAP_LOG_W("ccap: failed to decode MJPEG frame of %u bytes\n", frame->sizeInBytes);
+        return false;
+    }
+
+    // The planes are owned by the decoder until the next frame, the conversion below copies them out.
+    uint8_t* const sourceData = frame->data[0];
+    const uint32_t sourceWidth = frame->width, sourceHeight = frame->height;
+    const PixelFormat sourceFormat = frame->pixelFormat;
+    frame->pixelFormat = PixelFormat::I420f;
+    frame->width = view.width;
+    frame->height = view.height;
+    for (int i = 0; i < 3; ++i) {
+        frame->data[i] = const_cast<uint8_t*>(view.data[i]);
+        frame->stride[i] = view.stride[i];
+    }
+    applyCrop(frame);
+
+    const PixelFormat toFormat = m_frameProp.outputPixelFormat;
+    bool ok;
+    if (toFormat & kPixelFormatYUVColorBit) {
+        ok = inplaceConvertFrameI420ToYUV(frame, pixelFormatInclude(toFormat, PixelFormat::NV12) ? PixelFormat::NV12f : PixelFormat::I420f);
+    } else {
+        ok = inplaceConvertFrame(frame, toFormat, verticalFlip, m_frameProp.outputWidth, m_frameProp.outputHeight);
+    }
+
+    if (!ok) { // Back to the compressed image
+        frame->pixelFormat = sourceFormat;
+        frame->width = sourceWidth;
+        frame->height = sourceHeight;
+        frame->data[0] = sourceData;
+        frame->data[1] = frame->data[2] = nullptr;
+        frame->stride[0] = frame->stride[1] = frame->stride[2] = 0;
+    }
+    return ok;
+}
+
+bool ProviderImp::passMotionGate(const VideoFrame& frame) {
+    constexpr int kBlockSize = 8;
+    const int threshold = m_motionThreshold.load(std::memory_order_relaxed);
+    if (threshold <= 0) {
+        return true;
+    }
+
+    int columns = 0, rows = 0;
+    if (!lumaDownsampleFrame(frame, kBlockSize, m_motionBlocks, columns, rows)) {
+        return true; // No luma to compare
+    }
+
+    bool hasMotion = m_motionGateReset.exchange(false, std::memory_order_acq_rel) || columns != m_motionColumns || rows != m_motionRows;
+    if (!hasMotion) {
+        // Early-out: stops at the first row where enough blocks have moved
+        const auto minBlocks = static_cast<uint32_t>(m_motionMinBlocks.load(std::memory_order_relaxed));
+        m_motionDiff.resize(m_motionBlocks.size());
+        lumaAbsDiff(m_motionBlocks.data(), columns, m_motionReference.data(), columns, m_motionDiff.data(), columns, columns, rows, 1);
+        hasMotion = motionMask(m_motionDiff.data(), columns, nullptr, 0, columns, rows, static_cast<uint8_t>(threshold), minBlocks) >= minBlocks;
+    }
+
+    if (!hasMotion) {
+        ++m_motionSkippedFrames;
+        m_captureStats.motionSkipped();
+        return false;
+    }
+
+    m_motionReference.swap(m_motionBlocks);
+    m_motionColumns = columns;
+    m_motionRows = rows;
+    return true;
+}
+
+void ProviderImp::resetMotionGate() {
+    m_motionSkippedFrames = 0;
+    m_motionGateReset = true;
+}
+
 void ProviderImp::setNewFrameCallback(std::function<bool(const std::shared_ptr<VideoFrame>&)> callback) {
     if (callback) {
         m_callback = std::make_shared<std::function<bool(const std::shared_ptr<VideoFrame>&)>>(std::move(callback));
@@ -100,94 +305,156 @@ void ProviderImp::setNewFrameCallback(std::function<bool(const std::shared_ptr<V
 }
 
 void ProviderImp::setFrameAllocator(std::function<std::shared_ptr<Allocator>()> allocatorFactory) {
-    std::lock_guard<std::mutex> lock(m_poolMutex);
     m_allocatorFactory = std::move(allocatorFactory);
-    m_framePool.clear();
+    m_framePool->clear();
 }
 
 std::shared_ptr<VideoFrame> ProviderImp::grab(uint32_t timeoutInMs) {
-    std::unique_lock<std::mutex> lock(m_availableFrameMutex);
+    std::shared_ptr<VideoFrame> frame = waitForFrame(timeoutInMs);
+    if (frame) {
+        m_captureStats.frameDelivered(*frame);
+    }
+    return frame;
+}
 
-    if (m_availableFrames.empty() && timeoutInMs > 0) {
-        if (!isStarted()) {
-            reportError(ErrorCode::DeviceStartFailed, "Grab called when camera is not started");
-            return nullptr;
-        }
+std::shared_ptr<VideoFrame> ProviderImp::waitForFrame(uint32_t timeoutInMs) {
+    std::shared_ptr<VideoFrame> frame;
+    if (m_availableFrames->tryPop(frame) || timeoutInMs == 0) {
+        return frame;
+    }
 
-        m_grabFrameWaiting = true;
-        bool waitSuccess{};
+    if (!isStarted()) {
+        reportError(ErrorCode::DeviceStartFailed, "Grab called when camera is not started");
+        return nullptr;
+    }
 
-        for (uint32_t waitedTime = 0; waitedTime < timeoutInMs; waitedTime += 1000) {
-            waitSuccess = m_frameCondition.wait_for(lock, std::chrono::milliseconds(1000),
-                                                    [this]() { return m_grabFrameWaiting && !m_availableFrames.empty(); });
-            if (waitSuccess) break;
-            CCAP_LOG_V("ccap: Waiting for new frame... %u ms\n", waitedTime);
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutInMs);
+    for (;;) {
+        // Read the epoch before checking the ring, a frame pushed in between makes waitFor return at once
+        uint32_t epoch = m_availableFrames->waitEpoch();
+        if (m_availableFrames->tryPop(frame)) {
+            return frame;
         }
 
-        m_grabFrameWaiting = false;
-        if (!waitSuccess) {
-            reportError(ErrorCode::FrameCaptureTimeout, "Grab timed out after " + std::to_string(timeoutInMs) + " ms");
+        if (!isStarted()) {
+            CCAP_LOG_V("ccap: VideoFrame waiting stopped\n");
             return nullptr;
         }
+
+        if (!m_availableFrames->waitFor(epoch, deadline)) break;
     }
 
-    if (!m_availableFrames.empty()) {
-        auto frame = std::move(m_availableFrames.front());
-        m_availableFrames.pop();
+    if (m_availableFrames->tryPop(frame)) {
         return frame;
     }
+    reportError(ErrorCode::FrameCaptureTimeout, "Grab timed out after " + std::to_string(timeoutInMs) + " ms");
     return nullptr;
 }
 
-void ProviderImp::setMaxAvailableFrameSize(uint32_t size) { m_maxAvailableFrameSize = size; }
+void ProviderImp::setMaxAvailableFrameSize(uint32_t size) {
+    m_maxAvailableFrameSize = size;
+    if (size <= m_availableFrames->capacity()) return;
 
-void ProviderImp::setMaxCacheFrameSize(uint32_t size) { m_maxCacheFrameSize = size; }
+    if (isStarted()) {
+        CCAP_LOG_W("ccap: setMaxAvailableFrameSize(%u) called after start(), the limit stays at %u frames\n", size,
+                   m_availableFrames->capacity());
+        return;
+    }
+
+    auto frames = std::make_unique<FrameQueue>(size);
+    std::shared_ptr<VideoFrame> frame;
+    while (m_availableFrames->tryPop(frame)) {
+        frames->tryPush(frame);
+    }
+    m_availableFrames = std::move(frames);
+}
+
+void ProviderImp::setMaxCacheFrameSize(uint32_t size) {
+    m_maxCacheFrameSize = size;
+    m_framePool->setMaxSize(size);
+}
 
 void ProviderImp::newFrameAvailable(std::shared_ptr<VideoFrame> frame) {
     bool dropFrame = false;
     if (auto c = m_callback; c && *c) { // Prevent callback from being deleted during invocation, increase callback ref count
         dropFrame = (*c)(frame);
+        if (dropFrame) {
+            m_captureStats.frameDelivered(*frame);
+        }
     }
 
     if (!dropFrame) {
-        std::lock_guard<std::mutex> lock(m_availableFrameMutex);
+        const uint32_t maxSize = m_maxAvailableFrameSize;
+        std::shared_ptr<VideoFrame> oldest;
+        // Drop the oldest frames so that grab() always gets the latest ones. Dropped frames go back to the pool.
+        while (m_availableFrames->size() >= maxSize && m_availableFrames->tryPop(oldest)) {
+            oldest.reset();
+            m_captureStats.queueDropped();
+        }
 
-        m_availableFrames.push(std::move(frame));
-        if (m_availableFrames.size() > m_maxAvailableFrameSize) {
-            m_availableFrames.pop();
+        if (maxSize > 0) {
+            while (!m_availableFrames->tryPush(frame)) { // Full at a smaller capacity than maxSize
+                if (m_availableFrames->tryPop(oldest)) {
+                    oldest.reset();
+                    m_captureStats.queueDropped();
+                }
+            }
+            m_availableFrames->notify();
+        } else {
+            m_captureStats.queueDropped();
         }
     }
+}
+
+bool ProviderImp::tooManyNewFrames() { return m_availableFrames->size() > m_maxAvailableFrameSize; }
+
+std::shared_ptr<VideoFrame> ProviderImp::getFreeFrame() { return m_framePool->acquire(); }
 
-    if (m_grabFrameWaiting && !m_availableFrames.empty()) {
-        // Notify waiting threads
-        m_frameCondition.notify_all();
+void ProviderImp::wakeGrabWaiters() { m_availableFrames->notify(); }
+
+void ProviderImp::startConvertPipeline() {
+    m_convertPipeline.reset();
+    m_convertStats.reset();
+    if (m_convertWorkerCount > 0) {
+        m_convertPipeline = std::make_unique<ConvertPipeline>(m_convertWorkerCount, m_convertQueueDepth, m_convertStats,
+                                                              [this](std::shared_ptr<VideoFrame> frame) { newFrameAvailable(std::move(frame)); });
     }
 }
 
-bool ProviderImp::tooManyNewFrames() { return m_availableFrames.size() > m_maxAvailableFrameSize; }
+void ProviderImp::stopConvertPipeline() { m_convertPipeline.reset(); }
 
-std::shared_ptr<VideoFrame> ProviderImp::getFreeFrame() {
-    std::lock_guard<std::mutex> lock(m_poolMutex);
-    std::shared_ptr<VideoFrame> frame;
-    if (!m_framePool.empty()) {
-        auto ret = std::find_if(m_framePool.begin(), m_framePool.end(),
-                                [](const std::shared_ptr<VideoFrame>& frame) { return frame.use_count() == 1; });
+uint32_t ProviderImp::convertPipelineCapacity() const {
+    return m_convertWorkerCount > 0 ? static_cast<uint32_t>(m_convertWorkerCount + m_convertQueueDepth) : 0;
+}
 
-        if (ret != m_framePool.end()) {
-            frame = *ret;
-        } else {
-            if (m_framePool.size() > m_maxCacheFrameSize) {
-                CCAP_LOG_W("ccap: VideoFrame pool is full, new frame allocated...");
-                m_framePool.pop_front();
-            }
+uint32_t ProviderImp::captureBufferCount() const {
+    if (m_captureBufferCount > 0) {
+        return static_cast<uint32_t>(m_captureBufferCount);
+    }
+
+    switch (m_captureMode) {
+    case CaptureMode::LowLatency:
+        return 3; // One being filled, one ready, one delivered
+    case CaptureMode::HighThroughput:
+        return 8;
+    default:
+        return 4;
+    }
+}
+
+bool ProviderImp::submitFrame(ConvertPipeline::Task task) {
+    if (m_convertPipeline) {
+        if (!m_convertPipeline->submit(std::move(task))) {
+            m_captureStats.convertDropped();
+            return false;
         }
+        return true;
     }
 
-    if (!frame) {
-        frame = std::make_shared<VideoFrame>();
-        m_framePool.push_back(frame);
+    if (auto frame = task()) {
+        newFrameAvailable(std::move(frame));
     }
-    return frame;
+    return true;
 }
 
 void reportError(ErrorCode errorCode, std::string_view description) {
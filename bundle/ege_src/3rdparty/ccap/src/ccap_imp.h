@@ -11,15 +11,17 @@
 #ifndef CAMERA_CAPTURE_IMP_H
 #define CAMERA_CAPTURE_IMP_H
 
+#include "ccap_capture_stats.h"
+#include "ccap_convert_pipeline.h"
 #include "ccap_core.h"
+#include "ccap_frame_queue.h"
 #include "ccap_utils.h"
 
 #include <atomic>
-#include <condition_variable>
-#include <deque>
+#include <memory>
 #include <mutex>
 #include <optional>
-#include <queue>
+#include <vector>
 
 #if defined(_WIN32) || defined(_MSC_VER)
 #ifndef _DISABLE_CONSTEXPR_MUTEX_CONSTRUCTOR
@@ -33,6 +35,8 @@
 
 namespace ccap {
 
+class JpegDecoder;
+
 struct FrameProperty {
     double fps{ 0.0 }; ///< 0 means device default.
 
@@ -49,9 +53,18 @@ struct FrameProperty {
     int width{ 640 };
     int height{ 480 };
 
+    int outputWidth{ 0 };  ///< 0 means camera size, see PropertyName::OutputWidth
+    int outputHeight{ 0 }; ///< 0 means camera size, see PropertyName::OutputHeight
+
+    int cropX{ 0 };      ///< see PropertyName::CropX
+    int cropY{ 0 };      ///< see PropertyName::CropY
+    int cropWidth{ 0 };  ///< 0 means to the right edge, see PropertyName::CropWidth
+    int cropHeight{ 0 }; ///< 0 means to the bottom edge, see PropertyName::CropHeight
+
     inline bool operator==(const FrameProperty& prop) const {
         return fps == prop.fps && cameraPixelFormat == prop.cameraPixelFormat && outputPixelFormat == prop.outputPixelFormat &&
-            width == prop.width && height == prop.height;
+            width == prop.width && height == prop.height && outputWidth == prop.outputWidth && outputHeight == prop.outputHeight &&
+            cropX == prop.cropX && cropY == prop.cropY && cropWidth == prop.cropWidth && cropHeight == prop.cropHeight;
     }
     inline bool operator!=(const FrameProperty& prop) const { return !(*this == prop); }
 };
@@ -67,6 +80,8 @@ public:
     std::shared_ptr<VideoFrame> grab(uint32_t timeoutInMs);
     void setMaxAvailableFrameSize(uint32_t size);
     void setMaxCacheFrameSize(uint32_t size);
+    CaptureStats getStats() const { return m_captureStats.snapshot(); }
+    void resetStats() { m_captureStats.reset(); }
 
     virtual std::vector<std::string> findDeviceNames() = 0;
     virtual bool open(std::string_view deviceName) = 0;
@@ -76,6 +91,22 @@ public:
     virtual bool start() = 0;
     virtual void stop() = 0;
     virtual bool isStarted() const = 0;
+    /// True for providers without a real device, see ccap_imp_virtual.h
+    virtual bool isVirtual() const { return false; }
+
+    /**
+     * @brief Event loop integration for ProviderGroup. When enabled before start(), providers that can be driven from
+     *  outside do not start a capture thread: the group watches captureFd() and calls serviceCapture() when it is readable.
+     *  Other providers ignore it and keep their own thread.
+     */
+    void setExternalCapture(bool enabled) { m_externalCapture = enabled; }
+    /// The fd to watch for readability while started with external capture, -1 if the provider captures on its own.
+    virtual int captureFd() const { return -1; }
+    /// Handle a readable captureFd() without blocking. @return Milliseconds to stop watching the fd for (backoff), 0 to keep watching.
+    virtual int serviceCapture() { return 0; }
+
+    /// Take over the properties, callback and allocator settings of another provider (used when switching implementations).
+    void inheritSettings(const ProviderImp& other);
 
     inline FrameProperty& getFrameProperty() { return m_frameProp; }
     inline const FrameProperty& getFrameProperty() const { return m_frameProp; }
@@ -84,11 +115,56 @@ public:
 
     inline const std::function<std::shared_ptr<Allocator>()>& getAllocatorFactory() const { return m_allocatorFactory; }
 
+    /// Narrow a frame that still references the camera buffer to the crop properties, see `cropFrame` in ccap_convert_frame.h.
+    bool applyCrop(VideoFrame* frame, bool isBottomUp = false) const;
+
+    /**
+     * @brief The motion gate of PropertyName::MotionThreshold. Backends call it after applyCrop, before the frame is converted.
+     *  Only called from the capture thread.
+     * @return false if the frame has no motion and must be dropped.
+     */
+    bool passMotionGate(const VideoFrame& frame);
+    /// Deliver the next frame whatever its content and clear MotionSkippedFrames, called by Provider::start().
+    void resetMotionGate();
+
+    /**
+     * @brief Decode an MJPEG frame (`data[0]`/`sizeInBytes` hold the bitstream) into `frame->allocator`, then crop and convert
+     *  it to the output pixel format. YUV outputs become NV12f or I420f. Thread safe, used by the conversion workers.
+     * @return false if the image cannot be decoded, the frame is left untouched.
+     */
+    bool decodeMJPEGFrame(VideoFrame* frame, bool verticalFlip);
+
     bool tooManyNewFrames();
 
 protected:
     void newFrameAvailable(std::shared_ptr<VideoFrame> frame);
+    /// O(1), frames come back to the pool when their last reference is released. Only called from the capture thread.
     std::shared_ptr<VideoFrame> getFreeFrame();
+    /// Wake threads blocked in grab() so they notice the provider has stopped.
+    void wakeGrabWaiters();
+    /// Backends report received frames, conversion times and driver side drops here, see Provider::getStats.
+    inline CaptureStatsRecorder& captureStats() { return m_captureStats; }
+
+    /// Create the conversion workers if PropertyName::ConvertWorkerCount is set. Called by start() of the providers supporting it.
+    void startConvertPipeline();
+    /// Finish the frames being converted and join the workers. Called by stop() before the camera buffers are released.
+    void stopConvertPipeline();
+    /// Frames the conversion workers can hold at most with the current properties, 0 without workers.
+    /// Providers keep that many more camera buffers so the driver still has buffers to fill.
+    uint32_t convertPipelineCapacity() const;
+
+    /// Driver buffers to request, from PropertyName::CaptureBufferCount or the capture mode defaults, not counting the conversion workers.
+    uint32_t captureBufferCount() const;
+    inline CaptureMode captureMode() const { return m_captureMode; }
+    inline CaptureMemory captureMemory() const { return m_captureMemory; }
+    bool convertPipelineFull() const { return m_convertPipeline && m_convertPipeline->isFull(); }
+
+    /**
+     * @brief Convert and deliver a captured frame: on a conversion worker if they are running, right away otherwise.
+     *  `task` returns the frame to pass to newFrameAvailable, nullptr to drop it.
+     * @return false if the workers are busy, the frame is dropped and `task` is not called.
+     */
+    bool submitFrame(ConvertPipeline::Task task);
 
 protected:
     // Callback function for new data frames
@@ -96,23 +172,49 @@ protected:
     std::function<std::shared_ptr<Allocator>()> m_allocatorFactory;
 
     /// Frames from camera. If not taken or no callback is set, they will accumulate here. Max length is MAX_AVAILABLE_FRAME_SIZE.
-    std::queue<std::shared_ptr<VideoFrame>> m_availableFrames;
+    std::unique_ptr<FrameQueue> m_availableFrames;
 
     /// All frames for reuse. Max length is MAX_CACHE_FRAME_SIZE.
-    std::deque<std::shared_ptr<VideoFrame>> m_framePool;
-    std::mutex m_poolMutex, m_availableFrameMutex;
-    std::condition_variable m_frameCondition;
+    std::shared_ptr<FramePool> m_framePool;
 
     FrameProperty m_frameProp;
 
-    uint32_t m_maxAvailableFrameSize{ DEFAULT_MAX_AVAILABLE_FRAME_SIZE };
+    std::atomic_uint32_t m_maxAvailableFrameSize{ DEFAULT_MAX_AVAILABLE_FRAME_SIZE };
     uint32_t m_maxCacheFrameSize{ DEFAULT_MAX_CACHE_FRAME_SIZE };
 
     bool m_propertyChanged{ false };
-    bool m_grabFrameWaiting{ false };
+    bool m_externalCapture{ false };
     FrameOrientation m_frameOrientation = FrameOrientation::Default;
 
     std::atomic_uint32_t m_frameIndex{};
+
+    std::mutex m_jpegDecoderMutex;
+    std::vector<std::unique_ptr<JpegDecoder>> m_jpegDecoders; ///< Idle decoders, created by the MJPEG frames
+
+    int m_captureBufferCount{ 0 }; ///< 0 means the default of m_captureMode
+    CaptureMode m_captureMode{ CaptureMode::Default };
+    CaptureMemory m_captureMemory{ CaptureMemory::Default };
+
+    CaptureStatsRecorder m_captureStats;
+
+    std::atomic_int m_motionThreshold{ 0 };
+    std::atomic_int m_motionMinBlocks{ 1 };
+    std::atomic_uint64_t m_motionSkippedFrames{ 0 };
+    std::atomic_bool m_motionGateReset{ true };
+    std::vector<uint8_t> m_motionBlocks;    ///< 8x8 block averages of the current frame, capture thread only
+    std::vector<uint8_t> m_motionReference; ///< Block averages of the last delivered frame
+    std::vector<uint8_t> m_motionDiff;
+    int m_motionColumns{ 0 };
+    int m_motionRows{ 0 };
+
+    int m_convertWorkerCount{ 0 };
+    int m_convertQueueDepth{ 2 };
+    ConvertPipelineStats m_convertStats;
+    std::unique_ptr<ConvertPipeline> m_convertPipeline; ///< Declared last: stopped before the other members go away
+
+private:
+    std::shared_ptr<VideoFrame> waitForFrame(uint32_t timeoutInMs);
+    bool decodeMJPEGFrame(VideoFrame* frame, bool verticalFlip, JpegDecoder& decoder);
 };
 
 /// A lightweight class used to call the deleter function in the destructor of Frame
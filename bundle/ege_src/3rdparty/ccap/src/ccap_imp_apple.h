@@ -37,6 +37,7 @@ public:
 
     using ProviderImp::getFreeFrame;
     using ProviderImp::newFrameAvailable;
+    using ProviderImp::captureStats;
 
     inline FrameOrientation frameOrientation() const { return m_frameOrientation; }
 
@@ -863,6 +863,7 @@ NSArray<AVCaptureDevice*>* findAllDeviceName() {
     CVPixelBufferLockBaseAddress(imageBuffer, kCVPixelBufferLock_ReadOnly);
 
     auto newFrame = _provider->getFreeFrame();
+    _provider->captureStats().frameReceived(*newFrame, 0);
 
     CMTime timestamp = CMSampleBufferGetPresentationTimeStamp(sampleBuffer);
     auto internalFormat = _provider->getFrameProperty().cameraPixelFormat;
@@ -898,6 +899,12 @@ NSArray<AVCaptureDevice*>* findAllDeviceName() {
         newFrame->stride[2] = 0;
     }
 
+    _provider->applyCrop(newFrame.get());
+    if (!_provider->passMotionGate(*newFrame)) {
+        CVPixelBufferUnlockBaseAddress(imageBuffer, kCVPixelBufferLock_ReadOnly);
+        return;
+    }
+
     /// iOS/macOS does not support i420, and we do not intend to support nv12 to i420 conversion here.
     bool zeroCopy = ((internalFormat & kPixelFormatYUVColorBit) && (outputFormat & kPixelFormatYUVColorBit)) ||
         (internalFormat == outputFormat && _provider->frameOrientation() == kDefaultFrameOrientation);
@@ -910,13 +917,16 @@ NSArray<AVCaptureDevice*>* findAllDeviceName() {
             newFrame->allocator = f ? f() : std::make_shared<DefaultAllocator>();
         }
 
-        std::chrono::steady_clock::time_point startConvertTime;
+        uint64_t startConvertTime = steadyNowNs();
 
-        if (verboseLogEnabled()) {
-            startConvertTime = std::chrono::steady_clock::now();
-        }
+        auto& prop = _provider->getFrameProperty();
+        zeroCopy = !inplaceConvertFrame(newFrame.get(), outputFormat, (int)(newFrame->orientation != kDefaultFrameOrientation), prop.outputWidth,
+                                        prop.outputHeight);
 
-        zeroCopy = !inplaceConvertFrame(newFrame.get(), outputFormat, (int)(newFrame->orientation != kDefaultFrameOrientation));
+        uint64_t convertDuration = steadyNowNs() - startConvertTime;
+        if (!zeroCopy) {
+            _provider->captureStats().frameConverted(convertDuration);
+        }
 
         CVPixelBufferUnlockBaseAddress(imageBuffer, kCVPixelBufferLock_ReadOnly);
 
@@ -926,24 +936,12 @@ NSArray<AVCaptureDevice*>* findAllDeviceName() {
 #else
             constexpr const char* mode = "(Release)";
 #endif
-
-            double durInMs = (std::chrono::steady_clock::now() - startConvertTime).count() / 1.e6;
-            static double s_allCostTime = 0;
-            static double s_frames = 0;
-
-            if (s_frames > 60) {
-                s_allCostTime = 0;
-                s_frames = 0;
-            }
-
-            s_allCostTime += durInMs;
-            ++s_frames;
-
             CCAP_NSLOG_V(
                 @"ccap: inplaceConvertFrame requested pixel format: %s, actual pixel format: %s, flip: %d, cost time %s: (cur %g ms, avg %g ms)",
                 pixelFormatToString(_provider->getFrameProperty().outputPixelFormat).data(),
                 pixelFormatToString(_provider->getFrameProperty().cameraPixelFormat).data(),
-                (int)(newFrame->orientation != kDefaultFrameOrientation), mode, durInMs, s_allCostTime / s_frames);
+                (int)(newFrame->orientation != kDefaultFrameOrientation), mode, convertDuration / 1.e6,
+                _provider->captureStats().conversionAverageUs() / 1.e3);
         }
     }
 
@@ -965,35 +963,9 @@ NSArray<AVCaptureDevice*>* findAllDeviceName() {
 
     newFrame->frameIndex = _provider->frameIndex()++;
 
-    if (verboseLogEnabled()) { /// Generally, camera interfaces are not called in multiple threads, and verbose logs are only for debugging,
-                               /// so no lock is needed here.
-        static uint64_t s_lastFrameTime;
-        static std::deque<uint64_t> s_durations;
-
-        if (s_lastFrameTime != 0) {
-            auto dur = newFrame->timestamp - s_lastFrameTime;
-            s_durations.emplace_back(dur);
-        }
-
-        s_lastFrameTime = newFrame->timestamp;
-
-        /// use a window of 30 frames to calculate the fps
-        if (s_durations.size() > 30) {
-            s_durations.pop_front();
-        }
-
-        double fps = 0.0;
-
-        if (!s_durations.empty()) {
-            double sum = 0.0;
-            for (auto& d : s_durations) {
-                sum += d / 1e9f;
-            }
-            fps = std::round(s_durations.size() / sum * 10) / 10.0;
-        }
-
+    if (verboseLogEnabled()) {
         NSLog(@"ccap: New frame available: %ux%u, bytes %u, Data address: %p, fps: %g", newFrame->width, newFrame->height,
-              newFrame->sizeInBytes, newFrame->data[0], fps);
+              newFrame->sizeInBytes, newFrame->data[0], std::round(_provider->captureStats().fps() * 10) / 10.0);
     }
 
     _provider->newFrameAvailable(std::move(newFrame));
@@ -1103,6 +1075,7 @@ void ProviderApple::stop() {
             [m_imp stop];
         }
     }
+    wakeGrabWaiters();
 }
 
 bool ProviderApple::isStarted() const { return m_imp && [m_imp isRunning]; }
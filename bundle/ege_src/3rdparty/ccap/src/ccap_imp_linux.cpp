@@ -32,13 +32,25 @@ const std::vector<ProviderV4L2::V4L2Format> ProviderV4L2::s_supportedV4L2Formats
     { V4L2_PIX_FMT_UYVY, PixelFormat::UYVY, "UYVY" },
     { V4L2_PIX_FMT_NV12, PixelFormat::NV12, "NV12" },
     { V4L2_PIX_FMT_YUV420, PixelFormat::I420, "YUV420" },
+    { V4L2_PIX_FMT_NV21, PixelFormat::NV21, "NV21" },
+    { V4L2_PIX_FMT_YVU420, PixelFormat::YV12, "YVU420" },
+#ifdef V4L2_PIX_FMT_P010 // Linux 5.x headers
+    { V4L2_PIX_FMT_P010, PixelFormat::P010, "P010" },
+#endif
     { V4L2_PIX_FMT_RGB24, PixelFormat::RGB24, "RGB24" },
     { V4L2_PIX_FMT_BGR24, PixelFormat::BGR24, "BGR24" },
     { V4L2_PIX_FMT_RGB32, PixelFormat::RGBA32, "RGB32" },
     { V4L2_PIX_FMT_BGR32, PixelFormat::BGRA32, "BGR32" },
-    { V4L2_PIX_FMT_MJPEG, PixelFormat::Unknown, "MJPEG" },
+    { V4L2_PIX_FMT_RGB565, PixelFormat::RGB565, "RGB565" },
+    { V4L2_PIX_FMT_MJPEG, PixelFormat::MJPEG, "MJPEG" },
+    { V4L2_PIX_FMT_JPEG, PixelFormat::MJPEG, "JPEG" },
 };
 
+namespace {
+/// Raw formats at a given size and rate may exceed the USB bandwidth, most UVC cameras only reach 30 fps above 640x480 with MJPEG.
+constexpr double kDefaultTargetFps = 30.0;
+} // namespace
+
 ProviderV4L2::ProviderV4L2() {
     CCAP_LOG_V("ccap: ProviderV4L2 created\n");
     m_lifeHolder = std::make_shared<int>(1); // Keep the provider alive while frames are being processed
@@ -158,8 +170,9 @@ std::optional<DeviceInfo> ProviderV4L2::getDeviceInfo() const {
 
     // Get supported pixel formats
     for (const auto& format : m_supportedFormats) {
-        if (format.ccapFormat != PixelFormat::Unknown) {
-            info.supportedPixelFormats.push_back(format.ccapFormat);
+        auto& formats = info.supportedPixelFormats;
+        if (format.ccapFormat != PixelFormat::Unknown && std::find(formats.begin(), formats.end(), format.ccapFormat) == formats.end()) {
+            formats.push_back(format.ccapFormat); // MJPEG and JPEG share one entry
         }
     }
 
@@ -203,9 +216,13 @@ bool ProviderV4L2::start() {
     m_shouldStop = false;
     m_startTime = std::chrono::steady_clock::now();
     m_frameIndex = 0;
+    m_hasSequence = false;
+    startConvertPipeline();
 
-    // Start capture thread
-    m_captureThread = std::make_unique<std::thread>(&ProviderV4L2::captureThread, this);
+    if (!m_externalCapture) { // Otherwise a ProviderGroup services the device, see serviceCapture()
+        m_wakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC); // Without it, the capture thread polls with a timeout
+        m_captureThread = std::make_unique<std::thread>(&ProviderV4L2::captureThread, this);
+    }
 
     m_isStreaming = true;
     CCAP_LOG_I("ccap: Streaming started\n");
@@ -218,17 +235,29 @@ void ProviderV4L2::stop() {
     }
 
     m_shouldStop = true;
+    wakeGrabWaiters();
+    if (m_wakeFd >= 0) {
+        uint64_t one = 1;
+        (void)!write(m_wakeFd, &one, sizeof(one));
+    }
 
     // Wait for capture thread to finish
     if (m_captureThread && m_captureThread->joinable()) {
         m_captureThread->join();
         m_captureThread.reset();
     }
+    std::lock_guard<std::mutex> serviceLock(m_captureMutex); // Or for a ProviderGroup servicing the device right now
+    stopConvertPipeline(); // Requeues the buffers still being converted
 
+    if (m_wakeFd >= 0) {
+        ::close(m_wakeFd);
+        m_wakeFd = -1;
+    }
+
+    m_isStreaming = false; // Frames released from now on no longer requeue their buffer
     stopStreaming();
     releaseBuffers();
 
-    m_isStreaming = false;
     CCAP_LOG_I("ccap: Streaming stopped\n");
 }
 
@@ -328,6 +357,24 @@ std::vector<DeviceInfo::Resolution> ProviderV4L2::getSupportedResolutions(uint32
     return resolutions;
 }
 
+double ProviderV4L2::getMaxFrameRate(uint32_t pixelformat, uint32_t width, uint32_t height) {
+    double maxFps = 0;
+    struct v4l2_frmivalenum interval = {};
+    interval.pixel_format = pixelformat;
+    interval.width = width;
+    interval.height = height;
+
+    for (interval.index = 0; ioctl(m_fd, VIDIOC_ENUM_FRAMEINTERVALS, &interval) == 0; interval.index++) {
+        // Stepwise and continuous ranges report the shortest interval in `min`, like a discrete entry
+        const auto& frameInterval = interval.type == V4L2_FRMIVAL_TYPE_DISCRETE ? interval.discrete : interval.stepwise.min;
+        if (frameInterval.numerator > 0) {
+            maxFps = std::max(maxFps, static_cast<double>(frameInterval.denominator) / frameInterval.numerator);
+        }
+        if (interval.type != V4L2_FRMIVAL_TYPE_DISCRETE) break;
+    }
+    return maxFps;
+}
+
 bool ProviderV4L2::negotiateFormat() {
     // Get current format
     m_currentFormat.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
@@ -355,6 +402,28 @@ bool ProviderV4L2::negotiateFormat() {
             pix.pixelformat = v4l2Format;
             formatChanged = true;
         }
+    } else if (v4l2FormatToCcapFormat(pix.pixelformat) != PixelFormat::MJPEG) {
+        // Not specified: switch to MJPEG when the current raw format cannot deliver the size at the wanted frame rate
+        uint32_t mjpegFormat = 0;
+        for (const auto& format : m_supportedFormats) {
+            if (format.ccapFormat == PixelFormat::MJPEG) {
+                mjpegFormat = format.pixelformat;
+                break;
+            }
+        }
+
+        if (mjpegFormat != 0) {
+            double targetFps = m_frameProp.fps > 0 ? m_frameProp.fps : kDefaultTargetFps;
+            double rawFps = getMaxFrameRate(pix.pixelformat, pix.width, pix.height);
+            double mjpegFps = getMaxFrameRate(mjpegFormat, pix.width, pix.height);
+            // rawFps is 0 when the driver does not enumerate frame intervals, nothing says the raw format is too slow then
+            if (rawFps > 0 && rawFps < targetFps - 0.5 && mjpegFps > rawFps) {
+                CCAP_LOG_I("ccap: %s reaches %g fps at %ux%u, using MJPEG (%g fps)\n", getFormatName(pix.pixelformat), rawFps, pix.width,
+                           pix.height, mjpegFps);
+                pix.pixelformat = mjpegFormat;
+                formatChanged = true;
+            }
+        }
     }
 
     // Apply format if changed
@@ -375,6 +444,18 @@ bool ProviderV4L2::negotiateFormat() {
     m_frameProp.height = pix.height;
     m_frameProp.cameraPixelFormat = v4l2FormatToCcapFormat(pix.pixelformat);
 
+    if (m_frameProp.fps > 0) {
+        struct v4l2_streamparm parm = {};
+        parm.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+        if (ioctl(m_fd, VIDIOC_G_PARM, &parm) == 0 && (parm.parm.capture.capability & V4L2_CAP_TIMEPERFRAME)) {
+            parm.parm.capture.timeperframe.numerator = 1000;
+            parm.parm.capture.timeperframe.denominator = static_cast<uint32_t>(std::lround(m_frameProp.fps * 1000));
+            if (ioctl(m_fd, VIDIOC_S_PARM, &parm) < 0) {
+                CCAP_LOG_W("ccap: VIDIOC_S_PARM failed, using the device frame rate: %s\n", strerror(errno));
+            }
+        }
+    }
+
     CCAP_LOG_I("ccap: Format negotiated: %dx%d, format=%s\n",
                pix.width, pix.height, getFormatName(pix.pixelformat));
 
@@ -382,8 +463,79 @@ bool ProviderV4L2::negotiateFormat() {
 }
 
 bool ProviderV4L2::allocateBuffers() {
+    // Frames in the conversion workers hold their buffer
+    uint32_t count = std::min<uint32_t>(captureBufferCount() + convertPipelineCapacity(), VIDEO_MAX_FRAME);
+
+    if (captureMemory() != CaptureMemory::Mmap) {
+        if (importBuffers(count, captureMemory())) {
+            CCAP_LOG_V("ccap: Imported %zu %s buffers (%u requested), capture mode %d\n", m_buffers.size(),
+                       m_memoryType == V4L2_MEMORY_DMABUF ? "dma-buf" : "user pointer", count, static_cast<int>(captureMode()));
+            return true;
+        }
+        CCAP_LOG_W("ccap: Capture memory %d not available, falling back to driver buffers\n", static_cast<int>(captureMemory()));
+    }
+
+    if (!mapDriverBuffers(count)) {
+        return false;
+    }
+
+    CCAP_LOG_V("ccap: Allocated %zu buffers (%u requested), capture mode %d\n", m_buffers.size(), count, static_cast<int>(captureMode()));
+    return true;
+}
+
+bool ProviderV4L2::importBuffers(uint32_t count, CaptureMemory memory) {
+    m_memoryType = memory == CaptureMemory::DmaBuf ? V4L2_MEMORY_DMABUF : V4L2_MEMORY_USERPTR;
+
     struct v4l2_requestbuffers req = {};
-    req.count = kBufferCount;
+    req.count = count;
+    req.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+    req.memory = m_memoryType;
+
+    if (ioctl(m_fd, VIDIOC_REQBUFS, &req) < 0) {
+        CCAP_LOG_W("ccap: VIDIOC_REQBUFS for imported buffers failed: %s\n", strerror(errno));
+        m_memoryType = V4L2_MEMORY_MMAP;
+        return false;
+    }
+
+    if (req.count < 2) {
+        releaseAndFreeDriverBuffers();
+        m_memoryType = V4L2_MEMORY_MMAP;
+        return false;
+    }
+
+    // The driver writes whole pages
+    size_t pageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    size_t length = (m_currentFormat.fmt.pix.sizeimage + pageSize - 1) / pageSize * pageSize;
+
+    m_buffers.resize(req.count);
+    for (uint32_t i = 0; i < req.count; i++) {
+        auto allocator = m_allocatorFactory ? m_allocatorFactory() : std::make_shared<DefaultAllocator>();
+        if (allocator) {
+            allocator->resize(length);
+        }
+
+        if (!allocator || allocator->data() == nullptr || allocator->size() < length ||
+            (m_memoryType == V4L2_MEMORY_DMABUF && allocator->dmabufFd() < 0)) {
+            CCAP_LOG_W("ccap: The frame allocator cannot provide %s buffers of %zu bytes\n",
+                       m_memoryType == V4L2_MEMORY_DMABUF ? "dma-buf" : "user pointer", length);
+            releaseAndFreeDriverBuffers();
+            m_memoryType = V4L2_MEMORY_MMAP;
+            return false;
+        }
+
+        m_buffers[i].start = allocator->data();
+        m_buffers[i].length = length;
+        m_buffers[i].index = i;
+        m_buffers[i].allocator = std::move(allocator);
+    }
+    return true;
+}
+
+bool ProviderV4L2::mapDriverBuffers(uint32_t count) {
+    m_memoryType = V4L2_MEMORY_MMAP;
+
+    struct v4l2_requestbuffers req = {};
+    req.count = count;
     req.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
     req.memory = V4L2_MEMORY_MMAP;
 
@@ -421,14 +573,13 @@ bool ProviderV4L2::allocateBuffers() {
             return false;
         }
     }
-
-    CCAP_LOG_V("ccap: Allocated %zu buffers\n", m_buffers.size());
     return true;
 }
 
 void ProviderV4L2::releaseBuffers() {
     for (auto& buffer : m_buffers) {
-        if (buffer.start != nullptr && buffer.start != MAP_FAILED) {
+        // Imported memory belongs to the allocator, frames still using it keep it alive
+        if (m_memoryType == V4L2_MEMORY_MMAP && buffer.start != nullptr && buffer.start != MAP_FAILED) {
             munmap(buffer.start, buffer.length);
         }
     }
@@ -443,7 +594,7 @@ void ProviderV4L2::releaseAndFreeDriverBuffers() {
     struct v4l2_requestbuffers zero = {};
     zero.count = 0;
     zero.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
-    zero.memory = V4L2_MEMORY_MMAP;
+    zero.memory = m_memoryType;
     // Ignoring return value: this is a best-effort hint during cleanup
     ioctl(m_fd, VIDIOC_REQBUFS, &zero);
 }
@@ -452,9 +603,7 @@ bool ProviderV4L2::startStreaming() {
     // Queue all buffers
     for (size_t i = 0; i < m_buffers.size(); i++) {
         struct v4l2_buffer buf = {};
-        buf.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
-        buf.memory = V4L2_MEMORY_MMAP;
-        buf.index = i;
+        fillQueueBuffer(buf, static_cast<uint32_t>(i));
 
         if (ioctl(m_fd, VIDIOC_QBUF, &buf) < 0) {
             reportError(ErrorCode::DeviceStartFailed, "Queue buffer failed: " + std::string(strerror(errno)));
@@ -482,32 +631,62 @@ void ProviderV4L2::captureThread() {
     CCAP_LOG_V("ccap: Capture thread started\n");
 
     while (!m_shouldStop) {
-        if (!readFrame()) {
-            // Error or timeout, continue
-            std::this_thread::sleep_for(std::chrono::milliseconds(10));
-        }
+        readFrame(); // Waits for the device itself, and backs off on errors
     }
 
     CCAP_LOG_V("ccap: Capture thread finished\n");
 }
 
 bool ProviderV4L2::readFrame() {
-    // Use poll to wait for data
-    struct pollfd fds[1];
+    // Wait for data, or for stop() through the wake fd
+    struct pollfd fds[2];
     fds[0].fd = m_fd;
     fds[0].events = POLLIN;
+    fds[0].revents = 0;
+    fds[1].fd = m_wakeFd;
+    fds[1].events = POLLIN;
+    fds[1].revents = 0;
 
-    int ret = poll(fds, 1, 100); // 100ms timeout
+    int ret = poll(fds, m_wakeFd >= 0 ? 2 : 1, m_wakeFd >= 0 ? -1 : 100);
     if (ret < 0) {
         if (errno != EINTR) {
             CCAP_LOG_E("ccap: poll failed: %s\n", strerror(errno));
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
         }
         return false;
-    } else if (ret == 0) {
-        // Timeout
+    } else if (ret == 0 || m_shouldStop) {
+        // Timeout or stopping
         return false;
     }
 
+    if (fds[0].revents & (POLLERR | POLLHUP | POLLNVAL)) {
+        CCAP_LOG_E("ccap: device poll error, revents=0x%x\n", fds[0].revents);
+        std::this_thread::sleep_for(std::chrono::milliseconds(10)); // Do not spin on a broken device
+        return false;
+    }
+
+    int backoffMs = 0;
+    bool result = dequeueFrame(backoffMs);
+    if (backoffMs > 0) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(backoffMs));
+    }
+    return result;
+}
+
+int ProviderV4L2::captureFd() const { return m_externalCapture && m_isStreaming ? m_fd : -1; }
+
+int ProviderV4L2::serviceCapture() {
+    std::lock_guard<std::mutex> lock(m_captureMutex); // stop() waits for it
+    if (!m_isStreaming || m_shouldStop) {
+        return 100; // Stopped outside of the group, it will unregister the fd
+    }
+
+    int backoffMs = 0;
+    dequeueFrame(backoffMs);
+    return backoffMs;
+}
+
+bool ProviderV4L2::dequeueFrame(int& backoffMs) {
     // Check frame availability before dequeuing buffer
     if (tooManyNewFrames()) {
         if (m_callback && *m_callback) {
@@ -515,6 +694,7 @@ bool ProviderV4L2::readFrame() {
         } else {
             CCAP_LOG_I("ccap: VideoFrame dropped to avoid memory leak: grab() called less frequently than camera frame rate.\n");
         }
+        backoffMs = 10; // The device stays readable until grab() catches up
         return false; // Don't dequeue if we're going to drop the frame anyway
     }
 
@@ -526,26 +706,59 @@ bool ProviderV4L2::readFrame() {
 
     struct v4l2_buffer buf = {};
     buf.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
-    buf.memory = V4L2_MEMORY_MMAP;
+    buf.memory = m_memoryType;
 
     if (ioctl(m_fd, VIDIOC_DQBUF, &buf) < 0) {
         if (errno != EAGAIN) {
             CCAP_LOG_E("ccap: VIDIOC_DQBUF failed: %s\n", strerror(errno));
+            backoffMs = 10;
         }
         return false;
     }
 
+    // Gaps in the driver sequence numbers are frames the driver dropped for lack of queued buffers.
+    // Every dequeued buffer advances the sequence, so the stale buffers below are not counted again as gaps.
+    auto trackSequence = [this](const v4l2_buffer& dequeued) {
+        if (m_hasSequence && dequeued.sequence > m_lastSequence + 1) {
+            captureStats().driverDropped(dequeued.sequence - m_lastSequence - 1);
+        }
+        m_lastSequence = dequeued.sequence;
+        m_hasSequence = true;
+    };
+    trackSequence(buf);
+
+    if (captureMode() == CaptureMode::LowLatency) {
+        // Drain the driver queue: keep the newest buffer, hand the stale ones straight back
+        struct v4l2_buffer newer = buf;
+        while (ioctl(m_fd, VIDIOC_DQBUF, &newer) == 0) {
+            trackSequence(newer);
+            requeueBuffer(buf.index);
+            captureStats().staleDropped();
+            CCAP_LOG_V("ccap: Stale buffer %u skipped in low latency mode\n", buf.index);
+            buf = newer;
+        }
+    }
+
+    // The driver capture time is on CLOCK_MONOTONIC, the clock of std::chrono::steady_clock on Linux
+    uint64_t captureTime = 0;
+    if ((buf.flags & V4L2_BUF_FLAG_TIMESTAMP_MASK) == V4L2_BUF_FLAG_TIMESTAMP_MONOTONIC && (buf.timestamp.tv_sec || buf.timestamp.tv_usec)) {
+        captureTime = static_cast<uint64_t>(buf.timestamp.tv_sec) * 1000000000ull + static_cast<uint64_t>(buf.timestamp.tv_usec) * 1000ull;
+    }
+
     // Fill frame metadata
     frame->width = m_frameProp.width;
     frame->height = m_frameProp.height;
     frame->pixelFormat = m_frameProp.cameraPixelFormat;
-    frame->timestamp = (std::chrono::steady_clock::now() - m_startTime).count();
+    captureStats().frameReceived(*frame, captureTime);
+    const uint64_t startTime = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(m_startTime.time_since_epoch()).count());
+    frame->timestamp = (captureTime > startTime ? captureTime : frame->receiveTime) - startTime;
     frame->sizeInBytes = buf.bytesused;
 
     assert(frame->pixelFormat != PixelFormat::Unknown);
 
     // Check input/output format types and orientations
     bool isInputYUV = (frame->pixelFormat & kPixelFormatYUVColorBit) != 0;
+    bool isInputMJPEG = frame->pixelFormat == PixelFormat::MJPEG;
     bool isOutputYUV = (m_frameProp.outputPixelFormat & kPixelFormatYUVColorBit) != 0;
     auto inputOrientation = FrameOrientation::TopToBottom; // V4L2 always provides TopToBottom
 
@@ -553,9 +766,9 @@ bool ProviderV4L2::readFrame() {
     frame->orientation = isOutputYUV ? FrameOrientation::TopToBottom : m_frameOrientation;
 
     // Check if we need conversion or flipping
-    bool shouldFlip = frame->orientation != inputOrientation && !isOutputYUV;
     bool shouldConvert = (m_frameProp.outputPixelFormat != PixelFormat::Unknown &&
                           m_frameProp.outputPixelFormat != frame->pixelFormat);
+    bool shouldFlip = frame->orientation != inputOrientation && !isOutputYUV && (shouldConvert || !isInputMJPEG);
     bool zeroCopy = !shouldConvert && !shouldFlip;
 
     uint8_t* bufferData = static_cast<uint8_t*>(m_buffers[buf.index].start);
@@ -565,8 +778,8 @@ bool ProviderV4L2::readFrame() {
         frame->data[0] = bufferData;
         frame->stride[0] = m_frameProp.width;
 
-        if (pixelFormatInclude(frame->pixelFormat, PixelFormat::NV12)) {
-            // NV12: Y plane + interleaved UV plane
+        if (pixelFormatInclude(frame->pixelFormat, PixelFormat::NV12) || pixelFormatInclude(frame->pixelFormat, PixelFormat::NV21)) {
+            // NV12/NV21: Y plane + interleaved UV/VU plane
             frame->data[1] = bufferData + m_frameProp.width * m_frameProp.height;
             frame->data[2] = nullptr;
             frame->stride[1] = m_frameProp.width;
@@ -577,6 +790,19 @@ bool ProviderV4L2::readFrame() {
             frame->data[2] = bufferData + m_frameProp.width * m_frameProp.height * 5 / 4;
             frame->stride[1] = m_frameProp.width / 2;
             frame->stride[2] = m_frameProp.width / 2;
+        } else if (pixelFormatInclude(frame->pixelFormat, PixelFormat::YV12)) {
+            // YV12: Y + V + U planes, kept in memory order
+            frame->data[1] = bufferData + m_frameProp.width * m_frameProp.height;
+            frame->data[2] = bufferData + m_frameProp.width * m_frameProp.height * 5 / 4;
+            frame->stride[1] = m_frameProp.width / 2;
+            frame->stride[2] = m_frameProp.width / 2;
+        } else if (pixelFormatInclude(frame->pixelFormat, PixelFormat::P010)) {
+            // P010: like NV12 with 2 bytes per sample
+            frame->stride[0] = m_frameProp.width * 2;
+            frame->data[1] = bufferData + m_frameProp.width * 2 * m_frameProp.height;
+            frame->data[2] = nullptr;
+            frame->stride[1] = m_frameProp.width * 2;
+            frame->stride[2] = 0;
         } else {
             // YUYV/UYVY: packed format
             frame->data[1] = nullptr;
@@ -585,8 +811,16 @@ bool ProviderV4L2::readFrame() {
             frame->stride[1] = 0;
             frame->stride[2] = 0;
         }
+    } else if (isInputMJPEG) {
+        // Compressed image, decoded by the conversion below
+        frame->data[0] = bufferData;
+        frame->data[1] = nullptr;
+        frame->data[2] = nullptr;
+        frame->stride[0] = 0;
+        frame->stride[1] = 0;
+        frame->stride[2] = 0;
     } else {
-        // RGB formats: single plane
+        // RGB formats (including RGB565): single plane
         frame->data[0] = bufferData;
         frame->data[1] = nullptr;
         frame->data[2] = nullptr;
@@ -595,42 +829,69 @@ bool ProviderV4L2::readFrame() {
         frame->stride[2] = 0;
     }
 
+    applyCrop(frame.get()); // MJPEG is cropped after decoding
+    if (!passMotionGate(*frame)) {
+        requeueBuffer(buf.index);
+        return true;
+    }
+
+    frame->nativeHandle = nullptr;
+    frame->frameIndex = m_frameIndex;
+    const uint32_t bufferIndex = buf.index;
+    bool submitted = submitFrame([this, frame, bufferIndex, zeroCopy, shouldFlip]() mutable {
+        return finishFrame(std::move(frame), bufferIndex, zeroCopy, shouldFlip);
+    });
+
+    if (!submitted) {
+        CCAP_LOG_I("ccap: VideoFrame dropped: all conversion workers are busy, consider a higher ConvertWorkerCount.\n");
+        requeueBuffer(bufferIndex);
+        return false;
+    }
+
+    ++m_frameIndex;
+    return true;
+}
+
+std::shared_ptr<VideoFrame> ProviderV4L2::finishFrame(std::shared_ptr<VideoFrame> frame, uint32_t bufferIndex, bool zeroCopy, bool shouldFlip) {
+    const bool isInputMJPEG = frame->pixelFormat == PixelFormat::MJPEG;
+    const auto inputOrientation = FrameOrientation::TopToBottom;
+
     if (!zeroCopy) {
         // Need conversion: copy data and requeue buffer immediately
         if (!frame->allocator) {
             frame->allocator = m_allocatorFactory ? m_allocatorFactory() : std::make_shared<DefaultAllocator>();
         }
 
+        auto convertFrame = [&]() {
+            if (isInputMJPEG) {
+                return decodeMJPEGFrame(frame.get(), shouldFlip);
+            }
+            return inplaceConvertFrame(frame.get(), m_frameProp.outputPixelFormat, shouldFlip, m_frameProp.outputWidth, m_frameProp.outputHeight);
+        };
+
         // Perform pixel format conversion
+        uint64_t startTime = steadyNowNs();
+        zeroCopy = !convertFrame();
+        uint64_t duration = steadyNowNs() - startTime;
+        if (!zeroCopy) {
+            captureStats().frameConverted(duration);
+        } else if (isInputMJPEG) {
+            // A corrupt JPEG cannot fall back to the camera format: the consumer asked for pixels, not a bitstream
+            captureStats().decodeFailed();
+            requeueBuffer(bufferIndex);
+            return nullptr;
+        }
+
         if (verboseLogEnabled()) {
 #ifdef DEBUG
             constexpr const char* mode = "(Debug)";
 #else
             constexpr const char* mode = "(Release)";
 #endif
-
-            std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
-
-            zeroCopy = !inplaceConvertFrame(frame.get(), m_frameProp.outputPixelFormat, shouldFlip);
-
-            double durInMs = (std::chrono::steady_clock::now() - startTime).count() / 1.e6;
-            static double s_allCostTime = 0;
-            static double s_frames = 0;
-
-            if (s_frames > 60) {
-                s_allCostTime = 0;
-                s_frames = 0;
-            }
-
-            s_allCostTime += durInMs;
-            ++s_frames;
-
             CCAP_LOG_V(
                 "ccap: inplaceConvertFrame requested pixel format: %s, actual pixel format: %s, flip: %s, cost time %s: (cur %g ms, avg %g ms)\n",
                 pixelFormatToString(m_frameProp.outputPixelFormat).data(), pixelFormatToString(m_frameProp.cameraPixelFormat).data(),
-                shouldFlip ? "YES" : "NO", mode, durInMs, s_allCostTime / s_frames);
-        } else {
-            zeroCopy = !inplaceConvertFrame(frame.get(), m_frameProp.outputPixelFormat, shouldFlip);
+                shouldFlip ? "YES" : "NO", mode, duration / 1.e6, captureStats().conversionAverageUs() / 1.e3);
         }
     }
 
@@ -640,10 +901,10 @@ bool ProviderV4L2::readFrame() {
         frame->orientation = inputOrientation;
 
         // Create shared buffer manager to handle V4L2 buffer lifecycle
-        auto bufferIndex = buf.index;
         frame->nativeHandle = (void*)(uintptr_t)bufferIndex;
         std::weak_ptr<void> lifeHolder = m_lifeHolder;
-        auto bufferManager = std::make_shared<FakeFrame>([lifeHolder, this, bufferIndex, frame]() mutable {
+        auto memoryOwner = m_buffers[bufferIndex].allocator; // Imported memory must outlive the frame, even after stop()
+        auto bufferManager = std::make_shared<FakeFrame>([lifeHolder, this, bufferIndex, frame, memoryOwner]() mutable {
             // Requeue the V4L2 buffer when frame is destroyed
             auto holder = lifeHolder.lock();
             if (!holder) {
@@ -652,17 +913,10 @@ bool ProviderV4L2::readFrame() {
             }
 
             if (m_fd >= 0 && m_isStreaming) {
-                struct v4l2_buffer requeueBuf = {};
-                requeueBuf.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
-                requeueBuf.memory = V4L2_MEMORY_MMAP;
-                requeueBuf.index = bufferIndex;
-
-                if (ioctl(m_fd, VIDIOC_QBUF, &requeueBuf) < 0) {
-                    CCAP_LOG_E("ccap: VIDIOC_QBUF failed in destructor: %s\n", strerror(errno));
-                    reportError(ErrorCode::FrameCaptureFailed, "VIDIOC_QBUF failed in destructor: " + std::string(strerror(errno)));
-                }
+                requeueBuffer(bufferIndex);
             }
             frame = nullptr;
+            memoryOwner = nullptr;
         });
 
         // Replace frame with shared_ptr that manages V4L2 buffer lifecycle
@@ -673,47 +927,43 @@ bool ProviderV4L2::readFrame() {
         frame->sizeInBytes = frame->stride[0] * frame->height + (frame->stride[1] + frame->stride[2]) * frame->height / 2;
 
         // Requeue buffer immediately after copying data
-        if (ioctl(m_fd, VIDIOC_QBUF, &buf) < 0) {
-            CCAP_LOG_E("ccap: VIDIOC_QBUF failed: %s\n", strerror(errno));
-            reportError(ErrorCode::FrameCaptureFailed, "VIDIOC_QBUF failed: " + std::string(strerror(errno)));
-            return false;
+        if (!requeueBuffer(bufferIndex)) {
+            return nullptr;
         }
     }
 
-    frame->frameIndex = m_frameIndex++;
-
-    if (verboseLogEnabled()) { // Usually camera interfaces are not called from multiple threads, and verbose log is for debugging, so
-                               // no lock here.
-        static uint64_t s_lastFrameTime;
-        static std::deque<uint64_t> s_durations;
-
-        if (s_lastFrameTime != 0) {
-            auto dur = frame->timestamp - s_lastFrameTime;
-            s_durations.emplace_back(dur);
-        }
-
-        s_lastFrameTime = frame->timestamp;
+    if (verboseLogEnabled()) {
+        CCAP_LOG_V("ccap: New frame available: %ux%u, bytes %u, Data address: %p, fps: %g\n", frame->width, frame->height,
+                   frame->sizeInBytes, frame->data[0], std::round(captureStats().fps() * 10) / 10.0);
+    }
 
-        // use a window of 30 frames to calculate the fps
-        if (s_durations.size() > 30) {
-            s_durations.pop_front();
-        }
+    return frame;
+}
 
-        double fps = 0.0;
+void ProviderV4L2::fillQueueBuffer(struct v4l2_buffer& buf, uint32_t bufferIndex) const {
+    buf.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+    buf.memory = m_memoryType;
+    buf.index = bufferIndex;
+
+    const auto& buffer = m_buffers[bufferIndex];
+    if (m_memoryType == V4L2_MEMORY_USERPTR) {
+        buf.m.userptr = reinterpret_cast<unsigned long>(buffer.start);
+        buf.length = static_cast<uint32_t>(buffer.length);
+    } else if (m_memoryType == V4L2_MEMORY_DMABUF) {
+        buf.m.fd = buffer.allocator->dmabufFd();
+        buf.length = static_cast<uint32_t>(buffer.length);
+    }
+}
 
-        if (!s_durations.empty()) {
-            double sum = 0.0;
-            for (auto& d : s_durations) {
-                sum += d / 1e9f;
-            }
-            fps = std::round(s_durations.size() / sum * 10) / 10.0;
-        }
+bool ProviderV4L2::requeueBuffer(uint32_t bufferIndex) {
+    struct v4l2_buffer buf = {};
+    fillQueueBuffer(buf, bufferIndex);
 
-        CCAP_LOG_V("ccap: New frame available: %ux%u, bytes %u, Data address: %p, fps: %g\n", frame->width, frame->height,
-                   frame->sizeInBytes, frame->data[0], fps);
+    if (ioctl(m_fd, VIDIOC_QBUF, &buf) < 0) {
+        CCAP_LOG_E("ccap: VIDIOC_QBUF failed: %s\n", strerror(errno));
+        reportError(ErrorCode::FrameCaptureFailed, "VIDIOC_QBUF failed: " + std::string(strerror(errno)));
+        return false;
     }
-
-    newFrameAvailable(std::move(frame));
     return true;
 }
 
@@ -29,6 +29,7 @@ extern "C" {
 #include <fcntl.h>
 #include <linux/videodev2.h>
 #include <poll.h>
+#include <sys/eventfd.h>
 #include <sys/ioctl.h>
 #include <sys/mman.h>
 #include <unistd.h>
@@ -53,12 +54,15 @@ public:
     bool start() override;
     void stop() override;
     bool isStarted() const override;
+    int captureFd() const override;
+    int serviceCapture() override;
 
 private:
     struct V4L2Buffer {
         void* start = nullptr;
         size_t length = 0;
         uint32_t index = 0;
+        std::shared_ptr<Allocator> allocator; ///< Owns the memory for V4L2_MEMORY_USERPTR / V4L2_MEMORY_DMABUF
     };
 
     struct V4L2Format {
@@ -71,17 +75,31 @@ private:
     bool setupDevice();
     bool negotiateFormat();
     bool allocateBuffers();
+    /// Hand buffers of the frame allocator to the driver, see PropertyName::CaptureMemory.
+    bool importBuffers(uint32_t count, CaptureMemory memory);
+    bool mapDriverBuffers(uint32_t count);
     void releaseBuffers();
     bool startStreaming();
     void stopStreaming();
     void captureThread();
+    /// Wait for the device on the capture thread, then dequeueFrame().
     bool readFrame();
+    /// Dequeue and submit a frame without blocking. Sets `backoffMs` when the device should be left alone for a while.
+    bool dequeueFrame(int& backoffMs);
+    /// Convert a dequeued frame (or wrap the camera buffer when no conversion is needed) and requeue the buffer when done.
+    /// Runs on the capture thread or on a conversion worker, see PropertyName::ConvertWorkerCount.
+    std::shared_ptr<VideoFrame> finishFrame(std::shared_ptr<VideoFrame> frame, uint32_t bufferIndex, bool zeroCopy, bool shouldFlip);
+    bool requeueBuffer(uint32_t bufferIndex);
+    /// Fill a v4l2_buffer for VIDIOC_QBUF with the memory of the buffer.
+    void fillQueueBuffer(struct v4l2_buffer& buf, uint32_t bufferIndex) const;
 
     // V4L2 utility methods
     bool queryCapabilities();
     bool enumerateFormats();
     bool enumerateFrameSizes();
     std::vector<DeviceInfo::Resolution> getSupportedResolutions(uint32_t pixelformat);
+    /// @return The highest frame rate of the format at the size, 0 if the size is not supported or the driver cannot tell.
+    double getMaxFrameRate(uint32_t pixelformat, uint32_t width, uint32_t height);
     PixelFormat v4l2FormatToCcapFormat(uint32_t v4l2Format);
     uint32_t ccapFormatToV4l2Format(PixelFormat ccapFormat);
     const char* getFormatName(uint32_t pixelformat);
@@ -98,7 +116,7 @@ private:
     std::string m_devicePath;
     std::string m_deviceName;
     bool m_isOpened = false;
-    bool m_isStreaming = false;
+    std::atomic<bool> m_isStreaming{ false }; ///< Read by grab() on other threads
 
     // V4L2 device capabilities
     struct v4l2_capability m_caps{};
@@ -108,19 +126,21 @@ private:
     // Current format
     struct v4l2_format m_currentFormat{};
 
-    // Buffer management
+    // Buffer management, the count comes from PropertyName::CaptureBufferCount / CaptureMode
     std::vector<V4L2Buffer> m_buffers;
-    static constexpr size_t kBufferCount = 4;
+    uint32_t m_memoryType = V4L2_MEMORY_MMAP; ///< The memory of m_buffers, may differ from captureMemory() after a fallback
 
     // Capture thread
     std::unique_ptr<std::thread> m_captureThread;
     std::atomic<bool> m_shouldStop{ false };
-    std::mutex m_captureMutex;
-    std::condition_variable m_captureCondition;
+    int m_wakeFd = -1; ///< eventfd polled with the device, written by stop() so the capture thread exits at once
+    std::mutex m_captureMutex; ///< Held by serviceCapture(), stop() takes it before releasing the buffers
 
     // Frame management
     std::chrono::steady_clock::time_point m_startTime{};
     uint64_t m_frameIndex{ 0 };
+    uint32_t m_lastSequence{ 0 }; ///< v4l2_buffer::sequence of the last dequeued frame, gaps are driver drops
+    bool m_hasSequence{ false };
 
     std::shared_ptr<int> m_lifeHolder; // To keep the provider alive while frames are being processed
 
@@ -0,0 +1,988 @@
+/**
+ * @file ccap_imp_virtual.cpp
+ * @author wysaid (this@wysaid.org)
+ * @brief Virtual implementation of ccap::Provider class: test patterns and Y4M/raw file playback.
+ * @date 2025-10
+ *
+ */
+
+#include "ccap_imp_virtual.h"
+
+#include "ccap_convert_frame.h"
+#include "ccap_jpeg.h"
+#include "ccap_utils.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <vector>
+
+namespace ccap {
+
+namespace {
+
+constexpr double kDefaultVirtualFps = 30.0;
+constexpr int kPatternScrollPixels = 4; ///< Pixels the color bars move per frame
+
+struct PlaneInfo {
+    uint32_t offset = 0;
+    uint32_t stride = 0;
+    uint32_t rows = 0;
+};
+
+/// Tightly packed frame layout, the same layout `dumpFrameToFile` writes for YUV frames.
+struct FrameLayout {
+    PixelFormat format = PixelFormat::Unknown;
+    uint32_t width = 0;
+    uint32_t height = 0;
+    PlaneInfo planes[3]{};
+    int planeCount = 0;
+    size_t frameSize = 0;
+};
+
+inline PixelFormat stripFullRange(PixelFormat format) {
+    return static_cast<PixelFormat>(static_cast<uint32_t>(format) & ~static_cast<uint32_t>(kPixelFormatFullRangeBit));
+}
+
+bool makeFrameLayout(PixelFormat format, int width, int height, FrameLayout& layout) {
+    if (width <= 0 || height <= 0) return false;
+
+    layout = FrameLayout{};
+    layout.format = format;
+    layout.width = width;
+    layout.height = height;
+
+    uint32_t w = width, h = height;
+    bool isYUV = format & kPixelFormatYUVColorBit;
+    if (isYUV && (w & 1)) return false;
+
+    switch (stripFullRange(format)) {
+    case PixelFormat::NV12:
+        if (h & 1) return false;
+        layout.planes[0] = { 0, w, h };
+        layout.planes[1] = { w * h, w, h / 2 };
+        layout.planeCount = 2;
+        break;
+    case PixelFormat::I420:
+        if (h & 1) return false;
+        layout.planes[0] = { 0, w, h };
+        layout.planes[1] = { w * h, w / 2, h / 2 };
+        layout.planes[2] = { w * h + (w / 2) * (h / 2), w / 2, h / 2 };
+        layout.planeCount = 3;
+        break;
+    case PixelFormat::YUYV:
+    case PixelFormat::UYVY:
+        layout.planes[0] = { 0, w * 2, h };
+        layout.planeCount = 1;
+        break;
+    case PixelFormat::RGB24:
+    case PixelFormat::BGR24:
+        layout.planes[0] = { 0, w * 3, h };
+        layout.planeCount = 1;
+        break;
+    case PixelFormat::RGBA32:
+    case PixelFormat::BGRA32:
+        layout.planes[0] = { 0, w * 4, h };
+        layout.planeCount = 1;
+        break;
+    default:
+        return false;
+    }
+
+    const auto& last = layout.planes[layout.planeCount - 1];
+    layout.frameSize = static_cast<size_t>(last.offset) + static_cast<size_t>(last.stride) * last.rows;
+    return true;
+}
+
+void bindFrameLayout(VideoFrame* frame, const FrameLayout& layout, uint8_t* base) {
+    for (int i = 0; i < 3; ++i) {
+        if (i < layout.planeCount) {
+            frame->data[i] = base + layout.planes[i].offset;
+            frame->stride[i] = layout.planes[i].stride;
+        } else {
+            frame->data[i] = nullptr;
+            frame->stride[i] = 0;
+        }
+    }
+    frame->width = layout.width;
+    frame->height = layout.height;
+    frame->pixelFormat = layout.format;
+    frame->sizeInBytes = static_cast<uint32_t>(layout.frameSize);
+}
+
+std::string toLower(std::string_view str) {
+    std::string ret(str);
+    std::transform(ret.begin(), ret.end(), ret.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return ret;
+}
+
+PixelFormat parsePixelFormatName(std::string_view name) {
+    static const struct {
+        const char* name;
+        PixelFormat format;
+    } kFormatNames[] = {
+        { "nv12", PixelFormat::NV12 },     { "nv12f", PixelFormat::NV12f },   { "i420", PixelFormat::I420 },
+        { "i420f", PixelFormat::I420f },   { "yuv420", PixelFormat::I420 },   { "yuv420p", PixelFormat::I420 },
+        { "yuyv", PixelFormat::YUYV },     { "yuyvf", PixelFormat::YUYVf },   { "yuy2", PixelFormat::YUYV },
+        { "uyvy", PixelFormat::UYVY },     { "uyvyf", PixelFormat::UYVYf },   { "rgb", PixelFormat::RGB24 },
+        { "rgb24", PixelFormat::RGB24 },   { "bgr", PixelFormat::BGR24 },     { "bgr24", PixelFormat::BGR24 },
+        { "rgba", PixelFormat::RGBA32 },   { "rgba32", PixelFormat::RGBA32 }, { "bgra", PixelFormat::BGRA32 },
+        { "bgra32", PixelFormat::BGRA32 }, { "mjpeg", PixelFormat::MJPEG },   { "mjpg", PixelFormat::MJPEG },
+        { "jpeg", PixelFormat::MJPEG },    { "jpg", PixelFormat::MJPEG },
+    };
+
+    auto lowerName = toLower(name);
+    for (const auto& item : kFormatNames) {
+        if (lowerName == item.name) return item.format;
+    }
+    return PixelFormat::Unknown;
+}
+
+/// Stream description from the device name, e.g. "nv12:1920x1080@60". Unset fields are filled from the provider properties.
+struct StreamSpec {
+    PixelFormat format = PixelFormat::Unknown;
+    int width = 0;
+    int height = 0;
+    double fps = -1.0; ///< Negative means not specified, 0 means unthrottled.
+};
+
+bool parseStreamSpec(std::string_view text, StreamSpec& spec) {
+    while (!text.empty()) {
+        auto sep = text.find(':');
+        auto token = text.substr(0, sep);
+        text = sep == std::string_view::npos ? std::string_view() : text.substr(sep + 1);
+
+        auto at = token.find('@');
+        if (at != std::string_view::npos) {
+            std::string fpsStr(token.substr(at + 1));
+            char* end = nullptr;
+            double fps = std::strtod(fpsStr.c_str(), &end);
+            if (fpsStr.empty() || *end != '\0' || fps < 0) return false;
+            spec.fps = fps;
+            token = token.substr(0, at);
+        }
+
+        if (token.empty()) continue;
+
+        auto x = token.find_first_of("xX");
+        if (x != std::string_view::npos && x > 0 && std::isdigit(static_cast<unsigned char>(token[0]))) {
+            std::string sizeStr(token);
+            char* end = nullptr;
+            long w = std::strtol(sizeStr.c_str(), &end, 10);
+            if (end != sizeStr.c_str() + x) return false;
+            long h = std::strtol(end + 1, &end, 10);
+            if (*end != '\0' || w <= 0 || h <= 0) return false;
+            spec.width = static_cast<int>(w);
+            spec.height = static_cast<int>(h);
+        } else {
+            auto format = parsePixelFormatName(token);
+            if (format == PixelFormat::Unknown) return false;
+            spec.format = format;
+        }
+    }
+    return true;
+}
+
+inline bool startsWith(std::string_view str, std::string_view prefix) {
+    return str.size() >= prefix.size() && str.substr(0, prefix.size()) == prefix;
+}
+
+inline uint8_t clampToByte(double v) { return static_cast<uint8_t>(std::clamp(v + 0.5, 0.0, 255.0)); }
+
+} // namespace
+
+/// Produces raw frames for ProviderVirtual.
+class VirtualSource {
+public:
+    virtual ~VirtualSource() = default;
+
+    /// Resolve the actual stream properties from the device name and the requested properties.
+    virtual FrameProperty resolve(const FrameProperty& requested) const = 0;
+    /// Called on start with the resolved properties.
+    virtual bool prepare(const FrameProperty& prop) = 0;
+    /// Write the next frame into `dst` using `layout()`.
+    virtual bool readFrame(uint8_t* dst) = 0;
+    /// Advance by one frame without producing it, used when the consumer is too slow.
+    virtual void skipFrame() = 0;
+    /// Bytes written by the last `readFrame`, compressed frames are smaller than `layout().frameSize`.
+    virtual size_t lastFrameSize() const { return m_layout.frameSize; }
+
+    const FrameLayout& layout() const { return m_layout; }
+
+protected:
+    FrameProperty resolveSpec(const FrameProperty& requested) const {
+        FrameProperty prop = requested;
+        if (m_spec.format != PixelFormat::Unknown) {
+            prop.cameraPixelFormat = m_spec.format;
+        } else if (prop.cameraPixelFormat == PixelFormat::Unknown) {
+            prop.cameraPixelFormat = PixelFormat::NV12;
+        }
+
+        if (m_spec.width > 0) {
+            prop.width = m_spec.width;
+            prop.height = m_spec.height;
+        }
+
+        if (m_spec.fps >= 0) {
+            prop.fps = m_spec.fps;
+        } else if (prop.fps <= 0) {
+            prop.fps = kDefaultVirtualFps;
+        }
+        return prop;
+    }
+
+    bool prepareLayout(const FrameProperty& prop) {
+        if (!makeFrameLayout(prop.cameraPixelFormat, prop.width, prop.height, m_layout)) {
+            reportError(ErrorCode::UnsupportedResolution,
+                        "Virtual camera does not support " + std::string(pixelFormatToString(prop.cameraPixelFormat)) + " at " +
+                            std::to_string(prop.width) + "x" + std::to_string(prop.height));
+            return false;
+        }
+        return true;
+    }
+
+protected:
+    StreamSpec m_spec;
+    FrameLayout m_layout;
+};
+
+namespace {
+
+/// Horizontally scrolling 75% color bars over a static luma ramp.
+/// Each plane keeps one doubled bar row and one ramp row, so a frame is generated with plain row copies.
+class PatternSource : public VirtualSource {
+public:
+    explicit PatternSource(const StreamSpec& spec) { m_spec = spec; }
+
+    FrameProperty resolve(const FrameProperty& requested) const override { return resolveSpec(requested); }
+
+    bool prepare(const FrameProperty& prop) override {
+        if (!prepareLayout(prop)) return false;
+
+        m_tick = 0;
+        const uint32_t w = m_layout.width;
+        const uint32_t h = m_layout.height;
+        const bool fullRange = (m_layout.format & kPixelFormatFullRangeBit);
+        const uint32_t rampStart = (h * 3 / 4) & ~1u;
+
+        // 75% color bars: white, yellow, cyan, green, magenta, red, blue, black
+        static const uint8_t kBars[8][3] = {
+            { 191, 191, 191 }, { 191, 191, 0 }, { 0, 191, 191 }, { 0, 191, 0 },
+            { 191, 0, 191 },   { 191, 0, 0 },   { 0, 0, 191 },   { 0, 0, 0 },
+        };
+
+        std::vector<uint8_t> yBar(w), uBar(w), vBar(w), yRamp(w);
+        for (uint32_t x = 0; x < w; ++x) {
+            const auto* c = kBars[x * 8 / w];
+            double r = c[0], g = c[1], b = c[2];
+            double gray = w > 1 ? 255.0 * x / (w - 1) : 0.0;
+            if (fullRange) {
+                yBar[x] = clampToByte(0.299 * r + 0.587 * g + 0.114 * b);
+                uBar[x] = clampToByte(-0.168736 * r - 0.331264 * g + 0.5 * b + 128);
+                vBar[x] = clampToByte(0.5 * r - 0.418688 * g - 0.081312 * b + 128);
+                yRamp[x] = clampToByte(gray);
+            } else {
+                yBar[x] = clampToByte(16 + (65.481 * r + 128.553 * g + 24.966 * b) / 255);
+                uBar[x] = clampToByte(128 + (-37.797 * r - 74.203 * g + 112.0 * b) / 255);
+                vBar[x] = clampToByte(128 + (112.0 * r - 93.786 * g - 18.214 * b) / 255);
+                yRamp[x] = clampToByte(16 + gray * 219 / 255);
+            }
+        }
+
+        for (int i = 0; i < m_layout.planeCount; ++i) {
+            auto& plane = m_planes[i];
+            plane.rowBytes = m_layout.planes[i].stride;
+            plane.bar.assign(plane.rowBytes * 2, 0);
+            plane.ramp.assign(plane.rowBytes, 128);
+            plane.rampStartRow = m_layout.planes[i].rows == h ? rampStart : rampStart / 2;
+        }
+
+        switch (stripFullRange(m_layout.format)) {
+        case PixelFormat::NV12:
+            setPlane(0, 1, 1, [&](uint8_t* bar, uint8_t* ramp) {
+                std::copy(yBar.begin(), yBar.end(), bar);
+                std::copy(yRamp.begin(), yRamp.end(), ramp);
+            });
+            setPlane(1, 1, 1, [&](uint8_t* bar, uint8_t*) {
+                for (uint32_t x = 0; x < w; x += 2) {
+                    bar[x] = uBar[x];
+                    bar[x + 1] = vBar[x];
+                }
+            });
+            break;
+        case PixelFormat::I420:
+            setPlane(0, 1, 1, [&](uint8_t* bar, uint8_t* ramp) {
+                std::copy(yBar.begin(), yBar.end(), bar);
+                std::copy(yRamp.begin(), yRamp.end(), ramp);
+            });
+            setPlane(1, 1, 2, [&](uint8_t* bar, uint8_t*) {
+                for (uint32_t x = 0; x < w; x += 2) bar[x / 2] = uBar[x];
+            });
+            setPlane(2, 1, 2, [&](uint8_t* bar, uint8_t*) {
+                for (uint32_t x = 0; x < w; x += 2) bar[x / 2] = vBar[x];
+            });
+            break;
+        case PixelFormat::YUYV:
+        case PixelFormat::UYVY: {
+            const bool isYUYV = pixelFormatInclude(m_layout.format, PixelFormat::YUYV);
+            setPlane(0, 2, 1, [&](uint8_t* bar, uint8_t* ramp) {
+                for (uint32_t x = 0; x < w; x += 2) {
+                    uint8_t* b = bar + x * 2;
+                    uint8_t* r = ramp + x * 2;
+                    if (isYUYV) {
+                        b[0] = yBar[x], b[1] = uBar[x], b[2] = yBar[x + 1], b[3] = vBar[x];
+                        r[0] = yRamp[x], r[1] = 128, r[2] = yRamp[x + 1], r[3] = 128;
+                    } else {
+                        b[0] = uBar[x], b[1] = yBar[x], b[2] = vBar[x], b[3] = yBar[x + 1];
+                        r[0] = 128, r[1] = yRamp[x], r[2] = 128, r[3] = yRamp[x + 1];
+                    }
+                }
+            });
+        } break;
+        default: { // RGB24/BGR24/RGBA32/BGRA32
+            const int channels = (m_layout.format & kPixelFormatAlphaColorBit) ? 4 : 3;
+            const bool isBGR = m_layout.format & kPixelFormatBGRBit;
+            setPlane(0, channels, 1, [&](uint8_t* bar, uint8_t* ramp) {
+                for (uint32_t x = 0; x < w; ++x) {
+                    const auto* c = kBars[x * 8 / w];
+                    uint8_t* b = bar + x * channels;
+                    uint8_t* r = ramp + x * channels;
+                    b[0] = isBGR ? c[2] : c[0];
+                    b[1] = c[1];
+                    b[2] = isBGR ? c[0] : c[2];
+                    r[0] = r[1] = r[2] = static_cast<uint8_t>(w > 1 ? x * 255 / (w - 1) : 0);
+                    if (channels == 4) b[3] = r[3] = 0xff;
+                }
+            });
+        } break;
+        }
+        return true;
+    }
+
+    bool readFrame(uint8_t* dst) override {
+        const uint32_t shiftPixels = static_cast<uint32_t>((m_tick++ * kPatternScrollPixels) % m_layout.width) & ~1u;
+        for (int i = 0; i < m_layout.planeCount; ++i) {
+            const auto& plane = m_planes[i];
+            const auto& info = m_layout.planes[i];
+            const uint8_t* barRow = plane.bar.data() + shiftPixels * plane.shiftNum / plane.shiftDen;
+            uint8_t* row = dst + info.offset;
+            for (uint32_t y = 0; y < info.rows; ++y, row += info.stride) {
+                std::memcpy(row, y < plane.rampStartRow ? barRow : plane.ramp.data(), plane.rowBytes);
+            }
+        }
+        return true;
+    }
+
+    void skipFrame() override { ++m_tick; }
+
+private:
+    /// @param shiftNum/shiftDen bytes per pixel of horizontal scrolling in this plane.
+    template <typename Fn>
+    void setPlane(int index, uint32_t shiftNum, uint32_t shiftDen, Fn&& fill) {
+        auto& plane = m_planes[index];
+        plane.shiftNum = shiftNum;
+        plane.shiftDen = shiftDen;
+        fill(plane.bar.data(), plane.ramp.data());
+        std::memcpy(plane.bar.data() + plane.rowBytes, plane.bar.data(), plane.rowBytes); // doubled for wrap-around scrolling
+    }
+
+    struct PatternPlane {
+        std::vector<uint8_t> bar; ///< Two copies of the bar row
+        std::vector<uint8_t> ramp;
+        uint32_t rowBytes = 0;
+        uint32_t rampStartRow = 0;
+        uint32_t shiftNum = 1;
+        uint32_t shiftDen = 1;
+    };
+
+    PatternPlane m_planes[3];
+    uint64_t m_tick = 0;
+};
+
+/// Y4M (4:2:0 only), concatenated JPEG images (MJPEG) or headerless raw frames from a file. Loops at end of file.
+class FileSource : public VirtualSource {
+public:
+    ~FileSource() override {
+        if (m_file) std::fclose(m_file);
+    }
+
+    bool open(std::string_view path, const StreamSpec& spec) {
+        m_spec = spec;
+        m_path = std::string(path);
+        m_file = std::fopen(m_path.c_str(), "rb");
+        if (!m_file) {
+            reportError(ErrorCode::DeviceOpenFailed, "Failed to open file: " + m_path);
+            return false;
+        }
+
+        char magic[10] = {};
+        if (std::fread(magic, 1, sizeof(magic), m_file) == sizeof(magic) && std::memcmp(magic, "YUV4MPEG2 ", sizeof(magic)) == 0) {
+            m_isY4M = true;
+            return parseY4MHeader();
+        }
+
+        std::rewind(m_file);
+        m_dataStart = 0;
+
+        if (m_spec.format == PixelFormat::Unknown) { // Guess from the file name, e.g. "capture.NV12.yuv" written by dumpFrameToFile
+            auto fileName = std::filesystem::path(m_path).filename().string();
+            size_t pos = 0;
+            while ((pos = fileName.find('.', pos)) != std::string::npos) {
+                auto end = fileName.find('.', ++pos);
+                auto format = parsePixelFormatName(std::string_view(fileName).substr(pos, end == std::string::npos ? end : end - pos));
+                if (format != PixelFormat::Unknown) m_spec.format = format;
+            }
+        }
+
+        if ((static_cast<uint8_t>(magic[0]) == 0xFF && static_cast<uint8_t>(magic[1]) == 0xD8) || m_spec.format == PixelFormat::MJPEG) {
+            return loadMJPEG();
+        }
+        return true;
+    }
+
+    FrameProperty resolve(const FrameProperty& requested) const override {
+        FrameProperty prop = resolveSpec(requested);
+        if (m_isY4M) {
+            prop.cameraPixelFormat = m_y4mFormat;
+            prop.width = m_y4mWidth;
+            prop.height = m_y4mHeight;
+            if (m_spec.fps < 0 && m_y4mFps > 0) prop.fps = m_y4mFps;
+        } else if (m_isMJPEG) { // Size of the first image, the decoder follows the size of each image
+            prop.cameraPixelFormat = PixelFormat::MJPEG;
+            prop.width = m_mjpegWidth;
+            prop.height = m_mjpegHeight;
+        }
+        return prop;
+    }
+
+    bool prepare(const FrameProperty& prop) override {
+        if (m_isMJPEG) { // One plane large enough for the largest image
+            m_layout = FrameLayout{};
+            m_layout.format = PixelFormat::MJPEG;
+            m_layout.width = prop.width;
+            m_layout.height = prop.height;
+            m_layout.planeCount = 1;
+            for (const auto& image : m_mjpegImages) {
+                m_layout.frameSize = std::max(m_layout.frameSize, image.size);
+            }
+            m_nextImage = 0;
+            return true;
+        }
+
+        if (!prepareLayout(prop)) return false;
+
+        if (!m_isY4M) {
+            std::error_code ec;
+            auto fileSize = std::filesystem::file_size(m_path, ec);
+            if (ec || fileSize < m_layout.frameSize) {
+                reportError(ErrorCode::DeviceStartFailed, "File " + m_path + " is smaller than one " +
+                                std::string(pixelFormatToString(m_layout.format)) + " frame of " + std::to_string(m_layout.width) + "x" +
+                                std::to_string(m_layout.height));
+                return false;
+            }
+            if (fileSize % m_layout.frameSize != 0) {
+                CCAP_LOG_W("ccap: file %s size is not a multiple of the frame size %zu, trailing bytes are ignored\n", m_path.c_str(),
+                           m_layout.frameSize);
+            }
+        }
+        return std::fseek(m_file, m_dataStart, SEEK_SET) == 0;
+    }
+
+    bool readFrame(uint8_t* dst) override {
+        if (m_isMJPEG) {
+            const auto& image = m_mjpegImages[m_nextImage];
+            std::memcpy(dst, m_mjpegData.data() + image.offset, image.size);
+            m_lastImageSize = image.size;
+            skipFrame();
+            return true;
+        }
+        return nextFrame(dst);
+    }
+
+    void skipFrame() override {
+        if (m_isMJPEG) {
+            m_nextImage = (m_nextImage + 1) % m_mjpegImages.size();
+            return;
+        }
+        nextFrame(nullptr);
+    }
+
+    size_t lastFrameSize() const override { return m_isMJPEG ? m_lastImageSize : m_layout.frameSize; }
+
+private:
+    /// Load the whole file and index the images, frames are copied from memory while streaming.
+    bool loadMJPEG() {
+        std::error_code ec;
+        auto fileSize = std::filesystem::file_size(m_path, ec);
+        m_mjpegData.resize(ec ? 0 : static_cast<size_t>(fileSize));
+        std::rewind(m_file);
+        if (m_mjpegData.empty() || std::fread(m_mjpegData.data(), 1, m_mjpegData.size(), m_file) != m_mjpegData.size()) {
+            reportError(ErrorCode::DeviceOpenFailed, "Failed to read file: " + m_path);
+            return false;
+        }
+
+        const uint8_t* data = m_mjpegData.data();
+        const size_t size = m_mjpegData.size();
+        for (size_t pos = 0; pos + 4 <= size;) {
+            if (data[pos] != 0xFF || data[pos + 1] != 0xD8) { // Skip bytes between images, e.g. container headers
+                ++pos;
+                continue;
+            }
+
+            size_t imageSize = findJpegImageSize(data + pos, size - pos);
+            if (imageSize == 0) break; // Truncated last image
+            m_mjpegImages.push_back({ pos, imageSize });
+            pos += imageSize;
+        }
+
+        if (m_mjpegImages.empty() || !getJpegImageSize(data + m_mjpegImages[0].offset, m_mjpegImages[0].size, m_mjpegWidth, m_mjpegHeight)) {
+            reportError(ErrorCode::DeviceOpenFailed, "No complete JPEG image in file: " + m_path);
+            return false;
+        }
+
+        m_isMJPEG = true;
+        CCAP_LOG_V("ccap: %zu JPEG images of %dx%d in %s\n", m_mjpegImages.size(), m_mjpegWidth, m_mjpegHeight, m_path.c_str());
+        return true;
+    }
+
+    bool parseY4MHeader() {
+        std::string header;
+        for (int c; (c = std::fgetc(m_file)) != EOF && c != '\n';) {
+            header.push_back(static_cast<char>(c));
+            if (header.size() > 4096) break;
+        }
+
+        bool fullRange = false;
+        m_y4mPlanar422 = false;
+        std::string_view rest(header);
+        while (!rest.empty()) {
+            auto sep = rest.find(' ');
+            auto token = rest.substr(0, sep);
+            rest = sep == std::string_view::npos ? std::string_view() : rest.substr(sep + 1);
+            if (token.empty()) continue;
+
+            std::string value(token.substr(1));
+            switch (token[0]) {
+            case 'W':
+                m_y4mWidth = std::atoi(value.c_str());
+                break;
+            case 'H':
+                m_y4mHeight = std::atoi(value.c_str());
+                break;
+            case 'F': {
+                int num = 0, den = 0;
+                if (std::sscanf(value.c_str(), "%d:%d", &num, &den) == 2 && num > 0 && den > 0) m_y4mFps = static_cast<double>(num) / den;
+            } break;
+            case 'C':
+                if (startsWith(value, "422")) {
+                    m_y4mPlanar422 = true;
+                } else if (!startsWith(value, "420")) {
+                    reportError(ErrorCode::UnsupportedPixelFormat, "Unsupported Y4M colorspace: " + value + ", only 4:2:0 and 4:2:2 are supported");
+                    return false;
+                }
+                break;
+            case 'X':
+                if (toLower(value) == "colorrange=full") fullRange = true;
+                break;
+            default:
+                break;
+            }
+        }
+
+        if (m_y4mWidth <= 0 || m_y4mHeight <= 0) {
+            reportError(ErrorCode::DeviceOpenFailed, "Invalid Y4M header in file: " + m_path);
+            return false;
+        }
+
+        // Planar 4:2:2 is delivered as YUYV, the packed layout cameras produce and the converters take
+        if (m_y4mPlanar422) {
+            m_y4mFormat = fullRange ? PixelFormat::YUYVf : PixelFormat::YUYV;
+        } else {
+            m_y4mFormat = fullRange ? PixelFormat::I420f : PixelFormat::I420;
+        }
+
+        m_dataStart = std::ftell(m_file);
+        return true;
+    }
+
+    /// Read (dst != nullptr) or skip one frame, rewinding once at end of file.
+    bool nextFrame(uint8_t* dst) {
+        for (int attempt = 0; attempt < 2; ++attempt) {
+            if (attempt > 0 && std::fseek(m_file, m_dataStart, SEEK_SET) != 0) break;
+
+            if (m_isY4M) { // "FRAME[ params]\n"
+                char tag[5];
+                if (std::fread(tag, 1, sizeof(tag), m_file) != sizeof(tag)) continue;
+                if (std::memcmp(tag, "FRAME", sizeof(tag)) != 0) {
+                    reportError(ErrorCode::FrameCaptureFailed, "Corrupted Y4M frame header in file: " + m_path);
+                    return false;
+                }
+                int c;
+                while ((c = std::fgetc(m_file)) != EOF && c != '\n') {}
+                if (c == EOF) continue;
+            }
+
+            if (dst == nullptr) {
+                if (std::fseek(m_file, static_cast<long>(m_layout.frameSize), SEEK_CUR) == 0) return true;
+                continue;
+            }
+
+            if (m_y4mPlanar422) { // Same size as YUYV: w * h luma and two w/2 * h chroma planes
+                m_planar.resize(m_layout.frameSize);
+                if (std::fread(m_planar.data(), 1, m_planar.size(), m_file) == m_planar.size()) {
+                    packPlanar422(m_planar.data(), dst);
+                    return true;
+                }
+                continue;
+            }
+
+            if (std::fread(dst, 1, m_layout.frameSize, m_file) == m_layout.frameSize) return true;
+        }
+
+        if (dst) reportError(ErrorCode::FrameCaptureFailed, "Failed to read frame from file: " + m_path);
+        return false;
+    }
+
+    /// Interleave Y, U, V planes of 4:2:2 into YUYV, the inverse of what FrameRecorder writes for C422.
+    void packPlanar422(const uint8_t* src, uint8_t* dst) const {
+        const uint32_t w = m_layout.width, h = m_layout.height, cw = w / 2;
+        const uint8_t* y = src;
+        const uint8_t* u = y + static_cast<size_t>(w) * h;
+        const uint8_t* v = u + static_cast<size_t>(cw) * h;
+        for (uint32_t row = 0; row < h; ++row, y += w, u += cw, v += cw, dst += w * 2) {
+            for (uint32_t x = 0; x < cw; ++x) {
+                dst[x * 4] = y[x * 2];
+                dst[x * 4 + 1] = u[x];
+                dst[x * 4 + 2] = y[x * 2 + 1];
+                dst[x * 4 + 3] = v[x];
+            }
+        }
+    }
+
+private:
+    std::string m_path;
+    std::FILE* m_file = nullptr;
+    long m_dataStart = 0;
+
+    bool m_isY4M = false;
+    bool m_y4mPlanar422 = false; ///< C422 file, frames are packed to YUYV while reading
+    std::vector<uint8_t> m_planar; ///< One planar 4:2:2 frame
+    PixelFormat m_y4mFormat = PixelFormat::Unknown;
+    int m_y4mWidth = 0;
+    int m_y4mHeight = 0;
+    double m_y4mFps = 0;
+
+    struct JpegImage {
+        size_t offset;
+        size_t size;
+    };
+
+    bool m_isMJPEG = false;
+    std::vector<uint8_t> m_mjpegData;
+    std::vector<JpegImage> m_mjpegImages;
+    size_t m_nextImage = 0;
+    size_t m_lastImageSize = 0;
+    int m_mjpegWidth = 0;
+    int m_mjpegHeight = 0;
+};
+
+} // namespace
+
+bool isVirtualDeviceName(std::string_view deviceName) {
+    return deviceName == "pattern" || startsWith(deviceName, "pattern:") || startsWith(deviceName, "file:");
+}
+
+ProviderVirtual::ProviderVirtual() { CCAP_LOG_V("ccap: ProviderVirtual created\n"); }
+
+ProviderVirtual::~ProviderVirtual() {
+    close();
+    CCAP_LOG_V("ccap: ProviderVirtual destroyed\n");
+}
+
+std::vector<std::string> ProviderVirtual::findDeviceNames() {
+    return {}; // Virtual devices are addressed by name only
+}
+
+bool ProviderVirtual::open(std::string_view deviceName) {
+    if (m_isOpened) {
+        reportError(ErrorCode::DeviceOpenFailed, "Device already opened");
+        return false;
+    }
+
+    if (startsWith(deviceName, "file:")) {
+        auto path = deviceName.substr(5);
+        StreamSpec spec;
+        auto query = path.rfind('?');
+        if (query != std::string_view::npos) {
+            if (!parseStreamSpec(path.substr(query + 1), spec)) {
+                reportError(ErrorCode::InvalidDevice, "Invalid virtual device name: " + std::string(deviceName));
+                return false;
+            }
+            path = path.substr(0, query);
+        }
+
+        auto source = std::make_unique<FileSource>();
+        if (!source->open(path, spec)) return false;
+        m_source = std::move(source);
+    } else if (isVirtualDeviceName(deviceName)) {
+        StreamSpec spec;
+        if (deviceName.size() > 8 && !parseStreamSpec(deviceName.substr(8), spec)) {
+            reportError(ErrorCode::InvalidDevice, "Invalid virtual device name: " + std::string(deviceName));
+            return false;
+        }
+        m_source = std::make_unique<PatternSource>(spec);
+    } else {
+        reportError(ErrorCode::InvalidDevice, "Not a virtual device: " + std::string(deviceName));
+        return false;
+    }
+
+    m_deviceName = deviceName;
+    m_isOpened = true;
+    CCAP_LOG_I("ccap: Successfully opened virtual device: %s\n", m_deviceName.c_str());
+    return true;
+}
+
+bool ProviderVirtual::isOpened() const { return m_isOpened; }
+
+std::optional<DeviceInfo> ProviderVirtual::getDeviceInfo() const {
+    if (!isOpened()) {
+        return std::nullopt;
+    }
+
+    auto prop = m_source->resolve(m_frameProp);
+    DeviceInfo info;
+    info.deviceName = m_deviceName;
+    info.supportedPixelFormats.push_back(prop.cameraPixelFormat);
+    info.supportedResolutions.push_back({ static_cast<uint32_t>(prop.width), static_cast<uint32_t>(prop.height) });
+    return info;
+}
+
+void ProviderVirtual::close() {
+    if (isStarted()) {
+        stop();
+    }
+
+    m_source.reset();
+    m_stagingPool.clear();
+    m_isOpened = false;
+    m_isStreaming = false;
+
+    CCAP_LOG_V("ccap: Virtual device closed\n");
+}
+
+bool ProviderVirtual::start() {
+    if (!isOpened()) {
+        reportError(ErrorCode::DeviceStartFailed, "Device not opened");
+        return false;
+    }
+
+    if (m_isStreaming) {
+        CCAP_LOG_W("ccap: Already streaming\n");
+        return true;
+    }
+
+    auto prop = m_source->resolve(m_frameProp);
+    if (!m_source->prepare(prop)) {
+        reportError(ErrorCode::DeviceStartFailed, "Failed to start streaming");
+        return false;
+    }
+
+    m_frameProp.cameraPixelFormat = prop.cameraPixelFormat;
+    m_frameProp.width = prop.width;
+    m_frameProp.height = prop.height;
+    m_frameProp.fps = prop.fps;
+
+    m_shouldStop = false;
+    m_startTime = std::chrono::steady_clock::now();
+    m_pacingBase = m_startTime;
+    m_pacingCount = 0;
+    m_frameIndex = 0;
+    startConvertPipeline();
+
+    m_captureThread = std::make_unique<std::thread>(&ProviderVirtual::captureThread, this);
+
+    m_isStreaming = true;
+    CCAP_LOG_I("ccap: Virtual streaming started: %s %dx%d@%g\n", pixelFormatToString(prop.cameraPixelFormat).data(), prop.width,
+               prop.height, prop.fps);
+    return true;
+}
+
+void ProviderVirtual::stop() {
+    if (!m_isStreaming) {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_captureMutex);
+        m_shouldStop = true;
+    }
+    m_captureCondition.notify_all();
+    wakeGrabWaiters();
+
+    if (m_captureThread && m_captureThread->joinable()) {
+        m_captureThread->join();
+        m_captureThread.reset();
+    }
+    stopConvertPipeline();
+
+    m_isStreaming = false;
+    CCAP_LOG_I("ccap: Virtual streaming stopped\n");
+}
+
+bool ProviderVirtual::isStarted() const { return m_isStreaming && !m_shouldStop; }
+
+void ProviderVirtual::captureThread() {
+    CCAP_LOG_V("ccap: Virtual capture thread started\n");
+
+    const double fps = m_frameProp.fps;
+    const auto period = fps > 0 ? std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(1.0 / fps))
+                                : std::chrono::steady_clock::duration::zero();
+
+    while (!m_shouldStop) {
+        if (fps > 0) {
+            // Deadlines are computed from the base time, so rounding errors do not accumulate.
+            auto deadline = m_pacingBase + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                                               std::chrono::duration<double>(static_cast<double>(m_pacingCount) / fps));
+            auto now = std::chrono::steady_clock::now();
+            if (now > deadline + period) { // Fell behind by more than one frame: resync instead of bursting
+                m_pacingBase = now;
+                m_pacingCount = 0;
+            } else {
+                std::unique_lock<std::mutex> lock(m_captureMutex);
+                if (m_captureCondition.wait_until(lock, deadline, [this]() { return m_shouldStop.load(); })) break;
+            }
+            ++m_pacingCount;
+        } else if ((!m_callback && m_availableFrames->size() >= m_maxAvailableFrameSize) || convertPipelineFull()) {
+            // Unthrottled: produce frames as fast as they are consumed
+            std::this_thread::sleep_for(std::chrono::microseconds(200));
+            continue;
+        }
+
+        if (!readFrame() && fps <= 0) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+    }
+
+    CCAP_LOG_V("ccap: Virtual capture thread finished\n");
+}
+
+bool ProviderVirtual::readFrame() {
+    if (tooManyNewFrames()) {
+        CCAP_LOG_I("ccap: VideoFrame dropped to avoid memory leak: grab() called less frequently than camera frame rate.\n");
+        m_source->skipFrame();
+        return false;
+    }
+
+    auto frame = getFreeFrame();
+    if (!frame) {
+        CCAP_LOG_W("ccap: VideoFrame pool is full, a new frame skipped...\n");
+        m_source->skipFrame();
+        return false;
+    }
+
+    const auto& layout = m_source->layout();
+    const PixelFormat inputFormat = layout.format;
+    const auto inputOrientation = FrameOrientation::TopToBottom;
+
+    // Only YUV -> RGB and RGB -> RGB conversions are available, other output formats fall back to the source format.
+    // MJPEG is decoded for any output format but MJPEG/Unknown.
+    const PixelFormat outputFormat = m_frameProp.outputPixelFormat;
+    const bool isInputMJPEG = inputFormat == PixelFormat::MJPEG;
+    bool shouldConvert = outputFormat != PixelFormat::Unknown && outputFormat != inputFormat &&
+        (isInputMJPEG || !(outputFormat & kPixelFormatYUVColorBit));
+    PixelFormat deliverFormat = shouldConvert ? outputFormat : inputFormat;
+    bool isDeliverRGB = deliverFormat & kPixelFormatRGBColorBit;
+    frame->orientation = isDeliverRGB ? m_frameOrientation : FrameOrientation::TopToBottom;
+    bool shouldFlip = isDeliverRGB && frame->orientation != inputOrientation;
+
+    if (!frame->allocator) {
+        frame->allocator = m_allocatorFactory ? m_allocatorFactory() : std::make_shared<DefaultAllocator>();
+    }
+
+    // Without conversion the source is written straight into the frame memory.
+    bool needConvert = shouldConvert || shouldFlip;
+    auto staging = needConvert ? takeStaging() : nullptr;
+    Allocator* target = needConvert ? staging.get() : frame->allocator.get();
+    target->resize(layout.frameSize);
+    if (target->data() == nullptr || !m_source->readFrame(target->data())) {
+        recycleStaging(std::move(staging));
+        return false;
+    }
+
+    bindFrameLayout(frame.get(), layout, target->data());
+    const auto sourceSize = static_cast<uint32_t>(m_source->lastFrameSize());
+    frame->sizeInBytes = sourceSize;
+    applyCrop(frame.get());
+    captureStats().frameReceived(*frame, 0);
+    if (!passMotionGate(*frame)) {
+        recycleStaging(std::move(staging));
+        return true;
+    }
+    frame->timestamp = (std::chrono::steady_clock::now() - m_startTime).count();
+    frame->nativeHandle = nullptr;
+    frame->frameIndex = m_frameIndex;
+
+    auto task = [this, frame, staging, layout, needConvert, isInputMJPEG, deliverFormat, shouldFlip, sourceSize, inputOrientation]() mutable {
+        bool converted = false;
+        if (needConvert) {
+            uint64_t startTime = steadyNowNs();
+            converted = isInputMJPEG ? decodeMJPEGFrame(frame.get(), shouldFlip) :
+                                       inplaceConvertFrame(frame.get(), deliverFormat, shouldFlip, m_frameProp.outputWidth, m_frameProp.outputHeight);
+            if (converted) {
+                captureStats().frameConverted(steadyNowNs() - startTime);
+            }
+        }
+
+        if (needConvert && !converted && isInputMJPEG) {
+            // Corrupt JPEG, drop it rather than deliver a bitstream in place of the requested pixels
+            captureStats().decodeFailed();
+            recycleStaging(std::move(staging));
+            return std::shared_ptr<VideoFrame>();
+        }
+
+        if (needConvert && !converted) {
+            // Conversion failed, deliver the source format.
+            frame->allocator->resize(sourceSize);
+            std::memcpy(frame->allocator->data(), staging->data(), sourceSize);
+            bindFrameLayout(frame.get(), layout, frame->allocator->data());
+            frame->sizeInBytes = sourceSize;
+            applyCrop(frame.get());
+            frame->orientation = inputOrientation;
+        }
+
+        recycleStaging(std::move(staging));
+        return std::move(frame);
+    };
+
+    if (!submitFrame(std::move(task))) {
+        CCAP_LOG_I("ccap: VideoFrame dropped: all conversion workers are busy, consider a higher ConvertWorkerCount.\n");
+        return false;
+    }
+
+    ++m_frameIndex;
+    return true;
+}
+
+std::shared_ptr<Allocator> ProviderVirtual::takeStaging() {
+    std::lock_guard<std::mutex> lock(m_stagingMutex);
+    if (m_stagingPool.empty()) {
+        return std::make_shared<DefaultAllocator>();
+    }
+    auto staging = std::move(m_stagingPool.back());
+    m_stagingPool.pop_back();
+    return staging;
+}
+
+void ProviderVirtual::recycleStaging(std::shared_ptr<Allocator> staging) {
+    if (!staging) return;
+    std::lock_guard<std::mutex> lock(m_stagingMutex);
+    m_stagingPool.push_back(std::move(staging));
+}
+
+ProviderImp* createProviderVirtual() { return new ProviderVirtual(); }
+
+} // namespace ccap
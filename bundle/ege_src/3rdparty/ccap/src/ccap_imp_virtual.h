@@ -0,0 +1,95 @@
+/**
+ * @file ccap_imp_virtual.h
+ * @author wysaid (this@wysaid.org)
+ * @brief Header file for the virtual (synthetic / file-backed) implementation of ccap::Provider class.
+ * @date 2025-10
+ *
+ * Device name syntax:
+ *   - `pattern[:<format>][:<W>x<H>][@<fps>]`, e.g. "pattern:nv12:1920x1080@60"
+ *     Generates a scrolling color bar pattern.
+ *   - `file:<path>[?<format>][:<W>x<H>][@<fps>]`, e.g. "file:clip.y4m", "file:dump.yuv?i420:1280x720@30", "file:cam.mjpeg?@30"
+ *     Streams frames from a Y4M file, from concatenated JPEG images (MJPEG, loaded into memory, decoded like camera MJPEG),
+ *     or from a raw NV12/I420/YUYV/UYVY/RGB/BGR(A) file. Loops at end of file.
+ *
+ * Anything not given in the device name falls back to the Width/Height/FrameRate/PixelFormatInternal properties.
+ * `@0` disables frame pacing and produces frames as fast as they are consumed.
+ */
+
+#pragma once
+#ifndef CAMERA_CAPTURE_VIRTUAL_H
+#define CAMERA_CAPTURE_VIRTUAL_H
+
+#include "ccap_imp.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+
+namespace ccap {
+
+class VirtualSource;
+
+/**
+ * @brief Camera provider without a real device. Frames go through the same pool/convert/delivery path as real providers.
+ */
+class ProviderVirtual : public ProviderImp {
+public:
+    ProviderVirtual();
+    ~ProviderVirtual() override;
+
+    // ProviderImp interface implementation
+    std::vector<std::string> findDeviceNames() override;
+    bool open(std::string_view deviceName) override;
+    bool isOpened() const override;
+    std::optional<DeviceInfo> getDeviceInfo() const override;
+    void close() override;
+    bool start() override;
+    void stop() override;
+    bool isStarted() const override;
+    bool isVirtual() const override { return true; }
+
+private:
+    void captureThread();
+    bool readFrame();
+    std::shared_ptr<Allocator> takeStaging();
+    void recycleStaging(std::shared_ptr<Allocator> staging);
+
+private:
+    std::string m_deviceName;
+    std::unique_ptr<VirtualSource> m_source;
+    bool m_isOpened = false;
+    std::atomic<bool> m_isStreaming{ false }; ///< Read by grab() on other threads
+
+    /// Staging buffers for the source frames when a conversion is needed, one per frame in the conversion workers.
+    std::vector<std::shared_ptr<Allocator>> m_stagingPool;
+    std::mutex m_stagingMutex;
+
+    // Capture thread
+    std::unique_ptr<std::thread> m_captureThread;
+    std::atomic<bool> m_shouldStop{ false };
+    std::mutex m_captureMutex;
+    std::condition_variable m_captureCondition;
+
+    // Frame pacing
+    std::chrono::steady_clock::time_point m_startTime{};
+    std::chrono::steady_clock::time_point m_pacingBase{};
+    uint64_t m_pacingCount{ 0 };
+    uint64_t m_frameIndex{ 0 };
+};
+
+/// @return true if the device name should be handled by the virtual provider ("pattern..." or "file:...").
+bool isVirtualDeviceName(std::string_view deviceName);
+
+/**
+ * @brief Create a virtual provider instance
+ */
+ProviderImp* createProviderVirtual();
+
+} // namespace ccap
+
+#endif // CAMERA_CAPTURE_VIRTUAL_H
@@ -765,6 +765,7 @@ HRESULT STDMETHODCALLTYPE ProviderDirectShow::SampleCB(double sampleTime, IMedia
         }
     }
 
+    captureStats().frameReceived(*newFrame, 0);
     if (fixTimestamp) { // sampleTime is wrong, implement it yourself. This often happens when using virtual cameras.
         newFrame->timestamp = (std::chrono::steady_clock::now() - m_startTime).count();
     } else {
@@ -821,50 +822,45 @@ HRESULT STDMETHODCALLTYPE ProviderDirectShow::SampleCB(double sampleTime, IMedia
         assert(newFrame->stride[0] * newFrame->height <= bufferLen);
     }
 
+    newFrame->sizeInBytes = bufferLen; // Narrowed by applyCrop to the cropped view
+    applyCrop(newFrame.get(), inputOrientation == FrameOrientation::BottomToTop);
+    if (!passMotionGate(*newFrame)) {
+        return S_OK;
+    }
+
     if (!zeroCopy) { // If convert fails, fallback to using sampleData, need to continue with zeroCopy logic
 
         if (!newFrame->allocator) {
             newFrame->allocator = m_allocatorFactory ? m_allocatorFactory() : std::make_shared<DefaultAllocator>();
         }
 
+        uint64_t startTime = steadyNowNs();
+        zeroCopy = !inplaceConvertFrame(newFrame.get(), m_frameProp.outputPixelFormat, shouldFlip, m_frameProp.outputWidth, m_frameProp.outputHeight);
+        uint64_t duration = steadyNowNs() - startTime;
+        if (!zeroCopy) {
+            captureStats().frameConverted(duration);
+        }
+
         if (verboseLogEnabled()) {
 #ifdef DEBUG
             constexpr const char* mode = "(Debug)";
 #else
             constexpr const char* mode = "(Release)";
 #endif
-
-            std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
-
-            zeroCopy = !inplaceConvertFrame(newFrame.get(), m_frameProp.outputPixelFormat, shouldFlip);
-
-            double durInMs = (std::chrono::steady_clock::now() - startTime).count() / 1.e6;
-            static double s_allCostTime = 0;
-            static double s_frames = 0;
-
-            if (s_frames > 60) {
-                s_allCostTime = 0;
-                s_frames = 0;
-            }
-
-            s_allCostTime += durInMs;
-            ++s_frames;
-
             CCAP_LOG_V(
                 "ccap: inplaceConvertFrame requested pixel format: %s, actual pixel format: %s, flip: %s, cost time %s: (cur %g ms, avg %g ms)\n",
                 pixelFormatToString(m_frameProp.outputPixelFormat).data(), pixelFormatToString(m_frameProp.cameraPixelFormat).data(),
-                shouldFlip ? "YES" : "NO", mode, durInMs, s_allCostTime / s_frames);
-        } else {
-            zeroCopy = !inplaceConvertFrame(newFrame.get(), m_frameProp.outputPixelFormat, shouldFlip);
+                shouldFlip ? "YES" : "NO", mode, duration / 1.e6, captureStats().conversionAverageUs() / 1.e3);
         }
 
-        newFrame->sizeInBytes = newFrame->stride[0] * newFrame->height + (newFrame->stride[1] + newFrame->stride[2]) * newFrame->height / 2;
+        if (!zeroCopy) {
+            newFrame->sizeInBytes = newFrame->stride[0] * newFrame->height + (newFrame->stride[1] + newFrame->stride[2]) * newFrame->height / 2;
+        }
     }
 
     if (zeroCopy) {
         // Conversion may fail. If conversion fails, fall back to zero-copy mode.
         // In this case, the returned format is the original camera input format.
-        newFrame->sizeInBytes = bufferLen;
 
         mediaSample->AddRef(); // Ensure data lifecycle
         auto manager = std::make_shared<FakeFrame>([newFrame, mediaSample]() mutable {
@@ -877,35 +873,9 @@ HRESULT STDMETHODCALLTYPE ProviderDirectShow::SampleCB(double sampleTime, IMedia
 
     newFrame->frameIndex = m_frameIndex++;
 
-    if (ccap::verboseLogEnabled()) { // Usually camera interfaces are not called from multiple threads, and verbose log is for debugging, so
-                                     // no lock here.
-        static uint64_t s_lastFrameTime;
-        static std::deque<uint64_t> s_durations;
-
-        if (s_lastFrameTime != 0) {
-            auto dur = newFrame->timestamp - s_lastFrameTime;
-            s_durations.emplace_back(dur);
-        }
-
-        s_lastFrameTime = newFrame->timestamp;
-
-        // use a window of 30 frames to calculate the fps
-        if (s_durations.size() > 30) {
-            s_durations.pop_front();
-        }
-
-        double fps = 0.0;
-
-        if (!s_durations.empty()) {
-            double sum = 0.0;
-            for (auto& d : s_durations) {
-                sum += d / 1e9f;
-            }
-            fps = std::round(s_durations.size() / sum * 10) / 10.0;
-        }
-
+    if (ccap::verboseLogEnabled()) {
         CCAP_LOG_V("ccap: New frame available: %lux%lu, bytes %lu, Data address: %p, fps: %g\n", newFrame->width, newFrame->height,
-                   newFrame->sizeInBytes, newFrame->data[0], fps);
+                   newFrame->sizeInBytes, newFrame->data[0], std::round(captureStats().fps() * 10) / 10.0);
     }
 
     newFrameAvailable(std::move(newFrame));
@@ -1053,19 +1023,13 @@ bool ProviderDirectShow::start() {
 void ProviderDirectShow::stop() {
     CCAP_LOG_V("ccap: ProviderDirectShow stop called\n");
 
-    if (m_grabFrameWaiting) {
-        CCAP_LOG_V("ccap: VideoFrame waiting stopped\n");
-
-        m_grabFrameWaiting = false;
-        m_frameCondition.notify_all();
-    }
-
     if (m_isRunning && m_mediaControl) {
         m_mediaControl->Stop();
         m_isRunning = false;
 
         CCAP_LOG_V("ccap: IMediaControl->Stop() succeeded.\n");
     }
+    wakeGrabWaiters();
 }
 
 bool ProviderDirectShow::isStarted() const { return m_isRunning && m_mediaControl; }
@@ -123,7 +123,7 @@ private:
     // 状态变量
     bool m_didSetup{ false };
     bool m_isOpened{ false };
-    bool m_isRunning{ false };
+    std::atomic<bool> m_isRunning{ false }; ///< Read by grab() on other threads
 
     std::mutex m_callbackMutex;
 };
@@ -0,0 +1,760 @@
+/**
+ * @file ccap_jpeg.cpp
+ * @author wysaid (this@wysaid.org)
+ * @brief Baseline JPEG decoder for MJPEG camera streams.
+ * @date 2025-10
+ *
+ */
+
+#include "ccap_jpeg.h"
+
+#include "ccap_convert.h"
+#include "ccap_convert_avx2.h"
+#include "ccap_convert_neon.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+namespace ccap {
+
+namespace {
+
+/// Natural (row major) index of each zigzag position, padded so a corrupted run cannot index out of range.
+constexpr uint8_t kZigzag[64 + 16] = {
+    0,  1,  8,  16, 9,  2,  3,  10, 17, 24, 32, 25, 18, 11, 4,  5,  12, 19, 26, 33, 40, 48, 41, 34, 27, 20, 13, 6,  7,  14, 21, 28,
+    35, 42, 49, 56, 57, 50, 43, 36, 29, 22, 15, 23, 30, 37, 44, 51, 58, 59, 52, 45, 38, 31, 39, 46, 53, 60, 61, 54, 47, 55, 62, 63,
+    63, 63, 63, 63, 63, 63, 63, 63, 63, 63, 63, 63, 63, 63, 63, 63,
+};
+
+// Standard Huffman tables (ITU T.81, K.3). MJPEG streams usually omit DHT and rely on them.
+constexpr uint8_t kDcLumaCounts[16] = { 0, 1, 5, 1, 1, 1, 1, 1, 1, 0, 0, 0, 0, 0, 0, 0 };
+constexpr uint8_t kDcChromaCounts[16] = { 0, 3, 1, 1, 1, 1, 1, 1, 1, 1, 1, 0, 0, 0, 0, 0 };
+constexpr uint8_t kDcValues[12] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11 };
+
+constexpr uint8_t kAcLumaCounts[16] = { 0, 2, 1, 3, 3, 2, 4, 3, 5, 5, 4, 4, 0, 0, 1, 0x7d };
+constexpr uint8_t kAcLumaValues[162] = {
+    0x01, 0x02, 0x03, 0x00, 0x04, 0x11, 0x05, 0x12, 0x21, 0x31, 0x41, 0x06, 0x13, 0x51, 0x61, 0x07, 0x22, 0x71, 0x14, 0x32, 0x81,
+    0x91, 0xa1, 0x08, 0x23, 0x42, 0xb1, 0xc1, 0x15, 0x52, 0xd1, 0xf0, 0x24, 0x33, 0x62, 0x72, 0x82, 0x09, 0x0a, 0x16, 0x17, 0x18,
+    0x19, 0x1a, 0x25, 0x26, 0x27, 0x28, 0x29, 0x2a, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3a, 0x43, 0x44, 0x45, 0x46, 0x47, 0x48,
+    0x49, 0x4a, 0x53, 0x54, 0x55, 0x56, 0x57, 0x58, 0x59, 0x5a, 0x63, 0x64, 0x65, 0x66, 0x67, 0x68, 0x69, 0x6a, 0x73, 0x74, 0x75,
+    0x76, 0x77, 0x78, 0x79, 0x7a, 0x83, 0x84, 0x85, 0x86, 0x87, 0x88, 0x89, 0x8a, 0x92, 0x93, 0x94, 0x95, 0x96, 0x97, 0x98, 0x99,
+    0x9a, 0xa2, 0xa3, 0xa4, 0xa5, 0xa6, 0xa7, 0xa8, 0xa9, 0xaa, 0xb2, 0xb3, 0xb4, 0xb5, 0xb6, 0xb7, 0xb8, 0xb9, 0xba, 0xc2, 0xc3,
+    0xc4, 0xc5, 0xc6, 0xc7, 0xc8, 0xc9, 0xca, 0xd2, 0xd3, 0xd4, 0xd5, 0xd6, 0xd7, 0xd8, 0xd9, 0xda, 0xe1, 0xe2, 0xe3, 0xe4, 0xe5,
+    0xe6, 0xe7, 0xe8, 0xe9, 0xea, 0xf1, 0xf2, 0xf3, 0xf4, 0xf5, 0xf6, 0xf7, 0xf8, 0xf9, 0xfa,
+};
+
+constexpr uint8_t kAcChromaCounts[16] = { 0, 2, 1, 2, 4, 4, 3, 4, 7, 5, 4, 4, 0, 1, 2, 0x77 };
+constexpr uint8_t kAcChromaValues[162] = {
+    0x00, 0x01, 0x02, 0x03, 0x11, 0x04, 0x05, 0x21, 0x31, 0x06, 0x12, 0x41, 0x51, 0x07, 0x61, 0x71, 0x13, 0x22, 0x32, 0x81, 0x08,
+    0x14, 0x42, 0x91, 0xa1, 0xb1, 0xc1, 0x09, 0x23, 0x33, 0x52, 0xf0, 0x15, 0x62, 0x72, 0xd1, 0x0a, 0x16, 0x24, 0x34, 0xe1, 0x25,
+    0xf1, 0x17, 0x18, 0x19, 0x1a, 0x26, 0x27, 0x28, 0x29, 0x2a, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3a, 0x43, 0x44, 0x45, 0x46, 0x47,
+    0x48, 0x49, 0x4a, 0x53, 0x54, 0x55, 0x56, 0x57, 0x58, 0x59, 0x5a, 0x63, 0x64, 0x65, 0x66, 0x67, 0x68, 0x69, 0x6a, 0x73, 0x74,
+    0x75, 0x76, 0x77, 0x78, 0x79, 0x7a, 0x82, 0x83, 0x84, 0x85, 0x86, 0x87, 0x88, 0x89, 0x8a, 0x92, 0x93, 0x94, 0x95, 0x96, 0x97,
+    0x98, 0x99, 0x9a, 0xa2, 0xa3, 0xa4, 0xa5, 0xa6, 0xa7, 0xa8, 0xa9, 0xaa, 0xb2, 0xb3, 0xb4, 0xb5, 0xb6, 0xb7, 0xb8, 0xb9, 0xba,
+    0xc2, 0xc3, 0xc4, 0xc5, 0xc6, 0xc7, 0xc8, 0xc9, 0xca, 0xd2, 0xd3, 0xd4, 0xd5, 0xd6, 0xd7, 0xd8, 0xd9, 0xda, 0xe2, 0xe3, 0xe4,
+    0xe5, 0xe6, 0xe7, 0xe8, 0xe9, 0xea, 0xf2, 0xf3, 0xf4, 0xf5, 0xf6, 0xf7, 0xf8, 0xf9, 0xfa,
+};
+
+/// 8-bit samples give dequantized coefficients within +-2048 (plus rounding), clamping to this range keeps corrupted
+/// values inside the int16_t block. The worst case gain of one idct1D pass is 61214, so the first pass stays below
+/// 4095 * 61214 < 2^28, but the second one can reach 2^33 on corrupted data: idct1D works modulo 2^32 for that.
+constexpr int kMaxCoefficient = 4095;
+
+/// Legal DC predictions are far smaller, the bound keeps `dcPred * quant` within int on corrupted data.
+constexpr int kMaxDcPrediction = 32767;
+
+constexpr int kMaxImageSide = 16384;
+
+// Fixed point constants of the islow IDCT (CONST_BITS = 13)
+constexpr int kConstBits = 13;
+constexpr int kPass1Bits = 2;
+constexpr int32_t kFix_0_298631336 = 2446;
+constexpr int32_t kFix_0_390180644 = 3196;
+constexpr int32_t kFix_0_541196100 = 4433;
+constexpr int32_t kFix_0_765366865 = 6270;
+constexpr int32_t kFix_0_899976223 = 7373;
+constexpr int32_t kFix_1_175875602 = 9633;
+constexpr int32_t kFix_1_501321110 = 12299;
+constexpr int32_t kFix_1_847759065 = 15137;
+constexpr int32_t kFix_1_961570560 = 16069;
+constexpr int32_t kFix_2_053119869 = 16819;
+constexpr int32_t kFix_2_562915447 = 20995;
+constexpr int32_t kFix_3_072711693 = 25172;
+
+inline int readU16(const uint8_t* p) { return p[0] << 8 | p[1]; }
+
+inline bool isRestartMarker(uint8_t marker) { return marker >= 0xD0 && marker <= 0xD7; }
+
+inline int clampCoefficient(int v) { return std::clamp(v, -kMaxCoefficient, kMaxCoefficient); }
+
+inline uint8_t clampSample(int v) { return static_cast<uint8_t>(std::clamp(v, 0, 255)); }
+
+/// 1-D islow IDCT of s[0], s[stride] ... s[7 * stride], results are not descaled.
+/// @note Computed modulo 2^32 like the 32-bit lanes of the SIMD versions, corrupted blocks that exceed the int32 range
+///       (see kMaxCoefficient) give garbage pixels instead of undefined behavior. Valid data never wraps.
+inline void idct1D(const int32_t* s, int stride, int32_t* out) {
+    auto w = [](int32_t v) { return static_cast<uint32_t>(v); };
+
+    // Even part
+    uint32_t z2 = w(s[2 * stride]), z3 = w(s[6 * stride]);
+    uint32_t z1 = (z2 + z3) * w(kFix_0_541196100);
+    uint32_t tmp2 = z1 - z3 * w(kFix_1_847759065);
+    uint32_t tmp3 = z1 + z2 * w(kFix_0_765366865);
+    uint32_t tmp0 = (w(s[0]) + w(s[4 * stride])) << kConstBits;
+    uint32_t tmp1 = (w(s[0]) - w(s[4 * stride])) << kConstBits;
+    uint32_t tmp10 = tmp0 + tmp3, tmp13 = tmp0 - tmp3;
+    uint32_t tmp11 = tmp1 + tmp2, tmp12 = tmp1 - tmp2;
+
+    // Odd part
+    tmp0 = w(s[7 * stride]);
+    tmp1 = w(s[5 * stride]);
+    tmp2 = w(s[3 * stride]);
+    tmp3 = w(s[stride]);
+    z1 = tmp0 + tmp3;
+    z2 = tmp1 + tmp2;
+    z3 = tmp0 + tmp2;
+    uint32_t z4 = tmp1 + tmp3;
+    uint32_t z5 = (z3 + z4) * w(kFix_1_175875602);
+    tmp0 *= w(kFix_0_298631336);
+    tmp1 *= w(kFix_2_053119869);
+    tmp2 *= w(kFix_3_072711693);
+    tmp3 *= w(kFix_1_501321110);
+    z1 *= w(-kFix_0_899976223);
+    z2 *= w(-kFix_2_562915447);
+    z3 = z3 * w(-kFix_1_961570560) + z5;
+    z4 = z4 * w(-kFix_0_390180644) + z5;
+    tmp0 += z1 + z3;
+    tmp1 += z2 + z4;
+    tmp2 += z2 + z3;
+    tmp3 += z1 + z4;
+
+    out[0] = static_cast<int32_t>(tmp10 + tmp3);
+    out[7] = static_cast<int32_t>(tmp10 - tmp3);
+    out[1] = static_cast<int32_t>(tmp11 + tmp2);
+    out[6] = static_cast<int32_t>(tmp11 - tmp2);
+    out[2] = static_cast<int32_t>(tmp12 + tmp1);
+    out[5] = static_cast<int32_t>(tmp12 - tmp1);
+    out[3] = static_cast<int32_t>(tmp13 + tmp0);
+    out[4] = static_cast<int32_t>(tmp13 - tmp0);
+}
+
+/// Rounding right shift, the rounding term wraps like idct1D.
+inline int32_t descale(int32_t v, int shift) {
+    return static_cast<int32_t>(static_cast<uint32_t>(v) + (1u << (shift - 1))) >> shift;
+}
+
+typedef void (*IdctFunc)(const int16_t* coefficients, uint8_t* dst, int dstStride);
+
+IdctFunc getIdctFunc() {
+#if ENABLE_AVX2_IMP
+    if (canUseAVX2()) {
+        return idct8x8_avx2;
+    }
+#endif
+
+#if ENABLE_NEON_IMP
+    if (canUseNEON()) {
+        return idct8x8_neon;
+    }
+#endif
+
+    return idct8x8;
+}
+
+} // namespace
+
+void idct8x8(const int16_t* coefficients, uint8_t* dst, int dstStride) {
+    int32_t in[64], ws[64], out[8];
+    for (int i = 0; i < 64; ++i) {
+        in[i] = coefficients[i];
+    }
+
+    // Pass 1: columns, results are scaled up by 2^kPass1Bits
+    for (int col = 0; col < 8; ++col) {
+        const int32_t* s = in + col;
+        if ((s[8] | s[16] | s[24] | s[32] | s[40] | s[48] | s[56]) == 0) { // Same result as the full transform
+            for (int row = 0; row < 8; ++row) {
+                ws[row * 8 + col] = s[0] * (1 << kPass1Bits);
+            }
+            continue;
+        }
+
+        idct1D(s, 8, out);
+        for (int row = 0; row < 8; ++row) {
+            ws[row * 8 + col] = descale(out[row], kConstBits - kPass1Bits);
+        }
+    }
+
+    // Pass 2: rows, remove the scaling of both passes and the 8x of the transform
+    constexpr int kShift = kConstBits + kPass1Bits + 3;
+    for (int row = 0; row < 8; ++row, dst += dstStride) {
+        const int32_t* s = ws + row * 8;
+        if ((s[1] | s[2] | s[3] | s[4] | s[5] | s[6] | s[7]) == 0) {
+            std::memset(dst, clampSample(((s[0] + (1 << (kPass1Bits + 2))) >> (kPass1Bits + 3)) + 128), 8);
+            continue;
+        }
+
+        idct1D(s, 1, out);
+        for (int x = 0; x < 8; ++x) {
+            dst[x] = clampSample(descale(out[x], kShift) + 128);
+        }
+    }
+}
+
+/// MSB first bit reader over entropy coded data. Stuffed zero bytes are removed, zeros are returned past a marker.
+struct JpegDecoder::BitReader {
+    const uint8_t* pos;
+    const uint8_t* end;
+    uint64_t bits = 0; ///< Next bit in the highest position
+    int count = 0;
+    bool hitMarker = false;
+
+    BitReader(const uint8_t* p, const uint8_t* e) :
+        pos(p), end(e) {}
+
+    void fill() {
+        while (count <= 56) {
+            uint32_t byte = 0;
+            if (!hitMarker && pos < end) {
+                byte = *pos;
+                if (byte != 0xFF) {
+                    ++pos;
+                } else if (pos + 1 < end && pos[1] == 0) {
+                    pos += 2;
+                } else {
+                    hitMarker = true; // Leave the marker for the caller
+                    byte = 0;
+                }
+            }
+            bits |= static_cast<uint64_t>(byte) << (56 - count);
+            count += 8;
+        }
+    }
+
+    uint32_t peek(int n) const { return static_cast<uint32_t>(bits >> (64 - n)); }
+
+    void skip(int n) {
+        bits <<= n;
+        count -= n;
+    }
+
+    /// Read an `s` bit (1 ~ 16) magnitude and extend its sign, JPEG F.2.2.1
+    int receiveExtend(int s) {
+        if (count < s) fill();
+        int v = static_cast<int>(peek(s));
+        skip(s);
+        return v < (1 << (s - 1)) ? v - (1 << s) + 1 : v;
+    }
+
+    int decode(const HuffmanTable& table) {
+        if (count < 16) fill();
+        uint32_t entry = table.lookup[peek(9)];
+        if (entry != 0) {
+            skip(entry >> 8);
+            return entry & 0xFF;
+        }
+
+        int32_t code = static_cast<int32_t>(peek(16));
+        for (int length = 10; length <= 16; ++length) {
+            int32_t prefix = code >> (16 - length);
+            if (prefix <= table.maxCode[length]) {
+                skip(length);
+                return table.values[table.valueOffset[length] + prefix];
+            }
+        }
+        return -1;
+    }
+
+    /// Drop the bits left in the interval and consume the RSTn marker that must follow.
+    bool restart() {
+        bits = 0;
+        count = 0;
+        hitMarker = false;
+        for (; pos + 1 < end; ++pos) {
+            if (pos[0] == 0xFF && pos[1] != 0 && pos[1] != 0xFF) {
+                if (!isRestartMarker(pos[1])) return false;
+                pos += 2;
+                return true;
+            }
+        }
+        return false;
+    }
+};
+
+bool JpegDecoder::buildHuffmanTable(HuffmanTable& table, const uint8_t* counts, const uint8_t* symbols, int symbolCount) {
+    std::memset(table.lookup, 0, sizeof(table.lookup));
+    std::memset(table.fastAC, 0, sizeof(table.fastAC));
+    table.isValid = false;
+
+    int code = 0, k = 0;
+    for (int length = 1; length <= 16; ++length) {
+        int n = counts[length - 1];
+        if (k + n > symbolCount || code + n > (1 << length)) {
+            return false;
+        }
+
+        table.valueOffset[length] = k - code;
+        table.maxCode[length] = n > 0 ? code + n - 1 : -1;
+        for (int i = 0; i < n; ++i, ++code, ++k) {
+            table.values[k] = symbols[k];
+            if (length <= 9) {
+                int first = code << (9 - length), last = (code + 1) << (9 - length);
+                for (int j = first; j < last; ++j) {
+                    table.lookup[j] = static_cast<uint16_t>(length << 8 | symbols[k]);
+                }
+            }
+        }
+        code <<= 1;
+    }
+
+    // Run/size symbols that can be decoded together with their magnitude in a single lookup, only used for AC tables
+    for (int i = 0; i < (1 << 9); ++i) {
+        int length = table.lookup[i] >> 8, run = (table.lookup[i] >> 4) & 15, s = table.lookup[i] & 15;
+        if (length == 0 || s == 0 || length + s > 9) continue;
+
+        int v = (i >> (9 - length - s)) & ((1 << s) - 1);
+        v = v < (1 << (s - 1)) ? v - (1 << s) + 1 : v;
+        table.fastAC[i] = v * 256 + (run << 4 | (length + s));
+    }
+
+    table.isValid = true;
+    return true;
+}
+
+void JpegDecoder::setDefaultHuffmanTables() {
+    buildHuffmanTable(m_dcTables[0], kDcLumaCounts, kDcValues, 12);
+    buildHuffmanTable(m_dcTables[1], kDcChromaCounts, kDcValues, 12);
+    buildHuffmanTable(m_acTables[0], kAcLumaCounts, kAcLumaValues, 162);
+    buildHuffmanTable(m_acTables[1], kAcChromaCounts, kAcChromaValues, 162);
+    m_dcTables[2].isValid = m_dcTables[3].isValid = false;
+    m_acTables[2].isValid = m_acTables[3].isValid = false;
+}
+
+bool JpegDecoder::parseDQT(const uint8_t* p, int length) {
+    while (length > 0) {
+        int precision = p[0] >> 4, index = p[0] & 15;
+        int tableSize = 1 + (precision ? 128 : 64);
+        if (index > 3 || precision > 1 || length < tableSize) {
+            return false;
+        }
+
+        for (int i = 0; i < 64; ++i) {
+            m_quant[index][i] = static_cast<uint16_t>(precision ? readU16(p + 1 + i * 2) : p[1 + i]);
+        }
+        p += tableSize;
+        length -= tableSize;
+    }
+    return true;
+}
+
+bool JpegDecoder::parseDHT(const uint8_t* p, int length) {
+    while (length > 0) {
+        if (length < 17) return false;
+
+        int tableClass = p[0] >> 4, index = p[0] & 15;
+        int symbolCount = 0;
+        for (int i = 0; i < 16; ++i) {
+            symbolCount += p[1 + i];
+        }
+        if (tableClass > 1 || index > 3 || symbolCount > 256 || length < 17 + symbolCount) {
+            return false;
+        }
+
+        auto& table = tableClass == 0 ? m_dcTables[index] : m_acTables[index];
+        if (!buildHuffmanTable(table, p + 1, p + 17, symbolCount)) {
+            return false;
+        }
+        p += 17 + symbolCount;
+        length -= 17 + symbolCount;
+    }
+    return true;
+}
+
+bool JpegDecoder::parseSOF(const uint8_t* p, int length) {
+    if (length < 6 || p[0] != 8) { // 8-bit samples only
+        return false;
+    }
+
+    m_height = readU16(p + 1);
+    m_width = readU16(p + 3);
+    m_componentCount = p[5];
+    if ((m_componentCount != 1 && m_componentCount != 3) || length < 6 + m_componentCount * 3 || m_width <= 0 || m_height <= 0 ||
+        m_width > kMaxImageSide || m_height > kMaxImageSide) {
+        return false;
+    }
+
+    m_hMax = m_vMax = 1;
+    for (int i = 0; i < m_componentCount; ++i) {
+        auto& c = m_components[i];
+        const uint8_t* info = p + 6 + i * 3;
+        c.id = info[0];
+        c.h = info[1] >> 4;
+        c.v = info[1] & 15;
+        c.quantIndex = info[2];
+        if (c.h < 1 || c.h > 2 || c.v < 1 || c.v > 2 || c.quantIndex > 3) {
+            return false;
+        }
+        m_hMax = std::max(m_hMax, c.h);
+        m_vMax = std::max(m_vMax, c.v);
+    }
+
+    if (m_componentCount == 1) { // The sampling factors of a single component do not matter
+        m_components[0].h = m_components[0].v = 1;
+        m_hMax = m_vMax = 1;
+    } else if (m_components[0].h != m_hMax || m_components[0].v != m_vMax || m_components[1].h != 1 || m_components[1].v != 1 ||
+               m_components[2].h != 1 || m_components[2].v != 1) {
+        return false; // Only luma may be subsampled less than chroma, which covers all camera formats
+    }
+
+    m_mcusX = (m_width + 8 * m_hMax - 1) / (8 * m_hMax);
+    m_mcusY = (m_height + 8 * m_vMax - 1) / (8 * m_vMax);
+
+    size_t total = 0;
+    size_t offsets[3];
+    for (int i = 0; i < m_componentCount; ++i) {
+        auto& c = m_components[i];
+        c.stride = m_mcusX * c.h * 8;
+        c.blocksX = ((m_width * c.h + m_hMax - 1) / m_hMax + 7) / 8;
+        c.blocksY = ((m_height * c.v + m_vMax - 1) / m_vMax + 7) / 8;
+        offsets[i] = total;
+        total += static_cast<size_t>(c.stride) * m_mcusY * c.v * 8;
+    }
+
+    m_planes.resize(total);
+    for (int i = 0; i < m_componentCount; ++i) {
+        m_components[i].plane = m_planes.data() + offsets[i];
+    }
+    m_hasFrame = true;
+    return true;
+}
+
+bool JpegDecoder::decodeBlock(BitReader& reader, Component& c, uint8_t* dst, int dstStride) {
+    const uint16_t* quant = m_quant[c.quantIndex];
+
+    int t = reader.decode(m_dcTables[c.dcTable]);
+    if (t < 0 || t > 15) {
+        return false;
+    }
+    if (t > 0) {
+        c.dcPred = std::clamp(c.dcPred + reader.receiveExtend(t), -kMaxDcPrediction, kMaxDcPrediction);
+    }
+    int dc = clampCoefficient(c.dcPred * quant[0]);
+
+    const HuffmanTable& acTable = m_acTables[c.acTable];
+    bool hasAC = false;
+    for (int k = 1; k < 64;) {
+        if (reader.count < 16) reader.fill();
+
+        int run, value;
+        int32_t fast = acTable.fastAC[reader.peek(9)];
+        if (fast != 0) {
+            reader.skip(fast & 15);
+            run = (fast >> 4) & 15;
+            value = fast >> 8;
+        } else {
+            int rs = reader.decode(acTable);
+            if (rs < 0) {
+                return false;
+            }
+
+            run = rs >> 4;
+            int s = rs & 15;
+            if (s == 0) {
+                if (run != 15) break; // EOB
+                k += 16;              // ZRL
+                continue;
+            }
+            value = reader.receiveExtend(s);
+        }
+
+        k += run;
+        if (k > 63) {
+            return false;
+        }
+        if (!hasAC) {
+            std::memset(m_block, 0, sizeof(m_block));
+            hasAC = true;
+        }
+        m_block[kZigzag[k]] = static_cast<int16_t>(clampCoefficient(value * quant[k]));
+        ++k;
+    }
+
+    if (!hasAC) { // Flat block, the same value the full IDCT gives
+        uint8_t value = clampSample(((dc * (1 << kPass1Bits) + (1 << (kPass1Bits + 2))) >> (kPass1Bits + 3)) + 128);
+        for (int y = 0; y < 8; ++y, dst += dstStride) {
+            std::memset(dst, value, 8);
+        }
+        return true;
+    }
+
+    m_block[0] = static_cast<int16_t>(dc);
+    m_idct(m_block, dst, dstStride);
+    return true;
+}
+
+bool JpegDecoder::decodeScan(const uint8_t* p, int length, const uint8_t*& pos, const uint8_t* end) {
+    int count = length > 0 ? p[0] : 0;
+    if (count < 1 || count > m_componentCount || length < 4 + count * 2) {
+        return false;
+    }
+
+    Component* scan[3];
+    for (int i = 0; i < count; ++i) {
+        int id = p[1 + i * 2], tables = p[2 + i * 2];
+        scan[i] = nullptr;
+        for (int j = 0; j < m_componentCount; ++j) {
+            if (m_components[j].id == id) scan[i] = &m_components[j];
+        }
+        if (!scan[i]) return false;
+
+        scan[i]->dcTable = tables >> 4;
+        scan[i]->acTable = tables & 15;
+        if (scan[i]->dcTable > 3 || scan[i]->acTable > 3 || !m_dcTables[scan[i]->dcTable].isValid || !m_acTables[scan[i]->acTable].isValid) {
+            return false;
+        }
+        scan[i]->dcPred = 0;
+    }
+
+    const uint8_t* spectral = p + 1 + count * 2;
+    if (spectral[0] != 0 || spectral[1] != 63 || spectral[2] != 0) { // Sequential scans only
+        return false;
+    }
+
+    BitReader reader(pos, end);
+    int units = 0; // MCUs, or blocks of a non-interleaved scan, for restart intervals
+    auto nextUnit = [&]() {
+        if (m_restartInterval > 0 && units > 0 && units % m_restartInterval == 0) {
+            if (!reader.restart()) return false;
+            for (int i = 0; i < count; ++i) {
+                scan[i]->dcPred = 0;
+            }
+        }
+        ++units;
+        return true;
+    };
+
+    if (count == 1) {
+        Component& c = *scan[0];
+        for (int by = 0; by < c.blocksY; ++by) {
+            for (int bx = 0; bx < c.blocksX; ++bx) {
+                if (!nextUnit() || !decodeBlock(reader, c, c.plane + by * 8 * c.stride + bx * 8, c.stride)) {
+                    return false;
+                }
+            }
+        }
+    } else {
+        for (int mcuY = 0; mcuY < m_mcusY; ++mcuY) {
+            for (int mcuX = 0; mcuX < m_mcusX; ++mcuX) {
+                if (!nextUnit()) return false;
+
+                for (int i = 0; i < count; ++i) {
+                    Component& c = *scan[i];
+                    for (int v = 0; v < c.v; ++v) {
+                        uint8_t* row = c.plane + (mcuY * c.v + v) * 8 * c.stride + mcuX * c.h * 8;
+                        for (int h = 0; h < c.h; ++h) {
+                            if (!decodeBlock(reader, c, row + h * 8, c.stride)) return false;
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    // Continue after the entropy coded data, at the next marker
+    for (pos = std::min(reader.pos, end); pos + 1 < end; ++pos) {
+        if (pos[0] == 0xFF && pos[1] != 0 && pos[1] != 0xFF && !isRestartMarker(pos[1])) break;
+    }
+    return true;
+}
+
+bool JpegDecoder::decode(const uint8_t* data, size_t size, I420View& view) {
+    if (data == nullptr || size < 4 || data[0] != 0xFF || data[1] != 0xD8) {
+        return false;
+    }
+
+    m_idct = getIdctFunc();
+    setDefaultHuffmanTables();
+    m_restartInterval = 0;
+    m_hasFrame = false;
+
+    const uint8_t* end = data + size;
+    const uint8_t* pos = data + 2;
+    bool hasScan = false;
+    while (pos + 1 < end) {
+        if (pos[0] != 0xFF) {
+            return false;
+        }
+
+        uint8_t marker = pos[1];
+        pos += 2;
+        if (marker == 0xFF) { // Fill byte
+            --pos;
+            continue;
+        }
+        if (marker == 0xD9) { // EOI
+            break;
+        }
+        if (marker == 0x01 || isRestartMarker(marker)) {
+            continue;
+        }
+
+        if (pos + 2 > end) return false;
+        int length = readU16(pos);
+        if (length < 2 || pos + length > end) return false;
+        const uint8_t* payload = pos + 2;
+        pos += length;
+        length -= 2;
+
+        bool ok = true;
+        switch (marker) {
+        case 0xDB:
+            ok = parseDQT(payload, length);
+            break;
+        case 0xC4:
+            ok = parseDHT(payload, length);
+            break;
+        case 0xC0: // Baseline
+        case 0xC1: // Extended sequential, Huffman
+            ok = parseSOF(payload, length);
+            break;
+        case 0xC2: case 0xC3: case 0xC5: case 0xC6: case 0xC7: // Progressive, lossless, hierarchical
+        case 0xC9: case 0xCA: case 0xCB: case 0xCD: case 0xCE: case 0xCF: // Arithmetic coding
+            ok = false;
+            break;
+        case 0xDD: // DRI
+            ok = length >= 2;
+            m_restartInterval = ok ? readU16(payload) : 0;
+            break;
+        case 0xDA: // SOS, `pos` moves past the entropy coded data
+            ok = m_hasFrame && decodeScan(payload, length, pos, end);
+            hasScan = ok;
+            break;
+        default: // APPn, COM...
+            break;
+        }
+
+        if (!ok) return false;
+    }
+
+    if (!hasScan) {
+        return false;
+    }
+
+    const Component& y = m_components[0];
+    view.width = m_width;
+    view.height = m_height;
+    view.data[0] = y.plane;
+    view.stride[0] = y.stride;
+
+    if (m_componentCount == 3 && m_hMax == 2 && m_vMax == 2) { // 4:2:0 as decoded
+        for (int i = 1; i < 3; ++i) {
+            view.data[i] = m_components[i].plane;
+            view.stride[i] = m_components[i].stride;
+        }
+        return true;
+    }
+
+    // Gray, 4:2:2, 4:4:4 and 4:4:0: average each chroma sample over the pixels of a 4:2:0 sample
+    const int chromaWidth = (m_width + 1) / 2, chromaHeight = (m_height + 1) / 2;
+    m_chroma.resize(static_cast<size_t>(chromaWidth) * chromaHeight * 2);
+    for (int i = 1; i < 3; ++i) {
+        uint8_t* dst = m_chroma.data() + (i - 1) * static_cast<size_t>(chromaWidth) * chromaHeight;
+        view.data[i] = dst;
+        view.stride[i] = chromaWidth;
+
+        if (m_componentCount == 1) {
+            std::memset(dst, 128, static_cast<size_t>(chromaWidth) * chromaHeight);
+            continue;
+        }
+
+        const Component& c = m_components[i];
+        const int sx = m_hMax == 2 ? 1 : 2, sy = m_vMax == 2 ? 1 : 2; // Component samples per 4:2:0 sample
+        for (int row = 0; row < chromaHeight; ++row, dst += chromaWidth) {
+            const uint8_t* src = c.plane + row * sy * c.stride;
+            for (int x = 0; x < chromaWidth; ++x) {
+                int sum = 0;
+                for (int j = 0; j < sy; ++j) {
+                    for (int k = 0; k < sx; ++k) {
+                        sum += src[j * c.stride + x * sx + k];
+                    }
+                }
+                dst[x] = static_cast<uint8_t>((sum + sx * sy / 2) / (sx * sy));
+            }
+        }
+    }
+    return true;
+}
+
+size_t findJpegImageSize(const uint8_t* data, size_t size) {
+    if (data == nullptr || size < 4 || data[0] != 0xFF || data[1] != 0xD8) {
+        return 0;
+    }
+
+    size_t pos = 2;
+    while (pos + 1 < size) {
+        if (data[pos] != 0xFF) {
+            return 0;
+        }
+
+        uint8_t marker = data[pos + 1];
+        if (marker == 0xFF) {
+            ++pos;
+            continue;
+        }
+        pos += 2;
+        if (marker == 0xD9) {
+            return pos;
+        }
+        if (marker == 0x01 || isRestartMarker(marker)) {
+            continue;
+        }
+
+        if (pos + 2 > size) return 0;
+        size_t length = readU16(data + pos);
+        if (length < 2) return 0;
+        pos += length;
+
+        if (marker == 0xDA) { // Skip the entropy coded data
+            for (; pos + 1 < size; ++pos) {
+                if (data[pos] == 0xFF && data[pos + 1] != 0 && data[pos + 1] != 0xFF && !isRestartMarker(data[pos + 1])) break;
+            }
+        }
+    }
+    return 0;
+}
+
+bool getJpegImageSize(const uint8_t* data, size_t size, int& width, int& height) {
+    if (data == nullptr || size < 4 || data[0] != 0xFF || data[1] != 0xD8) {
+        return false;
+    }
+
+    size_t pos = 2;
+    while (pos + 4 <= size && data[pos] == 0xFF) {
+        uint8_t marker = data[pos + 1];
+        if (marker == 0xFF) {
+            ++pos;
+            continue;
+        }
+        pos += 2;
+        if (marker == 0x01 || isRestartMarker(marker)) {
+            continue;
+        }
+        if (marker == 0xD9 || marker == 0xDA) {
+            break;
+        }
+
+        size_t length = readU16(data + pos);
+        if (length < 2) break;
+        if (marker >= 0xC0 && marker <= 0xCF && marker != 0xC4 && marker != 0xC8 && marker != 0xCC) { // SOFn
+            if (pos + 7 > size) break;
+            height = readU16(data + pos + 3);
+            width = readU16(data + pos + 5);
+            return width > 0 && height > 0;
+        }
+        pos += length;
+    }
+    return false;
+}
+
+} // namespace ccap
@@ -0,0 +1,101 @@
+/**
+ * @file ccap_jpeg.h
+ * @author wysaid (this@wysaid.org)
+ * @brief Baseline JPEG decoder for MJPEG camera streams.
+ * @date 2025-10
+ *
+ */
+
+#pragma once
+#ifndef CCAP_JPEG_H
+#define CCAP_JPEG_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace ccap {
+
+/**
+ * @brief Decoder for the JPEG frames produced by UVC/MJPEG cameras: baseline Huffman, 8-bit, gray or YCbCr with
+ *  4:4:4, 4:2:2, 4:2:0 or 4:4:0 sampling. Progressive and arithmetic coded images are rejected.
+ *  Frames without DHT (usual for MJPEG, see the AVI1 format) use the standard Huffman tables.
+ *  The IDCT is the accurate integer one of libjpeg (islow), AVX2/NEON accelerated. The output is bit-exact between backends.
+ *  Tables and buffers are reused between frames, one decoder must not be used by several threads at the same time.
+ */
+class JpegDecoder {
+public:
+    /// A decoded image as I420 (full range BT.601, as defined by JFIF). Pointers stay valid until the next decode.
+    struct I420View {
+        const uint8_t* data[3] = {};
+        int stride[3] = {};
+        int width = 0;
+        int height = 0;
+    };
+
+    /**
+     * @brief Decode one frame. 4:2:0 planes are returned as decoded, the chroma of other samplings is averaged down to 4:2:0.
+     * @return false if the bitstream is not supported or is corrupted.
+     */
+    bool decode(const uint8_t* data, size_t size, I420View& view);
+
+private:
+    struct HuffmanTable {
+        uint16_t lookup[1 << 9]; ///< (code length << 8) | symbol for codes up to 9 bits, 0 otherwise
+        int32_t fastAC[1 << 9];  ///< (coefficient << 8) | (run << 4) | total length, for AC codes whose magnitude bits also fit
+        int32_t maxCode[18];     ///< Largest code of each length, -1 if there is none
+        int32_t valueOffset[18]; ///< Index of the first symbol of each length, minus the first code
+        uint8_t values[256];
+        bool isValid = false;
+    };
+
+    struct Component {
+        int id = 0;
+        int h = 1, v = 1; ///< Sampling factors
+        int quantIndex = 0;
+        int dcTable = 0, acTable = 0;
+        int dcPred = 0;
+        int blocksX = 0, blocksY = 0; ///< Blocks covering the component in a non-interleaved scan
+        uint8_t* plane = nullptr;
+        int stride = 0;
+    };
+
+    struct BitReader;
+
+    bool parseDQT(const uint8_t* p, int length);
+    bool parseDHT(const uint8_t* p, int length);
+    bool parseSOF(const uint8_t* p, int length);
+    bool decodeScan(const uint8_t* p, int length, const uint8_t*& pos, const uint8_t* end);
+    bool decodeBlock(BitReader& reader, Component& c, uint8_t* dst, int dstStride);
+    void setDefaultHuffmanTables();
+    static bool buildHuffmanTable(HuffmanTable& table, const uint8_t* counts, const uint8_t* symbols, int symbolCount);
+
+private:
+    uint16_t m_quant[4][64]{}; ///< Zigzag order
+    HuffmanTable m_dcTables[4], m_acTables[4];
+    Component m_components[3];
+    int m_componentCount = 0;
+    int m_width = 0, m_height = 0;
+    int m_hMax = 1, m_vMax = 1;
+    int m_mcusX = 0, m_mcusY = 0;
+    int m_restartInterval = 0;
+    bool m_hasFrame = false;
+    void (*m_idct)(const int16_t* coefficients, uint8_t* dst, int dstStride) = nullptr; ///< Backend picked per frame
+
+    std::vector<uint8_t> m_planes;  ///< Decoded component planes, MCU aligned
+    std::vector<uint8_t> m_chroma;  ///< Resampled 4:2:0 chroma for the other samplings
+    alignas(32) int16_t m_block[64]; ///< Dequantized coefficients of the current block, natural order
+};
+
+/// @return The size of the JPEG image starting at `data` (SOI to EOI included), 0 if there is no complete image.
+size_t findJpegImageSize(const uint8_t* data, size_t size);
+
+/// Read the image size from the SOF marker without decoding.
+bool getJpegImageSize(const uint8_t* data, size_t size, int& width, int& height);
+
+/// Accurate integer 8x8 IDCT (libjpeg islow) of dequantized coefficients in natural order, with level shift and clamping.
+void idct8x8(const int16_t* coefficients, uint8_t* dst, int dstStride);
+
+} // namespace ccap
+
+#endif // CCAP_JPEG_H
@@ -0,0 +1,520 @@
+/**
+ * @file ccap_recorder.cpp
+ * @author wysaid (this@wysaid.org)
+ * @brief Asynchronous Y4M / raw frame recorder, see ccap::FrameRecorder.
+ * @date 2025-10
+ *
+ */
+
+#if defined(_WIN32) || defined(_MSC_VER)
+#ifndef _CRT_SECURE_NO_WARNINGS
+#define _CRT_SECURE_NO_WARNINGS 1
+#endif
+#endif
+
+#include "ccap_utils.h"
+
+#include "ccap_imp.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cinttypes>
+#include <cmath>
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace ccap {
+
+namespace {
+
+/// One plane of a frame, `rows` rows of `rowBytes` bytes.
+struct SourcePlane {
+    const uint8_t* data = nullptr;
+    uint32_t stride = 0;
+    uint32_t rowBytes = 0;
+    uint32_t rows = 0;
+};
+
+inline PixelFormat stripFullRange(PixelFormat format) {
+    return static_cast<PixelFormat>(static_cast<uint32_t>(format) & ~static_cast<uint32_t>(kPixelFormatFullRangeBit));
+}
+
+/// Planes of the frame without the stride padding, the layout of the raw container. Returns the plane count, 0 if unsupported.
+int packedPlanes(const VideoFrame& frame, SourcePlane planes[3]) {
+    const uint32_t w = frame.width, h = frame.height;
+    if (frame.pixelFormat == PixelFormat::MJPEG) {
+        if (!frame.data[0] || frame.sizeInBytes == 0) return 0;
+        planes[0] = { frame.data[0], frame.sizeInBytes, frame.sizeInBytes, 1 };
+        return 1;
+    }
+
+    if (w == 0 || h == 0) return 0;
+    switch (stripFullRange(frame.pixelFormat)) {
+    case PixelFormat::NV12:
+    case PixelFormat::NV21:
+        planes[0] = { frame.data[0], frame.stride[0], w, h };
+        planes[1] = { frame.data[1], frame.stride[1], (w + 1) / 2 * 2, (h + 1) / 2 };
+        return 2;
+    case PixelFormat::P010:
+        planes[0] = { frame.data[0], frame.stride[0], w * 2, h };
+        planes[1] = { frame.data[1], frame.stride[1], (w + 1) / 2 * 4, (h + 1) / 2 };
+        return 2;
+    case PixelFormat::I420:
+    case PixelFormat::YV12:
+        planes[0] = { frame.data[0], frame.stride[0], w, h };
+        planes[1] = { frame.data[1], frame.stride[1], (w + 1) / 2, (h + 1) / 2 };
+        planes[2] = { frame.data[2], frame.stride[2], (w + 1) / 2, (h + 1) / 2 };
+        return 3;
+    case PixelFormat::YUYV:
+    case PixelFormat::UYVY:
+    case PixelFormat::RGB565:
+        planes[0] = { frame.data[0], frame.stride[0], w * 2, h };
+        return 1;
+    case PixelFormat::RGB24:
+    case PixelFormat::BGR24:
+        planes[0] = { frame.data[0], frame.stride[0], w * 3, h };
+        return 1;
+    case PixelFormat::RGBA32:
+    case PixelFormat::BGRA32:
+        planes[0] = { frame.data[0], frame.stride[0], w * 4, h };
+        return 1;
+    default:
+        return 0;
+    }
+}
+
+bool isY4MFormat(PixelFormat format) {
+    switch (stripFullRange(format)) {
+    case PixelFormat::NV12:
+    case PixelFormat::NV21:
+    case PixelFormat::I420:
+    case PixelFormat::YV12:
+    case PixelFormat::YUYV:
+    case PixelFormat::UYVY:
+        return true;
+    default:
+        return false;
+    }
+}
+
+bool endsWithNoCase(std::string_view str, std::string_view suffix) {
+    if (str.size() < suffix.size()) return false;
+    return std::equal(suffix.begin(), suffix.end(), str.end() - suffix.size(),
+                      [](char a, char b) { return std::tolower(static_cast<unsigned char>(a)) == std::tolower(static_cast<unsigned char>(b)); });
+}
+
+/// Frame rate as the fraction of a Y4M header: 30 -> 30:1, 29.97 -> 30000:1001.
+void fpsToFraction(double fps, uint32_t& num, uint32_t& den) {
+    if (!(fps > 0) || fps > 1000) fps = 30.0;
+    for (uint32_t d : { 1u, 1001u, 1000u }) {
+        double n = fps * d;
+        if (std::fabs(n - std::round(n)) < 0.01 || d == 1000) {
+            num = static_cast<uint32_t>(std::round(n));
+            den = d;
+            return;
+        }
+    }
+}
+} // namespace
+
+class FrameRecorderImp {
+public:
+    struct Packet {
+        std::vector<uint8_t> data; ///< Packed planes, see packedPlanes
+        uint32_t planeSize[3] = {};
+        uint64_t frameIndex = 0;
+        uint64_t timestamp = 0;
+    };
+
+    ~FrameRecorderImp() { close(); }
+
+    bool open(std::string_view path, const FrameRecorderOptions& options);
+    bool record(const VideoFrame& frame);
+    void close();
+    FrameRecorderStats stats() const;
+
+    bool isOpened() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_file != nullptr;
+    }
+
+private:
+    void writerThread();
+    void writePacket(const Packet& packet);
+    void writeHeader();
+    void writePlane(const uint8_t* src, size_t size);
+    /// Writes `rows` rows of `rowBytes` bytes, each made by `fill(dst, row)`.
+    template <typename Fn>
+    void writeRows(uint32_t rows, uint32_t rowBytes, Fn&& fill);
+    void flushBlock(bool final);
+
+    std::string m_path;
+    FrameRecorderOptions m_options;
+    bool m_isY4M = false;
+    std::FILE* m_file = nullptr;
+    std::FILE* m_indexFile = nullptr;
+
+    // Set by the first recorded frame, the later frames must match
+    PixelFormat m_format = PixelFormat::Unknown;
+    uint32_t m_width = 0;
+    uint32_t m_height = 0;
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_condition;
+    std::deque<Packet> m_queue;
+    std::vector<Packet> m_freePackets; ///< Recycled so that copying a frame does not allocate
+    uint32_t m_copying = 0;            ///< Frames being copied by `record`, they hold a queue slot
+    bool m_closing = false;
+    FrameRecorderStats m_stats;
+
+    // Writer thread only
+    std::thread m_thread;
+    DefaultAllocator m_block;
+    size_t m_blockUsed = 0;
+    uint64_t m_fileOffset = 0;
+    bool m_headerWritten = false;
+};
+
+bool FrameRecorderImp::open(std::string_view path, const FrameRecorderOptions& options) {
+    if (isOpened()) {
+        reportError(ErrorCode::InitializationFailed, "FrameRecorder already opened: " + m_path);
+        return false;
+    }
+
+    m_path = std::string(path);
+    m_options = options;
+    m_options.maxQueuedFrames = std::max(m_options.maxQueuedFrames, 1u);
+    m_options.writeBlockSize = std::max<uint32_t>((m_options.writeBlockSize + 4095) & ~4095u, 4096);
+    m_isY4M = options.container == RecordContainer::Y4M || (options.container == RecordContainer::Auto && endsWithNoCase(path, ".y4m"));
+
+    std::FILE* file = std::fopen(m_path.c_str(), "wb");
+    if (!file) {
+        reportError(ErrorCode::InitializationFailed, "FrameRecorder failed to create file: " + m_path);
+        return false;
+    }
+    std::setvbuf(file, nullptr, _IONBF, 0); // Whole blocks are written, stdio buffering would only add a copy
+
+    if (!m_isY4M) {
+        m_indexFile = std::fopen((m_path + ".idx").c_str(), "w");
+        if (!m_indexFile) {
+            reportError(ErrorCode::InitializationFailed, "FrameRecorder failed to create index file: " + m_path + ".idx");
+            std::fclose(file);
+            return false;
+        }
+    }
+
+    m_block.resize(m_options.writeBlockSize);
+    m_blockUsed = 0;
+    m_fileOffset = 0;
+    m_headerWritten = false;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_file = file;
+        m_format = PixelFormat::Unknown;
+        m_width = m_height = 0;
+        m_stats = FrameRecorderStats();
+        m_closing = false;
+    }
+    m_thread = std::thread(&FrameRecorderImp::writerThread, this);
+
+    CCAP_LOG_V("ccap: FrameRecorder recording to %s (%s)\n", m_path.c_str(), m_isY4M ? "Y4M" : "raw");
+    return true;
+}
+
+bool FrameRecorderImp::record(const VideoFrame& frame) {
+    SourcePlane planes[3];
+    int planeCount = packedPlanes(frame, planes);
+
+    Packet packet;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_file || m_closing) return false;
+
+        if (m_format == PixelFormat::Unknown) {
+            if (planeCount == 0 || (m_isY4M && !isY4MFormat(frame.pixelFormat))) {
+                if (m_stats.rejectedFrames++ == 0) {
+                    reportError(ErrorCode::UnsupportedPixelFormat, "FrameRecorder cannot record " + std::string(pixelFormatToString(frame.pixelFormat)) +
+                                                                       (m_isY4M ? " frames to Y4M, use RecordContainer::Raw" : " frames"));
+                }
+                return false;
+            }
+            m_format = frame.pixelFormat;
+            m_width = frame.width;
+            m_height = frame.height;
+        } else if (frame.pixelFormat != m_format || (m_format != PixelFormat::MJPEG && (frame.width != m_width || frame.height != m_height))) {
+            if (m_stats.rejectedFrames++ == 0) {
+                CCAP_LOG_W("ccap: FrameRecorder: %s %ux%u frame does not match the recording (%s %ux%u), frames like it are dropped\n",
+                           pixelFormatToString(frame.pixelFormat).data(), frame.width, frame.height, pixelFormatToString(m_format).data(), m_width,
+                           m_height);
+            }
+            return false;
+        }
+
+        if (m_stats.writeFailed || m_queue.size() + m_copying >= m_options.maxQueuedFrames) {
+            ++m_stats.droppedFrames;
+            return false;
+        }
+
+        ++m_copying;
+        if (!m_freePackets.empty()) {
+            packet = std::move(m_freePackets.back());
+            m_freePackets.pop_back();
+        }
+    }
+
+    // Copied outside the lock, the writer thread keeps writing meanwhile
+    size_t total = 0;
+    for (int i = 0; i < planeCount; ++i) {
+        packet.planeSize[i] = planes[i].rowBytes * planes[i].rows;
+        total += packet.planeSize[i];
+    }
+    packet.data.resize(total);
+    uint8_t* dst = packet.data.data();
+    for (int i = 0; i < planeCount; ++i) {
+        const auto& plane = planes[i];
+        if (plane.stride == plane.rowBytes) {
+            std::memcpy(dst, plane.data, packet.planeSize[i]);
+            dst += packet.planeSize[i];
+        } else {
+            for (uint32_t row = 0; row < plane.rows; ++row, dst += plane.rowBytes) {
+                std::memcpy(dst, plane.data + static_cast<size_t>(plane.stride) * row, plane.rowBytes);
+            }
+        }
+    }
+    for (int i = planeCount; i < 3; ++i) {
+        packet.planeSize[i] = 0;
+    }
+    packet.frameIndex = frame.frameIndex;
+    packet.timestamp = frame.timestamp;
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        --m_copying;
+        m_queue.push_back(std::move(packet));
+        ++m_stats.recordedFrames;
+        m_stats.peakQueuedFrames = std::max(m_stats.peakQueuedFrames, static_cast<uint32_t>(m_queue.size()));
+    }
+    m_condition.notify_one();
+    return true;
+}
+
+void FrameRecorderImp::close() {
+    if (!isOpened()) return;
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_closing = true;
+    }
+    m_condition.notify_all();
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+
+    flushBlock(true);
+    std::FILE* file;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex); // record() checks m_file
+        file = m_file;
+        m_file = nullptr;
+        m_freePackets.clear();
+    }
+    std::fclose(file);
+    if (m_indexFile) {
+        std::fclose(m_indexFile);
+        m_indexFile = nullptr;
+    }
+
+    CCAP_LOG_V("ccap: FrameRecorder closed %s: %" PRIu64 " frames, %" PRIu64 " bytes, %" PRIu64 " dropped\n", m_path.c_str(),
+               m_stats.recordedFrames, m_stats.bytesWritten, m_stats.droppedFrames);
+}
+
+FrameRecorderStats FrameRecorderImp::stats() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    FrameRecorderStats stats = m_stats;
+    stats.queuedFrames = static_cast<uint32_t>(m_queue.size());
+    return stats;
+}
+
+void FrameRecorderImp::writerThread() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    for (;;) {
+        m_condition.wait(lock, [this]() { return !m_queue.empty() || (m_closing && m_copying == 0); });
+        if (m_queue.empty()) break; // Closing, and no frame is being copied any more
+
+        Packet packet = std::move(m_queue.front());
+        m_queue.pop_front();
+        lock.unlock();
+
+        writePacket(packet);
+
+        lock.lock();
+        m_freePackets.push_back(std::move(packet));
+    }
+}
+
+void FrameRecorderImp::writeHeader() {
+    uint32_t num = 0, den = 1;
+    fpsToFraction(m_options.fps, num, den);
+    const bool fullRange = (m_format & kPixelFormatFullRangeBit) != 0;
+
+    if (m_isY4M) {
+        auto base = stripFullRange(m_format);
+        const char* chroma = base == PixelFormat::YUYV || base == PixelFormat::UYVY ? "C422" : "C420jpeg";
+        char header[128];
+        int size = std::snprintf(header, sizeof(header), "YUV4MPEG2 W%u H%u F%u:%u Ip A1:1 %s%s\n", m_width, m_height, num, den, chroma,
+                                 fullRange ? " XCOLORRANGE=FULL" : "");
+        writePlane(reinterpret_cast<const uint8_t*>(header), static_cast<size_t>(size));
+    } else {
+        std::fprintf(m_indexFile, "# ccap raw recording: format=%s width=%u height=%u fps=%u:%u\n", pixelFormatToString(m_format).data(), m_width,
+                     m_height, num, den);
+        std::fprintf(m_indexFile, "# frameIndex timestamp(ns) offset size\n");
+    }
+    m_headerWritten = true;
+}
+
+void FrameRecorderImp::writePacket(const Packet& packet) {
+    if (!m_headerWritten) writeHeader();
+
+    const uint8_t* planes[3] = { packet.data.data(), nullptr, nullptr };
+    planes[1] = planes[0] + packet.planeSize[0];
+    planes[2] = planes[1] + packet.planeSize[1];
+
+    if (!m_isY4M) {
+        std::fprintf(m_indexFile, "%" PRIu64 " %" PRIu64 " %" PRIu64 " %zu\n", packet.frameIndex, packet.timestamp, m_fileOffset + m_blockUsed,
+                     packet.data.size());
+        writePlane(packet.data.data(), packet.data.size());
+        return;
+    }
+
+    static const char kFrameTag[] = "FRAME\n";
+    writePlane(reinterpret_cast<const uint8_t*>(kFrameTag), sizeof(kFrameTag) - 1);
+
+    const uint32_t w = m_width, h = m_height;
+    const uint32_t cw = (w + 1) / 2, ch = (h + 1) / 2;
+    switch (stripFullRange(m_format)) {
+    case PixelFormat::I420:
+        writePlane(planes[0], packet.data.size());
+        break;
+    case PixelFormat::YV12: // Y, V, U
+        writePlane(planes[0], packet.planeSize[0]);
+        writePlane(planes[2], packet.planeSize[2]);
+        writePlane(planes[1], packet.planeSize[1]);
+        break;
+    case PixelFormat::NV12:
+    case PixelFormat::NV21: {
+        const int uOffset = stripFullRange(m_format) == PixelFormat::NV12 ? 0 : 1;
+        writePlane(planes[0], packet.planeSize[0]);
+        for (int c = 0; c < 2; ++c) {
+            const uint8_t* uv = planes[1] + (c == 0 ? uOffset : 1 - uOffset);
+            writeRows(ch, cw, [&](uint8_t* dst, uint32_t row) {
+                const uint8_t* src = uv + static_cast<size_t>(row) * cw * 2;
+                for (uint32_t x = 0; x < cw; ++x) {
+                    dst[x] = src[x * 2];
+                }
+            });
+        }
+    } break;
+    case PixelFormat::YUYV:
+    case PixelFormat::UYVY: {
+        // YUYV: Y0 U Y1 V, UYVY: U Y0 V Y1
+        const bool yuyv = stripFullRange(m_format) == PixelFormat::YUYV;
+        const int yOffset = yuyv ? 0 : 1;
+        const int uOffset = yuyv ? 1 : 0;
+        writeRows(h, w, [&](uint8_t* dst, uint32_t row) {
+            const uint8_t* src = planes[0] + static_cast<size_t>(row) * w * 2 + yOffset;
+            for (uint32_t x = 0; x < w; ++x) {
+                dst[x] = src[x * 2];
+            }
+        });
+        for (int c = 0; c < 2; ++c) {
+            const int offset = uOffset + c * 2;
+            writeRows(h, w / 2, [&](uint8_t* dst, uint32_t row) {
+                const uint8_t* src = planes[0] + static_cast<size_t>(row) * w * 2 + offset;
+                for (uint32_t x = 0; x < w / 2; ++x) {
+                    dst[x] = src[x * 4];
+                }
+            });
+        }
+    } break;
+    default:
+        break;
+    }
+}
+
+void FrameRecorderImp::writePlane(const uint8_t* src, size_t size) {
+    const size_t blockSize = m_options.writeBlockSize;
+    while (size > 0) {
+        size_t n = std::min(size, blockSize - m_blockUsed);
+        std::memcpy(m_block.data() + m_blockUsed, src, n);
+        m_blockUsed += n;
+        src += n;
+        size -= n;
+        if (m_blockUsed == blockSize) flushBlock(false);
+    }
+}
+
+template <typename Fn>
+void FrameRecorderImp::writeRows(uint32_t rows, uint32_t rowBytes, Fn&& fill) {
+    const size_t blockSize = m_options.writeBlockSize;
+    std::vector<uint8_t> rowBuffer; // Only for rows that straddle two blocks
+    for (uint32_t row = 0; row < rows; ++row) {
+        if (blockSize - m_blockUsed >= rowBytes) {
+            fill(m_block.data() + m_blockUsed, row);
+            m_blockUsed += rowBytes;
+            if (m_blockUsed == blockSize) flushBlock(false);
+        } else {
+            rowBuffer.resize(rowBytes);
+            fill(rowBuffer.data(), row);
+            writePlane(rowBuffer.data(), rowBytes);
+        }
+    }
+}
+
+void FrameRecorderImp::flushBlock(bool final) {
+    if (m_blockUsed == 0) return;
+
+    bool failed;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        failed = m_stats.writeFailed;
+    }
+
+    if (!failed && std::fwrite(m_block.data(), 1, m_blockUsed, m_file) != m_blockUsed) {
+        reportError(ErrorCode::InternalError, "FrameRecorder failed to write " + m_path + ": " + std::strerror(errno));
+        failed = true;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (failed) {
+        m_stats.writeFailed = true;
+    } else {
+        m_stats.bytesWritten += m_blockUsed;
+    }
+    m_fileOffset += m_blockUsed;
+    m_blockUsed = 0;
+    if (final && m_indexFile) {
+        std::fflush(m_indexFile);
+    }
+}
+
+FrameRecorder::FrameRecorder() :
+    m_imp(new FrameRecorderImp()) {}
+
+FrameRecorder::~FrameRecorder() { delete m_imp; }
+
+bool FrameRecorder::open(std::string_view path, const FrameRecorderOptions& options) { return m_imp->open(path, options); }
+
+bool FrameRecorder::isOpened() const { return m_imp->isOpened(); }
+
+bool FrameRecorder::record(const VideoFrame& frame) { return m_imp->record(frame); }
+
+void FrameRecorder::close() { m_imp->close(); }
+
+FrameRecorderStats FrameRecorder::stats() const { return m_imp->stats(); }
+
+} // namespace ccap
@@ -0,0 +1,110 @@
+/**
+ * @file ccap_thread_pool.cpp
+ * @author wysaid (this@wysaid.org)
+ * @brief A small worker pool shared by ccap pixel conversions.
+ * @date 2025-10
+ *
+ */
+
+#include "ccap_thread_pool.h"
+
+#include "ccap_convert.h"
+
+#include <algorithm>
+
+namespace ccap {
+
+ThreadPool& ThreadPool::shared() {
+    // Never destroyed: joining threads from static destructors may deadlock when ccap lives in a DLL.
+    static ThreadPool* s_pool = new ThreadPool();
+    return *s_pool;
+}
+
+ThreadPool::~ThreadPool() {
+    std::lock_guard<std::mutex> lock(m_callMutex);
+    stopWorkers();
+}
+
+void ThreadPool::setThreadCount(int count) {
+    count = std::clamp(count, 1, 64);
+
+    std::lock_guard<std::mutex> lock(m_callMutex);
+    if (count == static_cast<int>(m_workers.size()) + 1) return;
+
+    stopWorkers();
+    m_stop = false;
+    for (int i = 1; i < count; ++i) {
+        m_workers.emplace_back(&ThreadPool::workerLoop, this);
+    }
+    m_threadCount = count;
+}
+
+void ThreadPool::stopWorkers() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_workCondition.notify_all();
+    for (auto& worker : m_workers) {
+        worker.join();
+    }
+    m_workers.clear();
+    m_threadCount = 1;
+}
+
+void ThreadPool::parallelFor(int taskCount, const std::function<void(int)>& task) {
+    std::unique_lock<std::mutex> callLock(m_callMutex, std::try_to_lock);
+    if (taskCount <= 1 || !callLock.owns_lock() || m_workers.empty()) {
+        for (int i = 0; i < taskCount; ++i) task(i);
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_task = &task;
+        m_taskCount = taskCount;
+        m_nextTask = 0;
+        ++m_generation;
+    }
+    m_workCondition.notify_all();
+
+    runTasks();
+
+    // Every task has been claimed now, wait for the workers still running one.
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_doneCondition.wait(lock, [this]() { return m_activeWorkers == 0; });
+    m_task = nullptr;
+}
+
+void ThreadPool::runTasks() {
+    for (int i; (i = m_nextTask.fetch_add(1)) < m_taskCount;) {
+        (*m_task)(i);
+    }
+}
+
+void ThreadPool::workerLoop() {
+    uint64_t generation = 0;
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_workCondition.wait(lock, [&]() { return m_stop || (m_task && m_generation != generation); });
+            if (m_stop) return;
+            generation = m_generation;
+            ++m_activeWorkers; // The caller keeps the task alive until this drops back to 0
+        }
+
+        runTasks();
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (--m_activeWorkers == 0) m_doneCondition.notify_all();
+    }
+}
+
+void setConvertThreadCount(int count) {
+    if (count <= 0) count = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    ThreadPool::shared().setThreadCount(count);
+}
+
+int getConvertThreadCount() { return ThreadPool::shared().threadCount(); }
+
+} // namespace ccap
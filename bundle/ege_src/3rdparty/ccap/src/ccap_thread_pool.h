@@ -0,0 +1,62 @@
+/**
+ * @file ccap_thread_pool.h
+ * @author wysaid (this@wysaid.org)
+ * @brief A small worker pool shared by ccap pixel conversions.
+ * @date 2025-10
+ *
+ */
+
+#pragma once
+#ifndef CCAP_THREAD_POOL_H
+#define CCAP_THREAD_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace ccap {
+
+class ThreadPool {
+public:
+    /// The pool used by the conversion functions, see `setConvertThreadCount`.
+    static ThreadPool& shared();
+
+    ~ThreadPool();
+
+    /// @brief Total number of threads taking part in `parallelFor`, including the calling thread. 1 means no worker threads.
+    void setThreadCount(int count);
+    int threadCount() const { return m_threadCount.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Run task(i) for every i in [0, taskCount) and wait for all of them. The calling thread takes part.
+     * @note If the pool is busy with another caller, the tasks run on the calling thread instead of waiting.
+     */
+    void parallelFor(int taskCount, const std::function<void(int)>& task);
+
+private:
+    void workerLoop();
+    void runTasks();
+    void stopWorkers();
+
+private:
+    std::vector<std::thread> m_workers;
+    std::atomic_int m_threadCount{ 1 };
+
+    std::mutex m_callMutex; ///< One parallelFor at a time, also guards worker start/stop
+    std::mutex m_mutex;
+    std::condition_variable m_workCondition, m_doneCondition;
+
+    const std::function<void(int)>* m_task = nullptr;
+    int m_taskCount = 0;
+    std::atomic_int m_nextTask{ 0 };
+    int m_activeWorkers = 0;
+    uint64_t m_generation = 0;
+    bool m_stop = false;
+};
+
+} // namespace ccap
+
+#endif // CCAP_THREAD_POOL_H
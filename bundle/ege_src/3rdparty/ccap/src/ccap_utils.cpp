@@ -166,7 +166,7 @@ bool saveRgbDataAsBMP(const char* filename, const unsigned char* data, uint32_t
 }
 
 std::string dumpFrameToFile(VideoFrame* frame, std::string_view fileNameWithNoSuffix) {
-    if (frame->pixelFormat & ccap::kPixelFormatRGBColorBit) { /// RGB or RGBA
+    if ((frame->pixelFormat & ccap::kPixelFormatRGBColorBit) && frame->pixelFormat != PixelFormat::RGB565) { /// RGB or RGBA
         auto filePath = std::string(fileNameWithNoSuffix) + ".bmp";
         bool isBGR = (frame->pixelFormat & ccap::kPixelFormatBGRBit) != 0;
 
@@ -185,6 +185,14 @@ std::string dumpFrameToFile(VideoFrame* frame, std::string_view fileNameWithNoSu
             fclose(fp);
             return filePath;
         }
+    } else if (frame->pixelFormat == PixelFormat::MJPEG) { // The compressed image as is
+        auto filePath = std::string(fileNameWithNoSuffix) + ".jpg";
+        FILE* fp = fopen(filePath.c_str(), "wb");
+        if (fp) {
+            fwrite(frame->data[0], frame->sizeInBytes, 1, fp);
+            fclose(fp);
+            return filePath;
+        }
     }
     return {};
 }
@@ -211,6 +219,21 @@ std::string_view pixelFormatToString(PixelFormat format) {
     case PixelFormat::UYVYf:
         return "UYVYf";
 
+    case PixelFormat::NV21:
+        return "NV21";
+    case PixelFormat::NV21f:
+        return "NV21f";
+
+    case PixelFormat::YV12:
+        return "YV12";
+    case PixelFormat::YV12f:
+        return "YV12f";
+
+    case PixelFormat::P010:
+        return "P010";
+    case PixelFormat::P010f:
+        return "P010f";
+
     case PixelFormat::RGB24:
         return "RGB24";
     case PixelFormat::RGBA32:
@@ -220,6 +243,12 @@ std::string_view pixelFormatToString(PixelFormat format) {
         return "BGR24";
     case PixelFormat::BGRA32:
         return "BGRA32";
+
+    case PixelFormat::RGB565:
+        return "RGB565";
+
+    case PixelFormat::MJPEG:
+        return "MJPEG";
     default:
         break;
     }
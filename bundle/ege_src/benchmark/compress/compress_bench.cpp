@@ -0,0 +1,550 @@
+/*
+* EGE (Easy Graphics Engine)
+* filename  compress_bench.cpp
+
+ege_compress2 / ege_uncompress 的基准测试.
+
+对内置语料(图像、文本、二进制数据)逐一以压缩级别 0 ~ 9 进行压缩与解压,
+统计压缩/解压速度(MB/s)、压缩率以及内存峰值, 输出表格或 JSON.
+
+用法:
+    ege_compress_bench [--json <file|->] [--min-time <seconds>] [--levels <min>-<max>] [--filter <name>]
+*/
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+#include "external/sdefl.h"
+#include "external/sinfl.h"
+
+#ifndef CLAMP
+#define CLAMP(a, min, max)  (((a) < (min)) ? (min) : ((a) > (max) ? (max) : (a)))
+#endif
+
+namespace
+{
+
+/* 与 ege.h 中 ege_compress2 对外承诺的级别范围一致 */
+const int EGE_LEVEL_MIN = 0;
+const int EGE_LEVEL_MAX = 9;
+
+struct Corpus
+{
+    std::string          name;
+    std::string          kind;
+    std::vector<uint8_t> data;
+};
+
+struct Result
+{
+    std::string corpus;
+    std::string kind;
+    int         level;
+    int         sdeflLevel;
+    uint32_t    originalSize;
+    uint32_t    compressedSize;
+    double      ratio;
+    double      compressMBps;
+    double      uncompressMBps;
+    size_t      workingSetBytes;
+    bool        verified;
+};
+
+/*------------------------------------------------------------------------------
+ * 与 compress.cpp 相同的封装: 前 4 个字节(小端)存储原数据长度, 之后为 deflate 数据.
+ * compress.cpp 依赖 Windows 头文件, 这里复刻其逻辑以便在任意平台上测量同一份 sdefl/sinfl.
+ *----------------------------------------------------------------------------*/
+
+uint32_t benchCompressBound(uint32_t dataSize)
+{
+    return (dataSize > INT_MAX) ? 0 : ((uint32_t)sdefl_bound((int)dataSize) + sizeof(uint32_t));
+}
+
+uint32_t benchCompress(sdefl* sd, void* compressData, const void* data, uint32_t size, int level)
+{
+    level = CLAMP(level, SDEFL_LVL_MIN, SDEFL_LVL_MAX);
+    memcpy(compressData, &size, sizeof(uint32_t));
+    return (uint32_t)sdeflate(sd, (uint8_t*)compressData + sizeof(uint32_t), data, (int)size, level) + sizeof(uint32_t);
+}
+
+int benchUncompress(void* buffer, uint32_t bufferSize, const void* compressData, uint32_t compressSize)
+{
+    return sinflate(buffer, (int)bufferSize, (const uint8_t*)compressData + sizeof(uint32_t), (int)(compressSize - sizeof(uint32_t)));
+}
+
+/*------------------------------------------------------------------------------
+ * 内置语料. 全部由固定种子生成, 保证不同机器、不同版本之间结果可比.
+ *----------------------------------------------------------------------------*/
+
+struct XorShift32
+{
+    uint32_t s;
+    explicit XorShift32(uint32_t seed) : s(seed ? seed : 1u) {}
+
+    uint32_t next()
+    {
+        s ^= s << 13;
+        s ^= s >> 17;
+        s ^= s << 5;
+        return s;
+    }
+};
+
+const int IMAGE_WIDTH  = 640;
+const int IMAGE_HEIGHT = 480;
+
+void putColor(std::vector<uint8_t>& buf, uint32_t color)
+{
+    /* color_t 在内存中为 BGRA 排列 */
+    buf.push_back((uint8_t)(color));
+    buf.push_back((uint8_t)(color >> 8));
+    buf.push_back((uint8_t)(color >> 16));
+    buf.push_back((uint8_t)(color >> 24));
+}
+
+/* 平滑渐变, 类似 hsv 色带背景 */
+Corpus makeImageGradient()
+{
+    Corpus c = {"image_gradient", "image", std::vector<uint8_t>()};
+    c.data.reserve(IMAGE_WIDTH * IMAGE_HEIGHT * 4);
+    for (int y = 0; y < IMAGE_HEIGHT; ++y) {
+        for (int x = 0; x < IMAGE_WIDTH; ++x) {
+            uint32_t r = x * 255 / (IMAGE_WIDTH - 1);
+            uint32_t g = y * 255 / (IMAGE_HEIGHT - 1);
+            uint32_t b = (x + y) * 255 / (IMAGE_WIDTH + IMAGE_HEIGHT - 2);
+            putColor(c.data, 0xFF000000u | (r << 16) | (g << 8) | b);
+        }
+    }
+    return c;
+}
+
+/* 纯色背景上的若干实心圆与矩形, 类似 demo 程序中的绘图结果 */
+Corpus makeImageShapes()
+{
+    Corpus c = {"image_shapes", "image", std::vector<uint8_t>()};
+    std::vector<uint32_t> pixels(IMAGE_WIDTH * IMAGE_HEIGHT, 0xFF202020u);
+    XorShift32 rng(0x5EED0001u);
+
+    for (int i = 0; i < 40; ++i) {
+        int      cx     = (int)(rng.next() % IMAGE_WIDTH);
+        int      cy     = (int)(rng.next() % IMAGE_HEIGHT);
+        int      radius = 8 + (int)(rng.next() % 60);
+        uint32_t color  = 0xFF000000u | (rng.next() & 0xFFFFFFu);
+        bool     circle = (rng.next() & 1) != 0;
+
+        for (int y = cy - radius; y <= cy + radius; ++y) {
+            if (y < 0 || y >= IMAGE_HEIGHT) {
+                continue;
+            }
+            for (int x = cx - radius; x <= cx + radius; ++x) {
+                if (x < 0 || x >= IMAGE_WIDTH) {
+                    continue;
+                }
+                if (circle && (x - cx) * (x - cx) + (y - cy) * (y - cy) > radius * radius) {
+                    continue;
+                }
+                pixels[y * IMAGE_WIDTH + x] = color;
+            }
+        }
+    }
+
+    c.data.reserve(pixels.size() * 4);
+    for (size_t i = 0; i < pixels.size(); ++i) {
+        putColor(c.data, pixels[i]);
+    }
+    return c;
+}
+
+/* 带噪声的照片类图像, 低位随机, 压缩难度较高 */
+Corpus makeImageNoisy()
+{
+    Corpus c = {"image_noisy", "image", std::vector<uint8_t>()};
+    XorShift32 rng(0x5EED0002u);
+    c.data.reserve(IMAGE_WIDTH * IMAGE_HEIGHT * 4);
+    for (int y = 0; y < IMAGE_HEIGHT; ++y) {
+        for (int x = 0; x < IMAGE_WIDTH; ++x) {
+            uint32_t noise = rng.next();
+            uint32_t r = ((x * 200 / IMAGE_WIDTH) + (noise & 0x1F)) & 0xFF;
+            uint32_t g = ((y * 200 / IMAGE_HEIGHT) + ((noise >> 8) & 0x1F)) & 0xFF;
+            uint32_t b = (128 + ((noise >> 16) & 0x3F)) & 0xFF;
+            putColor(c.data, 0xFF000000u | (r << 16) | (g << 8) | b);
+        }
+    }
+    return c;
+}
+
+/* 由常用词随机拼接的英文文本 */
+Corpus makeTextEnglish()
+{
+    static const char* const words[] = {
+        "the", "of", "and", "to", "in", "is", "that", "for", "it", "as", "was", "with", "be", "by", "on", "not",
+        "he", "this", "are", "or", "his", "from", "at", "which", "but", "have", "an", "had", "they", "you",
+        "graphics", "window", "image", "color", "pixel", "draw", "line", "circle", "random", "easy", "engine",
+    };
+    const size_t wordCount = sizeof(words) / sizeof(words[0]);
+    const size_t targetSize = 1024 * 1024;
+
+    Corpus c = {"text_english", "text", std::vector<uint8_t>()};
+    XorShift32 rng(0x5EED0003u);
+    c.data.reserve(targetSize + 64);
+
+    int wordsInSentence = 0;
+    while (c.data.size() < targetSize) {
+        const char* word = words[rng.next() % wordCount];
+        size_t      len  = strlen(word);
+        for (size_t i = 0; i < len; ++i) {
+            char ch = word[i];
+            if (wordsInSentence == 0 && i == 0) {
+                ch = (char)(ch - 'a' + 'A');
+            }
+            c.data.push_back((uint8_t)ch);
+        }
+        if (++wordsInSentence > 6 + (int)(rng.next() % 10)) {
+            c.data.push_back('.');
+            c.data.push_back((rng.next() % 5 == 0) ? '\n' : ' ');
+            wordsInSentence = 0;
+        } else {
+            c.data.push_back(' ');
+        }
+    }
+    return c;
+}
+
+/* 类似 C++ 源码的结构化文本, 大量重复的标识符与缩进 */
+Corpus makeTextSource()
+{
+    const size_t targetSize = 1024 * 1024;
+    Corpus c = {"text_source", "text", std::vector<uint8_t>()};
+    XorShift32 rng(0x5EED0004u);
+    char line[160];
+
+    c.data.reserve(targetSize + sizeof(line));
+    int funcIndex = 0;
+    while (c.data.size() < targetSize) {
+        int n = snprintf(line, sizeof(line), "void EGEAPI func_%d(int x, int y, color_t color, PIMAGE pimg)\n{\n", funcIndex++);
+        c.data.insert(c.data.end(), line, line + n);
+        int statements = 2 + (int)(rng.next() % 6);
+        for (int i = 0; i < statements; ++i) {
+            n = snprintf(line, sizeof(line), "    putpixel(x + %u, y + %u, color, pimg);\n", rng.next() % 100, rng.next() % 100);
+            c.data.insert(c.data.end(), line, line + n);
+        }
+        static const char tail[] = "}\n\n";
+        c.data.insert(c.data.end(), tail, tail + sizeof(tail) - 1);
+    }
+    return c;
+}
+
+/* 不可压缩的随机数据 */
+Corpus makeBinaryRandom()
+{
+    const size_t size = 1024 * 1024;
+    Corpus c = {"binary_random", "binary", std::vector<uint8_t>(size)};
+    XorShift32 rng(0x5EED0005u);
+    for (size_t i = 0; i + 4 <= size; i += 4) {
+        uint32_t v = rng.next();
+        memcpy(&c.data[i], &v, 4);
+    }
+    return c;
+}
+
+/* 结构体数组, 字段值缓慢变化, 类似存档或网格数据 */
+Corpus makeBinaryRecords()
+{
+    struct Record
+    {
+        int32_t  id;
+        float    x, y, z;
+        uint32_t color;
+        uint16_t flags;
+        uint16_t reserved;
+    };
+
+    const size_t count = 1024 * 1024 / sizeof(Record);
+    Corpus c = {"binary_records", "binary", std::vector<uint8_t>(count * sizeof(Record))};
+    XorShift32 rng(0x5EED0006u);
+    for (size_t i = 0; i < count; ++i) {
+        Record r;
+        r.id       = (int32_t)i;
+        r.x        = (float)i * 0.5f;
+        r.y        = (float)(rng.next() % 1000) * 0.01f;
+        r.z        = 0.0f;
+        r.color    = 0xFF000000u | (uint32_t)((i / 64) * 0x010101u);
+        r.flags    = (uint16_t)(rng.next() % 4);
+        r.reserved = 0;
+        memcpy(&c.data[i * sizeof(Record)], &r, sizeof(Record));
+    }
+    return c;
+}
+
+/* 全零数据, 测试最理想情况 */
+Corpus makeBinaryZeros()
+{
+    Corpus c = {"binary_zeros", "binary", std::vector<uint8_t>(1024 * 1024, 0)};
+    return c;
+}
+
+/*------------------------------------------------------------------------------
+ * 计时与内存统计
+ *----------------------------------------------------------------------------*/
+
+double nowSeconds()
+{
+    using namespace std::chrono;
+    return duration<double>(steady_clock::now().time_since_epoch()).count();
+}
+
+/* 进程的内存峰值(字节), 获取失败时返回 0 */
+size_t peakResidentBytes()
+{
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS pmc;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &pmc, sizeof(pmc))) {
+        return (size_t)pmc.PeakWorkingSetSize;
+    }
+    return 0;
+#else
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) {
+        return 0;
+    }
+#if defined(__APPLE__)
+    return (size_t)usage.ru_maxrss;
+#else
+    return (size_t)usage.ru_maxrss * 1024;
+#endif
+#endif
+}
+
+/*------------------------------------------------------------------------------
+ * 基准测试主体
+ *----------------------------------------------------------------------------*/
+
+struct Options
+{
+    std::string jsonPath;
+    std::string filter;
+    double      minTime;
+    int         levelMin;
+    int         levelMax;
+
+    Options() : minTime(0.25), levelMin(EGE_LEVEL_MIN), levelMax(EGE_LEVEL_MAX) {}
+};
+
+/* 重复执行直到累计时间不少于 minTime, 返回单次平均耗时(秒) */
+template <typename Func>
+double measure(Func func, double minTime)
+{
+    int    iterations = 0;
+    double start      = nowSeconds();
+    double elapsed    = 0.0;
+    do {
+        func();
+        ++iterations;
+        elapsed = nowSeconds() - start;
+    } while (elapsed < minTime);
+    return elapsed / iterations;
+}
+
+struct CompressOp
+{
+    sdefl* sd;
+    uint8_t* out;
+    const Corpus* corpus;
+    int level;
+    uint32_t* outSize;
+
+    void operator()() const { *outSize = benchCompress(sd, out, &corpus->data[0], (uint32_t)corpus->data.size(), level); }
+};
+
+struct UncompressOp
+{
+    uint8_t* out;
+    uint32_t outCapacity;
+    const uint8_t* compressed;
+    uint32_t compressedSize;
+    int* result;
+
+    void operator()() const { *result = benchUncompress(out, outCapacity, compressed, compressedSize); }
+};
+
+bool runCorpus(const Corpus& corpus, const Options& opt, std::vector<Result>& results)
+{
+    const uint32_t size  = (uint32_t)corpus.data.size();
+    const uint32_t bound = benchCompressBound(size);
+    const double   mb    = (double)size / (1024.0 * 1024.0);
+
+    std::vector<uint8_t> compressed(bound);
+    std::vector<uint8_t> restored(size);
+
+    sdefl* sd = (sdefl*)malloc(sizeof(struct sdefl));
+    if (sd == NULL) {
+        fprintf(stderr, "out of memory\n");
+        return false;
+    }
+
+    bool allOk = true;
+    for (int level = opt.levelMin; level <= opt.levelMax; ++level) {
+        uint32_t   compressedSize = 0;
+        int        restoredSize   = 0;
+        CompressOp   cop = {sd, &compressed[0], &corpus, level, &compressedSize};
+        double       compressTime = measure(cop, opt.minTime);
+        UncompressOp uop = {&restored[0], size, &compressed[0], compressedSize, &restoredSize};
+        double       uncompressTime = measure(uop, opt.minTime);
+
+        Result r;
+        r.corpus          = corpus.name;
+        r.kind            = corpus.kind;
+        r.level           = level;
+        r.sdeflLevel      = CLAMP(level, SDEFL_LVL_MIN, SDEFL_LVL_MAX);
+        r.originalSize    = size;
+        r.compressedSize  = compressedSize;
+        r.ratio           = compressedSize ? (double)size / compressedSize : 0.0;
+        r.compressMBps    = mb / compressTime;
+        r.uncompressMBps  = mb / uncompressTime;
+        /* ege_compress2 调用期间的堆内存: sdefl 状态 + 输出缓冲区; 解压只额外需要输出缓冲区 */
+        r.workingSetBytes = sizeof(struct sdefl) + bound + size;
+        r.verified        = restoredSize == (int)size && memcmp(&restored[0], &corpus.data[0], size) == 0;
+
+        if (!r.verified) {
+            fprintf(stderr, "round-trip mismatch: corpus=%s level=%d\n", corpus.name.c_str(), level);
+            allOk = false;
+        }
+        results.push_back(r);
+    }
+
+    free(sd);
+    return allOk;
+}
+
+void printTable(FILE* fp, const std::vector<Result>& results)
+{
+    fprintf(fp, "%-16s %5s %5s %10s %10s %8s %12s %12s %10s\n", "corpus", "level", "sdefl", "original", "compressed",
+        "ratio", "comp MB/s", "decomp MB/s", "mem KB");
+    for (size_t i = 0; i < results.size(); ++i) {
+        const Result& r = results[i];
+        fprintf(fp, "%-16s %5d %5d %10u %10u %8.3f %12.2f %12.2f %10u%s\n", r.corpus.c_str(), r.level, r.sdeflLevel,
+            r.originalSize, r.compressedSize, r.ratio, r.compressMBps, r.uncompressMBps,
+            (unsigned)(r.workingSetBytes / 1024), r.verified ? "" : "  MISMATCH");
+    }
+}
+
+void printJson(FILE* fp, const std::vector<Result>& results, const Options& opt)
+{
+    fprintf(fp, "{\n");
+    fprintf(fp, "  \"benchmark\": \"ege_compress\",\n");
+    fprintf(fp, "  \"min_time_s\": %.3f,\n", opt.minTime);
+    fprintf(fp, "  \"peak_rss_bytes\": %zu,\n", peakResidentBytes());
+    fprintf(fp, "  \"results\": [\n");
+    for (size_t i = 0; i < results.size(); ++i) {
+        const Result& r = results[i];
+        fprintf(fp,
+            "    {\"corpus\": \"%s\", \"kind\": \"%s\", \"level\": %d, \"sdefl_level\": %d, "
+            "\"original_bytes\": %u, \"compressed_bytes\": %u, \"ratio\": %.4f, "
+            "\"compress_mb_s\": %.3f, \"uncompress_mb_s\": %.3f, \"working_set_bytes\": %zu, \"verified\": %s}%s\n",
+            r.corpus.c_str(), r.kind.c_str(), r.level, r.sdeflLevel, r.originalSize, r.compressedSize, r.ratio,
+            r.compressMBps, r.uncompressMBps, r.workingSetBytes, r.verified ? "true" : "false",
+            (i + 1 < results.size()) ? "," : "");
+    }
+    fprintf(fp, "  ]\n");
+    fprintf(fp, "}\n");
+}
+
+void printUsage(const char* argv0)
+{
+    fprintf(stderr,
+        "Usage: %s [options]\n"
+        "  --json <file|->       write results as JSON ('-' for stdout)\n"
+        "  --min-time <seconds>  minimum measuring time per level and direction (default 0.25)\n"
+        "  --levels <min>-<max>  compression levels to run, within 0-9 (default 0-9)\n"
+        "  --filter <name>       only run corpora whose name contains <name>\n",
+        argv0);
+}
+
+bool parseOptions(int argc, char* argv[], Options& opt)
+{
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        if (i + 1 >= argc) {
+            return false;
+        }
+        if (strcmp(arg, "--json") == 0) {
+            opt.jsonPath = argv[++i];
+        } else if (strcmp(arg, "--min-time") == 0) {
+            opt.minTime = atof(argv[++i]);
+        } else if (strcmp(arg, "--levels") == 0) {
+            if (sscanf(argv[++i], "%d-%d", &opt.levelMin, &opt.levelMax) != 2) {
+                return false;
+            }
+        } else if (strcmp(arg, "--filter") == 0) {
+            opt.filter = argv[++i];
+        } else {
+            return false;
+        }
+    }
+
+    opt.levelMin = CLAMP(opt.levelMin, EGE_LEVEL_MIN, EGE_LEVEL_MAX);
+    opt.levelMax = CLAMP(opt.levelMax, EGE_LEVEL_MIN, EGE_LEVEL_MAX);
+    return opt.levelMin <= opt.levelMax && opt.minTime >= 0.0;
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    Options opt;
+    if (!parseOptions(argc, argv, opt)) {
+        printUsage(argv[0]);
+        return 2;
+    }
+
+    typedef Corpus (*CorpusFactory)();
+    static const CorpusFactory factories[] = {
+        makeImageGradient, makeImageShapes, makeImageNoisy,
+        makeTextEnglish, makeTextSource,
+        makeBinaryRandom, makeBinaryRecords, makeBinaryZeros,
+    };
+
+    std::vector<Result> results;
+    bool allOk = true;
+    for (size_t i = 0; i < sizeof(factories) / sizeof(factories[0]); ++i) {
+        Corpus corpus = factories[i]();
+        if (!opt.filter.empty() && corpus.name.find(opt.filter) == std::string::npos) {
+            continue;
+        }
+        allOk = runCorpus(corpus, opt, results) && allOk;
+    }
+
+    bool jsonToStdout = opt.jsonPath == "-";
+    if (!jsonToStdout) {
+        printTable(stdout, results);
+        printf("peak RSS: %zu KB\n", peakResidentBytes() / 1024);
+    }
+
+    if (!opt.jsonPath.empty()) {
+        FILE* fp = jsonToStdout ? stdout : fopen(opt.jsonPath.c_str(), "w");
+        if (fp == NULL) {
+            fprintf(stderr, "failed to open %s\n", opt.jsonPath.c_str());
+            return 1;
+        }
+        printJson(fp, results, opt);
+        if (!jsonToStdout) {
+            fclose(fp);
+        }
+    }
+
+    return allOk ? 0 : 1;
+}
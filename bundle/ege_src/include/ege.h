@@ -1033,6 +1033,21 @@ struct ege_transform_matrix
     float m31, m32;     ///< Third row: [m31, m32] translation components
 };
 
+/**
+ * @struct ege_transform_matrix3d
+ * @brief 3D transformation matrix
+ *
+ * 4x4 matrix for 3D point transformations, uses row vector convention [x y z 1] * M
+ * like ege_transform_matrix. Translation components are in the fourth row.
+ */
+struct ege_transform_matrix3d
+{
+    float m11, m12, m13, m14;   ///< First row
+    float m21, m22, m23, m24;   ///< Second row
+    float m31, m32, m33, m34;   ///< Third row
+    float m41, m42, m43, m44;   ///< Fourth row: [m41, m42, m43] translation components
+};
+
 /**
  * @struct ege_path
  * @brief Graphics path
@@ -1231,6 +1246,89 @@ struct VECTOR3D
     static float GetAngle(const VECTOR3D& e, const VECTOR3D& s = VECTOR3D(0.0f, 0.0f, 1.0f));
 };
 
+/// @brief Set 3D matrix to identity
+/// @param matrix Matrix to set
+void EGEAPI ege_matrix3d_identity(ege_transform_matrix3d* matrix);
+
+/// @brief Multiply 3D matrices, result = a * b (apply a first, then b)
+/// @param result Result matrix, may be the same as a or b
+/// @param a First matrix
+/// @param b Second matrix
+void EGEAPI ege_matrix3d_multiply(ege_transform_matrix3d* result, const ege_transform_matrix3d* a, const ege_transform_matrix3d* b);
+
+/// @brief Append rotation around X axis to matrix
+/// @param matrix Matrix to modify
+/// @param rad Rotation angle (radians), same direction as rotate_point3d_x()
+void EGEAPI ege_matrix3d_rotate_x(ege_transform_matrix3d* matrix, float rad);
+
+/// @brief Append rotation around Y axis to matrix
+/// @param matrix Matrix to modify
+/// @param rad Rotation angle (radians), same direction as rotate_point3d_y()
+void EGEAPI ege_matrix3d_rotate_y(ege_transform_matrix3d* matrix, float rad);
+
+/// @brief Append rotation around Z axis to matrix
+/// @param matrix Matrix to modify
+/// @param rad Rotation angle (radians), same direction as rotate_point3d_z()
+void EGEAPI ege_matrix3d_rotate_z(ege_transform_matrix3d* matrix, float rad);
+
+/// @brief Append scaling to matrix
+/// @param matrix Matrix to modify
+/// @param sx X scale factor
+/// @param sy Y scale factor
+/// @param sz Z scale factor
+void EGEAPI ege_matrix3d_scale(ege_transform_matrix3d* matrix, float sx, float sy, float sz);
+
+/// @brief Append translation to matrix
+/// @param matrix Matrix to modify
+/// @param tx X offset
+/// @param ty Y offset
+/// @param tz Z offset
+void EGEAPI ege_matrix3d_translate(ege_transform_matrix3d* matrix, float tx, float ty, float tz);
+
+/// @brief Transform 3D points in batch
+/// @param dst Output point array, may be the same as src
+/// @param src Input point array
+/// @param count Number of points
+/// @param matrix Transformation matrix, homogeneous division is applied if the fourth column is not (0, 0, 0, 1)
+/// @note Uses SIMD instructions when available; the matrix is evaluated once for the whole array
+void EGEAPI transform_points3d(VECTOR3D* dst, const VECTOR3D* src, int count, const ege_transform_matrix3d* matrix);
+
+/// @brief Transform 3D points in batch (structure of arrays layout, in place)
+/// @param xs X coordinate array
+/// @param ys Y coordinate array
+/// @param zs Z coordinate array
+/// @param count Number of points
+/// @param matrix Transformation matrix
+/// @note Structure of arrays layout processes several points per SIMD instruction, fastest for large point clouds
+void EGEAPI transform_points3d(float* xs, float* ys, float* zs, int count, const ege_transform_matrix3d* matrix);
+
+/// @brief Transform and perspective project 3D points to screen coordinates
+/// @param dst Output screen coordinate array, at least count elements
+/// @param src Input point array
+/// @param count Number of points
+/// @param matrix Transformation from model space to camera space (camera looks along +Z)
+/// @param focalLength Distance from eye to projection plane, in pixels
+/// @param centerX Screen x coordinate of the projection center
+/// @param centerY Screen y coordinate of the projection center
+/// @return Number of points written, points behind the camera are skipped
+/// @note Screen y has the same direction as camera space y. Written points keep their relative order, so if all points are in front of the camera the output can be used with ege_drawpoly(), ege_polyline() etc.
+int  EGEAPI project_points3d(ege_point* dst, const VECTOR3D* src, int count, const ege_transform_matrix3d* matrix,
+    float focalLength, float centerX, float centerY);
+
+/// @brief Transform and perspective project 3D points to pixels for putpixels()
+/// @param dst Output array of [x, y, color] triples, at least 3 * count elements
+/// @param src Input point array
+/// @param count Number of points
+/// @param matrix Transformation from model space to camera space (camera looks along +Z)
+/// @param focalLength Distance from eye to projection plane, in pixels
+/// @param centerX Screen x coordinate of the projection center
+/// @param centerY Screen y coordinate of the projection center
+/// @param color Pixel color written to each triple
+/// @return Number of points written, points behind the camera are skipped
+/// @see putpixels()
+int  EGEAPI project_points3d(int* dst, const VECTOR3D* src, int count, const ege_transform_matrix3d* matrix,
+    float focalLength, float centerX, float centerY, color_t color);
+
 /// @brief Image object forward declaration
 class IMAGE;
 /// @brief Image object pointer type
@@ -4901,6 +4999,113 @@ unsigned int    EGEAPI random(unsigned int n = 0);
  */
 double          EGEAPI randomf();
 
+/**
+ * @brief Fill a buffer with random 32-bit integers
+ * @param buf Output buffer, at least n elements
+ * @param n Number of values to generate
+ * @note Produces exactly the same sequence as calling random() n times, but in one batched pass
+ * @see random(), random_fill_f32(), random_fill_normal()
+ */
+void            EGEAPI random_fill_u32(uint32_t* buf, int n);
+
+/**
+ * @brief Fill a buffer with uniformly distributed random floating point numbers
+ * @param buf Output buffer, at least n elements
+ * @param n Number of values to generate
+ * @param lo Lower bound of the range
+ * @param hi Upper bound of the range
+ * @note Values are in range [lo, hi) with 24-bit resolution, suitable for initializing particle arrays
+ * @see randomf(), random_fill_u32(), random_fill_normal()
+ */
+void            EGEAPI random_fill_f32(float* buf, int n, float lo = 0.0f, float hi = 1.0f);
+
+/**
+ * @brief Fill a buffer with normally distributed random floating point numbers
+ * @param buf Output buffer, at least n elements
+ * @param n Number of values to generate
+ * @param mean Mean of the distribution
+ * @param stddev Standard deviation of the distribution
+ * @note Uses Box-Muller transform on the Mersenne Twister output
+ * @see random_fill_u32(), random_fill_f32()
+ */
+void            EGEAPI random_fill_normal(float* buf, int n, float mean = 0.0f, float stddev = 1.0f);
+
+/**
+ * @brief Independent random number stream
+ *
+ * Each stream owns its own generator state (xoshiro256**), so different threads can
+ * generate random numbers in parallel without locking. Not related to the global
+ * generator used by random(), whose behaviour is unchanged.
+ * @see ege_rng_create()
+ */
+struct ege_rng;
+
+/**
+ * @brief Create independent random number stream
+ * @param seed Random number seed
+ * @param streamId Stream index; streams created with the same seed and different
+ *        streamId produce non-overlapping sequences (each is 2^128 numbers apart)
+ * @return Stream object pointer, NULL on failure
+ * @note Creation cost grows with the number of bits in streamId, at most 32 jumps
+ * @see ege_rng_destroy(), ege_rng_jump()
+ */
+ege_rng* EGEAPI ege_rng_create     (uint32_t seed, uint32_t streamId = 0);
+
+/**
+ * @brief Clone random number stream, the clone continues from the same state
+ * @param rng Source stream object pointer
+ * @return New stream object pointer
+ */
+ege_rng* EGEAPI ege_rng_clone      (const ege_rng* rng);
+
+/**
+ * @brief Destroy random number stream
+ * @param rng Stream object pointer
+ */
+void     EGEAPI ege_rng_destroy    (const ege_rng* rng);
+
+/**
+ * @brief Jump ahead, equivalent to generating 2^128 numbers
+ * @param rng Stream object pointer
+ * @note Can be used to split one stream into non-overlapping sub-streams
+ */
+void     EGEAPI ege_rng_jump       (ege_rng* rng);
+
+/**
+ * @brief Generate random integer from stream
+ * @param rng Stream object pointer
+ * @param n Upper limit of random number range, if 0 then generate full range random number
+ * @return Generated random integer, range is [0, n) or [0, UINT_MAX]
+ * @see random()
+ */
+uint32_t EGEAPI ege_rng_random     (ege_rng* rng, uint32_t n = 0);
+
+/**
+ * @brief Generate random floating point number from stream
+ * @param rng Stream object pointer
+ * @return Generated random floating point number, range is [0.0, 1.0)
+ * @see randomf()
+ */
+double   EGEAPI ege_rng_randomf    (ege_rng* rng);
+
+/**
+ * @brief Fill a buffer with random 32-bit integers from stream
+ * @see random_fill_u32()
+ */
+void     EGEAPI ege_rng_fill_u32   (ege_rng* rng, uint32_t* buf, int n);
+
+/**
+ * @brief Fill a buffer with uniformly distributed random floating point numbers in [lo, hi) from stream
+ * @see random_fill_f32()
+ */
+void     EGEAPI ege_rng_fill_f32   (ege_rng* rng, float* buf, int n, float lo = 0.0f, float hi = 1.0f);
+
+/**
+ * @brief Fill a buffer with normally distributed random floating point numbers from stream
+ * @see random_fill_normal()
+ */
+void     EGEAPI ege_rng_fill_normal(ege_rng* rng, float* buf, int n, float mean = 0.0f, float stddev = 1.0f);
+
 /**
  * @brief Show input dialog to get single line text (ASCII version)
  * @param title Dialog title
@@ -1033,6 +1033,21 @@ struct ege_transform_matrix
     float m31, m32;     ///< 第三行：[m31, m32] 平移分量
 };
 
+/**
+ * @struct ege_transform_matrix3d
+ * @brief 3D 变换矩阵
+ *
+ * 用于三维点变换的 4x4 矩阵，与 ege_transform_matrix 一样采用行向量约定 [x y z 1] * M，
+ * 平移分量位于第四行。
+ */
+struct ege_transform_matrix3d
+{
+    float m11, m12, m13, m14;   ///< 第一行
+    float m21, m22, m23, m24;   ///< 第二行
+    float m31, m32, m33, m34;   ///< 第三行
+    float m41, m42, m43, m44;   ///< 第四行：[m41, m42, m43] 为平移分量
+};
+
 /**
  * @struct ege_path
  * @brief 图形路径
@@ -1231,6 +1246,89 @@ struct VECTOR3D
     static float GetAngle(const VECTOR3D& e, const VECTOR3D& s = VECTOR3D(0.0f, 0.0f, 1.0f));
 };
 
+/// @brief 将 3D 矩阵设置为单位矩阵
+/// @param matrix 要设置的矩阵
+void EGEAPI ege_matrix3d_identity(ege_transform_matrix3d* matrix);
+
+/// @brief 3D 矩阵相乘，result = a * b（先应用 a，再应用 b）
+/// @param result 结果矩阵，可以与 a 或 b 相同
+/// @param a 第一个矩阵
+/// @param b 第二个矩阵
+void EGEAPI ege_matrix3d_multiply(ege_transform_matrix3d* result, const ege_transform_matrix3d* a, const ege_transform_matrix3d* b);
+
+/// @brief 在矩阵后追加绕 X 轴的旋转
+/// @param matrix 要修改的矩阵
+/// @param rad 旋转角度（弧度），方向与 rotate_point3d_x() 相同
+void EGEAPI ege_matrix3d_rotate_x(ege_transform_matrix3d* matrix, float rad);
+
+/// @brief 在矩阵后追加绕 Y 轴的旋转
+/// @param matrix 要修改的矩阵
+/// @param rad 旋转角度（弧度），方向与 rotate_point3d_y() 相同
+void EGEAPI ege_matrix3d_rotate_y(ege_transform_matrix3d* matrix, float rad);
+
+/// @brief 在矩阵后追加绕 Z 轴的旋转
+/// @param matrix 要修改的矩阵
+/// @param rad 旋转角度（弧度），方向与 rotate_point3d_z() 相同
+void EGEAPI ege_matrix3d_rotate_z(ege_transform_matrix3d* matrix, float rad);
+
+/// @brief 在矩阵后追加缩放
+/// @param matrix 要修改的矩阵
+/// @param sx X 方向缩放系数
+/// @param sy Y 方向缩放系数
+/// @param sz Z 方向缩放系数
+void EGEAPI ege_matrix3d_scale(ege_transform_matrix3d* matrix, float sx, float sy, float sz);
+
+/// @brief 在矩阵后追加平移
+/// @param matrix 要修改的矩阵
+/// @param tx X 方向偏移
+/// @param ty Y 方向偏移
+/// @param tz Z 方向偏移
+void EGEAPI ege_matrix3d_translate(ege_transform_matrix3d* matrix, float tx, float ty, float tz);
+
+/// @brief 批量变换 3D 点
+/// @param dst 输出点数组，可以与 src 相同
+/// @param src 输入点数组
+/// @param count 点的个数
+/// @param matrix 变换矩阵，第四列不为 (0, 0, 0, 1) 时进行齐次除法
+/// @note 支持时使用 SIMD 指令，整个数组只需计算一次矩阵
+void EGEAPI transform_points3d(VECTOR3D* dst, const VECTOR3D* src, int count, const ege_transform_matrix3d* matrix);
+
+/// @brief 批量变换 3D 点（结构数组布局，原地变换）
+/// @param xs X 坐标数组
+/// @param ys Y 坐标数组
+/// @param zs Z 坐标数组
+/// @param count 点的个数
+/// @param matrix 变换矩阵
+/// @note 结构数组布局下一条 SIMD 指令可同时处理多个点，适合大规模点云
+void EGEAPI transform_points3d(float* xs, float* ys, float* zs, int count, const ege_transform_matrix3d* matrix);
+
+/// @brief 变换 3D 点并透视投影到屏幕坐标
+/// @param dst 输出屏幕坐标数组，至少 count 个元素
+/// @param src 输入点数组
+/// @param count 点的个数
+/// @param matrix 从模型空间到相机空间的变换（相机朝向 +Z）
+/// @param focalLength 视点到投影平面的距离，单位为像素
+/// @param centerX 投影中心的屏幕 x 坐标
+/// @param centerY 投影中心的屏幕 y 坐标
+/// @return 写入的点数，位于相机后方的点会被跳过
+/// @note 屏幕 y 方向与相机空间 y 方向相同。写入的点保持原有的相对顺序，所有点都位于相机前方时可直接用于 ege_drawpoly()、ege_polyline() 等
+int  EGEAPI project_points3d(ege_point* dst, const VECTOR3D* src, int count, const ege_transform_matrix3d* matrix,
+    float focalLength, float centerX, float centerY);
+
+/// @brief 变换 3D 点并透视投影为 putpixels() 所需的像素数组
+/// @param dst 输出 [x, y, color] 三元组数组，至少包含 3 * count 个元素
+/// @param src 输入点数组
+/// @param count 点的个数
+/// @param matrix 从模型空间到相机空间的变换（相机朝向 +Z）
+/// @param focalLength 视点到投影平面的距离，单位为像素
+/// @param centerX 投影中心的屏幕 x 坐标
+/// @param centerY 投影中心的屏幕 y 坐标
+/// @param color 写入每个三元组的像素颜色
+/// @return 写入的点数，位于相机后方的点会被跳过
+/// @see putpixels()
+int  EGEAPI project_points3d(int* dst, const VECTOR3D* src, int count, const ege_transform_matrix3d* matrix,
+    float focalLength, float centerX, float centerY, color_t color);
+
 /// @brief 图像对象前置声明
 class IMAGE;
 /// @brief 图像对象指针类型
@@ -4896,6 +4994,111 @@ unsigned int    EGEAPI random(unsigned int n = 0);
  */
 double          EGEAPI randomf();
 
+/**
+ * @brief 批量生成 32 位随机整数
+ * @param buf 输出缓冲区，至少包含 n 个元素
+ * @param n 生成的个数
+ * @note 结果与连续调用 n 次 random() 完全相同，但一次性批量生成
+ * @see random(), random_fill_f32(), random_fill_normal()
+ */
+void            EGEAPI random_fill_u32(uint32_t* buf, int n);
+
+/**
+ * @brief 批量生成均匀分布的随机浮点数
+ * @param buf 输出缓冲区，至少包含 n 个元素
+ * @param n 生成的个数
+ * @param lo 范围下限
+ * @param hi 范围上限
+ * @note 生成的数值范围为 [lo, hi)，精度为 24 位，适合批量初始化粒子数组
+ * @see randomf(), random_fill_u32(), random_fill_normal()
+ */
+void            EGEAPI random_fill_f32(float* buf, int n, float lo = 0.0f, float hi = 1.0f);
+
+/**
+ * @brief 批量生成正态分布的随机浮点数
+ * @param buf 输出缓冲区，至少包含 n 个元素
+ * @param n 生成的个数
+ * @param mean 均值
+ * @param stddev 标准差
+ * @note 对 Mersenne Twister 输出使用 Box-Muller 变换
+ * @see random_fill_u32(), random_fill_f32()
+ */
+void            EGEAPI random_fill_normal(float* buf, int n, float mean = 0.0f, float stddev = 1.0f);
+
+/**
+ * @brief 独立随机数流
+ *
+ * 每个随机数流拥有独立的生成器状态（xoshiro256**），不同线程可以各自持有一个并行生成随机数，无需加锁。
+ * 与 random() 使用的全局生成器互不影响，random() 的行为保持不变。
+ * @see ege_rng_create()
+ */
+struct ege_rng;
+
+/**
+ * @brief 创建独立随机数流
+ * @param seed 随机数种子
+ * @param streamId 流编号；种子相同、编号不同的流产生互不重叠的序列（彼此相隔 2^128 个数）
+ * @return 随机数流对象指针，失败时返回 NULL
+ * @note 创建耗时取决于 streamId 的二进制位数，最多 32 次跳跃
+ * @see ege_rng_destroy(), ege_rng_jump()
+ */
+ege_rng* EGEAPI ege_rng_create     (uint32_t seed, uint32_t streamId = 0);
+
+/**
+ * @brief 克隆随机数流，克隆体从相同状态继续生成
+ * @param rng 源随机数流对象指针
+ * @return 新的随机数流对象指针
+ */
+ege_rng* EGEAPI ege_rng_clone      (const ege_rng* rng);
+
+/**
+ * @brief 销毁随机数流
+ * @param rng 随机数流对象指针
+ */
+void     EGEAPI ege_rng_destroy    (const ege_rng* rng);
+
+/**
+ * @brief 向前跳跃，相当于生成 2^128 个随机数
+ * @param rng 随机数流对象指针
+ * @note 可用于将一个流划分为互不重叠的子流
+ */
+void     EGEAPI ege_rng_jump       (ege_rng* rng);
+
+/**
+ * @brief 从随机数流生成随机整数
+ * @param rng 随机数流对象指针
+ * @param n 随机数范围的上限，如果为 0 则生成完整范围的随机数
+ * @return 生成的随机整数，范围为 [0, n) 或 [0, UINT_MAX]
+ * @see random()
+ */
+uint32_t EGEAPI ege_rng_random     (ege_rng* rng, uint32_t n = 0);
+
+/**
+ * @brief 从随机数流生成随机浮点数
+ * @param rng 随机数流对象指针
+ * @return 生成的随机浮点数，范围为 [0.0, 1.0)
+ * @see randomf()
+ */
+double   EGEAPI ege_rng_randomf    (ege_rng* rng);
+
+/**
+ * @brief 从随机数流批量生成 32 位随机整数
+ * @see random_fill_u32()
+ */
+void     EGEAPI ege_rng_fill_u32   (ege_rng* rng, uint32_t* buf, int n);
+
+/**
+ * @brief 从随机数流批量生成 [lo, hi) 范围内均匀分布的随机浮点数
+ * @see random_fill_f32()
+ */
+void     EGEAPI ege_rng_fill_f32   (ege_rng* rng, float* buf, int n, float lo = 0.0f, float hi = 1.0f);
+
+/**
+ * @brief 从随机数流批量生成正态分布的随机浮点数
+ * @see random_fill_normal()
+ */
+void     EGEAPI ege_rng_fill_normal(ege_rng* rng, float* buf, int n, float mean = 0.0f, float stddev = 1.0f);
+
 /**
  * @brief 显示输入对话框获取单行文本（ASCII 版本）
  * @param title 对话框标题
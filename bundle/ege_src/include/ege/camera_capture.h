@@ -245,6 +245,28 @@ public:
      */
     std::shared_ptr<CameraFrame> grabFrame(unsigned int timeoutInMs = 0);
 
+    /**
+     * @brief 开启或关闭 "最新帧" 模式, 默认关闭. 可以在 open 之前或之后调用.
+     *      开启后, 每一帧在后台线程 (相机的采集线程) 上就被准备成可以直接绘制的 IMAGE,
+     *      渲染循环通过 `getLatestImage` 取得最新的一帧, 不需要等待, 也没有内存分配.
+     *      适合只关心最新画面的程序, 比如实时的可视化效果.
+     * @note 开启期间 `grabFrame` 拿不到帧. 渲染循环来不及取的帧会被直接丢弃.
+     */
+    void setLatestFrameMode(bool enable);
+
+    /// @brief 是否开启了 "最新帧" 模式.
+    bool isLatestFrameMode() const;
+
+    /**
+     * @brief "最新帧" 模式下, 获取最新的一帧. 立即返回, 不会等待新帧.
+     * @param isNewFrame 可选, 返回这一帧是否是上一次调用之后才到达的新帧.
+     * @return 最新一帧的 IMAGE, 生命周期归 CameraCapture 管理, 请勿释放.
+     *      在下一次调用 `getLatestImage` 或者 `close` 之前有效, 这期间后台线程不会修改它.
+     *      还没有收到任何帧 (或者没有开启 "最新帧" 模式) 时返回 nullptr.
+     * @note 只能在一个线程 (通常是渲染线程) 中调用.
+     */
+    PIMAGE getLatestImage(bool* isNewFrame = nullptr);
+
     ////////////////////////////////////////////////
 
     // 内部实现, 使用者无需关心.
@@ -8,11 +8,15 @@
 #if EGE_ENABLE_CAMERA_CAPTURE
 
 #include <ccap.h>
+#include <atomic>
 #include <cstdint>
+#include <cstring>
 #include <memory>
 #include <algorithm>
 #include <vector>
 
+#include "ege_common.h"
+#include "ege_dllimport.h"
 #include "image.h"
 
 using namespace ccap;
@@ -44,11 +48,23 @@ bool hasCameraCaptureModule()
 #endif
 }
 
+#if EGE_ENABLE_CAMERA_CAPTURE
+class LatestFrameBuffer;
+
+/// ImageAllocator 共享的状态, 生命周期可能长于 CameraCapture (用户仍持有帧时).
+struct ImageAllocatorContext
+{
+    std::atomic<int> frameWidth{0}; ///< 当前 BGRA 帧的宽度, 用来从 Allocator::resize 的字节数推算出 IMAGE 的尺寸
+};
+#endif
+
 // 仅仅是套壳, 避免把 std::shared_ptr 暴露出去.
 struct FrameContainer
 {
 #if EGE_ENABLE_CAMERA_CAPTURE
     std::vector<std::shared_ptr<CameraFrameImp>> allFrames;
+    std::shared_ptr<ImageAllocatorContext>       allocatorContext = std::make_shared<ImageAllocatorContext>();
+    std::shared_ptr<LatestFrameBuffer>           latestFrame; ///< "最新帧" 模式开启时才有
 #else
     int dummy;
 #endif
@@ -62,10 +78,93 @@ CameraFrame::~CameraFrame()
 
 #if EGE_ENABLE_CAMERA_CAPTURE
 
+/// 让 ccap 直接把帧转换 (YUV -> BGRA, 或 RGB 翻转) 到 ege::IMAGE 的 DIB 内存里,
+/// 这样 getImage 不需要再拷贝一次. 字节数凑不成整行时退回普通内存.
+/// @note 运行在 ccap 的采集线程上. IMAGE 只包含内存 DC 和 DIB, 不与线程绑定.
+///       但构造 IMAGE 时的 dll 加载与 GDI+ 初始化没有加锁, 所以 CameraCapture 的构造函数要先在用户线程上完成它们.
+class ImageAllocator : public ccap::Allocator
+{
+public:
+    explicit ImageAllocator(std::shared_ptr<ImageAllocatorContext> context) : m_context(std::move(context)) {}
+
+    void resize(size_t size) override
+    {
+        const int    width    = m_context->frameWidth.load(std::memory_order_relaxed);
+        const size_t lineSize = static_cast<size_t>(width) * 4;
+
+        if (width > 0 && size % lineSize == 0 && size / lineSize <= INT32_MAX) {
+            const int height = static_cast<int>(size / lineSize);
+            if (!m_image || m_image->getwidth() != width || m_image->getheight() != height) {
+                m_image = std::make_unique<ege::IMAGE>(width, height);
+            }
+            m_heap.reset();
+            return;
+        }
+
+        m_image.reset();
+        if (!m_heap) {
+            m_heap = std::make_unique<ccap::DefaultAllocator>();
+        }
+        m_heap->resize(size);
+    }
+
+    uint8_t* data() override
+    {
+        if (m_image) {
+            return reinterpret_cast<uint8_t*>(m_image->getbuffer());
+        }
+        return m_heap ? m_heap->data() : nullptr;
+    }
+
+    size_t size() override
+    {
+        if (m_image) {
+            return static_cast<size_t>(m_image->getwidth()) * m_image->getheight() * 4;
+        }
+        return m_heap ? m_heap->size() : 0;
+    }
+
+    /// 如果 frame 的像素就在一个 IMAGE 里, 并且尺寸一致, 返回这个 IMAGE.
+    static PIMAGE imageOf(const ccap::VideoFrame& frame)
+    {
+        auto* allocator = dynamic_cast<ImageAllocator*>(frame.allocator.get());
+        if (allocator == nullptr || !allocator->m_image || frame.data[0] != allocator->data()) {
+            return nullptr;
+        }
+
+        PIMAGE image = allocator->m_image.get();
+        if (frame.stride[0] != frame.width * 4 || image->getwidth() != static_cast<int>(frame.width) ||
+            image->getheight() != static_cast<int>(frame.height))
+        {
+            return nullptr;
+        }
+        return image;
+    }
+
+private:
+    std::shared_ptr<ImageAllocatorContext>  m_context;
+    std::unique_ptr<ege::IMAGE>             m_image;
+    std::unique_ptr<ccap::DefaultAllocator> m_heap;
+};
+
+/// 把 BGRA 帧拷贝到同样尺寸的 IMAGE 中.
+static void copyFrameToImage(const ccap::VideoFrame& frame, PIMAGE img)
+{
+    auto*          buffer   = reinterpret_cast<uint8_t*>(img->getbuffer());
+    const uint32_t lineSize = frame.width * 4;
+    if (lineSize == frame.stride[0]) { // 已对齐
+        memcpy(buffer, frame.data[0], static_cast<size_t>(lineSize) * frame.height);
+    } else { // 未对齐
+        for (uint32_t i = 0; i < frame.height; ++i) {
+            memcpy(buffer + i * lineSize, frame.data[0] + i * frame.stride[0], lineSize);
+        }
+    }
+}
+
 class CameraFrameImp : public CameraFrame, public std::enable_shared_from_this<CameraFrameImp>
 {
 public:
-    CameraFrameImp(CameraCapture* cam) { m_camera = cam; }
+    CameraFrameImp(CameraCapture* cam) : m_currentImage(nullptr) { m_camera = cam; }
 
     ~CameraFrameImp()
     {
@@ -79,8 +178,8 @@ public:
     {
         // 检查是否需要更新图像数据：
         // 1. m_frame != m_realFrame.get() 表示帧数据已更新（新帧或帧被复用）
-        // 2. m_realImage == nullptr 表示图像尚未创建
-        if ((m_frame != m_realFrame.get() || m_realImage == nullptr) && m_realFrame) {
+        // 2. m_currentImage == nullptr 表示图像尚未准备好
+        if ((m_frame != m_realFrame.get() || m_currentImage == nullptr) && m_realFrame) {
             if (m_realFrame->pixelFormat != ccap::PixelFormat::BGRA32) {
                 fputs("ege: 抓取到的图像格式不正确, 请上报一个错误!!", stderr);
                 fputs("ege: The captured image format is incorrect, please report an error!!", stderr);
@@ -90,29 +189,21 @@ public:
 
             // 更新一下数据.
             m_frame = m_realFrame.get();
-            if (!m_realImage) {
-                m_realImage = std::make_shared<ege::IMAGE>(m_realFrame->width, m_realFrame->height, ege::BLACK);
-            }
-
-            auto* img    = m_realImage.get();
-            auto* buffer = img->getbuffer();
 
-            if (m_realFrame->width * 4 == m_realFrame->stride[0]) { // 已对齐
-                assert(m_realFrame->sizeInBytes >= m_realFrame->width * m_realFrame->height * 4);
-                memcpy(buffer, m_realFrame->data[0], m_realFrame->sizeInBytes);
-            } else { // 未对齐
-                for (uint32_t i = 0; i < m_realFrame->height; ++i) {
-                    memcpy(buffer + i * m_realFrame->width, m_realFrame->data[0] + i * m_realFrame->stride[0],
-                        m_realFrame->width * 4);
+            // ccap 已经把像素写进了 IMAGE 的内存 (ImageAllocator), 直接使用, 不再拷贝.
+            m_currentImage = ImageAllocator::imageOf(*m_realFrame);
+            if (m_currentImage == nullptr) {
+                const int width  = static_cast<int>(m_realFrame->width);
+                const int height = static_cast<int>(m_realFrame->height);
+                if (!m_realImage || m_realImage->getwidth() != width || m_realImage->getheight() != height) {
+                    m_realImage = std::make_shared<ege::IMAGE>(width, height, ege::BLACK);
                 }
+                copyFrameToImage(*m_realFrame, m_realImage.get());
+                m_currentImage = m_realImage.get();
             }
         }
 
-        if (m_realImage) {
-            return m_realImage.get();
-        }
-
-        return nullptr;
+        return m_currentImage;
     }
 
     PIMAGE copyImage() override
@@ -125,16 +216,8 @@ public:
                 return m_realImage.get();
             }
 
-            PIMAGE img    = new ege::IMAGE(m_realFrame->width, m_realFrame->height, ege::BLACK);
-            auto*  buffer = img->getbuffer();
-            if (m_realFrame->width * 4 == m_realFrame->stride[0]) { // 已对齐
-                memcpy(buffer, m_realFrame->data[0], m_realFrame->sizeInBytes);
-            } else { // 未对齐
-                for (uint32_t i = 0; i < m_realFrame->height; ++i) {
-                    memcpy(buffer + i * m_realFrame->width, m_realFrame->data[0] + i * m_realFrame->stride[0],
-                        m_realFrame->width * 4);
-                }
-            }
+            PIMAGE img = new ege::IMAGE(m_realFrame->width, m_realFrame->height, ege::BLACK);
+            copyFrameToImage(*m_realFrame, img);
             return img;
         }
         return nullptr;
@@ -172,15 +255,132 @@ public:
         return 0;
     }
 
-    void setCcapFrame(std::shared_ptr<ccap::VideoFrame> frame) { m_realFrame = std::move(frame); }
+    void setCcapFrame(std::shared_ptr<ccap::VideoFrame> frame)
+    {
+        m_realFrame    = std::move(frame);
+        m_currentImage = nullptr; // ccap 会复用 VideoFrame 对象, 地址相同也可能是新的一帧
+    }
 
     ccap::VideoFrame* getCcapFrame() const { return m_realFrame.get(); }
 
 private:
     std::shared_ptr<ccap::VideoFrame> m_realFrame;
-    std::shared_ptr<ege::IMAGE>       m_realImage;
+    std::shared_ptr<ege::IMAGE>       m_realImage;    ///< 帧不在 IMAGE 内存里时, 拷贝到这里
+    PIMAGE                            m_currentImage; ///< getImage 的返回值, 指向 m_realImage 或帧自己的 IMAGE
+};
+
+/// "最新帧" 模式的三缓冲. 采集线程写 back, 渲染线程读 front, 第三个槽位 ready 通过原子交换在两者之间传递,
+/// 双方都不需要等待对方. 只有两块缓冲时, 采集线程写完之后必须等渲染线程放开 front 才能交换.
+class LatestFrameBuffer
+{
+public:
+    /// 采集线程调用.
+    void publish(const std::shared_ptr<ccap::VideoFrame>& frame)
+    {
+        if (frame->pixelFormat != ccap::PixelFormat::BGRA32) {
+            return;
+        }
+
+        Slot& slot = m_slots[m_back];
+        slot.frame = frame; // 持有帧, ccap 才不会往这块 IMAGE 里写下一帧
+        slot.image = ImageAllocator::imageOf(*frame);
+        if (slot.image == nullptr) {
+            slot.frame.reset();
+            const int width  = static_cast<int>(frame->width);
+            const int height = static_cast<int>(frame->height);
+            if (!slot.ownImage || slot.ownImage->getwidth() != width || slot.ownImage->getheight() != height) {
+                slot.ownImage = std::make_unique<ege::IMAGE>(width, height);
+            }
+            copyFrameToImage(*frame, slot.ownImage.get());
+            slot.image = slot.ownImage.get();
+        }
+
+        m_back = m_ready.exchange(static_cast<uint8_t>(m_back | kFreshBit), std::memory_order_acq_rel) & kIndexMask;
+    }
+
+    /// 渲染线程调用, 不等待, 不分配内存. 旧的帧在采集线程覆盖槽位时才释放.
+    PIMAGE acquire(bool* isNewFrame)
+    {
+        const bool fresh = (m_ready.load(std::memory_order_relaxed) & kFreshBit) != 0;
+        if (fresh) {
+            m_front = m_ready.exchange(m_front, std::memory_order_acq_rel) & kIndexMask;
+        }
+        if (isNewFrame) {
+            *isNewFrame = fresh;
+        }
+        return m_slots[m_front].image;
+    }
+
+    /// 释放所有帧和图像. 只能在采集线程停止, 并且渲染线程不在调用 acquire 时调用.
+    void clear()
+    {
+        for (auto& slot : m_slots) {
+            slot = Slot();
+        }
+        m_ready.store(1, std::memory_order_relaxed);
+        m_back  = 0;
+        m_front = 2;
+    }
+
+private:
+    static const uint8_t kIndexMask = 3;
+    static const uint8_t kFreshBit  = 4; ///< ready 槽位里是还没有被渲染线程取走的新帧
+
+    struct Slot
+    {
+        std::shared_ptr<ccap::VideoFrame> frame;
+        std::unique_ptr<ege::IMAGE>       ownImage; ///< 帧不在 IMAGE 内存里时, 拷贝到这里
+        PIMAGE                            image = nullptr;
+    };
+
+    Slot                 m_slots[3];
+    std::atomic<uint8_t> m_ready{1};
+    uint8_t              m_back  = 0; ///< 只有采集线程访问
+    uint8_t              m_front = 2; ///< 只有渲染线程访问
 };
 
+/// 按 ccap 的裁剪和缩放规则 (见 PropertyName::CropX, PropertyName::OutputWidth) 推算 open 之后送达的帧宽度.
+/// 推算不准时 ImageAllocator 只会退回普通内存, 收到第一帧后 frameWidth 会被纠正.
+static int expectedFrameWidth(Provider& provider)
+{
+    int width  = static_cast<int>(provider.get(PropertyName::Width));
+    int height = static_cast<int>(provider.get(PropertyName::Height));
+    auto format = static_cast<PixelFormat>(static_cast<uint32_t>(provider.get(PropertyName::PixelFormatInternal)));
+    // MJPEG 先解码为 YUV, 之后的处理与 YUV 输入相同
+    const bool isYUV   = pixelFormatInclude(format, kPixelFormatYUVColorBit) || format == PixelFormat::MJPEG;
+    const bool is422   = pixelFormatInclude(format, PixelFormat::YUYV) || pixelFormatInclude(format, PixelFormat::UYVY);
+    const int  cropX   = static_cast<int>(provider.get(PropertyName::CropX));
+    const int  cropY   = static_cast<int>(provider.get(PropertyName::CropY));
+    const int  cropW   = static_cast<int>(provider.get(PropertyName::CropWidth));
+    const int  cropH   = static_cast<int>(provider.get(PropertyName::CropHeight));
+    const int  alignX  = isYUV ? 2 : 1;
+    const int  alignY  = (isYUV && !is422) ? 2 : 1;
+
+    if (width < alignX || height < alignY) {
+        return width;
+    }
+
+    if (cropX > 0 || cropY > 0 || cropW > 0 || cropH > 0) {
+        int x  = std::clamp(cropX, 0, width - alignX) & ~(alignX - 1);
+        int y  = std::clamp(cropY, 0, height - alignY) & ~(alignY - 1);
+        int w  = cropW > 0 ? std::min(cropW, width - x) : width - x;
+        int h  = cropH > 0 ? std::min(cropH, height - y) : height - y;
+        width  = std::max(w & ~(alignX - 1), alignX);
+        height = std::max(h & ~(alignY - 1), alignY);
+    }
+
+    // 只有 YUV 转 RGB 时才会缩放
+    int outputW = static_cast<int>(provider.get(PropertyName::OutputWidth));
+    int outputH = static_cast<int>(provider.get(PropertyName::OutputHeight));
+    if (isYUV && (outputW > 0 || outputH > 0)) {
+        if (outputW <= 0) {
+            outputW = static_cast<int>((static_cast<int64_t>(width) * outputH + height / 2) / height);
+        }
+        width = std::clamp(outputW, 1, width);
+    }
+    return width;
+}
+
 #endif
 
 /////////////////
@@ -190,8 +390,17 @@ CameraCapture::CameraCapture() : m_provider(nullptr), m_frameContainer(nullptr)
     CHECK_AND_PRINT_ERROR_MSG();
 
 #if EGE_ENABLE_CAMERA_CAPTURE
+    // ImageAllocator 会在采集线程上构造 IMAGE, 这两步没有加锁, 先在这里完成
+    dll::loadDllsIfNot();
+    gdiplusinit();
+
     m_provider       = new Provider();
     m_frameContainer = new FrameContainer();
+
+    // 帧的内存由 IMAGE 提供, ccap 的转换结果直接就是可以绘制的图像.
+    m_provider->setFrameAllocator([context = m_frameContainer->allocatorContext]() -> std::shared_ptr<ccap::Allocator> {
+        return std::make_shared<ImageAllocator>(context);
+    });
 #endif
 }
 
@@ -305,7 +514,13 @@ bool CameraCapture::open(const char* deviceName, bool autoStart)
     m_provider->set(PropertyName::PixelFormatInternal, ccap::PixelFormat::BGRA32);
     m_provider->set(PropertyName::FrameOrientation, ccap::FrameOrientation::TopToBottom);
 
-    return m_provider->open(deviceName, autoStart);
+    if (!m_provider->open(deviceName, false)) {
+        return false;
+    }
+
+    // 实际的分辨率和格式在 open 之后才确定, ImageAllocator 按送达帧的宽度创建 IMAGE.
+    m_frameContainer->allocatorContext->frameWidth = expectedFrameWidth(*m_provider);
+    return !autoStart || start();
 #endif
 }
 
@@ -342,6 +557,9 @@ void CameraCapture::close()
     if (m_provider) {
         m_provider->close();
     }
+    if (m_frameContainer && m_frameContainer->latestFrame) {
+        m_frameContainer->latestFrame->clear(); // 采集线程已经停止
+    }
 #endif
 }
 
@@ -357,7 +575,15 @@ bool CameraCapture::start()
 {
     CHECK_AND_PRINT_ERROR_MSG(false);
 #if EGE_ENABLE_CAMERA_CAPTURE
-    return m_provider && m_provider->start();
+    if (!m_provider || !m_provider->start()) {
+        return false;
+    }
+
+    // 部分后端 (如虚拟设备) 在 start 时才确定采集格式, 需要重新推算帧宽度
+    if (m_frameContainer) {
+        m_frameContainer->allocatorContext->frameWidth = expectedFrameWidth(*m_provider);
+    }
+    return true;
 #endif
 }
 
@@ -387,6 +613,7 @@ std::shared_ptr<CameraFrame> CameraCapture::grabFrame(unsigned int timeoutInMs)
         auto frame = m_provider->grab(timeoutInMs);
         if (frame && m_frameContainer) {
             auto& allFrames = m_frameContainer->allFrames;
+            m_frameContainer->allocatorContext->frameWidth = static_cast<int>(frame->width);
 
             // 查找只被 allFrames 持有的空闲帧 (use_count() == 1 表示用户已释放其 shared_ptr)
             if (auto freeFrameIt = std::find_if(allFrames.begin(), allFrames.end(),
@@ -411,6 +638,53 @@ std::shared_ptr<CameraFrame> CameraCapture::grabFrame(unsigned int timeoutInMs)
 #endif
 }
 
+void CameraCapture::setLatestFrameMode(bool enable)
+{
+    CHECK_AND_PRINT_ERROR_MSG();
+#if EGE_ENABLE_CAMERA_CAPTURE
+    if (!m_provider || !m_frameContainer || enable == (m_frameContainer->latestFrame != nullptr)) {
+        return;
+    }
+
+    if (enable) {
+        auto buffer  = std::make_shared<LatestFrameBuffer>();
+        auto context = m_frameContainer->allocatorContext;
+        m_frameContainer->latestFrame = buffer;
+        m_provider->setNewFrameCallback([buffer, context](const std::shared_ptr<ccap::VideoFrame>& frame) {
+            context->frameWidth = static_cast<int>(frame->width);
+            buffer->publish(frame);
+            return true; // 帧已经被取走, 不再进入 grab 的队列
+        });
+    } else {
+        // 回调持有 buffer, 正在执行的回调结束后 buffer 才会释放
+        m_provider->setNewFrameCallback(nullptr);
+        m_frameContainer->latestFrame.reset();
+    }
+#endif
+}
+
+bool CameraCapture::isLatestFrameMode() const
+{
+    CHECK_AND_PRINT_ERROR_MSG(false);
+#if EGE_ENABLE_CAMERA_CAPTURE
+    return m_frameContainer && m_frameContainer->latestFrame != nullptr;
+#endif
+}
+
+PIMAGE CameraCapture::getLatestImage(bool* isNewFrame)
+{
+    if (isNewFrame) {
+        *isNewFrame = false;
+    }
+    CHECK_AND_PRINT_ERROR_MSG(nullptr);
+#if EGE_ENABLE_CAMERA_CAPTURE
+    if (m_frameContainer && m_frameContainer->latestFrame) {
+        return m_frameContainer->latestFrame->acquire(isNewFrame);
+    }
+    return nullptr;
+#endif
+}
+
 FrameContainer* CameraCapture::getFrameContainer() const
 {
     return m_frameContainer;
@@ -7,6 +7,12 @@
 
 #include "ege_head.h"
 #include <math.h>
+#include <string.h>
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define EGE_MATH_SSE2 1
+#include <emmintrin.h>
+#endif
 
 namespace ege
 {
@@ -170,4 +176,412 @@ float VECTOR3D::GetAngle(const VECTOR3D& _e, const VECTOR3D& _s)
 
     return (float)asin(sr);
 }
+
+//************************************************************************
+//  3D 变换矩阵与批量点变换
+//  采用行向量约定: [x y z 1] * M, 与 ege_transform_matrix 一致, 平移分量位于第四行.
+//************************************************************************
+
+void ege_matrix3d_identity(ege_transform_matrix3d* matrix)
+{
+    if (matrix == NULL) {
+        return;
+    }
+
+    memset(matrix, 0, sizeof(*matrix));
+    matrix->m11 = matrix->m22 = matrix->m33 = matrix->m44 = 1.0f;
+}
+
+void ege_matrix3d_multiply(ege_transform_matrix3d* result, const ege_transform_matrix3d* a, const ege_transform_matrix3d* b)
+{
+    if (result == NULL || a == NULL || b == NULL) {
+        return;
+    }
+
+    const float* ma = &a->m11;
+    const float* mb = &b->m11;
+    float        r[16];
+
+    for (int i = 0; i < 4; ++i) {
+        for (int j = 0; j < 4; ++j) {
+            r[i * 4 + j] = ma[i * 4 + 0] * mb[0 * 4 + j] + ma[i * 4 + 1] * mb[1 * 4 + j]
+                         + ma[i * 4 + 2] * mb[2 * 4 + j] + ma[i * 4 + 3] * mb[3 * 4 + j];
+        }
+    }
+
+    memcpy(&result->m11, r, sizeof(r));
+}
+
+// matrix = matrix * t, 即在已有变换之后追加变换 t
+static void matrix3d_append(ege_transform_matrix3d* matrix, const ege_transform_matrix3d& t)
+{
+    ege_matrix3d_multiply(matrix, matrix, &t);
+}
+
+void ege_matrix3d_rotate_x(ege_transform_matrix3d* matrix, float rad)
+{
+    if (matrix == NULL) {
+        return;
+    }
+
+    float sr = (float)sin(rad), cr = (float)cos(rad);
+    ege_transform_matrix3d t;
+    ege_matrix3d_identity(&t);
+    t.m22 = cr;  t.m23 = sr;
+    t.m32 = -sr; t.m33 = cr;
+    matrix3d_append(matrix, t);
+}
+
+void ege_matrix3d_rotate_y(ege_transform_matrix3d* matrix, float rad)
+{
+    if (matrix == NULL) {
+        return;
+    }
+
+    float sr = (float)sin(rad), cr = (float)cos(rad);
+    ege_transform_matrix3d t;
+    ege_matrix3d_identity(&t);
+    t.m11 = cr; t.m13 = -sr;
+    t.m31 = sr; t.m33 = cr;
+    matrix3d_append(matrix, t);
+}
+
+void ege_matrix3d_rotate_z(ege_transform_matrix3d* matrix, float rad)
+{
+    if (matrix == NULL) {
+        return;
+    }
+
+    float sr = (float)sin(rad), cr = (float)cos(rad);
+    ege_transform_matrix3d t;
+    ege_matrix3d_identity(&t);
+    t.m11 = cr;  t.m12 = sr;
+    t.m21 = -sr; t.m22 = cr;
+    matrix3d_append(matrix, t);
+}
+
+void ege_matrix3d_scale(ege_transform_matrix3d* matrix, float sx, float sy, float sz)
+{
+    if (matrix == NULL) {
+        return;
+    }
+
+    ege_transform_matrix3d t;
+    ege_matrix3d_identity(&t);
+    t.m11 = sx;
+    t.m22 = sy;
+    t.m33 = sz;
+    matrix3d_append(matrix, t);
+}
+
+void ege_matrix3d_translate(ege_transform_matrix3d* matrix, float tx, float ty, float tz)
+{
+    if (matrix == NULL) {
+        return;
+    }
+
+    ege_transform_matrix3d t;
+    ege_matrix3d_identity(&t);
+    t.m41 = tx;
+    t.m42 = ty;
+    t.m43 = tz;
+    matrix3d_append(matrix, t);
+}
+
+// 第四列为 (0, 0, 0, 1) 时为仿射变换, 无需做齐次除法
+static bool matrix3d_is_affine(const ege_transform_matrix3d* m)
+{
+    return m->m14 == 0.0f && m->m24 == 0.0f && m->m34 == 0.0f && m->m44 == 1.0f;
+}
+
+#ifdef EGE_MATH_SSE2
+// 与标量路径相同的求和顺序 ((x * r1 + y * r2) + z * r3) + r4, 保证两条路径结果逐位一致
+static inline __m128 madd4_sse2(__m128 x, __m128 y, __m128 z, __m128 r1, __m128 r2, __m128 r3, __m128 r4)
+{
+    return _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(x, r1), _mm_mul_ps(y, r2)), _mm_mul_ps(z, r3)), r4);
+}
+
+// 单个点乘以矩阵, 结果为 (x, y, z, w)
+static inline __m128 transform_point_sse2(const VECTOR3D& v, __m128 row1, __m128 row2, __m128 row3, __m128 row4)
+{
+    return madd4_sse2(_mm_set1_ps(v.x), _mm_set1_ps(v.y), _mm_set1_ps(v.z), row1, row2, row3, row4);
+}
+#endif
+
+void transform_points3d(VECTOR3D* dst, const VECTOR3D* src, int count, const ege_transform_matrix3d* matrix)
+{
+    if (dst == NULL || src == NULL || matrix == NULL || count <= 0) {
+        return;
+    }
+
+    const ege_transform_matrix3d& m = *matrix;
+    const bool affine = matrix3d_is_affine(matrix);
+    int i = 0;
+
+#ifdef EGE_MATH_SSE2
+    // 每次处理一个点: 4 个输出分量 (x, y, z, w) 同时计算, 矩阵行只加载一次
+    const __m128 row1 = _mm_loadu_ps(&m.m11);
+    const __m128 row2 = _mm_loadu_ps(&m.m21);
+    const __m128 row3 = _mm_loadu_ps(&m.m31);
+    const __m128 row4 = _mm_loadu_ps(&m.m41);
+
+    for (; i < count; ++i) {
+        __m128 r = transform_point_sse2(src[i], row1, row2, row3, row4);
+
+        if (!affine) {
+            r = _mm_div_ps(r, _mm_shuffle_ps(r, r, _MM_SHUFFLE(3, 3, 3, 3)));
+        }
+
+        // VECTOR3D 只有 3 个分量, 不能整体写入 16 字节
+        float out[4];
+        _mm_storeu_ps(out, r);
+        dst[i].x = out[0];
+        dst[i].y = out[1];
+        dst[i].z = out[2];
+    }
+#endif
+
+    for (; i < count; ++i) {
+        float x = src[i].x, y = src[i].y, z = src[i].z;
+        float tx = x * m.m11 + y * m.m21 + z * m.m31 + m.m41;
+        float ty = x * m.m12 + y * m.m22 + z * m.m32 + m.m42;
+        float tz = x * m.m13 + y * m.m23 + z * m.m33 + m.m43;
+
+        if (!affine) {
+            float w = x * m.m14 + y * m.m24 + z * m.m34 + m.m44;
+            tx /= w;
+            ty /= w;
+            tz /= w;
+        }
+
+        dst[i].x = tx;
+        dst[i].y = ty;
+        dst[i].z = tz;
+    }
+}
+
+void transform_points3d(float* xs, float* ys, float* zs, int count, const ege_transform_matrix3d* matrix)
+{
+    if (xs == NULL || ys == NULL || zs == NULL || matrix == NULL || count <= 0) {
+        return;
+    }
+
+    const ege_transform_matrix3d& m = *matrix;
+    const bool affine = matrix3d_is_affine(matrix);
+    int i = 0;
+
+#ifdef EGE_MATH_SSE2
+    // 结构数组布局下每次处理 4 个点, 每个矩阵元素广播到一个寄存器
+    const __m128 m11 = _mm_set1_ps(m.m11), m12 = _mm_set1_ps(m.m12), m13 = _mm_set1_ps(m.m13), m14 = _mm_set1_ps(m.m14);
+    const __m128 m21 = _mm_set1_ps(m.m21), m22 = _mm_set1_ps(m.m22), m23 = _mm_set1_ps(m.m23), m24 = _mm_set1_ps(m.m24);
+    const __m128 m31 = _mm_set1_ps(m.m31), m32 = _mm_set1_ps(m.m32), m33 = _mm_set1_ps(m.m33), m34 = _mm_set1_ps(m.m34);
+    const __m128 m41 = _mm_set1_ps(m.m41), m42 = _mm_set1_ps(m.m42), m43 = _mm_set1_ps(m.m43), m44 = _mm_set1_ps(m.m44);
+
+    for (; i + 4 <= count; i += 4) {
+        __m128 x = _mm_loadu_ps(xs + i);
+        __m128 y = _mm_loadu_ps(ys + i);
+        __m128 z = _mm_loadu_ps(zs + i);
+
+        __m128 tx = madd4_sse2(x, y, z, m11, m21, m31, m41);
+        __m128 ty = madd4_sse2(x, y, z, m12, m22, m32, m42);
+        __m128 tz = madd4_sse2(x, y, z, m13, m23, m33, m43);
+
+        if (!affine) {
+            __m128 w = madd4_sse2(x, y, z, m14, m24, m34, m44);
+            tx = _mm_div_ps(tx, w);
+            ty = _mm_div_ps(ty, w);
+            tz = _mm_div_ps(tz, w);
+        }
+
+        _mm_storeu_ps(xs + i, tx);
+        _mm_storeu_ps(ys + i, ty);
+        _mm_storeu_ps(zs + i, tz);
+    }
+#endif
+
+    for (; i < count; ++i) {
+        float x = xs[i], y = ys[i], z = zs[i];
+        float tx = x * m.m11 + y * m.m21 + z * m.m31 + m.m41;
+        float ty = x * m.m12 + y * m.m22 + z * m.m32 + m.m42;
+        float tz = x * m.m13 + y * m.m23 + z * m.m33 + m.m43;
+
+        if (!affine) {
+            float w = x * m.m14 + y * m.m24 + z * m.m34 + m.m44;
+            tx /= w;
+            ty /= w;
+            tz /= w;
+        }
+
+        xs[i] = tx;
+        ys[i] = ty;
+        zs[i] = tz;
+    }
+}
+
+// 透视投影时允许的最小深度, 小于该值的点视为位于观察点之后
+#define PROJECT_NEAR_Z 1e-4f
+
+#ifdef EGE_MATH_SSE2
+// 4 路并行的变换与透视除法, 与 project_point() 的计算顺序相同
+struct project_sse2
+{
+    __m128 row1, row2, row3, row4;
+    __m128 focal, cx, cy, nearZ;
+
+    project_sse2(const ege_transform_matrix3d& m, float focalLength, float centerX, float centerY)
+        : row1(_mm_loadu_ps(&m.m11))
+        , row2(_mm_loadu_ps(&m.m21))
+        , row3(_mm_loadu_ps(&m.m31))
+        , row4(_mm_loadu_ps(&m.m41))
+        , focal(_mm_set1_ps(focalLength))
+        , cx(_mm_set1_ps(centerX))
+        , cy(_mm_set1_ps(centerY))
+        , nearZ(_mm_set1_ps(PROJECT_NEAR_Z))
+    {
+    }
+
+    // 投影 src[0..3], 返回位于观察点之前的点的位掩码
+    int operator()(const VECTOR3D* src, __m128& sx, __m128& sy) const
+    {
+        __m128 p0 = transform_point_sse2(src[0], row1, row2, row3, row4);
+        __m128 p1 = transform_point_sse2(src[1], row1, row2, row3, row4);
+        __m128 p2 = transform_point_sse2(src[2], row1, row2, row3, row4);
+        __m128 p3 = transform_point_sse2(src[3], row1, row2, row3, row4);
+        _MM_TRANSPOSE4_PS(p0, p1, p2, p3);
+
+        __m128 s = _mm_div_ps(focal, _mm_max_ps(p2, nearZ));
+        sx = _mm_add_ps(cx, _mm_mul_ps(p0, s));
+        sy = _mm_add_ps(cy, _mm_mul_ps(p1, s));
+        return _mm_movemask_ps(_mm_cmpgt_ps(p2, nearZ));
+    }
+};
+
+// 与标量路径一致的 floor(v + 0.5) 取整
+static inline __m128i round_ps(__m128 v)
+{
+    v = _mm_add_ps(v, _mm_set1_ps(0.5f));
+    __m128i t = _mm_cvttps_epi32(v);
+    __m128  adjust = _mm_cmpgt_ps(_mm_cvtepi32_ps(t), v);
+    return _mm_add_epi32(t, _mm_castps_si128(adjust));
+}
+#endif
+
+// 投影单个点, 点位于观察点之后时返回 false
+static inline bool project_point(const VECTOR3D& v, const ege_transform_matrix3d& m, float focalLength, float centerX,
+    float centerY, float* sx, float* sy)
+{
+    float x = v.x, y = v.y, z = v.z;
+    float tz = x * m.m13 + y * m.m23 + z * m.m33 + m.m43;
+    if (!(tz > PROJECT_NEAR_Z)) {
+        return false;
+    }
+
+    float tx = x * m.m11 + y * m.m21 + z * m.m31 + m.m41;
+    float ty = x * m.m12 + y * m.m22 + z * m.m32 + m.m42;
+    float s  = focalLength / tz;
+
+    *sx = centerX + tx * s;
+    *sy = centerY + ty * s;
+    return true;
+}
+
+int project_points3d(ege_point* dst, const VECTOR3D* src, int count, const ege_transform_matrix3d* matrix,
+    float focalLength, float centerX, float centerY)
+{
+    if (dst == NULL || src == NULL || matrix == NULL || count <= 0) {
+        return 0;
+    }
+
+    const ege_transform_matrix3d& m = *matrix;
+    int numOfPoints = 0;
+    int i = 0;
+
+#ifdef EGE_MATH_SSE2
+    const project_sse2 project(m, focalLength, centerX, centerY);
+
+    for (; i + 4 <= count; i += 4) {
+        __m128 sx, sy;
+        int mask = project(src + i, sx, sy);
+        if (mask == 0) {
+            continue;
+        }
+
+        float xs[4], ys[4];
+        _mm_storeu_ps(xs, sx);
+        _mm_storeu_ps(ys, sy);
+        for (int k = 0; k < 4; ++k) {
+            if (mask & (1 << k)) {
+                dst[numOfPoints].x = xs[k];
+                dst[numOfPoints].y = ys[k];
+                ++numOfPoints;
+            }
+        }
+    }
+#endif
+
+    for (; i < count; ++i) {
+        float sx, sy;
+        if (project_point(src[i], m, focalLength, centerX, centerY, &sx, &sy)) {
+            dst[numOfPoints].x = sx;
+            dst[numOfPoints].y = sy;
+            ++numOfPoints;
+        }
+    }
+
+    return numOfPoints;
+}
+
+int project_points3d(int* dst, const VECTOR3D* src, int count, const ege_transform_matrix3d* matrix,
+    float focalLength, float centerX, float centerY, color_t color)
+{
+    if (dst == NULL || src == NULL || matrix == NULL || count <= 0) {
+        return 0;
+    }
+
+    const ege_transform_matrix3d& m = *matrix;
+    int numOfPoints = 0;
+    int i = 0;
+
+#ifdef EGE_MATH_SSE2
+    const project_sse2 project(m, focalLength, centerX, centerY);
+
+    // 每次投影 4 个点, 取整也 4 路并行完成
+    for (; i + 4 <= count; i += 4) {
+        __m128 sx, sy;
+        int mask = project(src + i, sx, sy);
+        if (mask == 0) {
+            continue;
+        }
+
+        int xs[4], ys[4];
+        _mm_storeu_si128((__m128i*)xs, round_ps(sx));
+        _mm_storeu_si128((__m128i*)ys, round_ps(sy));
+        for (int k = 0; k < 4; ++k) {
+            if (mask & (1 << k)) {
+                dst[0] = xs[k];
+                dst[1] = ys[k];
+                dst[2] = (int)color;
+                dst   += 3;
+                ++numOfPoints;
+            }
+        }
+    }
+#endif
+
+    for (; i < count; ++i) {
+        float sx, sy;
+        if (project_point(src[i], m, focalLength, centerX, centerY, &sx, &sy)) {
+            dst[0] = (int)floorf(sx + 0.5f);
+            dst[1] = (int)floorf(sy + 0.5f);
+            dst[2] = (int)color;
+            dst   += 3;
+            ++numOfPoints;
+        }
+    }
+
+    return numOfPoints;
+}
+
+#undef PROJECT_NEAR_Z
+
 } // namespace ege
@@ -8,7 +8,15 @@
 #include "ege_head.h"
 #include "ege_common.h"
 
+#include <math.h>
+#include <string.h>
 #include <time.h>
+#include <new>
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define EGE_RANDOM_SSE2 1
+#include <emmintrin.h>
+#endif
 
 namespace ege
 {
@@ -102,6 +110,28 @@ public:
         return y;
     }
 
+    // 批量生成, 与连续调用 n 次 rand() 得到的序列完全相同
+    void fill(uint32_t* out, size_t n)
+    {
+        while (n > 0) {
+            if (left == 1) {
+                next_state();
+                ++left; // rand() 在刷新状态后取第一个数时不递减 left, 这里补上
+            }
+
+            size_t count = left - 1;
+            if (count > n) {
+                count = n;
+            }
+
+            temper(next, out, count);
+            next += count;
+            left -= (uint32_t)count;
+            out  += count;
+            n    -= count;
+        }
+    }
+
     double real() { return (double)rand() / ((double)(unsigned long)(-1L) + 1); }
 
     // generates a random number on [0,1) with 53-bit resolution
@@ -142,6 +172,31 @@ private:
         next = state;
     }
 
+    static void temper(const uint32_t* src, uint32_t* dst, size_t n)
+    {
+        size_t i = 0;
+#ifdef EGE_RANDOM_SSE2
+        const __m128i mask_b = _mm_set1_epi32((int)0x9d2c5680UL);
+        const __m128i mask_c = _mm_set1_epi32((int)0xefc60000UL);
+        for (; i + 4 <= n; i += 4) {
+            __m128i y = _mm_loadu_si128((const __m128i*)(src + i));
+            y = _mm_xor_si128(y, _mm_srli_epi32(y, 11));
+            y = _mm_xor_si128(y, _mm_and_si128(_mm_slli_epi32(y, 7), mask_b));
+            y = _mm_xor_si128(y, _mm_and_si128(_mm_slli_epi32(y, 15), mask_c));
+            y = _mm_xor_si128(y, _mm_srli_epi32(y, 18));
+            _mm_storeu_si128((__m128i*)(dst + i), y);
+        }
+#endif
+        for (; i < n; ++i) {
+            uint32_t y = src[i];
+            y ^= (y >> 11);
+            y ^= (y << 7) & 0x9d2c5680UL;
+            y ^= (y << 15) & 0xefc60000UL;
+            y ^= (y >> 18);
+            dst[i] = y;
+        }
+    }
+
     uint32_t mixbits(uint32_t u, uint32_t v) const { return (u & 2147483648UL) | (v & 2147483647UL); }
 
     uint32_t twist(uint32_t u, uint32_t v) const { return ((mixbits(u, v) >> 1) ^ (v & 1UL ? 2567483615UL : 0UL)); }
@@ -166,6 +221,8 @@ public:
     uint32_t operator()() const { return r.rand(); }
 
     double operator()(double) { return r.real(); }
+
+    void operator()(uint32_t* buf, size_t n) { r.fill(buf, n); }
 };
 
 mtrandom mtrand_help::r;
@@ -213,4 +270,318 @@ double randomf()
     return mtdrand();
 }
 
+void random_fill_u32(uint32_t* buf, int n)
+{
+    if (buf == NULL || n <= 0) {
+        return;
+    }
+
+    mtrand_help()(buf, (size_t)n);
+}
+
+// 取高 24 位映射到 [0, 1), 恰好填满 float 的尾数精度
+#define U32_TO_UNIT_FLOAT(u) ((float)((u) >> 8) * (1.0f / 16777216.0f))
+
+// 与 nextafterf(x, target) 相同, 旧版 VC 的运行库没有提供 nextafterf
+static float float_toward(float x, float target)
+{
+    if (x != x || target != target) {
+        return x + target;
+    }
+    if (x == target) {
+        return target;
+    }
+
+    uint32_t bits;
+    memcpy(&bits, &x, sizeof(bits));
+    if (x == 0.0f) {
+        bits = (target > 0.0f) ? 1u : 0x80000001u;
+    } else if ((x < target) == (x > 0.0f)) {
+        ++bits;
+    } else {
+        --bits;
+    }
+    memcpy(&x, &bits, sizeof(x));
+    return x;
+}
+
+// Source 需提供 operator()(uint32_t* buf, size_t n), 批量输出 32 位随机数
+template <typename Source>
+static void fill_f32(Source& source, float* buf, int n, float lo, float hi)
+{
+    const int   blockSize = 256;
+    uint32_t    block[blockSize];
+    const float scale = hi - lo;
+    // lo + scale * u 在 u 接近 1 时可能舍入为 hi, 需要限制在 hi 之前的最后一个 float
+    const float limit = float_toward(hi, lo);
+    const bool  ascending = hi > lo;
+
+    for (int offset = 0; offset < n; offset += blockSize) {
+        int count = MIN(blockSize, n - offset);
+        float* out = buf + offset;
+        source(block, (size_t)count);
+
+        int i = 0;
+#ifdef EGE_RANDOM_SSE2
+        const __m128  vunit  = _mm_set1_ps(1.0f / 16777216.0f);
+        const __m128  vscale = _mm_set1_ps(scale);
+        const __m128  vlo    = _mm_set1_ps(lo);
+        const __m128  vlimit = _mm_set1_ps(limit);
+        for (; i + 4 <= count; i += 4) {
+            __m128i u = _mm_srli_epi32(_mm_loadu_si128((const __m128i*)(block + i)), 8);
+            __m128  f = _mm_add_ps(vlo, _mm_mul_ps(vscale, _mm_mul_ps(_mm_cvtepi32_ps(u), vunit)));
+            f = ascending ? _mm_min_ps(f, vlimit) : _mm_max_ps(f, vlimit);
+            _mm_storeu_ps(out + i, f);
+        }
+#endif
+        for (; i < count; ++i) {
+            float f = lo + scale * U32_TO_UNIT_FLOAT(block[i]);
+            if (ascending ? (f > limit) : (f < limit)) {
+                f = limit;
+            }
+            out[i] = f;
+        }
+    }
+}
+
+template <typename Source>
+static void fill_normal(Source& source, float* buf, int n, float mean, float stddev)
+{
+    // Box-Muller 变换, 每对均匀分布随机数生成两个正态分布随机数
+    const int   blockSize = 256;
+    const float twoPi     = 6.28318530717958647692f;
+    uint32_t    block[blockSize];
+
+    for (int offset = 0; offset < n; offset += blockSize) {
+        int count = MIN(blockSize, n - offset);
+        int pairs = (count + 1) / 2;
+        float* out = buf + offset;
+        source(block, (size_t)pairs * 2);
+
+        for (int i = 0; i < pairs; ++i) {
+            // u1 取 (0, 1], 避免 log(0)
+            float u1 = 1.0f - U32_TO_UNIT_FLOAT(block[2 * i]);
+            float u2 = U32_TO_UNIT_FLOAT(block[2 * i + 1]);
+            float r  = stddev * sqrtf(-2.0f * logf(u1));
+            float theta = twoPi * u2;
+
+            out[2 * i] = mean + r * cosf(theta);
+            if (2 * i + 1 < count) {
+                out[2 * i + 1] = mean + r * sinf(theta);
+            }
+        }
+    }
+}
+
+#undef U32_TO_UNIT_FLOAT
+
+void random_fill_f32(float* buf, int n, float lo, float hi)
+{
+    if (buf == NULL || n <= 0) {
+        return;
+    }
+
+    mtrand_help source;
+    fill_f32(source, buf, n, lo, hi);
+}
+
+void random_fill_normal(float* buf, int n, float mean, float stddev)
+{
+    if (buf == NULL || n <= 0) {
+        return;
+    }
+
+    mtrand_help source;
+    fill_normal(source, buf, n, mean, stddev);
+}
+
+//************************************************************************
+//  独立随机数流, 基于 xoshiro256** (David Blackman, Sebastiano Vigna, 2018)
+//  每个 ege_rng 拥有独立状态, 不同线程各自持有一个即可无锁并行生成.
+//  jump() 相当于调用 2^128 次 next(), 用于划分互不重叠的子序列.
+//************************************************************************
+
+// JUMP_POLY[k] 为前进 2^(128+k) 步的跳跃多项式, 即 x^(2^(128+k)) 对特征多项式取模,
+// 第 0 项即 xoshiro256** 原作者给出的 jump() 常量. 按 streamId 的二进制位组合使用,
+// 定位第 streamId 个子序列只需 O(log streamId) 次跳跃.
+static const uint64_t JUMP_POLY[32][4] = {
+    {0x180ec6d33cfd0abaULL, 0xd5a61266f0c9392cULL, 0xa9582618e03fc9aaULL, 0x39abdc4529b1661cULL}, // 2^128
+    {0x8cfe9bd9ab71d992ULL, 0xccfc8ca2814de79eULL, 0xa5a28cccb37dba5bULL, 0xa23e49ee6f1a7a8dULL}, // 2^129
+    {0x1b2a94a672a48c05ULL, 0x5e38f4fbb6fcda72ULL, 0xca8a45310219dc67ULL, 0xd4e9921bccb8090bULL}, // 2^130
+    {0xf30974a2b1dbbb71ULL, 0x34cd4cc8228d74acULL, 0xfa0587a90f717438ULL, 0xee658f69deb5df26ULL}, // 2^131
+    {0xb42bd4670583b289ULL, 0xd2c0d8e0c8a2fb9bULL, 0x2573e3218d8bb7daULL, 0xd7aaaf48aa459c58ULL}, // 2^132
+    {0xf6a5ab84efb67883ULL, 0xcc7efdcfed1ac303ULL, 0xd82be75b83dbc2d0ULL, 0x8fd437c01abeab24ULL}, // 2^133
+    {0xc85ee5171484f5a4ULL, 0xedc8b8d02a22310bULL, 0xb0b87a330b854c8aULL, 0x7d16742eceb4d5abULL}, // 2^134
+    {0x4298ba0e862a6007ULL, 0x4157dc48443e3565ULL, 0x13c97c0891cab48aULL, 0x6533981804b420eaULL}, // 2^135
+    {0xee5f5a6f02dfe47cULL, 0xedc28c89cb341660ULL, 0x613b2ed9f0acc107ULL, 0xa1ee335d14807ae0ULL}, // 2^136
+    {0x5ec3050c6b43565aULL, 0x4b26f71c1fb1b47bULL, 0x0531513e8e0ac706ULL, 0x799d469b2145a8a3ULL}, // 2^137
+    {0x34f0a6799020283eULL, 0x7123f2290a1f413bULL, 0xb6acd7be4906b73dULL, 0x6007bb31ec5a2964ULL}, // 2^138
+    {0xaa0711c54877febdULL, 0x54fe6df4cff0db73ULL, 0x7e42d6f544840499ULL, 0xec907801890a47abULL}, // 2^139
+    {0x03833e601d82a673ULL, 0x3ec263f5c999196eULL, 0xd8c4367e574ab160ULL, 0x964e9d188c16508eULL}, // 2^140
+    {0xd64f3f2aaf8f2171ULL, 0xf524fd4408357a5cULL, 0x15ac212f3b861b5aULL, 0x24d9ba21277dd8d8ULL}, // 2^141
+    {0xfe9b778d7d1ca2deULL, 0xbbe0e2c0c44b2e1cULL, 0x17a7af3e97d8c402ULL, 0xf89354cfe1e6b5fbULL}, // 2^142
+    {0x695cf225704e767dULL, 0xf4873d277cd1ab72ULL, 0xaad8c318bc459cceULL, 0xb89526857566cd94ULL}, // 2^143
+    {0x3dcd32f39276a95fULL, 0xc51212c8b1aa2787ULL, 0x962c90a866ea6719ULL, 0xb81875d0f4f6f253ULL}, // 2^144
+    {0xb43cf8e4eaf8e068ULL, 0x1c554e97b2277f47ULL, 0xa5a140826c351d07ULL, 0x11495a1b200d4eb8ULL}, // 2^145
+    {0x417b73b324735d32ULL, 0xff957b6f55288048ULL, 0x05af69bf1fb82891ULL, 0x3e53bfa0db28e110ULL}, // 2^146
+    {0xb6c7a6004612889cULL, 0xfdb3f4ea18f0a56bULL, 0xd3da65e82bdd39e2ULL, 0x48f6214560239b46ULL}, // 2^147
+    {0xf1267ba0ec3c645eULL, 0xd9dc0929a54fea75ULL, 0xec60b640d685171dULL, 0xde364ef64a484f59ULL}, // 2^148
+    {0x2761cbab38e0f580ULL, 0xd7f1c5ade3de404aULL, 0xcb6286958a9af01aULL, 0x2b29c7d3ef18d3b3ULL}, // 2^149
+    {0x5a5ce93f67a3cdd6ULL, 0x547db3576511edc2ULL, 0x99455c744595c01fULL, 0x6a3b6a431109e3d1ULL}, // 2^150
+    {0xafd80c1c832a739eULL, 0x0d9d73da9f40f374ULL, 0xed1d0a619aa60748ULL, 0x00d2333b0c03f620ULL}, // 2^151
+    {0x11428ceb13f2cc2cULL, 0xef46e42368baead3ULL, 0x2a47bd3fc39081daULL, 0x3f03458e0273439bULL}, // 2^152
+    {0x47558e815c898e8bULL, 0x9f8160e9d0124398ULL, 0x0fdcfd4ab0f5afeeULL, 0xade2626c292a2a9fULL}, // 2^153
+    {0xe848ff06d72a9252ULL, 0xf8be2d3d6ce206b0ULL, 0xd84fc5f798c1a55eULL, 0xc35abe5cebab1ba4ULL}, // 2^154
+    {0xb0dd0edb19af078cULL, 0xee1d857a675ca074ULL, 0x60ef7116e6f3c1e0ULL, 0x7c25b2c3282fb730ULL}, // 2^155
+    {0xb51a19064886308aULL, 0x6b590805d407e77eULL, 0x57059d3707ee283aULL, 0x6298f48fa13cc12fULL}, // 2^156
+    {0x4f1102acb29c3230ULL, 0xcf69cee6182fa164ULL, 0x1780be415c86b5d5ULL, 0xab5d0760d1fe77dcULL}, // 2^157
+    {0xc639b7c24b26ef11ULL, 0xa57d650a8007d505ULL, 0xd81275131f4f91f8ULL, 0x10000e5f7bf7a58bULL}, // 2^158
+    {0x295b23eaa04478edULL, 0xf1d3279f36823213ULL, 0x743eedc2ede6d478ULL, 0x09d89163f581d1e0ULL}, // 2^159
+};
+
+struct ege_rng
+{
+    uint64_t s[4];
+
+    ege_rng(uint32_t seed, uint32_t streamId)
+    {
+        // 使用 splitmix64 展开种子, 保证状态不全为 0
+        uint64_t x = seed;
+        for (int i = 0; i < 4; ++i) {
+            uint64_t z = (x += 0x9e3779b97f4a7c15ULL);
+            z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+            z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+            s[i] = z ^ (z >> 31);
+        }
+
+        for (int k = 0; streamId != 0; ++k, streamId >>= 1) {
+            if (streamId & 1) {
+                jump(JUMP_POLY[k]);
+            }
+        }
+    }
+
+    static uint64_t rotl(uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+
+    uint64_t next()
+    {
+        const uint64_t result = rotl(s[1] * 5, 7) * 9;
+        const uint64_t t      = s[1] << 17;
+
+        s[2] ^= s[0];
+        s[3] ^= s[1];
+        s[1] ^= s[2];
+        s[0] ^= s[3];
+        s[2] ^= t;
+        s[3]  = rotl(s[3], 45);
+
+        return result;
+    }
+
+    // 前进的步数由跳跃多项式决定, 见 JUMP_POLY
+    void jump(const uint64_t poly[4])
+    {
+        uint64_t t[4] = {0, 0, 0, 0};
+        for (int i = 0; i < 4; ++i) {
+            for (int b = 0; b < 64; ++b) {
+                if (poly[i] & ((uint64_t)1 << b)) {
+                    t[0] ^= s[0];
+                    t[1] ^= s[1];
+                    t[2] ^= s[2];
+                    t[3] ^= s[3];
+                }
+                next();
+            }
+        }
+
+        s[0] = t[0];
+        s[1] = t[1];
+        s[2] = t[2];
+        s[3] = t[3];
+    }
+
+    // 高 32 位的统计质量优于低位
+    uint32_t next32() { return (uint32_t)(next() >> 32); }
+
+    void operator()(uint32_t* buf, size_t n)
+    {
+        for (size_t i = 0; i < n; ++i) {
+            buf[i] = next32();
+        }
+    }
+};
+
+ege_rng* ege_rng_create(uint32_t seed, uint32_t streamId)
+{
+    return new(std::nothrow) ege_rng(seed, streamId);
+}
+
+ege_rng* ege_rng_clone(const ege_rng* rng)
+{
+    if (rng == NULL) {
+        return NULL;
+    }
+
+    return new(std::nothrow) ege_rng(*rng);
+}
+
+void ege_rng_destroy(const ege_rng* rng)
+{
+    delete rng;
+}
+
+void ege_rng_jump(ege_rng* rng)
+{
+    if (rng != NULL) {
+        rng->jump(JUMP_POLY[0]);
+    }
+}
+
+uint32_t ege_rng_random(ege_rng* rng, uint32_t n)
+{
+    if (rng == NULL) {
+        return 0;
+    }
+
+    uint32_t x = rng->next32();
+    return (n == 0) ? x : (uint32_t)(((uint64_t)x * n) >> 32);
+}
+
+double ege_rng_randomf(ege_rng* rng)
+{
+    if (rng == NULL) {
+        return 0.0;
+    }
+
+    // 取高 53 位, 生成 [0, 1) 的双精度浮点数
+    return (double)(rng->next() >> 11) * (1.0 / 9007199254740992.0);
+}
+
+void ege_rng_fill_u32(ege_rng* rng, uint32_t* buf, int n)
+{
+    if (rng == NULL || buf == NULL || n <= 0) {
+        return;
+    }
+
+    (*rng)(buf, (size_t)n);
+}
+
+void ege_rng_fill_f32(ege_rng* rng, float* buf, int n, float lo, float hi)
+{
+    if (rng == NULL || buf == NULL || n <= 0) {
+        return;
+    }
+
+    fill_f32(*rng, buf, n, lo, hi);
+}
+
+void ege_rng_fill_normal(ege_rng* rng, float* buf, int n, float mean, float stddev)
+{
+    if (rng == NULL || buf == NULL || n <= 0) {
+        return;
+    }
+
+    fill_normal(*rng, buf, n, mean, stddev);
+}
+
 } // namespace ege